@@ -1,6 +1,13 @@
 #include <VizEngine.h>
 #include <VizEngine/Events/ApplicationEvent.h>
 #include <VizEngine/Events/KeyEvent.h>
+#include <VizEngine/Core/Half.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <unordered_map>
 
 class Sandbox : public VizEngine::Application
 {
@@ -35,47 +42,23 @@ public:
 		cube.Color = glm::vec4(0.9f, 0.5f, 0.3f, 1.0f);
 
 		// =========================================================================
-		// Load glTF Model
+		// Load glTF Model (in the background, added to the scene when ready)
 		// =========================================================================
-		auto duckModel = VizEngine::Model::LoadFromFile("assets/gltf-samples/Models/Duck/glTF-Binary/Duck.glb");
-		if (duckModel)
-		{
-			VP_INFO("Duck model loaded: {} meshes", duckModel->GetMeshCount());
-
-			// Store mesh and material properties for reuse (Add Duck button)
-			if (duckModel->GetMeshCount() > 0)
-			{
-				m_DuckMesh = duckModel->GetMeshes()[0];
-				const auto& material = duckModel->GetMaterialForMesh(0);
-				m_DuckColor = material.BaseColor;
-				m_DuckRoughness = material.Roughness;
-				if (material.BaseColorTexture)
-				{
-					m_DuckTexture = material.BaseColorTexture;
-				}
-			}
-
-			// Add initial duck to scene
-			for (size_t i = 0; i < duckModel->GetMeshCount(); i++)
-			{
-				auto& duckObj = m_Scene.Add(duckModel->GetMeshes()[i], "Duck");
-				duckObj.ObjectTransform.Position = glm::vec3(0.0f, 0.0f, 3.0f);
-				duckObj.ObjectTransform.Scale = glm::vec3(0.02f);
-
-				// Copy material properties from glTF
-				const auto& material = duckModel->GetMaterialForMesh(i);
-				duckObj.Color = material.BaseColor;
-				duckObj.Roughness = material.Roughness;
-				if (material.BaseColorTexture)
-				{
-					duckObj.TexturePtr = material.BaseColorTexture;
-				}
-			}
-		}
-		else
-		{
-			VP_ERROR("Failed to load Duck model!");
-		}
+		VizEngine::ModelLoadOptions duckOptions;
+		duckOptions.PackVertices = true;     // Compact 20-byte vertices
+		duckOptions.OptimizeMeshes = true;   // Vertex cache / overdraw / fetch order
+		duckOptions.GenerateLods = true;     // Quadric LOD chain, picked by screen size
+		duckOptions.BuildMeshlets = true;    // Per-cluster frustum / cone culling
+		duckOptions.CompressTextures = true; // BC1/BC7 with mips, cached next to the model
+		duckOptions.StreamTextures = true;   // Top mips loaded on demand, under a VRAM budget
+		m_DuckLoad = VizEngine::AssetManager::Get().LoadModelAsync("assets/gltf-samples/Models/Duck/glTF-Binary/Duck.glb", duckOptions);
+
+		// A gltfpack-style box (KHR_mesh_quantization + EXT_meshopt_compression)
+		// loaded with PackVertices alone, so its uint16 positions take the direct
+		// packed path with the node dequantization folded in (see ModelLoadOptions)
+		VizEngine::ModelLoadOptions quantizedOptions;
+		quantizedOptions.PackVertices = true;
+		m_QuantizedBoxLoad = VizEngine::AssetManager::Get().LoadModelAsync("resources/models/QuantizedBox.glb", quantizedOptions);
 
 		// =========================================================================
 		// Lighting
@@ -94,9 +77,29 @@ public:
 		// =========================================================================
 		// Load Assets
 		// =========================================================================
-		m_LitShader = std::make_unique<VizEngine::Shader>("resources/shaders/lit.shader");
-		m_ShadowDepthShader = std::make_unique<VizEngine::Shader>("resources/shaders/shadow_depth.shader");
-		m_DefaultTexture = std::make_shared<VizEngine::Texture>("resources/textures/uvchecker.png");
+		m_LitShader = VizEngine::AssetManager::Get().LoadShader("resources/shaders/lit.shader");
+		if (!m_LitShader)
+		{
+			// Nothing can be drawn without it; AssetManager logged the reason
+			VP_ERROR("Failed to load lit.shader, exiting");
+			VizEngine::Engine::Get().Quit();
+			return;
+		}
+
+		// Variants the scene draws with before and after the environment
+		// loads; issued now so the driver compiles them while assets stream in
+		uint64_t shadowsTextured = VizEngine::ShaderKeywords::Get("SHADOWS") | VizEngine::ShaderKeywords::Get("TEXTURED");
+		m_LitShader->GetVariant(shadowsTextured);
+		m_LitShader->GetVariant(shadowsTextured | VizEngine::ShaderKeywords::Get("ENV_DIFFUSE") | VizEngine::ShaderKeywords::Get("ENV_SPECULAR"));
+
+		// Environment lighting block of lit.shader; intensity 0 (flat ambient)
+		// until the skybox's irradiance is known
+		VizEngine::SHUniformBlock environment = VizEngine::SphericalHarmonics::ToUniformBlock({}, 0.0f);
+		m_EnvironmentUBO = std::make_unique<VizEngine::UniformBuffer>(
+			sizeof(environment), VizEngine::SphericalHarmonics::UniformBinding, &environment);
+
+		m_ShadowDepthShader = VizEngine::AssetManager::Get().LoadShader("resources/shaders/shadow_depth.shader");
+		m_DefaultTexture = VizEngine::AssetManager::Get().LoadTexture("resources/textures/uvchecker.png");
 
 		// Assign default texture to basic objects (created before this point)
 		for (size_t i = 0; i < m_Scene.Size(); i++)
@@ -170,8 +173,15 @@ public:
 		);
 		m_ShadowMapFramebuffer->AttachDepthTexture(m_ShadowMapDepth);
 
-		// Verify shadow map framebuffer is complete
-		if (!m_ShadowMapFramebuffer->IsComplete())
+		// Shadows need the depth shader and a complete framebuffer
+		if (!m_ShadowDepthShader)
+		{
+			VP_ERROR("Failed to load shadow_depth.shader! Disabling shadows.");
+			m_ShadowMapFramebuffer.reset();
+			m_ShadowMapDepth.reset();
+			m_ShowShadowMap = false;
+		}
+		else if (!m_ShadowMapFramebuffer->IsComplete())
 		{
 			VP_ERROR("Shadow map framebuffer is not complete! Disabling shadows.");
 			m_ShadowMapFramebuffer.reset();
@@ -189,22 +199,93 @@ public:
 		// =========================================================================
 		VP_INFO("Loading environment HDRI...");
 
-		// Load HDR equirectangular map
-		m_EnvironmentHDRI = std::make_shared<VizEngine::Texture>(
-			"resources/textures/environments/qwantani_dusk_2_puresky_2k.hdr", 
-			true  // isHDR
-		);
+		// Load the HDR equirectangular map as a cubemap in the background (from
+		// the cubemap cache after the first run); the skybox is built in
+		// OnEnvironmentLoaded() once the cubemap is on the GPU
+		m_EnvironmentLoad = VizEngine::CubemapUtils::LoadEquirectangularAsync(EnvironmentPath, CubemapResolution);
+	}
 
-		// Convert to cubemap (one-time operation)
-		int cubemapResolution = 512;  // 512x512 per face
-		m_SkyboxCubemap = VizEngine::CubemapUtils::EquirectangularToCubemap(
-			m_EnvironmentHDRI, 
-			cubemapResolution
-		);
+	void OnDuckLoaded(const std::shared_ptr<VizEngine::Model>& duckModel)
+	{
+		if (duckModel)
+		{
+			VP_INFO("Duck model loaded: {} meshes", duckModel->GetMeshCount());
+			m_DuckLoadStats = duckModel->GetLoadStats();
 
-		// Release original HDRI to free memory (~6MB for 2K texture)
-		// The cubemap now contains all the data we need
-		m_EnvironmentHDRI.reset();
+			// Store mesh and material properties for reuse (Add Duck button)
+			if (duckModel->GetMeshCount() > 0)
+			{
+				m_DuckMesh = duckModel->GetMeshes()[0];
+				const auto& material = duckModel->GetMaterialForMesh(0);
+				m_DuckColor = material.BaseColor;
+				m_DuckRoughness = material.Roughness;
+				if (material.BaseColorTexture)
+				{
+					m_DuckTexture = material.BaseColorTexture;
+				}
+			}
+
+			// Add initial duck to scene
+			for (size_t i = 0; i < duckModel->GetMeshCount(); i++)
+			{
+				auto& duckObj = m_Scene.Add(duckModel->GetMeshes()[i], "Duck");
+				duckObj.ObjectTransform.Position = glm::vec3(0.0f, 0.0f, 3.0f);
+				duckObj.ObjectTransform.Scale = glm::vec3(0.02f);
+
+				// Copy material properties from glTF
+				const auto& material = duckModel->GetMaterialForMesh(i);
+				duckObj.Color = material.BaseColor;
+				duckObj.Roughness = material.Roughness;
+				duckObj.TexturePtr = material.BaseColorTexture ? material.BaseColorTexture : m_DefaultTexture;
+			}
+		}
+		else
+		{
+			VP_ERROR("Failed to load Duck model!");
+		}
+	}
+
+	void OnQuantizedBoxLoaded(const std::shared_ptr<VizEngine::Model>& boxModel)
+	{
+		if (!boxModel)
+		{
+			VP_ERROR("Failed to load quantized box model!");
+			return;
+		}
+		m_QuantizedBoxLoadStats = boxModel->GetLoadStats();
+
+		// Mesh positions already include the glTF node transforms
+		for (size_t i = 0; i < boxModel->GetMeshCount(); i++)
+		{
+			auto& boxObj = m_Scene.Add(boxModel->GetMeshes()[i], "Quantized Box");
+			boxObj.ObjectTransform.Position = glm::vec3(-3.0f, -1.5f, 3.0f);
+
+			const auto& material = boxModel->GetMaterialForMesh(i);
+			boxObj.Color = material.BaseColor;
+			boxObj.Roughness = material.Roughness;
+			boxObj.TexturePtr = material.BaseColorTexture ? material.BaseColorTexture : m_DefaultTexture;
+		}
+	}
+
+	void OnEnvironmentLoaded(std::shared_ptr<VizEngine::Texture> skyboxCubemap)
+	{
+		if (!skyboxCubemap)
+		{
+			VP_ERROR("Failed to load environment HDRI, skybox disabled");
+			return;
+		}
+		m_SkyboxCubemap = std::move(skyboxCubemap);
+
+		// Diffuse image-based lighting: 9 SH coefficients replace the flat ambient
+		if (VizEngine::CubemapUtils::ProjectIrradiance(*m_SkyboxCubemap, m_Irradiance))
+		{
+			m_HasIrradiance = true;
+		}
+
+		// Specular image-based lighting: GGX-prefiltered mips + BRDF LUT
+		m_PrefilteredMap = VizEngine::CubemapUtils::PrefilterSpecular(*m_SkyboxCubemap, m_PrefilterOptions);
+		m_BrdfLut = VizEngine::CubemapUtils::GetBrdfLut();
+		UpdateEnvironmentLighting();
 
 		// Create skybox
 		m_Skybox = std::make_unique<VizEngine::Skybox>(m_SkyboxCubemap);
@@ -212,6 +293,32 @@ public:
 		VP_INFO("Skybox ready!");
 	}
 
+	void UpdateEnvironmentLighting()
+	{
+		float intensity = m_HasIrradiance && m_UseIrradiance ? m_IrradianceIntensity : 0.0f;
+		VizEngine::SHUniformBlock environment = VizEngine::SphericalHarmonics::ToUniformBlock(m_Irradiance, intensity);
+		if (m_PrefilteredMap && m_BrdfLut && m_UseReflections)
+		{
+			environment.Params.y = m_ReflectionIntensity;
+			environment.Params.z = static_cast<float>(VizEngine::CubemapUtils::GetPrefilterMipCount(m_PrefilterOptions) - 1);
+		}
+		m_EnvironmentUBO->SetData(&environment, sizeof(environment));
+
+		// Compile the unused terms out of lit.shader rather than weight them by 0
+		auto& renderer = VizEngine::Engine::Get().GetRenderer();
+		renderer.SetKeyword("ENV_DIFFUSE", intensity > 0.0f);
+		renderer.SetKeyword("ENV_SPECULAR", environment.Params.y > 0.0f);
+	}
+
+	void BindEnvironmentMaps()
+	{
+		if (m_PrefilteredMap && m_BrdfLut)
+		{
+			m_PrefilteredMap->Bind(5);
+			m_BrdfLut->Bind(6);
+		}
+	}
+
 	void OnUpdate(float deltaTime) override
 	{
 		// =========================================================================
@@ -225,6 +332,25 @@ public:
 			m_FpsUpdateTimer = 0.0f;
 		}
 
+		// =========================================================================
+		// Background Loads
+		// =========================================================================
+		if (m_DuckLoad.IsReady())
+		{
+			OnDuckLoaded(m_DuckLoad.Get());
+			m_DuckLoad = {};
+		}
+		if (m_QuantizedBoxLoad.IsReady())
+		{
+			OnQuantizedBoxLoaded(m_QuantizedBoxLoad.Get());
+			m_QuantizedBoxLoad = {};
+		}
+		if (m_EnvironmentLoad.IsReady())
+		{
+			OnEnvironmentLoaded(m_EnvironmentLoad.Get());
+			m_EnvironmentLoad = {};
+		}
+
 		// =========================================================================
 		// Camera Controller
 		// =========================================================================
@@ -270,6 +396,11 @@ public:
 
 	void OnRender() override
 	{
+		if (!m_LitShader)
+		{
+			return;  // OnCreate failed and asked the engine to quit
+		}
+
 		auto& engine = VizEngine::Engine::Get();
 		auto& renderer = engine.GetRenderer();
 
@@ -278,6 +409,14 @@ public:
 		// =========================================================================
 		m_LightSpaceMatrix = ComputeLightSpaceMatrix(m_Light);
 
+		// Light, shadow and camera state for every program (FrameData block),
+		// sent once; passes that don't change it send nothing
+		VizEngine::FrameUniforms& frame = renderer.GetFrameUniforms();
+		frame.SetLight(m_Light);
+		frame.LightSpaceMatrix = m_LightSpaceMatrix;
+		frame.SetCamera(m_Camera);
+		renderer.UploadFrameUniforms();
+
 		// =========================================================================
 		// Pass 1: Render scene from light's perspective to shadow map
 		// =========================================================================
@@ -290,22 +429,9 @@ public:
 			// Enable polygon offset to reduce shadow acne
 			renderer.EnablePolygonOffset(2.0f, 4.0f);
 
-			// Use shadow depth shader
-			m_ShadowDepthShader->Bind();
-			m_ShadowDepthShader->SetMatrix4fv("u_LightSpaceMatrix", m_LightSpaceMatrix);
-
-			// Render scene geometry (only need depth, no lighting)
-			// We need to set u_Model for each object since Scene::Render uses u_MVP
-			for (auto& obj : m_Scene)
-			{
-				if (!obj.Active || !obj.MeshPtr) continue;
-
-				glm::mat4 model = obj.ObjectTransform.GetModelMatrix();
-				m_ShadowDepthShader->SetMatrix4fv("u_Model", model);
-
-				obj.MeshPtr->Bind();
-				renderer.Draw(obj.MeshPtr->GetVertexArray(), obj.MeshPtr->GetIndexBuffer(), *m_ShadowDepthShader);
-			}
+			// Depth only, with the object blocks of the main pass (no uniforms per object);
+			// shadows tolerate more error than the visible surface: optionally go one LOD coarser
+			m_Scene.RenderDepth(renderer, *m_ShadowDepthShader, m_ShadowCoarserLod ? 1 : 0);
 
 			// Disable polygon offset
 			renderer.DisablePolygonOffset();
@@ -321,30 +447,18 @@ public:
 		// Clear screen
 		renderer.Clear(m_ClearColor);
 
-		// Set light uniforms
-		m_LitShader->Bind();
-		m_LitShader->SetVec3("u_LightDirection", m_Light.GetDirection());
-		m_LitShader->SetVec3("u_LightAmbient", m_Light.Ambient);
-		m_LitShader->SetVec3("u_LightDiffuse", m_Light.Diffuse);
-		m_LitShader->SetVec3("u_LightSpecular", m_Light.Specular);
-		m_LitShader->SetVec3("u_ViewPos", m_Camera.GetPosition());
-
-		// Set shadow mapping uniforms
-		m_LitShader->SetMatrix4fv("u_LightSpaceMatrix", m_LightSpaceMatrix);
-
-		// Bind shadow map to texture slot 1
+		// Bind shadow map to texture slot 1 (lit.shader's SHADOWS variant samples it)
 		if (m_ShadowMapDepth)
 		{
 			m_ShadowMapDepth->Bind(1);
-			m_LitShader->SetInt("u_ShadowMap", 1);
-		}
-		else
-		{
-			m_LitShader->SetInt("u_ShadowMap", 0);
 		}
+		renderer.SetKeyword("SHADOWS", m_ShadowMapDepth != nullptr);
+
+		BindEnvironmentMaps();
 
 		// Render scene with shadows
 		m_Scene.Render(renderer, *m_LitShader, m_Camera);
+		m_SceneUniformBytes = m_Scene.GetUniformUploadBytes();
 
 		// =========================================================================
 		// Render to Framebuffer (offscreen) - kept for F2 preview
@@ -358,14 +472,13 @@ public:
 			renderer.SetViewport(0, 0, m_Framebuffer->GetWidth(), m_Framebuffer->GetHeight());
 			renderer.Clear(m_ClearColor);
 
-			// Set shadow uniforms for offscreen render too
-			m_LitShader->Bind();
-			m_LitShader->SetMatrix4fv("u_LightSpaceMatrix", m_LightSpaceMatrix);
+			// Light and shadow state is already in the FrameData block; only
+			// the camera's aspect changes (Scene::Render uploads that)
 			if (m_ShadowMapDepth)
 			{
 				m_ShadowMapDepth->Bind(1);
-				m_LitShader->SetInt("u_ShadowMap", 1);
 			}
+			BindEnvironmentMaps();
 
 			m_Scene.Render(renderer, *m_LitShader, m_Camera);
 		
@@ -411,6 +524,80 @@ public:
 			uiManager.Separator();
 			uiManager.Text("Window: %d x %d", m_WindowWidth, m_WindowHeight);
 			uiManager.Separator();
+			uiManager.Text("Duck load: %.2f ms%s", m_DuckLoadStats.TotalMs, m_DuckLoadStats.FromCache ? " (cached)" : "");
+			uiManager.Text("  Parse: %.2f ms  Meshes: %.2f ms (%zu KB vertices, %zu KB indices)", m_DuckLoadStats.ParseMs,
+				m_DuckLoadStats.MeshMs, m_DuckLoadStats.VertexBytes / 1024, m_DuckLoadStats.IndexBytes / 1024);
+			if (m_DuckLoadStats.CacheAfter.Triangles > 0)
+			{
+				uiManager.Text("  ACMR %.3f -> %.3f  ATVR %.3f -> %.3f",
+					m_DuckLoadStats.CacheBefore.GetACMR(), m_DuckLoadStats.CacheAfter.GetACMR(),
+					m_DuckLoadStats.CacheBefore.GetATVR(), m_DuckLoadStats.CacheAfter.GetATVR());
+			}
+			if (m_DuckLoadStats.LodLevels > 0)
+			{
+				uiManager.Text("  LODs: %zu levels in %.2f ms", m_DuckLoadStats.LodLevels, m_DuckLoadStats.LodMs);
+			}
+			if (m_DuckLoadStats.MeshoptViews > 0 || m_DuckLoadStats.QuantizedMeshes > 0)
+			{
+				uiManager.Text("  Meshopt: %zu views (%zu KB) in %.2f ms, %zu quantized meshes", m_DuckLoadStats.MeshoptViews,
+					m_DuckLoadStats.MeshoptBytes / 1024, m_DuckLoadStats.MeshoptMs, m_DuckLoadStats.QuantizedMeshes);
+			}
+			uiManager.Text("  Textures: %zu, decode %.2f ms, wait %.2f ms, upload %.2f ms",
+				m_DuckLoadStats.TexturesLoaded, m_DuckLoadStats.DecodeWorkerMs,
+				m_DuckLoadStats.DecodeWaitMs, m_DuckLoadStats.UploadMs);
+			if (m_DuckLoadStats.TexturesCompressed > 0 || m_DuckLoadStats.TextureCacheHits > 0)
+			{
+				uiManager.Text("  Compressed: %zu textures, %zu from texture cache",
+					m_DuckLoadStats.TexturesCompressed, m_DuckLoadStats.TextureCacheHits);
+			}
+			if (m_DuckLoadStats.TexturesShared > 0 || m_DuckLoadStats.MeshesShared > 0)
+			{
+				uiManager.Text("  Shared: %zu textures, %zu meshes", m_DuckLoadStats.TexturesShared, m_DuckLoadStats.MeshesShared);
+			}
+			uiManager.Text("Quantized box load: %.2f ms%s, %zu quantized meshes (%zu KB vertices)",
+				m_QuantizedBoxLoadStats.TotalMs, m_QuantizedBoxLoadStats.FromCache ? " (cached)" : "",
+				m_QuantizedBoxLoadStats.QuantizedMeshes, m_QuantizedBoxLoadStats.VertexBytes / 1024);
+			uiManager.Text("  Meshopt: %zu views (%zu KB) in %.2f ms", m_QuantizedBoxLoadStats.MeshoptViews,
+				m_QuantizedBoxLoadStats.MeshoptBytes / 1024, m_QuantizedBoxLoadStats.MeshoptMs);
+			VizEngine::TextureStreamingStats streamStats = VizEngine::TextureStreamer::Get().GetStats();
+			if (streamStats.Textures > 0)
+			{
+				uiManager.Text("Streaming: %zu textures, %.2f / %.2f MB resident, %zu loads, %zu evictions",
+					streamStats.Textures, streamStats.ResidentBytes / (1024.0 * 1024.0), streamStats.FullBytes / (1024.0 * 1024.0),
+					streamStats.Loads, streamStats.Evictions);
+			}
+			VizEngine::AssetManagerStats assetStats = VizEngine::AssetManager::Get().GetStats();
+			uiManager.Text("Assets: %zu textures, %zu meshes, %zu shaders, %zu models",
+				assetStats.Textures, assetStats.Meshes, assetStats.Shaders, assetStats.Models);
+			uiManager.Text("  Hits: %zu by path, %zu by content, %zu misses",
+				assetStats.PathHits, assetStats.ContentHits, assetStats.Misses);
+			if (uiManager.Button("Benchmark Uniforms"))
+			{
+				RunUniformBenchmark();
+			}
+			uiManager.Text("Uniform blocks: %zu bytes of object data this frame, %zu FrameData uploads in total",
+				m_SceneUniformBytes, VizEngine::Engine::Get().GetRenderer().GetFrameUploadCount());
+			if (m_LitShader)
+			{
+				uiManager.Text("lit.shader variants: %zu", m_LitShader->GetVariantCount());
+			}
+			if (m_UniformBenchmarkStringNs > 0.0)
+			{
+				uiManager.Text("  Uniform lookups per draw: %.0f ns (std::string keys) -> %.0f ns (UniformID)",
+					m_UniformBenchmarkStringNs, m_UniformBenchmarkIdNs);
+			}
+			if (uiManager.Button("Compare Cubemap Conversion"))
+			{
+				RunCubemapComparison();
+			}
+			if (m_CubemapComparison.CpuMs > 0.0)
+			{
+				uiManager.Text("  Equirect -> cubemap: CPU %.1f ms, GPU %.1f ms (+%.1f ms readback)",
+					m_CubemapComparison.CpuMs, m_CubemapComparison.GpuMs, m_CubemapComparison.ReadbackMs);
+				uiManager.Text("  CPU vs GPU: mean |diff| %.4f, %.2f%% of channels within 1%%",
+					m_CubemapComparison.MeanAbsDiff, m_CubemapComparison.WithinPercent);
+			}
+			uiManager.Separator();
 			uiManager.Text("Press F1 to toggle");
 
 			uiManager.EndWindow();
@@ -482,6 +669,27 @@ public:
 			}
 
 			uiManager.Checkbox("Show Shadow Map", &m_ShowShadowMap);
+			uiManager.Checkbox("Coarser shadow LODs", &m_ShadowCoarserLod);
+
+			uiManager.Separator();
+			VizEngine::LodSettings lodSettings = m_Scene.GetLodSettings();
+			bool lodChanged = uiManager.Checkbox("Mesh LODs", &lodSettings.Enabled);
+			lodChanged |= uiManager.SliderFloat("LOD Error (px)", &lodSettings.ErrorPixels, 0.25f, 16.0f);
+			if (lodChanged)
+			{
+				m_Scene.SetLodSettings(lodSettings);
+			}
+
+			VizEngine::ClusterCullingSettings cullingSettings = m_Scene.GetClusterCullingSettings();
+			bool cullingChanged = uiManager.Checkbox("Meshlet culling", &cullingSettings.Enabled);
+			cullingChanged |= uiManager.Checkbox("Meshlet backface cones", &cullingSettings.Backface);
+			if (cullingChanged)
+			{
+				m_Scene.SetClusterCullingSettings(cullingSettings);
+			}
+			const VizEngine::ClusterCullingStats& cullingStats = m_Scene.GetClusterCullingStats();
+			uiManager.Text("Meshlets: %zu / %zu visible in %zu draw ranges",
+				cullingStats.Visible, cullingStats.Meshlets, cullingStats.DrawRanges);
 
 			uiManager.EndWindow();
 		}
@@ -512,6 +720,11 @@ public:
 
 			uiManager.Text("Selected: %s", obj.Name.c_str());
 			uiManager.Checkbox("Active", &obj.Active);
+			if (obj.MeshPtr && obj.MeshPtr->GetLodCount() > 1)
+			{
+				const VizEngine::MeshLod& lod = obj.MeshPtr->GetLod(obj.LodLevel);
+				uiManager.Text("LOD %zu / %zu (%u triangles)", obj.LodLevel, obj.MeshPtr->GetLodCount() - 1, lod.IndexCount / 3);
+			}
 
 			uiManager.Separator();
 			uiManager.Text("Transform");
@@ -583,6 +796,30 @@ public:
 		uiManager.ColorEdit3("Diffuse", &m_Light.Diffuse.x);
 		uiManager.ColorEdit3("Specular", &m_Light.Specular.x);
 
+		if (m_HasIrradiance)
+		{
+			uiManager.Separator();
+			uiManager.Text("Environment (SH irradiance)");
+			bool changed = uiManager.Checkbox("Sky Ambient", &m_UseIrradiance);
+			changed |= uiManager.SliderFloat("Sky Intensity", &m_IrradianceIntensity, 0.0f, 2.0f);
+			if (changed)
+			{
+				UpdateEnvironmentLighting();
+			}
+		}
+
+		if (m_PrefilteredMap && m_BrdfLut)
+		{
+			uiManager.Separator();
+			uiManager.Text("Environment (GGX reflections)");
+			bool changed = uiManager.Checkbox("Sky Reflections", &m_UseReflections);
+			changed |= uiManager.SliderFloat("Reflection Intensity", &m_ReflectionIntensity, 0.0f, 2.0f);
+			if (changed)
+			{
+				UpdateEnvironmentLighting();
+			}
+		}
+
 		uiManager.EndWindow();
 
 		// =========================================================================
@@ -688,6 +925,127 @@ public:
 	}
 
 private:
+	// =========================================================================
+	// Helper: CPU cost of uniform lookups by name
+	// =========================================================================
+	void RunUniformBenchmark()
+	{
+		// Location lookups for the uniforms every draw used to set (u_MVP,
+		// u_Model, u_ObjectColor, u_Color, u_Roughness). The glUniform calls
+		// cost the same either way, so only the lookups are timed.
+		if (!m_LitShader)
+		{
+			return;
+		}
+		constexpr int Draws = 20000;
+		VizEngine::Shader& shader = m_LitShader->GetVariant(m_LitShader->GetSupportedKeywords());
+		volatile int sink = 0;
+
+		// Both caches start warm: the string map is filled below, the shader's here
+		for (VizEngine::UniformID id : { VizEngine::UniformID("u_MVP"), VizEngine::UniformID("u_Model"),
+			VizEngine::UniformID("u_ObjectColor"), VizEngine::UniformID("u_Color"), VizEngine::UniformID("u_Roughness") })
+		{
+			shader.HasUniform(id);
+		}
+
+		// Before: the old Shader::GetUniformLocation(const std::string&), a
+		// string built from the literal per call and a std::unordered_map<std::string, int>
+		std::unordered_map<std::string, int> stringCache = {
+			{ "u_MVP", 0 }, { "u_Model", 1 }, { "u_ObjectColor", 2 }, { "u_Color", 3 }, { "u_Roughness", 4 } };
+		auto stringLocation = [&stringCache](const std::string& name)
+		{
+			if (stringCache.find(name) != stringCache.end())
+				return stringCache[name];
+			return -1;
+		};
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < Draws; i++)
+		{
+			sink = sink + stringLocation("u_MVP");
+			sink = sink + stringLocation("u_Model");
+			sink = sink + stringLocation("u_ObjectColor");
+			sink = sink + stringLocation("u_Color");
+			sink = sink + stringLocation("u_Roughness");
+		}
+		auto middle = std::chrono::steady_clock::now();
+
+		// After: the shader's own cache, keyed by literals hashed at compile time
+		for (int i = 0; i < Draws; i++)
+		{
+			sink = sink + shader.HasUniform("u_MVP");
+			sink = sink + shader.HasUniform("u_Model");
+			sink = sink + shader.HasUniform("u_ObjectColor");
+			sink = sink + shader.HasUniform("u_Color");
+			sink = sink + shader.HasUniform("u_Roughness");
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		m_UniformBenchmarkStringNs = std::chrono::duration<double, std::nano>(middle - start).count() / Draws;
+		m_UniformBenchmarkIdNs = std::chrono::duration<double, std::nano>(end - middle).count() / Draws;
+		VP_INFO("Uniform lookups per draw: {:.0f} ns with std::string keys, {:.0f} ns with UniformID",
+			m_UniformBenchmarkStringNs, m_UniformBenchmarkIdNs);
+	}
+
+	void RunCubemapComparison()
+	{
+		// Same source image, resolution and half-float output for both paths
+		VizEngine::TextureData equirect;
+		if (!VizEngine::HdrImage::Load(EnvironmentPath, VizEngine::HdrFormat::Half, equirect))
+		{
+			VP_ERROR("Cubemap comparison: failed to load {}", EnvironmentPath);
+			return;
+		}
+		auto source = std::make_shared<VizEngine::Texture>(equirect, true);
+
+		auto start = std::chrono::steady_clock::now();
+		VizEngine::TextureData cpuFaces;
+		bool cpuConverted = VizEngine::CubemapUtils::EquirectangularToCubemapCPU(equirect, CubemapResolution, cpuFaces);
+		auto cpuEnd = std::chrono::steady_clock::now();
+
+		// GL calls return before the GPU is done; the readback waits for it.
+		// A second readback of the finished cubemap measures the copy alone.
+		std::shared_ptr<VizEngine::Texture> gpuCubemap = VizEngine::CubemapUtils::EquirectangularToCubemap(source, CubemapResolution);
+		VizEngine::TextureData gpuFaces;
+		bool gpuConverted = gpuCubemap && VizEngine::CubemapUtils::ReadFaces(*gpuCubemap, gpuFaces);
+		auto gpuEnd = std::chrono::steady_clock::now();
+		gpuConverted = gpuConverted && VizEngine::CubemapUtils::ReadFaces(*gpuCubemap, gpuFaces);
+		auto readbackEnd = std::chrono::steady_clock::now();
+
+		if (!cpuConverted || !gpuConverted || cpuFaces.Levels[0].Size != gpuFaces.Levels[0].Size)
+		{
+			VP_ERROR("Cubemap comparison: conversion failed");
+			return;
+		}
+
+		// Level 0 of both, as RGB half floats in the same face order
+		size_t count = cpuFaces.Levels[0].Size / sizeof(uint16_t);
+		const uint16_t* cpu = reinterpret_cast<const uint16_t*>(cpuFaces.GetLevelData(0));
+		const uint16_t* gpu = reinterpret_cast<const uint16_t*>(gpuFaces.GetLevelData(0));
+		double totalDiff = 0.0;
+		size_t within = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			float a = VizEngine::Half::ToFloat(cpu[i]);
+			float b = VizEngine::Half::ToFloat(gpu[i]);
+			float diff = std::abs(a - b);
+			totalDiff += diff;
+			if (diff <= 0.01f * std::max(std::abs(a), std::abs(b)) + 1e-3f)
+			{
+				within++;
+			}
+		}
+
+		m_CubemapComparison.CpuMs = std::chrono::duration<double, std::milli>(cpuEnd - start).count();
+		m_CubemapComparison.ReadbackMs = std::chrono::duration<double, std::milli>(readbackEnd - gpuEnd).count();
+		m_CubemapComparison.GpuMs = std::max(0.0,
+			std::chrono::duration<double, std::milli>(gpuEnd - cpuEnd).count() - m_CubemapComparison.ReadbackMs);
+		m_CubemapComparison.MeanAbsDiff = totalDiff / static_cast<double>(count);
+		m_CubemapComparison.WithinPercent = 100.0 * static_cast<double>(within) / static_cast<double>(count);
+		VP_INFO("Equirect -> {}x{} cubemap: CPU {:.1f} ms, GPU {:.1f} ms; mean |diff| {:.4f}, {:.2f}% of channels within 1%",
+			CubemapResolution, CubemapResolution, m_CubemapComparison.CpuMs, m_CubemapComparison.GpuMs,
+			m_CubemapComparison.MeanAbsDiff, m_CubemapComparison.WithinPercent);
+	}
+
 	// =========================================================================
 	// Helper: Compute Light-Space Matrix for Shadow Mapping
 	// =========================================================================
@@ -732,8 +1090,8 @@ private:
 	VizEngine::DirectionalLight m_Light;
 
 	// Assets
-	std::unique_ptr<VizEngine::Shader> m_LitShader;
-	std::unique_ptr<VizEngine::Shader> m_ShadowDepthShader;
+	std::shared_ptr<VizEngine::Shader> m_LitShader;
+	std::shared_ptr<VizEngine::Shader> m_ShadowDepthShader;
 	std::shared_ptr<VizEngine::Texture> m_DefaultTexture;
 	std::shared_ptr<VizEngine::Mesh> m_PyramidMesh;
 	std::shared_ptr<VizEngine::Mesh> m_CubeMesh;
@@ -744,6 +1102,12 @@ private:
 	std::shared_ptr<VizEngine::Texture> m_DuckTexture;
 	glm::vec4 m_DuckColor = glm::vec4(1.0f);
 	float m_DuckRoughness = 0.5f;
+	VizEngine::ModelLoadStats m_DuckLoadStats;
+	VizEngine::AsyncHandle<VizEngine::Model> m_DuckLoad;
+
+	// Quantized / meshopt-compressed model (covers the direct packed path)
+	VizEngine::ModelLoadStats m_QuantizedBoxLoadStats;
+	VizEngine::AsyncHandle<VizEngine::Model> m_QuantizedBoxLoad;
 
 	// Framebuffer for offscreen rendering
 	std::shared_ptr<VizEngine::Framebuffer> m_Framebuffer;
@@ -756,6 +1120,26 @@ private:
 	std::shared_ptr<VizEngine::Texture> m_ShadowMapDepth;
 	glm::mat4 m_LightSpaceMatrix;
 	bool m_ShowShadowMap = false;
+	bool m_ShadowCoarserLod = true;
+
+	// Uniform benchmark results (ns per draw)
+	double m_UniformBenchmarkStringNs = 0.0;
+	double m_UniformBenchmarkIdNs = 0.0;
+	size_t m_SceneUniformBytes = 0;  // Object / material block bytes uploaded by the main pass
+
+	// Environment map, converted to 512x512 cubemap faces
+	static constexpr const char* EnvironmentPath = "resources/textures/environments/qwantani_dusk_2_puresky_2k.hdr";
+	static constexpr int CubemapResolution = 512;
+
+	// CPU vs GPU equirectangular conversion (see RunCubemapComparison)
+	struct CubemapComparison
+	{
+		double CpuMs = 0.0;
+		double GpuMs = 0.0;          // Conversion and mips, without the readback
+		double ReadbackMs = 0.0;
+		double MeanAbsDiff = 0.0;    // Level 0, linear radiance per channel
+		double WithinPercent = 0.0;  // Channels within 1% (or 1e-3) of each other
+	} m_CubemapComparison;
 
 	// Runtime state
 	float m_ClearColor[4] = { 0.1f, 0.1f, 0.15f, 1.0f };
@@ -777,10 +1161,24 @@ private:
 	int m_WindowHeight = 800;
 
 	// Skybox
-	std::shared_ptr<VizEngine::Texture> m_EnvironmentHDRI;
+	VizEngine::AsyncHandle<VizEngine::Texture> m_EnvironmentLoad;
 	std::shared_ptr<VizEngine::Texture> m_SkyboxCubemap;
 	std::unique_ptr<VizEngine::Skybox> m_Skybox;
 	bool m_ShowSkybox = true;
+
+	// Environment lighting (SH irradiance of the skybox)
+	std::unique_ptr<VizEngine::UniformBuffer> m_EnvironmentUBO;
+	VizEngine::SH9 m_Irradiance;
+	bool m_HasIrradiance = false;
+	bool m_UseIrradiance = true;
+	float m_IrradianceIntensity = 1.0f;
+
+	// Specular image-based lighting
+	VizEngine::SpecularPrefilterOptions m_PrefilterOptions;
+	std::shared_ptr<VizEngine::Texture> m_PrefilteredMap;
+	std::shared_ptr<VizEngine::Texture> m_BrdfLut;
+	bool m_UseReflections = true;
+	float m_ReflectionIntensity = 1.0f;
 };
 
 std::unique_ptr<VizEngine::Application> VizEngine::CreateApplication(VizEngine::EngineConfig& config)
@@ -788,5 +1186,15 @@ std::unique_ptr<VizEngine::Application> VizEngine::CreateApplication(VizEngine::
 	config.Title = "Sandbox - VizPsyche";
 	config.Width = 800;
 	config.Height = 800;
+
+	// Compiled in parallel while the scene and environment load
+	config.WarmupShaders = {
+		"resources/shaders/lit.shader",
+		"resources/shaders/shadow_depth.shader",
+		"resources/shaders/skybox.shader",
+		"resources/shaders/equirect_to_cube.shader",
+		"resources/shaders/prefilter_specular.shader",
+		"resources/shaders/brdf_lut.shader"
+	};
 	return std::make_unique<Sandbox>();
 }
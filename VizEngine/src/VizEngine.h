@@ -15,10 +15,13 @@
 #include "VizEngine/GUI/UIManager.h"
 #include "VizEngine/OpenGL/Renderer.h"
 #include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/ShaderCache.h"
 #include "VizEngine/OpenGL/Texture.h"
 #include "VizEngine/OpenGL/Framebuffer.h"
+#include "VizEngine/OpenGL/UniformBuffer.h"
 #include "VizEngine/OpenGL/CubemapUtils.h"
 #include "VizEngine/Renderer/Skybox.h"
+#include "VizEngine/Renderer/UniformBlocks.h"
 
 // Core types
 #include "VizEngine/Core/Camera.h"
@@ -26,11 +29,15 @@
 #include "VizEngine/Core/Scene.h"
 #include "VizEngine/Core/Mesh.h"
 #include "VizEngine/Core/Light.h"
+#include "VizEngine/Core/SphericalHarmonics.h"
 #include "VizEngine/Core/Input.h"
 
 // Asset loading
+#include "VizEngine/Core/AssetManager.h"
+#include "VizEngine/Core/AsyncHandle.h"
 #include "VizEngine/Core/Model.h"
 #include "VizEngine/Core/Material.h"
+#include "VizEngine/Core/TextureStreamer.h"
 
 // Events (for event-driven applications)
 #include "VizEngine/Events/Event.h"
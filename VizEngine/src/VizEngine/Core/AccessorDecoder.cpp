@@ -0,0 +1,298 @@
+#include "AccessorDecoder.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace VizEngine
+{
+	namespace
+	{
+		constexpr bool IsSigned(AccessorComponent component)
+		{
+			return component == AccessorComponent::Byte || component == AccessorComponent::Short;
+		}
+
+		// glTF normalization: unsigned c / max, signed max(c / max, -1)
+		constexpr float NormalizationScale(AccessorComponent component)
+		{
+			switch (component)
+			{
+				case AccessorComponent::Byte:          return 1.0f / 127.0f;
+				case AccessorComponent::UnsignedByte:  return 1.0f / 255.0f;
+				case AccessorComponent::Short:         return 1.0f / 32767.0f;
+				case AccessorComponent::UnsignedShort: return 1.0f / 65535.0f;
+				default:                               return 1.0f;
+			}
+		}
+
+		/**
+		 * Per-element conversion for one source component type.
+		 * Loads up to 4 components, converts them to float, applies
+		 * normalization and fills missing lanes from the defaults.
+		 */
+		template<AccessorComponent Type>
+		struct ElementConverter
+		{
+			int Components;
+			int DstComponents;
+			float Scale;
+			bool ClampNegative;
+
+#if VP_SIMD_SSE2
+			__m128 Defaults;
+			__m128 LaneMask;  // All bits set for lanes the source provides
+
+			ElementConverter(int components, int dstComponents, bool normalized, const float defaults[4])
+				: Components(components), DstComponents(dstComponents),
+				  Scale(normalized ? NormalizationScale(Type) : 1.0f),
+				  ClampNegative(normalized && IsSigned(Type))
+			{
+				Defaults = _mm_loadu_ps(defaults);
+				LaneMask = _mm_castsi128_ps(_mm_set_epi32(
+					components > 3 ? -1 : 0, components > 2 ? -1 : 0,
+					components > 1 ? -1 : 0, -1));
+			}
+
+			__m128 Load(const uint8_t* src) const
+			{
+				const __m128i zero = _mm_setzero_si128();
+
+				if constexpr (Type == AccessorComponent::Float)
+				{
+					float values[4] = {};
+					std::memcpy(values, src, Components * sizeof(float));
+					return _mm_loadu_ps(values);
+				}
+				else if constexpr (Type == AccessorComponent::UnsignedByte || Type == AccessorComponent::Byte)
+				{
+					uint32_t packed = 0;
+					std::memcpy(&packed, src, Components);
+					__m128i v = _mm_cvtsi32_si128(static_cast<int>(packed));
+					if constexpr (Type == AccessorComponent::Byte)
+					{
+						// Sign-extend by moving each byte to the top and shifting back
+						v = _mm_unpacklo_epi8(v, v);
+						v = _mm_unpacklo_epi16(v, v);
+						v = _mm_srai_epi32(v, 24);
+					}
+					else
+					{
+						v = _mm_unpacklo_epi8(v, zero);
+						v = _mm_unpacklo_epi16(v, zero);
+					}
+					return _mm_cvtepi32_ps(v);
+				}
+				else if constexpr (Type == AccessorComponent::UnsignedShort || Type == AccessorComponent::Short)
+				{
+					uint64_t packed = 0;
+					std::memcpy(&packed, src, Components * sizeof(uint16_t));
+					__m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&packed));
+					if constexpr (Type == AccessorComponent::Short)
+					{
+						v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+					}
+					else
+					{
+						v = _mm_unpacklo_epi16(v, zero);
+					}
+					return _mm_cvtepi32_ps(v);
+				}
+				else
+				{
+					// UnsignedInt: cvtepi32 is signed, so convert per lane
+					uint32_t values[4] = {};
+					std::memcpy(values, src, Components * sizeof(uint32_t));
+					return _mm_setr_ps(static_cast<float>(values[0]), static_cast<float>(values[1]),
+						static_cast<float>(values[2]), static_cast<float>(values[3]));
+				}
+			}
+
+			void Convert(const uint8_t* src, float* dst) const
+			{
+				__m128 v = Load(src);
+				if constexpr (Type != AccessorComponent::Float)
+				{
+					v = _mm_mul_ps(v, _mm_set1_ps(Scale));
+					if (ClampNegative)
+					{
+						v = _mm_max_ps(v, _mm_set1_ps(-1.0f));
+					}
+				}
+				v = _mm_or_ps(_mm_and_ps(LaneMask, v), _mm_andnot_ps(LaneMask, Defaults));
+				Store(dst, v);
+			}
+
+			void Store(float* dst, __m128 v) const
+			{
+				switch (DstComponents)
+				{
+					case 1: _mm_store_ss(dst, v); break;
+					case 2: _mm_storel_pi(reinterpret_cast<__m64*>(dst), v); break;
+					case 3:
+						_mm_storel_pi(reinterpret_cast<__m64*>(dst), v);
+						_mm_store_ss(dst + 2, _mm_movehl_ps(v, v));
+						break;
+					default: _mm_storeu_ps(dst, v); break;
+				}
+			}
+#else
+			float Defaults[4];
+
+			ElementConverter(int components, int dstComponents, bool normalized, const float defaults[4])
+				: Components(components), DstComponents(dstComponents),
+				  Scale(normalized ? NormalizationScale(Type) : 1.0f),
+				  ClampNegative(normalized && IsSigned(Type))
+			{
+				std::copy(defaults, defaults + 4, Defaults);
+			}
+
+			void Convert(const uint8_t* src, float* dst) const
+			{
+				float values[4] = { Defaults[0], Defaults[1], Defaults[2], Defaults[3] };
+				for (int c = 0; c < Components; c++)
+				{
+					float value;
+					if constexpr (Type == AccessorComponent::Float)
+					{
+						std::memcpy(&value, src + c * sizeof(float), sizeof(float));
+					}
+					else if constexpr (Type == AccessorComponent::UnsignedByte) { value = src[c]; }
+					else if constexpr (Type == AccessorComponent::Byte) { value = static_cast<int8_t>(src[c]); }
+					else if constexpr (Type == AccessorComponent::UnsignedShort)
+					{
+						uint16_t raw; std::memcpy(&raw, src + c * 2, 2); value = raw;
+					}
+					else if constexpr (Type == AccessorComponent::Short)
+					{
+						int16_t raw; std::memcpy(&raw, src + c * 2, 2); value = raw;
+					}
+					else
+					{
+						uint32_t raw; std::memcpy(&raw, src + c * 4, 4); value = static_cast<float>(raw);
+					}
+
+					if constexpr (Type != AccessorComponent::Float)
+					{
+						value *= Scale;
+						if (ClampNegative)
+						{
+							value = std::max(value, -1.0f);
+						}
+					}
+					values[c] = value;
+				}
+				std::memcpy(dst, values, DstComponents * sizeof(float));
+			}
+#endif
+		};
+
+		size_t ReadSparseIndex(const uint8_t* indices, AccessorComponent type, size_t i)
+		{
+			switch (type)
+			{
+				case AccessorComponent::UnsignedByte:
+					return indices[i];
+				case AccessorComponent::UnsignedShort:
+				{
+					uint16_t index;
+					std::memcpy(&index, indices + i * sizeof(uint16_t), sizeof(uint16_t));
+					return index;
+				}
+				default:
+				{
+					uint32_t index;
+					std::memcpy(&index, indices + i * sizeof(uint32_t), sizeof(uint32_t));
+					return index;
+				}
+			}
+		}
+
+		template<AccessorComponent Type>
+		void DecodeAll(const AccessorView& view, uint8_t* dst, size_t dstStride,
+			int dstComponents, const float defaults[4])
+		{
+			ElementConverter<Type> converter(view.Components, dstComponents, view.Normalized, defaults);
+
+			if (view.Data)
+			{
+				const uint8_t* src = view.Data;
+				for (size_t i = 0; i < view.Count; i++)
+				{
+					converter.Convert(src, reinterpret_cast<float*>(dst));
+					src += view.Stride;
+					dst += dstStride;
+				}
+				dst -= view.Count * dstStride;
+			}
+			else
+			{
+				// No bufferView: elements are zero (then patched by sparse values)
+				float zero[4] = {
+					view.Components > 0 ? 0.0f : defaults[0], view.Components > 1 ? 0.0f : defaults[1],
+					view.Components > 2 ? 0.0f : defaults[2], view.Components > 3 ? 0.0f : defaults[3] };
+				AccessorDecoder::Fill(dst, dstStride, view.Count, dstComponents, zero);
+			}
+
+			if (view.SparseCount > 0 && view.SparseIndices && view.SparseValues)
+			{
+				size_t elementSize = AccessorDecoder::ComponentSize(Type) * view.Components;
+				for (size_t i = 0; i < view.SparseCount; i++)
+				{
+					size_t index = ReadSparseIndex(view.SparseIndices, view.SparseIndexComponent, i);
+					if (index < view.Count)
+					{
+						converter.Convert(view.SparseValues + i * elementSize,
+							reinterpret_cast<float*>(dst + index * dstStride));
+					}
+				}
+			}
+		}
+	}
+
+	size_t AccessorDecoder::ComponentSize(AccessorComponent component)
+	{
+		switch (component)
+		{
+			case AccessorComponent::Byte:
+			case AccessorComponent::UnsignedByte:  return 1;
+			case AccessorComponent::Short:
+			case AccessorComponent::UnsignedShort: return 2;
+			case AccessorComponent::UnsignedInt:
+			case AccessorComponent::Float:         return 4;
+		}
+		return 0;
+	}
+
+	bool AccessorDecoder::DecodeFloat(const AccessorView& view, void* dst, size_t dstStride,
+		int dstComponents, const float defaults[4])
+	{
+		if (view.Components < 1 || view.Components > 4 || dstComponents < 1 || dstComponents > 4)
+		{
+			return false;
+		}
+
+		uint8_t* out = static_cast<uint8_t*>(dst);
+		switch (view.Component)
+		{
+			case AccessorComponent::Float:         DecodeAll<AccessorComponent::Float>(view, out, dstStride, dstComponents, defaults); return true;
+			case AccessorComponent::UnsignedByte:  DecodeAll<AccessorComponent::UnsignedByte>(view, out, dstStride, dstComponents, defaults); return true;
+			case AccessorComponent::Byte:          DecodeAll<AccessorComponent::Byte>(view, out, dstStride, dstComponents, defaults); return true;
+			case AccessorComponent::UnsignedShort: DecodeAll<AccessorComponent::UnsignedShort>(view, out, dstStride, dstComponents, defaults); return true;
+			case AccessorComponent::Short:         DecodeAll<AccessorComponent::Short>(view, out, dstStride, dstComponents, defaults); return true;
+			case AccessorComponent::UnsignedInt:   DecodeAll<AccessorComponent::UnsignedInt>(view, out, dstStride, dstComponents, defaults); return true;
+		}
+		return false;
+	}
+
+	void AccessorDecoder::Fill(void* dst, size_t dstStride, size_t count, int components, const float value[4])
+	{
+		uint8_t* out = static_cast<uint8_t*>(dst);
+		size_t bytes = static_cast<size_t>(components) * sizeof(float);
+		for (size_t i = 0; i < count; i++)
+		{
+			std::memcpy(out, value, bytes);
+			out += dstStride;
+		}
+	}
+}
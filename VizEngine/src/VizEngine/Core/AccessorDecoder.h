@@ -0,0 +1,73 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace VizEngine
+{
+	/**
+	 * Component types of a glTF accessor (values match the glTF spec).
+	 */
+	enum class AccessorComponent : int
+	{
+		Byte          = 5120,
+		UnsignedByte  = 5121,
+		Short         = 5122,
+		UnsignedShort = 5123,
+		UnsignedInt   = 5125,
+		Float         = 5126
+	};
+
+	/**
+	 * Bounds-checked description of an accessor's memory, independent of the
+	 * glTF library. Data == nullptr means the accessor has no bufferView
+	 * (all elements are zero before sparse substitution).
+	 */
+	struct AccessorView
+	{
+		const uint8_t* Data = nullptr;
+		size_t Count = 0;
+		size_t Stride = 0;           // Bytes between elements (never 0)
+		AccessorComponent Component = AccessorComponent::Float;
+		int Components = 1;          // 1..4
+		bool Normalized = false;
+
+		// Sparse substitution: element SparseIndices[i] takes SparseValues[i]
+		size_t SparseCount = 0;
+		const uint8_t* SparseIndices = nullptr;
+		AccessorComponent SparseIndexComponent = AccessorComponent::UnsignedInt;
+		const uint8_t* SparseValues = nullptr;  // Tightly packed elements
+	};
+
+	/**
+	 * Converts accessor data into float attributes of an interleaved vertex
+	 * stream (e.g. the Normal member of a Vertex array).
+	 *
+	 * Handles any byteStride, float and (normalized) integer components and
+	 * sparse accessors. Each element is converted with one SIMD operation
+	 * (all components at once) where SSE2 is available.
+	 */
+	class VizEngine_API AccessorDecoder
+	{
+	public:
+		/**
+		 * Size of one component in bytes (0 for unknown types).
+		 */
+		static size_t ComponentSize(AccessorComponent component);
+
+		/**
+		 * Decode view.Count elements to `dst`, advancing dstStride bytes per
+		 * element and writing dstComponents floats each. Components the source
+		 * does not have are taken from `defaults` (e.g. alpha = 1 for RGB colors).
+		 * @return false if the component type cannot be converted to float
+		 */
+		static bool DecodeFloat(const AccessorView& view, void* dst, size_t dstStride,
+			int dstComponents, const float defaults[4]);
+
+		/**
+		 * Write `count` copies of the first `components` values of `value`.
+		 */
+		static void Fill(void* dst, size_t dstStride, size_t count, int components, const float value[4]);
+	};
+}
@@ -0,0 +1,422 @@
+#include "AssetManager.h"
+#include "VizEngine/Core/Hash.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "VizEngine/Log.h"
+
+#include <filesystem>
+#include <future>
+
+namespace VizEngine
+{
+	static std::string NormalizePath(const std::string& path)
+	{
+		std::error_code ec;
+		std::filesystem::path absolute = std::filesystem::weakly_canonical(path, ec);
+		return ec ? path : absolute.generic_string();
+	}
+
+	// Path table key: one file can be loaded several ways (LDR/HDR, import options)
+	static std::string MakeKey(const std::string& normalizedPath, uint64_t variant)
+	{
+		return normalizedPath + '|' + std::to_string(variant);
+	}
+
+	AssetManager& AssetManager::Get()
+	{
+		static AssetManager instance;
+		return instance;
+	}
+
+	bool AssetManager::HashFile(const std::string& path, uint64_t& outHash)
+	{
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			return false;
+		}
+		outHash = Hash::Bytes(file.GetData(), file.GetSize());
+		return true;
+	}
+
+	//==========================================================================
+	// Table helpers (callers hold m_Mutex)
+	//==========================================================================
+	template<typename T>
+	std::shared_ptr<T> AssetManager::FindByPath(Table<T>& table, const std::string& key)
+	{
+		auto it = table.ByPath.find(key);
+		if (it == table.ByPath.end())
+		{
+			return nullptr;
+		}
+		std::shared_ptr<T> asset = it->second.Asset.lock();
+		if (!asset)
+		{
+			table.ByPath.erase(it);
+		}
+		return asset;
+	}
+
+	template<typename T>
+	std::shared_ptr<T> AssetManager::FindByContent(Table<T>& table, uint64_t contentKey)
+	{
+		auto it = table.ByContent.find(contentKey);
+		if (it == table.ByContent.end())
+		{
+			return nullptr;
+		}
+		std::shared_ptr<T> asset = it->second.lock();
+		if (!asset)
+		{
+			table.ByContent.erase(it);
+		}
+		return asset;
+	}
+
+	template<typename T>
+	std::shared_ptr<T> AssetManager::Insert(Table<T>& table, const std::string& key, const std::string& path,
+		uint64_t contentKey, std::shared_ptr<T> asset)
+	{
+		// Another load of the same content may have finished while this one ran
+		if (std::shared_ptr<T> existing = FindByContent(table, contentKey))
+		{
+			asset = existing;
+		}
+		else
+		{
+			table.ByContent[contentKey] = asset;
+		}
+
+		if (!key.empty())
+		{
+			table.ByPath[key] = { path, contentKey, asset };
+		}
+		return asset;
+	}
+
+	template<typename T>
+	size_t AssetManager::RemoveExpired(Table<T>& table)
+	{
+		size_t removed = std::erase_if(table.ByPath, [](const auto& entry) { return entry.second.Asset.expired(); });
+		removed += std::erase_if(table.ByContent, [](const auto& entry) { return entry.second.expired(); });
+		return removed;
+	}
+
+	//==========================================================================
+	// Load by path
+	//==========================================================================
+	std::shared_ptr<Texture> AssetManager::LoadTexture(const std::string& path, bool isHDR)
+	{
+		return LoadTexture(path, isHDR, MipContent::Color);
+	}
+
+	std::shared_ptr<Texture> AssetManager::LoadTexture(const std::string& path, MipContent content)
+	{
+		return LoadTexture(path, false, content);
+	}
+
+	std::shared_ptr<Texture> AssetManager::LoadTexture(const std::string& path, bool isHDR, MipContent content)
+	{
+		std::string normalized = NormalizePath(path);
+		// Everything that changes the texture: HDR or content, mips, compression, streaming
+		uint64_t settingsHash = Texture::GetLoadSettingsHash(isHDR, content);
+		std::string key = MakeKey(normalized, settingsHash);
+		uint64_t contentHash = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (std::shared_ptr<Texture> texture = FindByPath(m_Textures, key))
+			{
+				m_Stats.PathHits++;
+				return texture;
+			}
+		}
+
+		if (!HashFile(path, contentHash))
+		{
+			VP_CORE_ERROR("Failed to load texture: {}", path);
+			return nullptr;
+		}
+		// Texture(path) flips vertically (and may compress); loaders sharing this table must key differently
+		uint64_t contentKey = Hash::Combine(Hash::Combine(contentHash, Hash::FNV1a("Texture(path)")), settingsHash);
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (std::shared_ptr<Texture> texture = FindByContent(m_Textures, contentKey))
+			{
+				m_Stats.ContentHits++;
+				return Insert(m_Textures, key, normalized, contentKey, texture);
+			}
+		}
+
+		auto texture = isHDR ? std::make_shared<Texture>(path, true) : std::make_shared<Texture>(path, content);
+		if (texture->GetID() == 0)
+		{
+			return nullptr;  // Constructor logged the reason
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.Misses++;
+		return Insert(m_Textures, key, normalized, contentKey, texture);
+	}
+
+	std::shared_ptr<Shader> AssetManager::LoadShader(const std::string& path)
+	{
+		return LoadShader(path, false);
+	}
+
+	std::shared_ptr<Shader> AssetManager::LoadShaderAsync(const std::string& path)
+	{
+		return LoadShader(path, true);
+	}
+
+	std::shared_ptr<Shader> AssetManager::LoadShader(const std::string& path, bool async)
+	{
+		std::string normalized = NormalizePath(path);
+		std::string key = MakeKey(normalized, 0);
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (std::shared_ptr<Shader> shader = FindByPath(m_Shaders, key))
+			{
+				if (shader->IsValid())
+				{
+					m_Stats.PathHits++;
+					return shader;
+				}
+				// A CompileAsync program that failed to link after it was cached
+				RemoveShader(m_Shaders.ByPath[key].ContentKey);
+			}
+		}
+
+		// Included files are part of the content: the same text in another
+		// directory may include different code
+		uint64_t contentKey = 0;
+		if (!Shader::HashSource(path, contentKey))
+		{
+			VP_CORE_ERROR("Could not read shader file: {}", path);
+			return nullptr;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (std::shared_ptr<Shader> shader = FindByContent(m_Shaders, contentKey))
+			{
+				if (shader->IsValid())
+				{
+					m_Stats.ContentHits++;
+					return Insert(m_Shaders, key, normalized, contentKey, shader);
+				}
+				RemoveShader(contentKey);
+			}
+		}
+
+		auto shader = async ? Shader::CompileAsync(path) : std::make_shared<Shader>(path);
+		if (!shader || !shader->IsValid())
+		{
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.Misses++;
+		return Insert(m_Shaders, key, normalized, contentKey, shader);
+	}
+
+	void AssetManager::RemoveShader(uint64_t contentKey)
+	{
+		m_Shaders.ByContent.erase(contentKey);
+		std::erase_if(m_Shaders.ByPath, [contentKey](const auto& entry) { return entry.second.ContentKey == contentKey; });
+	}
+
+	std::shared_ptr<Model> AssetManager::LoadModel(const std::string& path, const ModelLoadOptions& options)
+	{
+		std::string normalized = NormalizePath(path);
+		uint64_t optionsHash = Model::GetOptionsHash(options);
+		std::string key = MakeKey(normalized, optionsHash);
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			CollectPendingModels();
+			if (std::shared_ptr<Model> model = FindByPath(m_Models, key))
+			{
+				m_Stats.PathHits++;
+				return model;
+			}
+		}
+
+		uint64_t contentHash = 0;
+		if (!HashFile(path, contentHash))
+		{
+			VP_CORE_ERROR("Model file not found: {}", path);
+			return nullptr;
+		}
+		uint64_t contentKey = Hash::Combine(contentHash, optionsHash);
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (std::shared_ptr<Model> model = FindByContent(m_Models, contentKey))
+			{
+				m_Stats.ContentHits++;
+				return Insert(m_Models, key, normalized, contentKey, model);
+			}
+		}
+
+		// Not under the lock: the loader calls back into the texture table
+		std::shared_ptr<Model> model = Model::LoadFromFile(path, options);
+		if (!model)
+		{
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.Misses++;
+		return Insert(m_Models, key, normalized, contentKey, model);
+	}
+
+	AsyncHandle<Model> AssetManager::LoadModelAsync(const std::string& path, const ModelLoadOptions& options)
+	{
+		std::string normalized = NormalizePath(path);
+		uint64_t optionsHash = Model::GetOptionsHash(options);
+		std::string key = MakeKey(normalized, optionsHash);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		CollectPendingModels();
+
+		if (std::shared_ptr<Model> model = FindByPath(m_Models, key))
+		{
+			m_Stats.PathHits++;
+			std::promise<std::shared_ptr<Model>> ready;
+			ready.set_value(model);
+			return AsyncHandle<Model>(ready.get_future().share());
+		}
+
+		auto pending = m_PendingModels.find(key);
+		if (pending != m_PendingModels.end())
+		{
+			m_Stats.PathHits++;
+			return pending->second.Handle;
+		}
+
+		// The file is read on a worker, so async loads are keyed by path only.
+		// Identical files under different paths still share their textures and meshes.
+		m_Stats.Misses++;
+		AsyncHandle<Model> handle = Model::LoadAsync(path, options);
+		m_PendingModels[key] = { normalized, Hash::FNV1a(key), handle };
+		return handle;
+	}
+
+	void AssetManager::CollectPendingModels()
+	{
+		for (auto it = m_PendingModels.begin(); it != m_PendingModels.end();)
+		{
+			if (!it->second.Handle.IsReady())
+			{
+				++it;
+				continue;
+			}
+			if (std::shared_ptr<Model> model = it->second.Handle.Get())
+			{
+				Insert(m_Models, it->first, it->second.Path, it->second.ContentKey, model);
+			}
+			it = m_PendingModels.erase(it);
+		}
+	}
+
+	//==========================================================================
+	// Content table
+	//==========================================================================
+	std::shared_ptr<Texture> AssetManager::FindTexture(uint64_t contentKey)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		std::shared_ptr<Texture> texture = FindByContent(m_Textures, contentKey);
+		if (texture)
+		{
+			m_Stats.ContentHits++;
+		}
+		return texture;
+	}
+
+	std::shared_ptr<Mesh> AssetManager::FindMesh(uint64_t contentKey)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		std::shared_ptr<Mesh> mesh = FindByContent(m_Meshes, contentKey);
+		if (mesh)
+		{
+			m_Stats.ContentHits++;
+		}
+		return mesh;
+	}
+
+	std::shared_ptr<Texture> AssetManager::AddTexture(uint64_t contentKey, std::shared_ptr<Texture> texture)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.Misses++;
+		return Insert(m_Textures, std::string(), std::string(), contentKey, std::move(texture));
+	}
+
+	std::shared_ptr<Mesh> AssetManager::AddMesh(uint64_t contentKey, std::shared_ptr<Mesh> mesh)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.Misses++;
+		return Insert(m_Meshes, std::string(), std::string(), contentKey, std::move(mesh));
+	}
+
+	//==========================================================================
+	// Eviction
+	//==========================================================================
+	void AssetManager::Evict(const std::string& path)
+	{
+		std::string normalized = NormalizePath(path);
+		auto evict = [&normalized](auto& table)
+		{
+			for (auto it = table.ByPath.begin(); it != table.ByPath.end();)
+			{
+				if (it->second.Path == normalized)
+				{
+					table.ByContent.erase(it->second.ContentKey);
+					it = table.ByPath.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		};
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		CollectPendingModels();
+		evict(m_Textures);
+		evict(m_Shaders);
+		evict(m_Models);
+		VP_CORE_TRACE("Evicted assets for '{}'", path);
+	}
+
+	size_t AssetManager::EvictExpired()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		CollectPendingModels();
+		return RemoveExpired(m_Textures) + RemoveExpired(m_Meshes) + RemoveExpired(m_Shaders) + RemoveExpired(m_Models);
+	}
+
+	void AssetManager::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Textures = {};
+		m_Meshes = {};
+		m_Shaders = {};
+		m_Models = {};
+		m_PendingModels.clear();
+		m_Stats = {};
+	}
+
+	AssetManagerStats AssetManager::GetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		CollectPendingModels();
+		RemoveExpired(m_Textures);
+		RemoveExpired(m_Meshes);
+		RemoveExpired(m_Shaders);
+		RemoveExpired(m_Models);
+
+		AssetManagerStats stats = m_Stats;
+		stats.Textures = m_Textures.ByContent.size();
+		stats.Meshes = m_Meshes.ByContent.size();
+		stats.Shaders = m_Shaders.ByContent.size();
+		stats.Models = m_Models.ByContent.size();
+		return stats;
+	}
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/AsyncHandle.h"
+#include "VizEngine/Core/Model.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace VizEngine
+{
+	/**
+	 * Cache counters since startup (or the last Clear()).
+	 */
+	struct AssetManagerStats
+	{
+		size_t PathHits = 0;      // Served from the path table
+		size_t ContentHits = 0;   // Different path (or loader), identical content
+		size_t Misses = 0;        // Had to load / upload
+		size_t Textures = 0;      // Live entries per table
+		size_t Meshes = 0;
+		size_t Shaders = 0;
+		size_t Models = 0;
+	};
+
+	/**
+	 * Engine-wide asset cache, so loading the same file twice (or two models
+	 * sharing a texture) reuses one GPU resource.
+	 *
+	 * Assets are found by normalized path and by a hash of their content, so
+	 * identical files under different paths are shared too. Loaders that
+	 * build GPU resources from in-memory data (e.g. glTF images) use the
+	 * content tables directly through Find/Add.
+	 *
+	 * The manager only holds weak references: an asset is freed as soon as
+	 * the last user drops it. Evict() forgets an entry so the next load reads
+	 * the file again (e.g. after editing it).
+	 *
+	 * Load* functions create GL objects and must run on the main thread;
+	 * Find* / Add* are thread-safe.
+	 */
+	class VizEngine_API AssetManager
+	{
+	public:
+		static AssetManager& Get();
+
+		AssetManager() = default;
+
+		// Non-copyable (holds the engine's asset tables)
+		AssetManager(const AssetManager&) = delete;
+		AssetManager& operator=(const AssetManager&) = delete;
+
+		// =====================================================================
+		// Load by path (main thread)
+		// =====================================================================
+
+		/**
+		 * Same as Texture(path) / Texture(path, true), cached per path and
+		 * Texture load settings (see Texture::GetLoadSettingsHash).
+		 * @return nullptr if the file can't be loaded
+		 */
+		std::shared_ptr<Texture> LoadTexture(const std::string& path, bool isHDR = false);
+
+		/**
+		 * Same as Texture(path, content), cached separately per content.
+		 * @return nullptr if the file can't be loaded
+		 */
+		std::shared_ptr<Texture> LoadTexture(const std::string& path, MipContent content);
+
+		/**
+		 * Same as Shader(path), cached.
+		 * @return nullptr if the shader fails to compile
+		 */
+		std::shared_ptr<Shader> LoadShader(const std::string& path);
+
+		/**
+		 * Same as Shader::CompileAsync(path), cached: LoadShader(path) returns
+		 * the same program, which finishes linking on first use if the driver
+		 * isn't done yet. A program that fails to link is dropped from the
+		 * cache, so the next load of its path compiles the file again.
+		 * @return nullptr if the file can't be parsed
+		 */
+		std::shared_ptr<Shader> LoadShaderAsync(const std::string& path);
+
+		/**
+		 * Same as Model::LoadFromFile, cached per path and import options.
+		 */
+		std::shared_ptr<Model> LoadModel(const std::string& path, const ModelLoadOptions& options = {});
+
+		/**
+		 * Same as Model::LoadAsync. Returns an already completed handle if the
+		 * model is loaded, and the pending handle if a load is in flight.
+		 */
+		AsyncHandle<Model> LoadModelAsync(const std::string& path, const ModelLoadOptions& options = {});
+
+		// =====================================================================
+		// Content table (any thread)
+		// =====================================================================
+
+		/**
+		 * Live texture / mesh previously added under a content key, or nullptr.
+		 * Keys are hashes of the source data combined with anything that changes
+		 * the resulting GPU resource (format, orientation, ...).
+		 */
+		std::shared_ptr<Texture> FindTexture(uint64_t contentKey);
+		std::shared_ptr<Mesh> FindMesh(uint64_t contentKey);
+
+		/**
+		 * Register a resource under a content key.
+		 * @return The resource to use: `texture` / `mesh`, or the live one another
+		 *         thread added under the same key first
+		 */
+		std::shared_ptr<Texture> AddTexture(uint64_t contentKey, std::shared_ptr<Texture> texture);
+		std::shared_ptr<Mesh> AddMesh(uint64_t contentKey, std::shared_ptr<Mesh> mesh);
+
+		// =====================================================================
+		// Eviction
+		// =====================================================================
+
+		/**
+		 * Forget every asset loaded from `path`. Users keep their references;
+		 * the next load reads the file again.
+		 */
+		void Evict(const std::string& path);
+
+		/**
+		 * Drop entries whose asset has been freed.
+		 * @return Number of entries removed
+		 */
+		size_t EvictExpired();
+
+		/**
+		 * Forget everything and reset the counters.
+		 */
+		void Clear();
+
+		AssetManagerStats GetStats();
+
+		/**
+		 * Content hash of a file (Hash::Bytes over its bytes).
+		 * @return false if the file can't be read
+		 */
+		static bool HashFile(const std::string& path, uint64_t& outHash);
+
+	private:
+		template<typename T>
+		struct Table
+		{
+			struct PathEntry
+			{
+				std::string Path;        // Normalized, for Evict()
+				uint64_t ContentKey = 0;
+				std::weak_ptr<T> Asset;
+			};
+
+			std::unordered_map<std::string, PathEntry> ByPath;  // Key: path + load variant
+			std::unordered_map<uint64_t, std::weak_ptr<T>> ByContent;
+		};
+
+		template<typename T>
+		std::shared_ptr<T> FindByPath(Table<T>& table, const std::string& key);
+		template<typename T>
+		std::shared_ptr<T> FindByContent(Table<T>& table, uint64_t contentKey);
+		template<typename T>
+		std::shared_ptr<T> Insert(Table<T>& table, const std::string& key, const std::string& path, uint64_t contentKey, std::shared_ptr<T> asset);
+		template<typename T>
+		static size_t RemoveExpired(Table<T>& table);
+
+		void CollectPendingModels();
+		std::shared_ptr<Shader> LoadShader(const std::string& path, bool async);
+		// Forget a shader that failed to link (callers hold m_Mutex)
+		void RemoveShader(uint64_t contentKey);
+		std::shared_ptr<Texture> LoadTexture(const std::string& path, bool isHDR, MipContent content);
+
+		std::mutex m_Mutex;
+		Table<Texture> m_Textures;
+		Table<Mesh> m_Meshes;
+		Table<Shader> m_Shaders;
+		Table<Model> m_Models;
+
+		// In-flight LoadModelAsync calls. They hold the model until the next
+		// model call moves it into m_Models.
+		struct PendingModel
+		{
+			std::string Path;
+			uint64_t ContentKey = 0;
+			AsyncHandle<Model> Handle;
+		};
+		std::unordered_map<std::string, PendingModel> m_PendingModels;
+
+		AssetManagerStats m_Stats;
+	};
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "VizEngine/Core/UploadQueue.h"
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace VizEngine
+{
+	/**
+	 * Handle to an asset loading in the background (Model::LoadAsync,
+	 * Texture::LoadAsync). Copyable; all copies refer to the same load.
+	 *
+	 * The asset becomes ready after its GPU resources were created on the
+	 * main thread by UploadQueue, so poll IsReady() from OnUpdate().
+	 *
+	 * Example:
+	 *   m_HelmetLoad = Model::LoadAsync("assets/helmet.glb");
+	 *   ...
+	 *   if (m_HelmetLoad.IsReady()) { auto helmet = m_HelmetLoad.Get(); ... }
+	 */
+	template<typename T>
+	class AsyncHandle
+	{
+	public:
+		AsyncHandle() = default;
+		explicit AsyncHandle(std::shared_future<std::shared_ptr<T>> future)
+			: m_Future(std::move(future)) {}
+
+		// False for default-constructed handles
+		bool IsValid() const { return m_Future.valid(); }
+
+		bool IsReady() const
+		{
+			return IsValid() && m_Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+
+		/**
+		 * The loaded asset; nullptr while loading or if loading failed.
+		 */
+		std::shared_ptr<T> Get() const
+		{
+			if (!IsReady())
+			{
+				return nullptr;
+			}
+			try
+			{
+				return m_Future.get();
+			}
+			catch (const std::future_error&)
+			{
+				// Load was abandoned (upload queue cleared at shutdown)
+				return nullptr;
+			}
+		}
+
+		/**
+		 * Block until the load finishes. Main thread only: queued GPU work is
+		 * run while waiting, since the load cannot complete without it.
+		 */
+		std::shared_ptr<T> Wait() const
+		{
+			while (IsValid() && !IsReady())
+			{
+				if (UploadQueue::Get().Flush() == 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+			return Get();
+		}
+
+	private:
+		std::shared_future<std::shared_ptr<T>> m_Future;
+	};
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "glm.hpp"
+
+namespace VizEngine
+{
+	/**
+	 * Six clip planes (xyz = inward normal, w = distance), extracted from a
+	 * projection matrix (Gribb & Hartmann).
+	 *
+	 * The planes live in whatever space the matrix transforms from: pass a
+	 * view-projection matrix for world space planes, or an MVP for object
+	 * space planes.
+	 */
+	struct VizEngine_API Frustum
+	{
+		glm::vec4 Planes[6];  // Left, right, bottom, top, near, far
+
+		static Frustum FromMatrix(const glm::mat4& m)
+		{
+			glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+			glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+			glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+			glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+			Frustum frustum;
+			frustum.Planes[0] = row3 + row0;
+			frustum.Planes[1] = row3 - row0;
+			frustum.Planes[2] = row3 + row1;
+			frustum.Planes[3] = row3 - row1;
+			frustum.Planes[4] = row3 + row2;  // OpenGL clip depth is [-w, w]
+			frustum.Planes[5] = row3 - row2;
+
+			for (glm::vec4& plane : frustum.Planes)
+			{
+				float length = glm::length(glm::vec3(plane));
+				if (length > 0.0f)
+				{
+					plane *= 1.0f / length;
+				}
+			}
+			return frustum;
+		}
+
+		bool IntersectsSphere(const glm::vec3& center, float radius) const
+		{
+			for (const glm::vec4& plane : Planes)
+			{
+				if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+}
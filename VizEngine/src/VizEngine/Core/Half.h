@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace VizEngine
+{
+	/**
+	 * IEEE 754 half-float conversion (as used by GL_HALF_FLOAT).
+	 * Handles subnormals, infinities and NaN; rounds to nearest even.
+	 */
+	namespace Half
+	{
+		inline uint16_t FromFloat(float value)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			uint32_t sign = bits & 0x80000000u;
+			bits ^= sign;
+
+			uint16_t result;
+			if (bits >= 0x47800000u)  // Too large for half: Inf, or NaN stays NaN
+			{
+				result = bits > 0x7F800000u ? 0x7E00 : 0x7C00;
+			}
+			else if (bits < 0x38800000u)  // Subnormal half or zero: let the FPU round
+			{
+				const uint32_t magicBits = 0x3F000000u;  // 0.5f
+				float magic;
+				std::memcpy(&magic, &magicBits, sizeof(magic));
+				float f;
+				std::memcpy(&f, &bits, sizeof(f));
+				f += magic;
+				std::memcpy(&bits, &f, sizeof(bits));
+				result = static_cast<uint16_t>(bits - magicBits);
+			}
+			else
+			{
+				uint32_t mantissaOdd = (bits >> 13) & 1;
+				bits += 0xC8000FFFu;  // Rebias exponent (-112 << 23) and round
+				bits += mantissaOdd;
+				result = static_cast<uint16_t>(bits >> 13);
+			}
+			return static_cast<uint16_t>(result | (sign >> 16));
+		}
+
+		inline float ToFloat(uint16_t value)
+		{
+			uint32_t bits = static_cast<uint32_t>(value & 0x7FFF) << 13;
+			uint32_t exponent = bits & 0x0F800000u;
+			bits += 0x38000000u;  // Rebias exponent (112 << 23)
+
+			float result;
+			if (exponent == 0x0F800000u)  // Inf / NaN
+			{
+				bits += 0x38000000u;
+				std::memcpy(&result, &bits, sizeof(result));
+			}
+			else if (exponent == 0)  // Subnormal: renormalize through the FPU
+			{
+				bits += 0x00800000u;
+				std::memcpy(&result, &bits, sizeof(result));
+				result -= 6.103515625e-05f;  // 2^-14
+			}
+			else
+			{
+				std::memcpy(&result, &bits, sizeof(result));
+			}
+
+			if (value & 0x8000)
+			{
+				result = -result;
+			}
+			return result;
+		}
+	}
+}
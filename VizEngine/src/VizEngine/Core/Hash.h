@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+namespace VizEngine
+{
+	/**
+	 * Small, dependency-free hashing helpers used for on-disk cache keys.
+	 *
+	 * These are NOT cryptographic hashes. They only need to detect that a
+	 * source file changed and to spread cache file names evenly.
+	 */
+	namespace Hash
+	{
+		constexpr uint64_t FNV1aOffset = 14695981039346656037ull;
+		constexpr uint64_t FNV1aPrime = 1099511628211ull;
+
+		/**
+		 * FNV-1a over a string (usable at compile time).
+		 */
+		constexpr uint64_t FNV1a(std::string_view str, uint64_t seed = FNV1aOffset)
+		{
+			uint64_t hash = seed;
+			for (char c : str)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= FNV1aPrime;
+			}
+			return hash;
+		}
+
+		/**
+		 * Fast hash over arbitrary bytes. Processes 8 bytes per step, which is
+		 * fast enough to fingerprint multi-megabyte asset files on every load.
+		 */
+		inline uint64_t Bytes(const void* data, size_t size, uint64_t seed = FNV1aOffset)
+		{
+			constexpr uint64_t k = 0x9E3779B97F4A7C15ull;
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			uint64_t hash = seed ^ (static_cast<uint64_t>(size) * k);
+
+			size_t i = 0;
+			for (; i + 8 <= size; i += 8)
+			{
+				uint64_t word;
+				std::memcpy(&word, bytes + i, sizeof(word));
+				word *= k;
+				word ^= word >> 31;
+				hash = (hash ^ word) * FNV1aPrime;
+				hash ^= hash >> 29;
+			}
+			for (; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= FNV1aPrime;
+			}
+
+			// Final avalanche (splitmix64 finalizer)
+			hash ^= hash >> 30;
+			hash *= 0xBF58476D1CE4E5B9ull;
+			hash ^= hash >> 27;
+			hash *= 0x94D049BB133111EBull;
+			hash ^= hash >> 31;
+			return hash;
+		}
+
+		/**
+		 * Combine two hashes (order dependent).
+		 */
+		constexpr uint64_t Combine(uint64_t a, uint64_t b)
+		{
+			return a ^ (b + 0x9E3779B97F4A7C15ull + (a << 6) + (a >> 2));
+		}
+	}
+}
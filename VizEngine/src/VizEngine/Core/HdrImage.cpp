@@ -0,0 +1,426 @@
+#include "HdrImage.h"
+#include "VizEngine/Core/Half.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "VizEngine/Core/Simd.h"
+#include "VizEngine/Core/ThreadPool.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+#include "stb_image.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace VizEngine
+{
+	static constexpr float HalfMax = 65504.0f;
+
+	//==========================================================================
+	// Converters
+	//==========================================================================
+	void HdrImage::FloatToHalf(const float* in, uint16_t* out, size_t count)
+	{
+		size_t i = 0;
+#if VP_SIMD_SSE2
+		// Same branches as Half::FromFloat, selected per lane. Values above the
+		// half range clamp to its maximum instead of becoming infinity.
+		const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000u));
+		const __m128 maxValue = _mm_set1_ps(HalfMax);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128i subnormalBias = _mm_set1_epi32(0x3F000000);
+		const __m128i normalBias = _mm_set1_epi32(static_cast<int>(0xC8000FFFu));
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i nanBits = _mm_set1_epi32(0x7E00);
+		const __m128i infinity = _mm_set1_epi32(0x7F800000);
+		const __m128i minNormal = _mm_set1_epi32(0x38800000);
+		const __m128i packBias = _mm_set1_epi32(0x8000);
+		const __m128i unpackBias = _mm_set1_epi16(static_cast<short>(0x8000));
+
+		auto convert = [&](__m128 value) -> __m128i
+		{
+			__m128i bits = _mm_castps_si128(value);
+			__m128i sign = _mm_and_si128(bits, signMask);
+			bits = _mm_xor_si128(bits, sign);
+			__m128i isNan = _mm_cmpgt_epi32(bits, infinity);
+			bits = _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(bits), maxValue));
+
+			__m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 13), one);
+			__m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, normalBias), odd), 13);
+			__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(bits), half)), subnormalBias);
+			__m128i isSubnormal = _mm_cmplt_epi32(bits, minNormal);
+
+			__m128i result = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+			result = _mm_or_si128(_mm_and_si128(isNan, nanBits), _mm_andnot_si128(isNan, result));
+			return _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+		};
+
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i lo = _mm_sub_epi32(convert(_mm_loadu_ps(in + i)), packBias);
+			__m128i hi = _mm_sub_epi32(convert(_mm_loadu_ps(in + i + 4)), packBias);
+			// Signed saturating pack is exact once biased into [-32768, 32767]
+			__m128i packed = _mm_xor_si128(_mm_packs_epi32(lo, hi), unpackBias);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+		}
+#endif
+		for (; i < count; i++)
+		{
+			float value = in[i];
+			out[i] = Half::FromFloat(std::fabs(value) > HalfMax ? std::copysign(HalfMax, value) : value);
+		}
+	}
+
+	uint32_t HdrImage::ToRgb9e5(float r, float g, float b)
+	{
+		// EXT_texture_shared_exponent: 9-bit mantissas, 5-bit exponent (bias 15)
+		static constexpr float MaxValue = 65408.0f;  // (511 / 512) * 2^16
+		auto clampChannel = [](float value) { return value > 0.0f ? std::min(value, MaxValue) : 0.0f; };  // NaN -> 0
+		r = clampChannel(r);
+		g = clampChannel(g);
+		b = clampChannel(b);
+
+		float maxChannel = std::max(r, std::max(g, b));
+		uint32_t bits;
+		std::memcpy(&bits, &maxChannel, sizeof(bits));
+		int floorLog2 = static_cast<int>((bits >> 23) & 0xFF) - 127;
+		int exponent = std::max(-16, floorLog2) + 16;
+
+		float scale = std::ldexp(1.0f, 24 - exponent);
+		if (static_cast<int>(maxChannel * scale + 0.5f) == 512)
+		{
+			exponent++;
+			scale *= 0.5f;
+		}
+
+		uint32_t rm = static_cast<uint32_t>(r * scale + 0.5f);
+		uint32_t gm = static_cast<uint32_t>(g * scale + 0.5f);
+		uint32_t bm = static_cast<uint32_t>(b * scale + 0.5f);
+		return rm | (gm << 9) | (bm << 18) | (static_cast<uint32_t>(exponent) << 27);
+	}
+
+	uint32_t HdrImage::RgbeToRgb9e5(const uint8_t rgbe[4])
+	{
+		// Both share one exponent: m * 2^(e - 136) == (2m) * 2^((e - 113) - 24)
+		if (rgbe[3] == 0)
+		{
+			return 0;
+		}
+		int exponent = rgbe[3] - 113;
+		if (exponent > 31)
+		{
+			float scale = std::ldexp(1.0f, rgbe[3] - 136);
+			return ToRgb9e5(rgbe[0] * scale, rgbe[1] * scale, rgbe[2] * scale);
+		}
+
+		uint32_t m[3] = { rgbe[0] * 2u, rgbe[1] * 2u, rgbe[2] * 2u };
+		if (exponent < 0)
+		{
+			// Below the smallest exponent: shift into it, rounding
+			int shift = -exponent;
+			for (uint32_t& mantissa : m)
+			{
+				mantissa = shift > 10 ? 0 : (mantissa + (1u << (shift - 1))) >> shift;
+				mantissa = std::min(mantissa, 511u);
+			}
+			exponent = 0;
+		}
+		return m[0] | (m[1] << 9) | (m[2] << 18) | (static_cast<uint32_t>(exponent) << 27);
+	}
+
+	//==========================================================================
+	// Output
+	//==========================================================================
+
+	// Single-level layout for `format`; rows are tightly packed
+	static void Allocate(int width, int height, bool alpha, HdrFormat format, TextureData& out)
+	{
+		out = TextureData();
+		size_t texelBytes;
+		if (format == HdrFormat::RGB9E5 && !alpha)
+		{
+			out.InternalFormat = GL_RGB9_E5;
+			out.Format = GL_RGB;
+			out.Type = GL_UNSIGNED_INT_5_9_9_9_REV;
+			texelBytes = 4;
+		}
+		else
+		{
+			out.InternalFormat = alpha ? GL_RGBA16F : GL_RGB16F;
+			out.Format = alpha ? GL_RGBA : GL_RGB;
+			out.Type = GL_HALF_FLOAT;
+			texelBytes = alpha ? 8 : 6;
+		}
+
+		TextureData::Level level;
+		level.Width = width;
+		level.Height = height;
+		level.Size = static_cast<size_t>(width) * height * texelBytes;
+		out.Levels.push_back(level);
+		out.Bytes.resize(level.Size);
+	}
+
+	static size_t RowGrain(int height)
+	{
+		return std::max<size_t>(1, height / (ThreadPool::Get().GetThreadCount() * 4 + 1));
+	}
+
+	bool HdrImage::Pack(const float* pixels, int width, int height, int channels, HdrFormat format, TextureData& out)
+	{
+		if (!pixels || width <= 0 || height <= 0 || (channels != 3 && channels != 4))
+		{
+			VP_CORE_ERROR("HdrImage: invalid image ({}x{}, {} channels)", width, height, channels);
+			return false;
+		}
+
+		Allocate(width, height, channels == 4, format, out);
+		bool rgb9e5 = out.InternalFormat == GL_RGB9_E5;
+		size_t rowValues = static_cast<size_t>(width) * channels;
+
+		ThreadPool::Get().ParallelFor(static_cast<size_t>(height), RowGrain(height), [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; y++)
+			{
+				const float* in = pixels + y * rowValues;
+				if (rgb9e5)
+				{
+					uint32_t* row = reinterpret_cast<uint32_t*>(out.Bytes.data()) + y * width;
+					for (int x = 0; x < width; x++)
+					{
+						row[x] = ToRgb9e5(in[x * 3], in[x * 3 + 1], in[x * 3 + 2]);
+					}
+				}
+				else
+				{
+					FloatToHalf(in, reinterpret_cast<uint16_t*>(out.Bytes.data()) + y * rowValues, rowValues);
+				}
+			}
+		});
+		return true;
+	}
+
+	//==========================================================================
+	// Radiance
+	//==========================================================================
+	bool HdrImage::IsRadiance(const uint8_t* bytes, size_t size)
+	{
+		auto startsWith = [&](std::string_view magic)
+		{
+			return size >= magic.size() && std::memcmp(bytes, magic.data(), magic.size()) == 0;
+		};
+		return bytes && (startsWith("#?RADIANCE\n") || startsWith("#?RGBE\n"));
+	}
+
+	// Next header line (without the newline), advancing `position`
+	static bool ReadLine(const uint8_t* bytes, size_t size, size_t& position, std::string_view& line)
+	{
+		size_t start = position;
+		while (position < size && bytes[position] != '\n')
+		{
+			position++;
+		}
+		if (position >= size)
+		{
+			return false;
+		}
+		line = std::string_view(reinterpret_cast<const char*>(bytes + start), position - start);
+		position++;
+		return true;
+	}
+
+	bool HdrImage::DecodeRadiance(const uint8_t* bytes, size_t size, bool flipVertically, HdrFormat format, TextureData& out)
+	{
+		if (!IsRadiance(bytes, size))
+		{
+			return false;
+		}
+
+		// Header: variables until an empty line, then the resolution string
+		size_t position = 0;
+		std::string_view line;
+		ReadLine(bytes, size, position, line);
+		while (true)
+		{
+			if (!ReadLine(bytes, size, position, line))
+			{
+				return false;
+			}
+			if (line.empty())
+			{
+				break;
+			}
+			if (line.substr(0, 7) == "FORMAT=" && line != "FORMAT=32-bit_rle_rgbe")
+			{
+				return false;  // XYZE
+			}
+		}
+
+		if (!ReadLine(bytes, size, position, line))
+		{
+			return false;
+		}
+		char ySign = 0, xSign = 0;
+		int height = 0, width = 0;
+		std::string resolution(line);
+		if (std::sscanf(resolution.c_str(), "%cY %d %cX %d", &ySign, &height, &xSign, &width) != 4 ||
+			xSign != '+' || (ySign != '-' && ySign != '+') || width <= 0 || height <= 0)
+		{
+			return false;
+		}
+		// -Y stores the top row first; flipping makes the bottom row first
+		bool bottomFirst = (ySign == '+') != flipVertically;
+
+		// New-style RLE only: every scanline starts with 2, 2, width
+		if (width < 8 || width > 0x7FFF)
+		{
+			return false;
+		}
+
+		// Find where each scanline starts by walking the run lengths
+		std::vector<size_t> rowOffsets(height);
+		for (int y = 0; y < height; y++)
+		{
+			if (position + 4 > size || bytes[position] != 2 || bytes[position + 1] != 2 ||
+				((bytes[position + 2] << 8) | bytes[position + 3]) != width)
+			{
+				return false;
+			}
+			rowOffsets[y] = position;
+			position += 4;
+			for (int channel = 0; channel < 4; channel++)
+			{
+				int x = 0;
+				while (x < width)
+				{
+					if (position >= size)
+					{
+						return false;
+					}
+					int count = bytes[position++];
+					bool run = count > 128;
+					count = run ? count - 128 : count;
+					if (count == 0 || x + count > width)
+					{
+						return false;
+					}
+					position += run ? 1 : static_cast<size_t>(count);
+					x += count;
+				}
+			}
+			if (position > size)
+			{
+				return false;
+			}
+		}
+
+		Allocate(width, height, false, format, out);
+		bool rgb9e5 = out.InternalFormat == GL_RGB9_E5;
+
+		ThreadPool::Get().ParallelFor(static_cast<size_t>(height), RowGrain(height), [&](size_t begin, size_t end)
+		{
+			std::vector<uint8_t> rgbe(static_cast<size_t>(width) * 4);
+			std::vector<float> rgb(rgb9e5 ? 0 : static_cast<size_t>(width) * 3);
+			for (size_t y = begin; y < end; y++)
+			{
+				// Channels are stored as separate runs; interleave into RGBE texels
+				const uint8_t* in = bytes + rowOffsets[y] + 4;
+				for (int channel = 0; channel < 4; channel++)
+				{
+					int x = 0;
+					while (x < width)
+					{
+						int count = *in++;
+						if (count > 128)
+						{
+							count -= 128;
+							uint8_t value = *in++;
+							for (int i = 0; i < count; i++)
+							{
+								rgbe[(x + i) * 4 + channel] = value;
+							}
+						}
+						else
+						{
+							for (int i = 0; i < count; i++)
+							{
+								rgbe[(x + i) * 4 + channel] = *in++;
+							}
+						}
+						x += count;
+					}
+				}
+
+				size_t row = bottomFirst ? height - 1 - y : y;
+				if (rgb9e5)
+				{
+					uint32_t* target = reinterpret_cast<uint32_t*>(out.Bytes.data()) + row * width;
+					for (int x = 0; x < width; x++)
+					{
+						target[x] = RgbeToRgb9e5(&rgbe[x * 4]);
+					}
+				}
+				else
+				{
+					// Same expansion as stb_image: mantissa * 2^(exponent - 136)
+					for (int x = 0; x < width; x++)
+					{
+						const uint8_t* texel = &rgbe[x * 4];
+						float scale = texel[3] ? std::ldexp(1.0f, texel[3] - 136) : 0.0f;
+						rgb[x * 3] = texel[0] * scale;
+						rgb[x * 3 + 1] = texel[1] * scale;
+						rgb[x * 3 + 2] = texel[2] * scale;
+					}
+					FloatToHalf(rgb.data(), reinterpret_cast<uint16_t*>(out.Bytes.data()) + row * width * 3, rgb.size());
+				}
+			}
+		});
+		return true;
+	}
+
+	//==========================================================================
+	// Files
+	//==========================================================================
+	bool HdrImage::Load(const std::string& path, HdrFormat format, TextureData& out)
+	{
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			return false;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		if (!DecodeRadiance(file.GetData(), file.GetSize(), true, format, out))
+		{
+			int width = 0, height = 0, channels = 0;
+			int size = static_cast<int>(file.GetSize());
+			if (!stbi_info_from_memory(file.GetData(), size, &width, &height, &channels))
+			{
+				return false;
+			}
+			// Grey and grey-alpha images are expanded to RGB / RGBA
+			channels = (channels == 2 || channels == 4) ? 4 : 3;
+
+			stbi_set_flip_vertically_on_load_thread(1);
+			float* pixels = stbi_loadf_from_memory(file.GetData(), size, &width, &height, nullptr, channels);
+			if (!pixels)
+			{
+				return false;
+			}
+			bool packed = Pack(pixels, width, height, channels, format, out);
+			stbi_image_free(pixels);
+			if (!packed)
+			{
+				return false;
+			}
+		}
+
+		VP_CORE_TRACE("Decoded {} ({}x{}) in {:.1f} ms", path, out.GetWidth(), out.GetHeight(),
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		return true;
+	}
+}
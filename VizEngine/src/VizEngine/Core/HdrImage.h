@@ -0,0 +1,65 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/TextureData.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace VizEngine
+{
+	/**
+	 * GPU format for HDR images.
+	 */
+	enum class HdrFormat
+	{
+		Half,    // GL_RGB16F / GL_RGBA16F, 6 or 8 bytes per texel
+		RGB9E5   // GL_RGB9_E5 shared exponent, 4 bytes per texel (no alpha, no negatives)
+	};
+
+	/**
+	 * HDR images packed on the CPU into the format they are uploaded in, so
+	 * the driver doesn't convert float32 data on the GL thread.
+	 *
+	 * Radiance (.hdr) files are decoded straight from RGBE into the target
+	 * format: scanline offsets are found in one pass over the run lengths,
+	 * then rows are decoded in parallel on the ThreadPool. No float32 copy of
+	 * the image is made. Float-to-half conversion uses SSE2 where available.
+	 */
+	class VizEngine_API HdrImage
+	{
+	public:
+		/**
+		 * True if the bytes start with a Radiance header.
+		 */
+		static bool IsRadiance(const uint8_t* bytes, size_t size);
+
+		/**
+		 * Load an HDR image file with a lower-left origin, as Texture(path, true).
+		 * Radiance files go through DecodeRadiance; other formats (and layouts
+		 * it doesn't handle) through stbi_loadf and Pack. Runs on any thread.
+		 */
+		static bool Load(const std::string& path, HdrFormat format, TextureData& out);
+
+		/**
+		 * Decode a run-length encoded Radiance image (-Y h +X w or +Y h +X w).
+		 * @param flipVertically Bottom row first, as stbi_set_flip_vertically_on_load
+		 * @return false for malformed files and layouts this decoder doesn't
+		 *         handle (flat scanlines, XYZE), which stb_image may still read
+		 */
+		static bool DecodeRadiance(const uint8_t* bytes, size_t size, bool flipVertically,
+			HdrFormat format, TextureData& out);
+
+		/**
+		 * Pack float RGB / RGBA pixels. Images with alpha always use Half.
+		 * @return false for invalid dimensions or channel counts
+		 */
+		static bool Pack(const float* pixels, int width, int height, int channels,
+			HdrFormat format, TextureData& out);
+
+		// Row converters (`count` values / texels)
+		static void FloatToHalf(const float* in, uint16_t* out, size_t count);
+		static uint32_t ToRgb9e5(float r, float g, float b);
+		static uint32_t RgbeToRgb9e5(const uint8_t rgbe[4]);
+	};
+}
@@ -0,0 +1,505 @@
+#include "Ktx2.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef VP_ENABLE_BASISU
+#include "transcoder/basisu_transcoder.h"
+#include <mutex>
+#endif
+
+namespace VizEngine
+{
+	//==========================================================================
+	// File layout
+	//==========================================================================
+	static constexpr uint8_t Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+	struct Header
+	{
+		uint8_t Identifier[12];
+		uint32_t VkFormat;
+		uint32_t TypeSize;
+		uint32_t PixelWidth;
+		uint32_t PixelHeight;
+		uint32_t PixelDepth;
+		uint32_t LayerCount;
+		uint32_t FaceCount;
+		uint32_t LevelCount;
+		uint32_t SupercompressionScheme;
+		uint32_t DfdByteOffset;
+		uint32_t DfdByteLength;
+		uint32_t KvdByteOffset;
+		uint32_t KvdByteLength;
+		uint64_t SgdByteOffset;
+		uint64_t SgdByteLength;
+	};
+
+	struct LevelIndex
+	{
+		uint64_t ByteOffset;
+		uint64_t ByteLength;
+		uint64_t UncompressedByteLength;
+	};
+
+	static_assert(sizeof(Header) == 80, "KTX2 header layout");
+	static_assert(sizeof(LevelIndex) == 24, "KTX2 level index layout");
+
+	enum Supercompression : uint32_t { None = 0, BasisLZ = 1, Zstandard = 2, Zlib = 3 };
+
+	// Data Format Descriptor color model of UASTC payloads (KHR_DF_MODEL_UASTC)
+	static constexpr uint8_t DfdModelUastc = 166;
+	static constexpr uint8_t DfdTransferLinear = 1;
+	static constexpr uint8_t DfdTransferSrgb = 2;
+	static constexpr uint8_t DfdModelBc5 = 132;
+	static constexpr size_t LevelAlignment = 16;  // Multiple of every block size and of 4
+
+	//==========================================================================
+	// VkFormat -> GL
+	//==========================================================================
+	struct FormatInfo
+	{
+		uint32_t VkFormat;
+		unsigned int InternalFormat;
+		unsigned int Format;       // Uncompressed only
+		unsigned int Type;
+		uint32_t BlockBytes;       // Per 4x4 block, or per pixel if uncompressed
+		bool Compressed;
+		uint8_t DfdModel;          // Color model written by Serialize (0 = can't write)
+		bool Srgb;
+	};
+
+	static constexpr FormatInfo Formats[] = {
+		{ 131, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 0, 0, 8, true, 128, false },                      // BC1_RGB_UNORM
+		{ 132, GL_COMPRESSED_SRGB_S3TC_DXT1_EXT, 0, 0, 8, true, 128, true },                      // BC1_RGB_SRGB
+		{ 133, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 0, 0, 8, true, 128, false },                     // BC1_RGBA_UNORM
+		{ 134, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 0, 0, 8, true, 128, true },                // BC1_RGBA_SRGB
+		{ 137, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 0, 0, 16, true, 130, false },                    // BC3_UNORM
+		{ 138, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 0, 0, 16, true, 130, true },               // BC3_SRGB
+		{ 139, GL_COMPRESSED_RED_RGTC1, 0, 0, 8, true, 131, false },                              // BC4_UNORM
+		{ 140, GL_COMPRESSED_SIGNED_RED_RGTC1, 0, 0, 8, true, 131, false },                       // BC4_SNORM
+		{ 141, GL_COMPRESSED_RG_RGTC2, 0, 0, 16, true, 132, false },                              // BC5_UNORM
+		{ 142, GL_COMPRESSED_SIGNED_RG_RGTC2, 0, 0, 16, true, 132, false },                       // BC5_SNORM
+		{ 143, GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT, 0, 0, 16, true, 133, false },               // BC6H_UFLOAT
+		{ 144, GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT, 0, 0, 16, true, 133, false },                 // BC6H_SFLOAT
+		{ 145, GL_COMPRESSED_RGBA_BPTC_UNORM, 0, 0, 16, true, 134, false },                       // BC7_UNORM
+		{ 146, GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM, 0, 0, 16, true, 134, true },                  // BC7_SRGB
+		{ 9, GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1, false, 1, false },                               // R8_UNORM
+		{ 16, GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2, false, 1, false },                              // R8G8_UNORM
+		{ 23, GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, 3, false, 1, false },                            // R8G8B8_UNORM
+		{ 37, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4, false, 1, false },                          // R8G8B8A8_UNORM
+		{ 43, GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE, 4, false, 1, true },                    // R8G8B8A8_SRGB
+		{ 90, GL_RGB16F, GL_RGB, GL_HALF_FLOAT, 6, false, 1, false },                             // R16G16B16_SFLOAT
+		{ 97, GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8, false, 1, false },                           // R16G16B16A16_SFLOAT
+		{ 122, GL_R11F_G11F_B10F, GL_RGB, GL_UNSIGNED_INT_10F_11F_11F_REV, 4, false, 0, false },  // B10G11R11_UFLOAT_PACK32
+		{ 123, GL_RGB9_E5, GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV, 4, false, 0, false },             // E5B9G9R9_UFLOAT_PACK32
+	};
+
+	static const FormatInfo* FindFormat(uint32_t vkFormat)
+	{
+		for (const FormatInfo& format : Formats)
+		{
+			if (format.VkFormat == vkFormat)
+			{
+				return &format;
+			}
+		}
+		return nullptr;
+	}
+
+	static const FormatInfo* FindInternalFormat(unsigned int internalFormat)
+	{
+		for (const FormatInfo& format : Formats)
+		{
+			if (format.InternalFormat == internalFormat)
+			{
+				return &format;
+			}
+		}
+		return nullptr;
+	}
+
+	static size_t LevelSize(const FormatInfo& format, int width, int height)
+	{
+		if (format.Compressed)
+		{
+			return static_cast<size_t>((width + 3) / 4) * static_cast<size_t>((height + 3) / 4) * format.BlockBytes;
+		}
+		return static_cast<size_t>(width) * height * format.BlockBytes;
+	}
+
+	static bool InRange(size_t fileSize, uint64_t offset, uint64_t length)
+	{
+		return offset <= fileSize && length <= fileSize - offset;
+	}
+
+	//==========================================================================
+	// Basis Universal
+	//==========================================================================
+#ifdef VP_ENABLE_BASISU
+	static bool Transcode(const uint8_t* bytes, size_t size, bool srgb, TextureData& out, const std::string& name)
+	{
+		static std::once_flag initialized;
+		std::call_once(initialized, []() { basist::basisu_transcoder_init(); });
+
+		basist::ktx2_transcoder transcoder;
+		if (!transcoder.init(bytes, static_cast<uint32_t>(size)) || !transcoder.start_transcoding())
+		{
+			VP_CORE_ERROR("KTX2: failed to start Basis Universal transcoding of '{}'", name);
+			return false;
+		}
+
+		// UASTC keeps its quality in BC7; ETC1S without alpha loses nothing in BC1
+		bool useBc1 = transcoder.is_etc1s() && !transcoder.get_has_alpha();
+		basist::transcoder_texture_format target = useBc1
+			? basist::transcoder_texture_format::cTFBC1_RGB
+			: basist::transcoder_texture_format::cTFBC7_RGBA;
+		uint32_t blockBytes = basist::basis_get_bytes_per_block_or_pixel(target);
+
+		out.Compressed = true;
+		out.InternalFormat = useBc1
+			? (srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+			: (srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM);
+
+		uint32_t levelCount = std::max(transcoder.get_levels(), 1u);
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			basist::ktx2_image_level_info info;
+			if (!transcoder.get_image_level_info(info, level, 0, 0))
+			{
+				VP_CORE_ERROR("KTX2: '{}' has an invalid level {}", name, level);
+				return false;
+			}
+
+			TextureData::Level entry;
+			entry.Offset = out.Bytes.size();
+			entry.Size = static_cast<size_t>(info.m_total_blocks) * blockBytes;
+			entry.Width = static_cast<int>(info.m_orig_width);
+			entry.Height = static_cast<int>(info.m_orig_height);
+			out.Bytes.resize(entry.Offset + entry.Size);
+
+			if (!transcoder.transcode_image_level(level, 0, 0, out.Bytes.data() + entry.Offset, info.m_total_blocks, target))
+			{
+				VP_CORE_ERROR("KTX2: failed to transcode level {} of '{}'", level, name);
+				return false;
+			}
+			out.Levels.push_back(entry);
+		}
+		return true;
+	}
+#endif
+
+	//==========================================================================
+	// Public API
+	//==========================================================================
+	bool Ktx2::IsKtx2(const uint8_t* bytes, size_t size)
+	{
+		return bytes && size >= sizeof(Identifier) && std::memcmp(bytes, Identifier, sizeof(Identifier)) == 0;
+	}
+
+	bool Ktx2::IsKtx2Path(const std::string& path)
+	{
+		std::string extension = std::filesystem::path(path).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(),
+			[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return extension == ".ktx2";
+	}
+
+	bool Ktx2::IsTranscoderAvailable()
+	{
+#ifdef VP_ENABLE_BASISU
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	bool Ktx2::Load(const std::string& path, TextureData& out)
+	{
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			VP_CORE_ERROR("KTX2: could not open '{}'", path);
+			return false;
+		}
+		return Parse(file.GetData(), file.GetSize(), out, path);
+	}
+
+	bool Ktx2::Parse(const uint8_t* bytes, size_t size, TextureData& out, const std::string& name)
+	{
+		out = TextureData();
+		if (!IsKtx2(bytes, size) || size < sizeof(Header))
+		{
+			VP_CORE_ERROR("KTX2: '{}' is not a KTX2 file", name);
+			return false;
+		}
+
+		Header header;
+		std::memcpy(&header, bytes, sizeof(Header));
+
+		bool cubemap = header.FaceCount == 6 && header.PixelWidth == header.PixelHeight;
+		if (header.PixelWidth == 0 || header.PixelHeight == 0 || header.PixelDepth > 1 ||
+			header.LayerCount > 1 || (header.FaceCount != 1 && !cubemap))
+		{
+			VP_CORE_ERROR("KTX2: '{}' is not a 2D texture or cubemap ({}x{}x{}, {} layers, {} faces)", name,
+				header.PixelWidth, header.PixelHeight, header.PixelDepth, header.LayerCount, header.FaceCount);
+			return false;
+		}
+
+		// Level count 0 asks the loader to generate mips; only level 0 is stored
+		uint32_t levelCount = std::max(header.LevelCount, 1u);
+		if (levelCount > 32 || !InRange(size, sizeof(Header), static_cast<uint64_t>(levelCount) * sizeof(LevelIndex)))
+		{
+			VP_CORE_ERROR("KTX2: '{}' has a corrupt level index", name);
+			return false;
+		}
+
+		// Data Format Descriptor: model and transfer function of the first basic block
+		uint8_t colorModel = 0;
+		bool srgb = false;
+		if (header.DfdByteLength >= 16 && InRange(size, header.DfdByteOffset, header.DfdByteLength))
+		{
+			const uint8_t* block = bytes + header.DfdByteOffset + 4;  // Skip dfdTotalSize
+			colorModel = block[8];
+			srgb = block[10] == DfdTransferSrgb;
+		}
+
+		bool isBasis = header.VkFormat == 0 &&
+			(header.SupercompressionScheme == BasisLZ || colorModel == DfdModelUastc);
+		if (isBasis)
+		{
+			if (cubemap)
+			{
+				VP_CORE_ERROR("KTX2: '{}' is a Basis Universal cubemap, which is not supported", name);
+				return false;
+			}
+#ifdef VP_ENABLE_BASISU
+			return Transcode(bytes, size, srgb, out, name);
+#else
+			(void)srgb;
+			VP_CORE_ERROR("KTX2: '{}' holds Basis Universal data; rebuild with VIZENGINE_BASISU to transcode it", name);
+			return false;
+#endif
+		}
+
+		if (header.SupercompressionScheme != None)
+		{
+			VP_CORE_ERROR("KTX2: '{}' uses unsupported supercompression scheme {}", name, header.SupercompressionScheme);
+			return false;
+		}
+
+		const FormatInfo* format = FindFormat(header.VkFormat);
+		if (!format)
+		{
+			VP_CORE_ERROR("KTX2: '{}' has unsupported VkFormat {}", name, header.VkFormat);
+			return false;
+		}
+
+		out.InternalFormat = format->InternalFormat;
+		out.Format = format->Format;
+		out.Type = format->Type;
+		out.Compressed = format->Compressed;
+		out.Faces = header.FaceCount;
+
+		// Level sizes are computed from the format, so a short level fails
+		// here rather than reading past the data in the driver
+		std::vector<TextureData::Level> levels(levelCount);
+		size_t totalSize = 0;
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			TextureData::Level& entry = levels[level];
+			entry.Width = static_cast<int>(std::max(header.PixelWidth >> level, 1u));
+			entry.Height = static_cast<int>(std::max(header.PixelHeight >> level, 1u));
+			entry.Size = LevelSize(*format, entry.Width, entry.Height) * out.Faces;
+			entry.Offset = totalSize;
+			totalSize += entry.Size;
+		}
+
+		out.Bytes.resize(totalSize);
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			LevelIndex index;
+			std::memcpy(&index, bytes + sizeof(Header) + level * sizeof(LevelIndex), sizeof(LevelIndex));
+			if (index.ByteLength < levels[level].Size || !InRange(size, index.ByteOffset, index.ByteLength))
+			{
+				VP_CORE_ERROR("KTX2: '{}' has a corrupt mip level {}", name, level);
+				out = TextureData();
+				return false;
+			}
+			std::memcpy(out.Bytes.data() + levels[level].Offset, bytes + index.ByteOffset, levels[level].Size);
+		}
+		out.Levels = std::move(levels);
+		return true;
+	}
+
+	//==========================================================================
+	// Writing
+	//==========================================================================
+	template<typename T>
+	static void Append(std::vector<uint8_t>& out, const T& value)
+	{
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+		out.insert(out.end(), bytes, bytes + sizeof(T));
+	}
+
+	// Bytes per channel of uncompressed formats (KTX2 typeSize)
+	static uint32_t ChannelBytes(const FormatInfo& format)
+	{
+		return format.Type == GL_HALF_FLOAT ? 2u : 1u;
+	}
+
+	// One basic Data Format Descriptor block. Block-compressed formats get one
+	// sample per 64 bits of block; uncompressed formats one sample per channel.
+	static void AppendDfd(std::vector<uint8_t>& out, const FormatInfo& format)
+	{
+		static constexpr uint8_t AlphaChannel = 15;
+		static constexpr uint8_t SampleFloat = 0x80;
+		static constexpr uint8_t SampleSigned = 0x40;
+		bool isFloat = format.Type == GL_HALF_FLOAT;
+		uint32_t sampleCount = format.Compressed
+			? (format.DfdModel == DfdModelBc5 ? 2u : 1u)
+			: format.BlockBytes / ChannelBytes(format);
+		uint32_t blockSize = 24 + 16 * sampleCount;
+
+		Append(out, static_cast<uint32_t>(4 + blockSize));      // dfdTotalSize
+		Append(out, static_cast<uint32_t>(0));                  // vendorId = Khronos, descriptorType = basic
+		Append(out, static_cast<uint32_t>(2 | (blockSize << 16)));  // versionNumber, descriptorBlockSize
+		out.push_back(format.DfdModel);
+		out.push_back(1);                                       // BT.709 primaries
+		out.push_back(format.Srgb ? DfdTransferSrgb : DfdTransferLinear);
+		out.push_back(0);                                       // Straight alpha
+		uint8_t blockDimension = format.Compressed ? 3 : 0;     // Size - 1
+		for (uint8_t dimension : { blockDimension, blockDimension, uint8_t(0), uint8_t(0) })
+		{
+			out.push_back(dimension);
+		}
+		for (int plane = 0; plane < 8; plane++)
+		{
+			out.push_back(plane == 0 ? static_cast<uint8_t>(format.BlockBytes) : 0);
+		}
+
+		for (uint32_t sample = 0; sample < sampleCount; sample++)
+		{
+			bool compressedSample = format.Compressed;
+			uint32_t bits = compressedSample ? format.BlockBytes * 8 / sampleCount : ChannelBytes(format) * 8;
+			uint8_t channel = static_cast<uint8_t>(sample);
+			if (!compressedSample && sample == 3)
+			{
+				channel = AlphaChannel;
+			}
+			bool linear = format.Srgb && channel == AlphaChannel;  // Alpha is never sRGB encoded
+			uint8_t qualifiers = (linear ? 0x10 : 0) | (isFloat ? SampleFloat | SampleSigned : 0);
+
+			Append(out, static_cast<uint16_t>(sample * bits));  // bitOffset
+			out.push_back(static_cast<uint8_t>(bits - 1));
+			out.push_back(static_cast<uint8_t>(channel | qualifiers));
+			Append(out, static_cast<uint32_t>(0));              // samplePosition
+			if (isFloat)
+			{
+				Append(out, 0xBF800000u);                       // sampleLower = -1.0f
+				Append(out, 0x3F800000u);                       // sampleUpper = 1.0f
+			}
+			else
+			{
+				Append(out, static_cast<uint32_t>(0));          // sampleLower
+				Append(out, compressedSample ? 0xFFFFFFFFu : 0xFFu);  // sampleUpper
+			}
+		}
+	}
+
+	bool Ktx2::Serialize(const TextureData& data, std::vector<uint8_t>& out)
+	{
+		out.clear();
+		const FormatInfo* format = FindInternalFormat(data.InternalFormat);
+		if (!data.IsValid() || !format || format->DfdModel == 0 || format->Compressed != data.Compressed ||
+			(data.Faces != 1 && data.Faces != 6))
+		{
+			VP_CORE_ERROR("KTX2: cannot write GL format 0x{:X}", data.InternalFormat);
+			return false;
+		}
+
+		uint32_t levelCount = static_cast<uint32_t>(data.Levels.size());
+		Header header = {};
+		std::memcpy(header.Identifier, Identifier, sizeof(Identifier));
+		header.VkFormat = format->VkFormat;
+		header.TypeSize = format->Compressed ? 1 : ChannelBytes(*format);
+		header.PixelWidth = static_cast<uint32_t>(data.GetWidth());
+		header.PixelHeight = static_cast<uint32_t>(data.GetHeight());
+		header.FaceCount = data.Faces;
+		header.LevelCount = levelCount;
+		header.SupercompressionScheme = None;
+
+		std::vector<uint8_t> dfd;
+		AppendDfd(dfd, *format);
+		header.DfdByteOffset = static_cast<uint32_t>(sizeof(Header) + levelCount * sizeof(LevelIndex));
+		header.DfdByteLength = static_cast<uint32_t>(dfd.size());
+
+		// Mip data follows, smallest level first as the specification requires
+		out.resize(header.DfdByteOffset);
+		out.insert(out.end(), dfd.begin(), dfd.end());
+
+		std::vector<LevelIndex> index(levelCount);
+		for (uint32_t level = levelCount; level-- > 0;)
+		{
+			const TextureData::Level& entry = data.Levels[level];
+			if (entry.Offset + entry.Size > data.Bytes.size() ||
+				entry.Size != LevelSize(*format, entry.Width, entry.Height) * data.Faces)
+			{
+				VP_CORE_ERROR("KTX2: mip level {} does not match its format", level);
+				out.clear();
+				return false;
+			}
+
+			out.resize((out.size() + LevelAlignment - 1) / LevelAlignment * LevelAlignment, 0);
+			index[level] = { out.size(), entry.Size, entry.Size };
+			out.insert(out.end(), data.Bytes.begin() + static_cast<std::ptrdiff_t>(entry.Offset),
+				data.Bytes.begin() + static_cast<std::ptrdiff_t>(entry.Offset + entry.Size));
+		}
+
+		std::memcpy(out.data(), &header, sizeof(Header));
+		std::memcpy(out.data() + sizeof(Header), index.data(), index.size() * sizeof(LevelIndex));
+		return true;
+	}
+
+	bool Ktx2::Write(const std::string& path, const TextureData& data)
+	{
+		std::vector<uint8_t> bytes;
+		if (!Serialize(data, bytes))
+		{
+			return false;
+		}
+
+		// Temporary file and rename, so readers never see a torn file
+		std::error_code ec;
+		std::filesystem::path target(path);
+		if (target.has_parent_path())
+		{
+			std::filesystem::create_directories(target.parent_path(), ec);
+		}
+		std::string tempPath = path + ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			if (!file)
+			{
+				VP_CORE_WARN("KTX2: cannot write '{}'", tempPath);
+				return false;
+			}
+		}
+		std::filesystem::rename(tempPath, path, ec);
+		if (ec)
+		{
+			VP_CORE_WARN("KTX2: cannot replace '{}': {}", path, ec.message());
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/TextureData.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * Reader and writer for KTX2 texture containers (https://registry.khronos.org/KTX/specs/2.0/).
+	 *
+	 * Supports 2D textures and cubemaps with a prebuilt mip chain in
+	 * BC1/BC3/BC4/BC5/BC6H/BC7 or common uncompressed formats (RGBA8, RGB8,
+	 * RG8, R8, RGBA16F, RGB16F, RGB9E5, RG11B10F).
+	 * The result is uploaded as stored, level by level: there is no vertical
+	 * flip, so author textures for Texture(path) with a lower-left origin.
+	 *
+	 * Basis Universal payloads (ETC1S / UASTC, as produced by `toktx --encode`
+	 * and used by KHR_texture_basisu) are transcoded to BC1 or BC7 when the
+	 * engine is built with VIZENGINE_BASISU; otherwise they fail to load.
+	 *
+	 * Parsing and transcoding make no GL calls and may run on any thread.
+	 */
+	class VizEngine_API Ktx2
+	{
+	public:
+		/**
+		 * True if the bytes start with the KTX2 file identifier.
+		 */
+		static bool IsKtx2(const uint8_t* bytes, size_t size);
+
+		/**
+		 * True if the path has a .ktx2 extension (case-insensitive).
+		 */
+		static bool IsKtx2Path(const std::string& path);
+
+		/**
+		 * True if Basis Universal payloads can be transcoded (VIZENGINE_BASISU).
+		 */
+		static bool IsTranscoderAvailable();
+
+		/**
+		 * Read a .ktx2 file into `out`.
+		 * @return false (and logs why) if the file is missing, corrupt or unsupported
+		 */
+		static bool Load(const std::string& path, TextureData& out);
+
+		/**
+		 * Parse an in-memory KTX2 container. Level data is copied into `out`.
+		 * @param name Used in log messages
+		 */
+		static bool Parse(const uint8_t* bytes, size_t size, TextureData& out, const std::string& name = "memory");
+
+		/**
+		 * Encode `data` as a KTX2 container (no supercompression). Supports the
+		 * block-compressed, 8-bit and half-float formats Parse reads.
+		 * @return false (and logs why) for other formats
+		 */
+		static bool Serialize(const TextureData& data, std::vector<uint8_t>& out);
+
+		/**
+		 * Serialize `data` to `path`, creating its directory.
+		 */
+		static bool Write(const std::string& path, const TextureData& data);
+	};
+}
@@ -0,0 +1,161 @@
+#include "MappedFile.h"
+
+#include <filesystem>
+
+#ifdef VP_PLATFORM_WINDOWS
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace VizEngine
+{
+	MappedFile::MappedFile(const std::string& path)
+	{
+		Open(path);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: m_Data(other.m_Data), m_Size(other.m_Size)
+#ifdef VP_PLATFORM_WINDOWS
+		, m_File(other.m_File), m_Mapping(other.m_Mapping)
+#endif
+	{
+		other.m_Data = nullptr;
+		other.m_Size = 0;
+#ifdef VP_PLATFORM_WINDOWS
+		other.m_File = nullptr;
+		other.m_Mapping = nullptr;
+#endif
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_Data = other.m_Data;
+			m_Size = other.m_Size;
+			other.m_Data = nullptr;
+			other.m_Size = 0;
+#ifdef VP_PLATFORM_WINDOWS
+			m_File = other.m_File;
+			m_Mapping = other.m_Mapping;
+			other.m_File = nullptr;
+			other.m_Mapping = nullptr;
+#endif
+		}
+		return *this;
+	}
+
+#ifdef VP_PLATFORM_WINDOWS
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+		std::wstring widePath = std::filesystem::path(path).wstring();
+		HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!view)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_File = file;
+		m_Mapping = mapping;
+		m_Data = static_cast<const uint8_t*>(view);
+		m_Size = static_cast<size_t>(fileSize.QuadPart);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+		{
+			UnmapViewOfFile(m_Data);
+		}
+		if (m_Mapping)
+		{
+			CloseHandle(static_cast<HANDLE>(m_Mapping));
+		}
+		if (m_File)
+		{
+			CloseHandle(static_cast<HANDLE>(m_File));
+		}
+		m_Data = nullptr;
+		m_Size = 0;
+		m_File = nullptr;
+		m_Mapping = nullptr;
+	}
+#else
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			return false;
+		}
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size <= 0)
+		{
+			close(fd);
+			return false;
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		// The mapping keeps its own reference to the file
+		close(fd);
+		if (view == MAP_FAILED)
+		{
+			return false;
+		}
+
+		m_Data = static_cast<const uint8_t*>(view);
+		m_Size = static_cast<size_t>(st.st_size);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+		{
+			munmap(const_cast<uint8_t*>(m_Data), m_Size);
+		}
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+#endif
+}
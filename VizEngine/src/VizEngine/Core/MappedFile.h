@@ -0,0 +1,51 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace VizEngine
+{
+	/**
+	 * Read-only memory-mapped file (RAII).
+	 *
+	 * The OS pages the file in on demand, so "loading" a large cache file is
+	 * just a mapping call. Data stays valid until the MappedFile is destroyed.
+	 */
+	class VizEngine_API MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::string& path);
+		~MappedFile();
+
+		// Non-copyable (owns an OS mapping)
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Movable
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/**
+		 * Map a file into memory, closing any previously mapped file.
+		 * @return true if the file is mapped (empty files are not mappable)
+		 */
+		bool Open(const std::string& path);
+		void Close();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		const uint8_t* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+
+#ifdef VP_PLATFORM_WINDOWS
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+#endif
+	};
+}
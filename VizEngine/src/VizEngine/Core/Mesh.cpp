@@ -1,4 +1,5 @@
 #include "Mesh.h"
+#include "VizEngine/Log.h"
 
 namespace VizEngine
 {
@@ -17,19 +18,121 @@ namespace VizEngine
 		SetupMesh(vertexData, vertexDataSize, indices, indexCount);
 	}
 
-	void Mesh::SetupMesh(const float* vertexData, size_t vertexDataSize, const unsigned int* indices, size_t indexCount)
+	Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const VertexPackingOptions& packing)
+	{
+		std::vector<PackedVertex> packed(vertices.size());
+		m_Format = VertexFormat::Pack(vertices.data(), vertices.size(), packing, packed.data());
+		SetupMesh(packed.data(), packed.size() * sizeof(PackedVertex), indices.data(), indices.size());
+	}
+
+	Mesh::Mesh(const PackedVertex* vertices, size_t vertexCount, const VertexFormat& format, const unsigned int* indices, size_t indexCount)
+		: m_Format(format)
+	{
+		m_Format.Packed = true;
+		SetupMesh(vertices, vertexCount * sizeof(PackedVertex), indices, indexCount);
+	}
+
+	void Mesh::SetupMesh(const void* vertexData, size_t vertexDataSize, const unsigned int* indices, size_t indexCount)
 	{
 		m_VertexArray = std::make_unique<VertexArray>();
 		m_VertexBuffer = std::make_unique<VertexBuffer>(vertexData, static_cast<unsigned int>(vertexDataSize));
 
+		// Attribute locations are the same for both formats, only the encoding differs
 		VertexBufferLayout layout;
-		layout.Push<float>(4); // Position (vec4)
-		layout.Push<float>(3); // Normal (vec3)
-		layout.Push<float>(4); // Color (vec4)
-		layout.Push<float>(2); // TexCoords (vec2)
+		if (m_Format.Packed)
+		{
+			if (m_Format.Position == PositionPrecision::Half)
+				layout.Push<HalfFloat>(4);        // Position (xyz relative to bounds, w unused)
+			else
+				layout.Push<unsigned short>(4);   // Position (unorm16 relative to bounds, w unused)
+
+			if (m_Format.Normal == NormalEncoding::Octahedral)
+				layout.Push<short>(2);            // Normal (octahedral snorm16)
+			else
+				layout.Push<Int2_10_10_10>(4);    // Normal (snorm 10:10:10)
+
+			layout.Push<unsigned char>(4);        // Color (unorm8)
+			layout.Push<HalfFloat>(2);            // TexCoords (half)
+		}
+		else
+		{
+			layout.Push<float>(4); // Position (vec4)
+			layout.Push<float>(3); // Normal (vec3)
+			layout.Push<float>(4); // Color (vec4)
+			layout.Push<float>(2); // TexCoords (vec2)
+		}
 
 		m_VertexArray->LinkVertexBuffer(*m_VertexBuffer, layout);
 		m_IndexBuffer = std::make_unique<IndexBuffer>(indices, static_cast<unsigned int>(indexCount));
+		m_Lods = { MeshLod{ 0, static_cast<uint32_t>(indexCount), 0.0f } };
+
+		// Bounds: packed formats already store them, float vertices are scanned
+		if (m_Format.Packed)
+		{
+			if (m_Format.Position == PositionPrecision::Half)
+			{
+				m_BoundsMin = m_Format.PositionOffset - m_Format.PositionScale;
+				m_BoundsMax = m_Format.PositionOffset + m_Format.PositionScale;
+			}
+			else
+			{
+				m_BoundsMin = m_Format.PositionOffset;
+				m_BoundsMax = m_Format.PositionOffset + m_Format.PositionScale;
+			}
+		}
+		else
+		{
+			const Vertex* vertices = static_cast<const Vertex*>(vertexData);
+			size_t vertexCount = vertexDataSize / sizeof(Vertex);
+			if (vertexCount > 0)
+			{
+				m_BoundsMin = m_BoundsMax = glm::vec3(vertices[0].Position);
+			}
+			for (size_t i = 1; i < vertexCount; i++)
+			{
+				m_BoundsMin = glm::min(m_BoundsMin, glm::vec3(vertices[i].Position));
+				m_BoundsMax = glm::max(m_BoundsMax, glm::vec3(vertices[i].Position));
+			}
+		}
+	}
+
+	bool Mesh::SetLods(std::vector<MeshLod> lods)
+	{
+		unsigned int indexCount = m_IndexBuffer->GetCount();
+		bool valid = !lods.empty() && std::all_of(lods.begin(), lods.end(), [indexCount](const MeshLod& lod)
+		{
+			return lod.IndexCount > 0 && lod.IndexCount % 3 == 0 &&
+				static_cast<uint64_t>(lod.FirstIndex) + lod.IndexCount <= indexCount;
+		});
+		if (!valid)
+		{
+			VP_CORE_WARN("Mesh: ignoring {} LOD ranges outside the index buffer ({} indices)", lods.size(), indexCount);
+			return false;
+		}
+
+		m_Lods = std::move(lods);
+		return true;
+	}
+
+	bool Mesh::SetMeshlets(std::vector<Meshlet> meshlets)
+	{
+		unsigned int indexCount = m_IndexBuffer->GetCount();
+		bool valid = std::all_of(meshlets.begin(), meshlets.end(), [indexCount](const Meshlet& meshlet)
+		{
+			return static_cast<uint64_t>(meshlet.FirstIndex) + meshlet.IndexCount <= indexCount;
+		});
+		valid = valid && std::all_of(m_Lods.begin(), m_Lods.end(), [&meshlets](const MeshLod& lod)
+		{
+			return static_cast<uint64_t>(lod.FirstMeshlet) + lod.MeshletCount <= meshlets.size();
+		});
+		if (!valid)
+		{
+			VP_CORE_WARN("Mesh: ignoring {} meshlets that don't match the index buffer or LODs", meshlets.size());
+			return false;
+		}
+
+		m_Meshlets = std::move(meshlets);
+		return true;
 	}
 
 	void Mesh::Bind() const
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "VizEngine/Core.h"
+#include "VizEngine/Core/VertexFormat.h"
+#include "VizEngine/Core/Meshlet.h"
 #include "glm.hpp"
 #include "VizEngine/OpenGL/VertexArray.h"
 #include "VizEngine/OpenGL/VertexBuffer.h"
 #include "VizEngine/OpenGL/IndexBuffer.h"
 #include "VizEngine/OpenGL/VertexBufferLayout.h"
+#include <algorithm>
 #include <vector>
 #include <memory>
 
@@ -30,11 +33,30 @@ namespace VizEngine
 			: Position(pos), Normal(0.0f, 1.0f, 0.0f), Color(col), TexCoords(tex) {}
 	};
 
+	/**
+	 * One level of detail: a range of the mesh's index buffer.
+	 * All levels share the vertex buffer.
+	 */
+	struct MeshLod
+	{
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;
+		float Error = 0.0f;  // Geometric error relative to the mesh's largest extent
+		uint32_t FirstMeshlet = 0;  // Meshlets covering this range (0 = drawn whole)
+		uint32_t MeshletCount = 0;
+	};
+
 	class VizEngine_API Mesh
 	{
 	public:
 		Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
 		Mesh(const float* vertexData, size_t vertexDataSize, const unsigned int* indices, size_t indexCount);
+
+		// Packs the vertices into the compact PackedVertex format before upload
+		Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const VertexPackingOptions& packing);
+
+		// Upload already packed vertices (e.g. from the mesh cache)
+		Mesh(const PackedVertex* vertices, size_t vertexCount, const VertexFormat& format, const unsigned int* indices, size_t indexCount);
 		~Mesh() = default;
 
 		// Prevent copying
@@ -48,9 +70,32 @@ namespace VizEngine
 		void Bind() const;
 		void Unbind() const;
 
-		unsigned int GetIndexCount() const { return m_IndexBuffer->GetCount(); }
+		/**
+		 * Replace the LOD ranges (LOD 0 first, each coarser than the last).
+		 * Ranges outside the index buffer are rejected.
+		 * @return false if the LODs were rejected
+		 */
+		bool SetLods(std::vector<MeshLod> lods);
+		size_t GetLodCount() const { return m_Lods.size(); }
+		const MeshLod& GetLod(size_t level) const { return m_Lods[std::min(level, m_Lods.size() - 1)]; }
+
+		/**
+		 * Replace the meshlets. Each LOD references its meshlets through
+		 * MeshLod::FirstMeshlet / MeshletCount, so set the LODs first.
+		 * @return false if a meshlet or LOD reference is out of range
+		 */
+		bool SetMeshlets(std::vector<Meshlet> meshlets);
+		const std::vector<Meshlet>& GetMeshlets() const { return m_Meshlets; }
+
+		// Object space bounds
+		const glm::vec3& GetBoundsMin() const { return m_BoundsMin; }
+		const glm::vec3& GetBoundsMax() const { return m_BoundsMax; }
+
+		// Index count of LOD 0
+		unsigned int GetIndexCount() const { return m_Lods[0].IndexCount; }
 		const VertexArray& GetVertexArray() const { return *m_VertexArray; }
 		const IndexBuffer& GetIndexBuffer() const { return *m_IndexBuffer; }
+		const VertexFormat& GetVertexFormat() const { return m_Format; }
 
 		// Factory methods for common shapes
 		static std::unique_ptr<Mesh> CreatePyramid();
@@ -58,11 +103,16 @@ namespace VizEngine
 		static std::unique_ptr<Mesh> CreatePlane(float size = 1.0f);
 
 	private:
-		void SetupMesh(const float* vertexData, size_t vertexDataSize, const unsigned int* indices, size_t indexCount);
+		void SetupMesh(const void* vertexData, size_t vertexDataSize, const unsigned int* indices, size_t indexCount);
 
 		std::unique_ptr<VertexArray> m_VertexArray;
 		std::unique_ptr<VertexBuffer> m_VertexBuffer;
 		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		VertexFormat m_Format;
+		std::vector<MeshLod> m_Lods;
+		std::vector<Meshlet> m_Meshlets;
+		glm::vec3 m_BoundsMin = glm::vec3(0.0f);
+		glm::vec3 m_BoundsMax = glm::vec3(0.0f);
 	};
 }
 
@@ -0,0 +1,508 @@
+#include "MeshCache.h"
+#include "VizEngine/Core/Hash.h"
+#include "VizEngine/Log.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+namespace VizEngine
+{
+	//==========================================================================
+	// On-disk layout
+	//==========================================================================
+	// [Header][MeshRecord * N][MaterialRecord * N][ImageRecord * N]
+	// [DependencyRecord * N][String table][Blobs (16-byte aligned)]
+	//
+	// All offsets are absolute byte offsets from the start of the file.
+	// Bump CacheVersion whenever any record or blob layout changes.
+
+	static constexpr char CacheMagic[4] = { 'V', 'P', 'M', 'C' };
+	static constexpr uint32_t CacheVersion = 6;
+	static constexpr size_t BlobAlignment = 16;
+
+	struct CacheHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t PathHash;
+		uint64_t SourceHash;
+		uint64_t SourceSize;
+		uint64_t OptionsHash;
+		uint32_t VertexStride;
+		uint32_t MeshCount;
+		uint32_t MaterialCount;
+		uint32_t ImageCount;
+		uint32_t DependencyCount;
+		uint32_t Reserved;
+		uint64_t StringTableOffset;
+		uint64_t StringTableSize;
+	};
+
+	struct MeshRecord
+	{
+		uint64_t VertexOffset;
+		uint64_t IndexOffset;
+		uint32_t VertexCount;
+		uint32_t IndexCount;
+		uint32_t MaterialIndex;
+		uint32_t Packed;             // 0 = Vertex, 1 = PackedVertex
+		uint32_t PositionPrecision;  // PositionPrecision (packed only)
+		uint32_t NormalEncoding;     // NormalEncoding (packed only)
+		float PositionScale[3];
+		float PositionOffset[3];
+		uint64_t LodOffset;          // MeshLod * LodCount
+		uint64_t MeshletOffset;      // Meshlet * MeshletCount
+		uint32_t LodCount;           // 0 = single level
+		uint32_t MeshletCount;
+	};
+
+	struct MaterialRecord
+	{
+		float BaseColor[4];
+		float EmissiveFactor[3];
+		float Metallic;
+		float Roughness;
+		float AlphaCutoff;
+		uint32_t AlphaMode;
+		uint32_t DoubleSided;
+		int32_t Images[MeshCacheMaterial::SlotCount];
+		uint32_t NameOffset;
+		uint32_t NameLength;
+		uint32_t Reserved;
+	};
+
+	struct ImageRecord
+	{
+		uint64_t PixelOffset;
+		uint64_t PixelBytes;
+		int32_t Width;
+		int32_t Height;
+		int32_t Channels;
+		uint32_t UriOffset;
+		uint32_t UriLength;
+		uint32_t Reserved;
+	};
+
+	struct DependencyRecord
+	{
+		uint64_t Hash;
+		uint64_t Size;
+		uint32_t PathOffset;
+		uint32_t PathLength;
+	};
+
+	static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex must be trivially copyable to be cached");
+	static_assert(std::is_trivially_copyable_v<PackedVertex>, "PackedVertex must be trivially copyable to be cached");
+	static_assert(std::is_trivially_copyable_v<MeshLod>, "MeshLod must be trivially copyable to be cached");
+	static_assert(std::is_trivially_copyable_v<Meshlet>, "Meshlet must be trivially copyable to be cached");
+
+	//==========================================================================
+	// Helpers
+	//==========================================================================
+	static uint64_t HashPath(const std::string& path)
+	{
+		std::error_code ec;
+		std::filesystem::path absolute = std::filesystem::weakly_canonical(path, ec);
+		std::string normalized = ec ? path : absolute.generic_string();
+		return Hash::FNV1a(normalized);
+	}
+
+	// Content hash + size of a file on disk
+	static bool HashFile(const std::string& path, uint64_t& outHash, uint64_t& outSize)
+	{
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			return false;
+		}
+		outHash = Hash::Bytes(file.GetData(), file.GetSize());
+		outSize = file.GetSize();
+		return true;
+	}
+
+	static size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	// Appends raw bytes to a growing byte buffer, returns the offset written at
+	static uint64_t AppendBlob(std::vector<uint8_t>& out, const void* data, size_t size)
+	{
+		size_t offset = AlignUp(out.size(), BlobAlignment);
+		out.resize(offset + size);
+		if (size > 0)
+		{
+			std::memcpy(out.data() + offset, data, size);
+		}
+		return offset;
+	}
+
+	template<typename T>
+	static void WriteRecord(std::vector<uint8_t>& out, size_t offset, const T& record)
+	{
+		std::memcpy(out.data() + offset, &record, sizeof(T));
+	}
+
+	template<typename T>
+	static const T* ReadRecords(const MappedFile& file, uint64_t offset, uint64_t count)
+	{
+		if (offset > file.GetSize() || count > (file.GetSize() - offset) / sizeof(T))
+		{
+			return nullptr;
+		}
+		return reinterpret_cast<const T*>(file.GetData() + offset);
+	}
+
+	static bool InRange(const MappedFile& file, uint64_t offset, uint64_t size)
+	{
+		return offset <= file.GetSize() && size <= file.GetSize() - offset;
+	}
+
+	//==========================================================================
+	// MeshCache
+	//==========================================================================
+	std::string MeshCache::GetCachePath(const std::string& sourcePath, const std::string& cacheDirectory)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.vpmesh", static_cast<unsigned long long>(HashPath(sourcePath)));
+		return (std::filesystem::path(cacheDirectory) / name).string();
+	}
+
+	bool MeshCache::Write(const std::string& sourcePath, const std::string& cacheDirectory, const MeshCacheData& data)
+	{
+		CacheHeader header = {};
+		std::memcpy(header.Magic, CacheMagic, sizeof(CacheMagic));
+		header.Version = CacheVersion;
+		header.PathHash = HashPath(sourcePath);
+		header.OptionsHash = data.OptionsHash;
+		header.VertexStride = sizeof(Vertex);
+		header.MeshCount = static_cast<uint32_t>(data.Meshes.size());
+		header.MaterialCount = static_cast<uint32_t>(data.Materials.size());
+		header.ImageCount = static_cast<uint32_t>(data.Images.size());
+		header.DependencyCount = static_cast<uint32_t>(data.Dependencies.size());
+
+		if (!HashFile(sourcePath, header.SourceHash, header.SourceSize))
+		{
+			VP_CORE_WARN("Mesh cache: cannot hash source '{}', not caching", sourcePath);
+			return false;
+		}
+
+		// Record tables follow the header back to back
+		size_t meshTable = sizeof(CacheHeader);
+		size_t materialTable = meshTable + data.Meshes.size() * sizeof(MeshRecord);
+		size_t imageTable = materialTable + data.Materials.size() * sizeof(MaterialRecord);
+		size_t dependencyTable = imageTable + data.Images.size() * sizeof(ImageRecord);
+		size_t tablesEnd = dependencyTable + data.Dependencies.size() * sizeof(DependencyRecord);
+
+		// String table (material names, image URIs, dependency paths)
+		std::string strings;
+		auto addString = [&strings](const std::string& str, uint32_t& offset, uint32_t& length)
+		{
+			offset = static_cast<uint32_t>(strings.size());
+			length = static_cast<uint32_t>(str.size());
+			strings += str;
+		};
+
+		std::vector<MaterialRecord> materials(data.Materials.size());
+		for (size_t i = 0; i < data.Materials.size(); i++)
+		{
+			const PBRMaterial& src = data.Materials[i].Material;
+			MaterialRecord& rec = materials[i];
+			rec = {};
+			for (int c = 0; c < 4; c++) rec.BaseColor[c] = src.BaseColor[c];
+			for (int c = 0; c < 3; c++) rec.EmissiveFactor[c] = src.EmissiveFactor[c];
+			rec.Metallic = src.Metallic;
+			rec.Roughness = src.Roughness;
+			rec.AlphaCutoff = src.AlphaCutoff;
+			rec.AlphaMode = static_cast<uint32_t>(src.Alpha);
+			rec.DoubleSided = src.DoubleSided ? 1u : 0u;
+			for (int s = 0; s < MeshCacheMaterial::SlotCount; s++) rec.Images[s] = data.Materials[i].Images[s];
+			addString(src.Name, rec.NameOffset, rec.NameLength);
+		}
+
+		std::vector<ImageRecord> images(data.Images.size());
+		for (size_t i = 0; i < data.Images.size(); i++)
+		{
+			images[i] = {};
+			addString(data.Images[i].Uri, images[i].UriOffset, images[i].UriLength);
+		}
+
+		std::vector<DependencyRecord> dependencies(data.Dependencies.size());
+		for (size_t i = 0; i < data.Dependencies.size(); i++)
+		{
+			DependencyRecord& rec = dependencies[i];
+			rec = {};
+			if (!HashFile(data.Dependencies[i], rec.Hash, rec.Size))
+			{
+				VP_CORE_WARN("Mesh cache: cannot hash dependency '{}', not caching", data.Dependencies[i]);
+				return false;
+			}
+			addString(data.Dependencies[i], rec.PathOffset, rec.PathLength);
+		}
+
+		// Assemble the file in memory, then write it in one go
+		std::vector<uint8_t> out(tablesEnd);
+		header.StringTableOffset = AppendBlob(out, strings.data(), strings.size());
+		header.StringTableSize = strings.size();
+
+		for (size_t i = 0; i < data.Meshes.size(); i++)
+		{
+			const MeshCacheMesh& mesh = data.Meshes[i];
+			MeshRecord rec = {};
+			rec.VertexCount = mesh.VertexCount;
+			rec.IndexCount = mesh.IndexCount;
+			rec.MaterialIndex = mesh.MaterialIndex;
+			rec.Packed = mesh.Format.Packed ? 1u : 0u;
+			rec.PositionPrecision = static_cast<uint32_t>(mesh.Format.Position);
+			rec.NormalEncoding = static_cast<uint32_t>(mesh.Format.Normal);
+			for (int c = 0; c < 3; c++)
+			{
+				rec.PositionScale[c] = mesh.Format.PositionScale[c];
+				rec.PositionOffset[c] = mesh.Format.PositionOffset[c];
+			}
+			const void* vertices = mesh.Format.Packed ? static_cast<const void*>(mesh.PackedVertices) : mesh.Vertices;
+			rec.VertexOffset = AppendBlob(out, vertices, size_t(mesh.VertexCount) * mesh.Format.GetStride());
+			rec.IndexOffset = AppendBlob(out, mesh.Indices, size_t(mesh.IndexCount) * sizeof(unsigned int));
+			if (mesh.LodCount > 0)
+			{
+				rec.LodCount = mesh.LodCount;
+				rec.LodOffset = AppendBlob(out, mesh.Lods, size_t(mesh.LodCount) * sizeof(MeshLod));
+			}
+			if (mesh.MeshletCount > 0)
+			{
+				rec.MeshletCount = mesh.MeshletCount;
+				rec.MeshletOffset = AppendBlob(out, mesh.Meshlets, size_t(mesh.MeshletCount) * sizeof(Meshlet));
+			}
+			WriteRecord(out, meshTable + i * sizeof(MeshRecord), rec);
+		}
+
+		for (size_t i = 0; i < data.Images.size(); i++)
+		{
+			const MeshCacheImage& image = data.Images[i];
+			images[i].Width = image.Width;
+			images[i].Height = image.Height;
+			images[i].Channels = image.Channels;
+			images[i].PixelBytes = image.PixelBytes;
+			images[i].PixelOffset = AppendBlob(out, image.Pixels, image.PixelBytes);
+			WriteRecord(out, imageTable + i * sizeof(ImageRecord), images[i]);
+		}
+
+		for (size_t i = 0; i < materials.size(); i++)
+		{
+			WriteRecord(out, materialTable + i * sizeof(MaterialRecord), materials[i]);
+		}
+		for (size_t i = 0; i < dependencies.size(); i++)
+		{
+			WriteRecord(out, dependencyTable + i * sizeof(DependencyRecord), dependencies[i]);
+		}
+		WriteRecord(out, 0, header);
+
+		// Write to a temporary file and rename, so a crash never leaves a torn cache entry
+		std::error_code ec;
+		std::filesystem::create_directories(cacheDirectory, ec);
+		std::string cachePath = GetCachePath(sourcePath, cacheDirectory);
+		std::string tempPath = cachePath + ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				VP_CORE_WARN("Mesh cache: cannot write '{}'", tempPath);
+				return false;
+			}
+			file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+			if (!file)
+			{
+				VP_CORE_WARN("Mesh cache: write failed for '{}'", tempPath);
+				return false;
+			}
+		}
+		std::filesystem::rename(tempPath, cachePath, ec);
+		if (ec)
+		{
+			VP_CORE_WARN("Mesh cache: cannot replace '{}': {}", cachePath, ec.message());
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+
+		VP_CORE_TRACE("Mesh cache written: {} ({} bytes)", cachePath, out.size());
+		return true;
+	}
+
+	bool MeshCache::Read(const std::string& sourcePath, const std::string& cacheDirectory, MappedFile& file, MeshCacheData& out)
+	{
+		std::string cachePath = GetCachePath(sourcePath, cacheDirectory);
+		if (!file.Open(cachePath))
+		{
+			return false;
+		}
+
+		const CacheHeader* header = ReadRecords<CacheHeader>(file, 0, 1);
+		if (!header || std::memcmp(header->Magic, CacheMagic, sizeof(CacheMagic)) != 0)
+		{
+			VP_CORE_WARN("Mesh cache: '{}' is not a cache file", cachePath);
+			file.Close();
+			return false;
+		}
+		if (header->Version != CacheVersion || header->VertexStride != sizeof(Vertex) ||
+			header->PathHash != HashPath(sourcePath))
+		{
+			VP_CORE_TRACE("Mesh cache: '{}' was written by a different version", cachePath);
+			file.Close();
+			return false;
+		}
+
+		uint64_t sourceHash = 0, sourceSize = 0;
+		if (!HashFile(sourcePath, sourceHash, sourceSize) ||
+			sourceHash != header->SourceHash || sourceSize != header->SourceSize)
+		{
+			VP_CORE_TRACE("Mesh cache: '{}' is stale", cachePath);
+			file.Close();
+			return false;
+		}
+
+		uint64_t meshTable = sizeof(CacheHeader);
+		uint64_t materialTable = meshTable + uint64_t(header->MeshCount) * sizeof(MeshRecord);
+		uint64_t imageTable = materialTable + uint64_t(header->MaterialCount) * sizeof(MaterialRecord);
+		uint64_t dependencyTable = imageTable + uint64_t(header->ImageCount) * sizeof(ImageRecord);
+
+		const MeshRecord* meshes = ReadRecords<MeshRecord>(file, meshTable, header->MeshCount);
+		const MaterialRecord* materials = ReadRecords<MaterialRecord>(file, materialTable, header->MaterialCount);
+		const ImageRecord* images = ReadRecords<ImageRecord>(file, imageTable, header->ImageCount);
+		const DependencyRecord* dependencies = ReadRecords<DependencyRecord>(file, dependencyTable, header->DependencyCount);
+		if (!meshes || !materials || !images || !dependencies ||
+			!InRange(file, header->StringTableOffset, header->StringTableSize))
+		{
+			VP_CORE_WARN("Mesh cache: '{}' is truncated", cachePath);
+			file.Close();
+			return false;
+		}
+
+		const char* strings = reinterpret_cast<const char*>(file.GetData() + header->StringTableOffset);
+		bool stringsValid = true;
+		auto getString = [&](uint32_t offset, uint32_t length) -> std::string
+		{
+			if (uint64_t(offset) + length > header->StringTableSize)
+			{
+				stringsValid = false;
+				return {};
+			}
+			return std::string(strings + offset, length);
+		};
+
+		// Dependencies first: a stale .bin or texture invalidates the whole entry
+		out = MeshCacheData{};
+		out.OptionsHash = header->OptionsHash;
+		for (uint32_t i = 0; i < header->DependencyCount; i++)
+		{
+			std::string path = getString(dependencies[i].PathOffset, dependencies[i].PathLength);
+			uint64_t hash = 0, size = 0;
+			if (!stringsValid || !HashFile(path, hash, size) ||
+				hash != dependencies[i].Hash || size != dependencies[i].Size)
+			{
+				VP_CORE_TRACE("Mesh cache: dependency '{}' changed", path);
+				file.Close();
+				return false;
+			}
+			out.Dependencies.push_back(std::move(path));
+		}
+
+		out.Meshes.reserve(header->MeshCount);
+		for (uint32_t i = 0; i < header->MeshCount; i++)
+		{
+			const MeshRecord& rec = meshes[i];
+
+			MeshCacheMesh mesh;
+			mesh.Format.Packed = rec.Packed != 0;
+			mesh.Format.Position = static_cast<PositionPrecision>(rec.PositionPrecision);
+			mesh.Format.Normal = static_cast<NormalEncoding>(rec.NormalEncoding);
+			mesh.Format.PositionScale = glm::vec3(rec.PositionScale[0], rec.PositionScale[1], rec.PositionScale[2]);
+			mesh.Format.PositionOffset = glm::vec3(rec.PositionOffset[0], rec.PositionOffset[1], rec.PositionOffset[2]);
+
+			if (rec.Packed > 1 || rec.PositionPrecision > 1 || rec.NormalEncoding > 1 ||
+				!InRange(file, rec.VertexOffset, uint64_t(rec.VertexCount) * mesh.Format.GetStride()) ||
+				!InRange(file, rec.IndexOffset, uint64_t(rec.IndexCount) * sizeof(unsigned int)) ||
+				!InRange(file, rec.LodOffset, uint64_t(rec.LodCount) * sizeof(MeshLod)) ||
+				!InRange(file, rec.MeshletOffset, uint64_t(rec.MeshletCount) * sizeof(Meshlet)))
+			{
+				VP_CORE_WARN("Mesh cache: '{}' has corrupt mesh records", cachePath);
+				file.Close();
+				return false;
+			}
+
+			if (mesh.Format.Packed)
+				mesh.PackedVertices = reinterpret_cast<const PackedVertex*>(file.GetData() + rec.VertexOffset);
+			else
+				mesh.Vertices = reinterpret_cast<const Vertex*>(file.GetData() + rec.VertexOffset);
+			mesh.VertexCount = rec.VertexCount;
+			mesh.Indices = reinterpret_cast<const unsigned int*>(file.GetData() + rec.IndexOffset);
+			mesh.IndexCount = rec.IndexCount;
+			if (rec.LodCount > 0)
+			{
+				mesh.Lods = reinterpret_cast<const MeshLod*>(file.GetData() + rec.LodOffset);
+				mesh.LodCount = rec.LodCount;
+			}
+			if (rec.MeshletCount > 0)
+			{
+				mesh.Meshlets = reinterpret_cast<const Meshlet*>(file.GetData() + rec.MeshletOffset);
+				mesh.MeshletCount = rec.MeshletCount;
+			}
+			mesh.MaterialIndex = rec.MaterialIndex;
+			out.Meshes.push_back(mesh);
+		}
+
+		out.Materials.reserve(header->MaterialCount);
+		for (uint32_t i = 0; i < header->MaterialCount; i++)
+		{
+			const MaterialRecord& rec = materials[i];
+			MeshCacheMaterial entry;
+			PBRMaterial& material = entry.Material;
+			material.Name = getString(rec.NameOffset, rec.NameLength);
+			material.BaseColor = glm::vec4(rec.BaseColor[0], rec.BaseColor[1], rec.BaseColor[2], rec.BaseColor[3]);
+			material.EmissiveFactor = glm::vec3(rec.EmissiveFactor[0], rec.EmissiveFactor[1], rec.EmissiveFactor[2]);
+			material.Metallic = rec.Metallic;
+			material.Roughness = rec.Roughness;
+			material.AlphaCutoff = rec.AlphaCutoff;
+			material.Alpha = static_cast<PBRMaterial::AlphaMode>(rec.AlphaMode);
+			material.DoubleSided = rec.DoubleSided != 0;
+			for (int s = 0; s < MeshCacheMaterial::SlotCount; s++)
+			{
+				entry.Images[s] = (rec.Images[s] >= 0 && static_cast<uint32_t>(rec.Images[s]) < header->ImageCount)
+					? rec.Images[s] : -1;
+			}
+			out.Materials.push_back(std::move(entry));
+		}
+
+		out.Images.reserve(header->ImageCount);
+		for (uint32_t i = 0; i < header->ImageCount; i++)
+		{
+			const ImageRecord& rec = images[i];
+			if (!InRange(file, rec.PixelOffset, rec.PixelBytes))
+			{
+				VP_CORE_WARN("Mesh cache: '{}' has corrupt image records", cachePath);
+				file.Close();
+				return false;
+			}
+
+			MeshCacheImage image;
+			image.Pixels = rec.PixelBytes > 0 ? file.GetData() + rec.PixelOffset : nullptr;
+			image.PixelBytes = rec.PixelBytes;
+			image.Width = rec.Width;
+			image.Height = rec.Height;
+			image.Channels = rec.Channels;
+			image.Uri = getString(rec.UriOffset, rec.UriLength);
+			out.Images.push_back(std::move(image));
+		}
+
+		if (!stringsValid)
+		{
+			VP_CORE_WARN("Mesh cache: '{}' has a corrupt string table", cachePath);
+			file.Close();
+			return false;
+		}
+
+		return true;
+	}
+}
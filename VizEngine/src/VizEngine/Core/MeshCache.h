@@ -0,0 +1,106 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/Mesh.h"
+#include "VizEngine/Core/Material.h"
+#include "VizEngine/Core/MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * One mesh as stored in the cache: converted vertices and indices, ready for upload.
+	 * Pointers reference either the loader's vectors (when writing) or the
+	 * mapped cache file (when reading) - no copies are made.
+	 * Exactly one of Vertices / PackedVertices is set, matching Format.Packed.
+	 */
+	struct MeshCacheMesh
+	{
+		const Vertex* Vertices = nullptr;
+		const PackedVertex* PackedVertices = nullptr;
+		VertexFormat Format;
+		uint32_t VertexCount = 0;
+		const unsigned int* Indices = nullptr;
+		uint32_t IndexCount = 0;
+		const MeshLod* Lods = nullptr;  // Ranges of Indices, LOD 0 first (none = single level)
+		uint32_t LodCount = 0;
+		const Meshlet* Meshlets = nullptr;  // Referenced by MeshLod::FirstMeshlet / MeshletCount
+		uint32_t MeshletCount = 0;
+		uint32_t MaterialIndex = 0;
+	};
+
+	/**
+	 * Material table entry. Texture pointers inside Material are ignored;
+	 * textures are referenced by index into the image table (-1 = none).
+	 */
+	struct MeshCacheMaterial
+	{
+		enum Slot { BaseColor = 0, MetallicRoughness, Normal, Occlusion, Emissive, SlotCount };
+
+		PBRMaterial Material;
+		int32_t Images[SlotCount] = { -1, -1, -1, -1, -1 };
+	};
+
+	/**
+	 * Image table entry. Embedded images are stored decoded (Pixels),
+	 * external images are stored by URI relative to the model directory.
+	 * Embedded KTX2 images are stored as the container, with Channels = 0.
+	 */
+	struct MeshCacheImage
+	{
+		const uint8_t* Pixels = nullptr;
+		size_t PixelBytes = 0;
+		int Width = 0;
+		int Height = 0;
+		int Channels = 0;
+		std::string Uri;
+	};
+
+	struct MeshCacheData
+	{
+		std::vector<MeshCacheMesh> Meshes;
+		std::vector<MeshCacheMaterial> Materials;
+		std::vector<MeshCacheImage> Images;
+
+		// External files the source model references (.bin buffers, image files).
+		// Their content hashes are part of the staleness check.
+		std::vector<std::string> Dependencies;
+
+		// Hash of the import options the data was converted with (packing,
+		// optimization, ...). The loader rebuilds entries whose hash differs.
+		uint64_t OptionsHash = 0;
+	};
+
+	/**
+	 * Binary, memory-mappable cache for converted model data.
+	 *
+	 * Cache files are named after a hash of the source path and store a hash of
+	 * the source file contents (and of every dependency). A warm load maps the
+	 * file and hands pointers straight to the GL upload; any mismatch makes the
+	 * entry stale and the caller falls back to parsing the glTF.
+	 */
+	class VizEngine_API MeshCache
+	{
+	public:
+		/**
+		 * Cache file path for a source model.
+		 */
+		static std::string GetCachePath(const std::string& sourcePath, const std::string& cacheDirectory);
+
+		/**
+		 * Write the converted data for sourcePath.
+		 * @return true if the cache file was written
+		 */
+		static bool Write(const std::string& sourcePath, const std::string& cacheDirectory, const MeshCacheData& data);
+
+		/**
+		 * Map and validate the cache entry for sourcePath.
+		 * On success, `out` references memory owned by `file`, so keep `file`
+		 * alive for as long as `out` is used.
+		 * @return false if the entry is missing, corrupt or stale
+		 */
+		static bool Read(const std::string& sourcePath, const std::string& cacheDirectory, MappedFile& file, MeshCacheData& out);
+	};
+}
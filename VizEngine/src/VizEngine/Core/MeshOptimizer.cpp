@@ -0,0 +1,440 @@
+#include "MeshOptimizer.h"
+#include "VizEngine/Core/Hash.h"
+#include "VizEngine/Core/Mesh.h"
+#include "VizEngine/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace VizEngine
+{
+	static constexpr unsigned int InvalidIndex = ~0u;
+
+	static bool IndicesInRange(const std::vector<unsigned int>& indices, size_t vertexCount)
+	{
+		for (unsigned int index : indices)
+		{
+			if (index >= vertexCount)
+			{
+				VP_CORE_WARN("Mesh optimizer: index {} out of range ({} vertices), skipping", index, vertexCount);
+				return false;
+			}
+		}
+		return indices.size() % 3 == 0;
+	}
+
+	// FIFO cache simulation: a vertex is cached if fewer than cacheSize misses
+	// happened since it was loaded. Returns the number of misses for the triangle.
+	static unsigned int UpdateCache(const unsigned int* triangle, unsigned int cacheSize,
+		std::vector<unsigned int>& timestamps, unsigned int& timestamp)
+	{
+		unsigned int misses = 0;
+		for (int k = 0; k < 3; k++)
+		{
+			unsigned int v = triangle[k];
+			if (timestamp - timestamps[v] > cacheSize)
+			{
+				timestamps[v] = timestamp++;
+				misses++;
+			}
+		}
+		return misses;
+	}
+
+	//==========================================================================
+	// Analysis
+	//==========================================================================
+	VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount,
+		unsigned int cacheSize)
+	{
+		VertexCacheStats stats;
+		std::vector<unsigned int> timestamps(vertexCount, 0);
+		std::vector<bool> referenced(vertexCount, false);
+		unsigned int timestamp = cacheSize + 1;
+
+		for (size_t i = 0; i + 2 < indexCount; i += 3)
+		{
+			if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount)
+			{
+				continue;
+			}
+			stats.Misses += UpdateCache(indices + i, cacheSize, timestamps, timestamp);
+			stats.Triangles++;
+			for (int k = 0; k < 3; k++)
+			{
+				if (!referenced[indices[i + k]])
+				{
+					referenced[indices[i + k]] = true;
+					stats.Vertices++;
+				}
+			}
+		}
+		return stats;
+	}
+
+	//==========================================================================
+	// Passes
+	//==========================================================================
+	void MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, float overdrawThreshold)
+	{
+		if (!IndicesInRange(indices, vertices.size()))
+		{
+			return;
+		}
+
+		WeldVertices(vertices, indices);
+		OptimizeVertexCache(indices, vertices.size());
+		OptimizeOverdraw(indices, vertices, overdrawThreshold);
+		OptimizeVertexFetch(vertices, indices);
+	}
+
+	size_t MeshOptimizer::WeldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+	{
+		if (!IndicesInRange(indices, vertices.size()))
+		{
+			return 0;
+		}
+
+		// Open addressing table of indices into `unique`
+		size_t tableSize = 16;
+		while (tableSize < vertices.size() * 2)
+		{
+			tableSize *= 2;
+		}
+		std::vector<unsigned int> table(tableSize, InvalidIndex);
+		std::vector<unsigned int> remap(vertices.size());
+		std::vector<Vertex> unique;
+		unique.reserve(vertices.size());
+
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			const Vertex& vertex = vertices[i];
+			size_t slot = static_cast<size_t>(Hash::Bytes(&vertex, sizeof(Vertex))) & (tableSize - 1);
+			while (table[slot] != InvalidIndex && std::memcmp(&unique[table[slot]], &vertex, sizeof(Vertex)) != 0)
+			{
+				slot = (slot + 1) & (tableSize - 1);
+			}
+
+			if (table[slot] == InvalidIndex)
+			{
+				table[slot] = static_cast<unsigned int>(unique.size());
+				unique.push_back(vertex);
+			}
+			remap[i] = table[slot];
+		}
+
+		for (unsigned int& index : indices)
+		{
+			index = remap[index];
+		}
+
+		size_t removed = vertices.size() - unique.size();
+		vertices.swap(unique);
+		return removed;
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount)
+	{
+		// Scores from the paper: recently used vertices and vertices with few
+		// remaining triangles are preferred
+		constexpr int CacheSize = 32;
+		constexpr unsigned int MaxValence = 32;
+
+		float cacheScores[CacheSize];
+		for (int i = 0; i < CacheSize; i++)
+		{
+			cacheScores[i] = i < 3 ? 0.75f : std::pow(1.0f - float(i - 3) / float(CacheSize - 3), 1.5f);
+		}
+		float valenceScores[MaxValence + 1];
+		valenceScores[0] = 0.0f;
+		for (unsigned int i = 1; i <= MaxValence; i++)
+		{
+			valenceScores[i] = 2.0f / std::sqrt(static_cast<float>(i));
+		}
+
+		auto vertexScore = [&](int cachePosition, unsigned int remaining)
+		{
+			if (remaining == 0)
+			{
+				return -1.0f;
+			}
+			float score = cachePosition >= 0 ? cacheScores[cachePosition] : 0.0f;
+			return score + valenceScores[std::min(remaining, MaxValence)];
+		};
+
+		size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0 || !IndicesInRange(indices, vertexCount))
+		{
+			return;
+		}
+
+		// Vertex -> triangle adjacency; live entries are kept at the front of each range
+		std::vector<unsigned int> remaining(vertexCount, 0);
+		for (unsigned int index : indices)
+		{
+			remaining[index]++;
+		}
+		std::vector<unsigned int> offsets(vertexCount + 1, 0);
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			offsets[v + 1] = offsets[v] + remaining[v];
+		}
+		std::vector<unsigned int> adjacency(indices.size());
+		{
+			std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t t = 0; t < triangleCount; t++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					adjacency[fill[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+				}
+			}
+		}
+
+		std::vector<int> cachePosition(vertexCount, -1);
+		std::vector<float> vertexScores(vertexCount);
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			vertexScores[v] = vertexScore(-1, remaining[v]);
+		}
+
+		std::vector<float> triangleScores(triangleCount);
+		std::vector<bool> emitted(triangleCount, false);
+		constexpr size_t NoTriangle = ~size_t(0);
+		size_t best = 0;
+		for (size_t t = 0; t < triangleCount; t++)
+		{
+			const unsigned int* tri = &indices[t * 3];
+			triangleScores[t] = vertexScores[tri[0]] + vertexScores[tri[1]] + vertexScores[tri[2]];
+			if (triangleScores[t] > triangleScores[best])
+			{
+				best = t;
+			}
+		}
+
+		std::vector<unsigned int> result;
+		result.reserve(indices.size());
+		unsigned int cache[CacheSize + 3];
+		int cacheCount = 0;
+		size_t cursor = 0;
+
+		while (result.size() < indices.size())
+		{
+			if (best == NoTriangle)
+			{
+				// Dead end: nothing in the cache has triangles left, take the next unemitted one
+				while (emitted[cursor])
+				{
+					cursor++;
+				}
+				best = cursor;
+			}
+
+			const unsigned int* tri = &indices[best * 3];
+			result.insert(result.end(), tri, tri + 3);
+			emitted[best] = true;
+
+			// Remove the triangle from its vertices' live adjacency
+			for (int k = 0; k < 3; k++)
+			{
+				unsigned int v = tri[k];
+				unsigned int* begin = &adjacency[offsets[v]];
+				unsigned int* end = begin + remaining[v];
+				unsigned int* it = std::find(begin, end, static_cast<unsigned int>(best));
+				std::swap(*it, *(end - 1));
+				remaining[v]--;
+			}
+
+			// New cache: the triangle's vertices in front, then the previous contents
+			unsigned int newCache[CacheSize + 3];
+			int newCount = 0;
+			for (int k = 0; k < 3; k++)
+			{
+				newCache[newCount++] = tri[k];
+			}
+			for (int i = 0; i < cacheCount; i++)
+			{
+				unsigned int v = cache[i];
+				if (v != tri[0] && v != tri[1] && v != tri[2])
+				{
+					newCache[newCount++] = v;
+				}
+			}
+
+			for (int i = 0; i < newCount; i++)
+			{
+				unsigned int v = newCache[i];
+				cachePosition[v] = i < CacheSize ? i : -1;
+				vertexScores[v] = vertexScore(cachePosition[v], remaining[v]);
+			}
+
+			// Rescore triangles touching changed vertices and pick the next one among them
+			best = NoTriangle;
+			float bestScore = -1.0f;
+			for (int i = 0; i < newCount; i++)
+			{
+				unsigned int v = newCache[i];
+				for (unsigned int a = offsets[v]; a < offsets[v] + remaining[v]; a++)
+				{
+					unsigned int t = adjacency[a];
+					const unsigned int* other = &indices[size_t(t) * 3];
+					triangleScores[t] = vertexScores[other[0]] + vertexScores[other[1]] + vertexScores[other[2]];
+					if (triangleScores[t] > bestScore)
+					{
+						bestScore = triangleScores[t];
+						best = t;
+					}
+				}
+			}
+
+			cacheCount = std::min(newCount, CacheSize);
+			std::copy(newCache, newCache + cacheCount, cache);
+		}
+
+		indices.swap(result);
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices, float threshold)
+	{
+		size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0 || !IndicesInRange(indices, vertices.size()))
+		{
+			return;
+		}
+
+		const unsigned int cacheSize = AnalysisCacheSize;
+		std::vector<unsigned int> timestamps(vertices.size(), 0);
+		unsigned int timestamp = cacheSize + 1;
+
+		// Hard boundaries: a triangle missing all three vertices starts a disjoint patch
+		std::vector<size_t> hardBoundaries;
+		for (size_t t = 0; t < triangleCount; t++)
+		{
+			if (UpdateCache(&indices[t * 3], cacheSize, timestamps, timestamp) == 3 || t == 0)
+			{
+				hardBoundaries.push_back(t);
+			}
+		}
+		hardBoundaries.push_back(triangleCount);
+
+		// Soft boundaries: split a patch whenever the running ACMR is within
+		// `threshold` of the patch's own, so reordering costs little cache efficiency
+		std::vector<size_t> clusters;
+		for (size_t h = 0; h + 1 < hardBoundaries.size(); h++)
+		{
+			size_t start = hardBoundaries[h];
+			size_t end = hardBoundaries[h + 1];
+
+			timestamp += cacheSize + 1;
+			size_t patchMisses = 0;
+			for (size_t t = start; t < end; t++)
+			{
+				patchMisses += UpdateCache(&indices[t * 3], cacheSize, timestamps, timestamp);
+			}
+			float target = threshold * static_cast<float>(patchMisses) / static_cast<float>(end - start);
+
+			clusters.push_back(start);
+			timestamp += cacheSize + 1;
+			size_t misses = 0, faces = 0;
+			bool tailReachedTarget = false;
+			for (size_t t = start; t < end; t++)
+			{
+				misses += UpdateCache(&indices[t * 3], cacheSize, timestamps, timestamp);
+				faces++;
+				if (static_cast<float>(misses) / static_cast<float>(faces) <= target)
+				{
+					if (t + 1 < end)
+					{
+						clusters.push_back(t + 1);
+						timestamp += cacheSize + 1;
+						misses = faces = 0;
+					}
+					else
+					{
+						tailReachedTarget = true;
+					}
+				}
+			}
+
+			// The last cluster rarely reaches the target on its own; merge it into the previous one
+			if (!tailReachedTarget && clusters.back() != start)
+			{
+				clusters.pop_back();
+			}
+		}
+		clusters.push_back(triangleCount);
+
+		glm::vec3 meshCentroid(0.0f);
+		for (const Vertex& vertex : vertices)
+		{
+			meshCentroid += glm::vec3(vertex.Position);
+		}
+		meshCentroid /= static_cast<float>(vertices.size());
+
+		// Sort key: how much the cluster faces away from the mesh centre
+		size_t clusterCount = clusters.size() - 1;
+		std::vector<float> sortKeys(clusterCount);
+		for (size_t c = 0; c < clusterCount; c++)
+		{
+			glm::vec3 centroid(0.0f), normal(0.0f);
+			float area = 0.0f;
+			for (size_t t = clusters[c]; t < clusters[c + 1]; t++)
+			{
+				glm::vec3 p0(vertices[indices[t * 3 + 0]].Position);
+				glm::vec3 p1(vertices[indices[t * 3 + 1]].Position);
+				glm::vec3 p2(vertices[indices[t * 3 + 2]].Position);
+				glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+				float triangleArea = glm::length(cross);
+				centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+				normal += cross;
+				area += triangleArea;
+			}
+
+			float normalLength = glm::length(normal);
+			if (area > 0.0f && normalLength > 0.0f)
+			{
+				sortKeys[c] = glm::dot(centroid / area - meshCentroid, normal / normalLength);
+			}
+			else
+			{
+				sortKeys[c] = 0.0f;
+			}
+		}
+
+		std::vector<size_t> order(clusterCount);
+		std::iota(order.begin(), order.end(), size_t(0));
+		std::stable_sort(order.begin(), order.end(), [&sortKeys](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+		std::vector<unsigned int> result;
+		result.reserve(indices.size());
+		for (size_t c : order)
+		{
+			result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+		}
+		indices.swap(result);
+	}
+
+	void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+	{
+		if (!IndicesInRange(indices, vertices.size()))
+		{
+			return;
+		}
+
+		std::vector<unsigned int> remap(vertices.size(), InvalidIndex);
+		std::vector<Vertex> ordered;
+		ordered.reserve(vertices.size());
+		for (unsigned int& index : indices)
+		{
+			if (remap[index] == InvalidIndex)
+			{
+				remap[index] = static_cast<unsigned int>(ordered.size());
+				ordered.push_back(vertices[index]);
+			}
+			index = remap[index];
+		}
+		vertices.swap(ordered);
+	}
+}
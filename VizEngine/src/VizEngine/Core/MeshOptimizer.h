@@ -0,0 +1,82 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstddef>
+#include <vector>
+
+namespace VizEngine
+{
+	struct Vertex;
+
+	/**
+	 * Post-transform vertex cache efficiency of an index buffer, measured with
+	 * a FIFO cache simulation. Counts add up across meshes.
+	 *
+	 * ACMR: vertex shader invocations per triangle (0.5 is ideal for large grids, 3 is worst).
+	 * ATVR: vertex shader invocations per unique vertex (1.0 is ideal).
+	 */
+	struct VertexCacheStats
+	{
+		size_t Misses = 0;
+		size_t Triangles = 0;
+		size_t Vertices = 0;
+
+		float GetACMR() const { return Triangles ? static_cast<float>(Misses) / Triangles : 0.0f; }
+		float GetATVR() const { return Vertices ? static_cast<float>(Misses) / Vertices : 0.0f; }
+
+		VertexCacheStats& operator+=(const VertexCacheStats& other)
+		{
+			Misses += other.Misses;
+			Triangles += other.Triangles;
+			Vertices += other.Vertices;
+			return *this;
+		}
+	};
+
+	/**
+	 * Import-time optimizations for indexed triangle lists.
+	 * Run in the order of Optimize(): weld, vertex cache, overdraw, vertex fetch.
+	 */
+	class VizEngine_API MeshOptimizer
+	{
+	public:
+		// FIFO size used by AnalyzeVertexCache and the overdraw clustering
+		static constexpr unsigned int AnalysisCacheSize = 16;
+
+		/**
+		 * Run every pass below on one mesh.
+		 * @param overdrawThreshold How much ACMR the overdraw pass may give up (1.05 = 5%)
+		 */
+		static void Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, float overdrawThreshold = 1.05f);
+
+		/**
+		 * Merge bitwise identical vertices and remap the indices.
+		 * @return Number of vertices removed
+		 */
+		static size_t WeldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+		/**
+		 * Reorder triangles for post-transform cache locality
+		 * (Forsyth, "Linear-Speed Vertex Cache Optimisation").
+		 */
+		static void OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+		/**
+		 * Reorder clusters of triangles so outward-facing ones draw first, reducing
+		 * overdraw (Sander et al., "Fast Triangle Reordering for Vertex Locality and
+		 * Reduced Overdraw"). Expects vertex cache optimized input.
+		 */
+		static void OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices, float threshold = 1.05f);
+
+		/**
+		 * Reorder vertices in the order the indices first use them, dropping unused ones.
+		 */
+		static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+		/**
+		 * Simulate a FIFO post-transform cache over the index buffer.
+		 */
+		static VertexCacheStats AnalyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount,
+			unsigned int cacheSize = AnalysisCacheSize);
+	};
+}
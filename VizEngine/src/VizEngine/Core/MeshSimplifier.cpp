@@ -0,0 +1,512 @@
+#include "MeshSimplifier.h"
+#include "VizEngine/Core/Hash.h"
+#include "VizEngine/Core/Mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace VizEngine
+{
+	//==========================================================================
+	// Quadric
+	//==========================================================================
+	// Sum of squared distances to a set of planes, normalized by the total
+	// plane weight so errors are comparable between vertices.
+	struct Quadric
+	{
+		double A00 = 0, A01 = 0, A02 = 0, A11 = 0, A12 = 0, A22 = 0;
+		double B0 = 0, B1 = 0, B2 = 0;
+		double C = 0;
+		double Weight = 0;
+
+		static Quadric FromPlane(const glm::vec3& normal, float distance, float weight)
+		{
+			Quadric q;
+			double a = normal.x, b = normal.y, c = normal.z, d = distance, w = weight;
+			q.A00 = a * a * w; q.A01 = a * b * w; q.A02 = a * c * w;
+			q.A11 = b * b * w; q.A12 = b * c * w; q.A22 = c * c * w;
+			q.B0 = a * d * w; q.B1 = b * d * w; q.B2 = c * d * w;
+			q.C = d * d * w;
+			q.Weight = w;
+			return q;
+		}
+
+		Quadric& operator+=(const Quadric& o)
+		{
+			A00 += o.A00; A01 += o.A01; A02 += o.A02;
+			A11 += o.A11; A12 += o.A12; A22 += o.A22;
+			B0 += o.B0; B1 += o.B1; B2 += o.B2;
+			C += o.C;
+			Weight += o.Weight;
+			return *this;
+		}
+
+		double Evaluate(const glm::vec3& p) const
+		{
+			double x = p.x, y = p.y, z = p.z;
+			double r = A00 * x * x + A11 * y * y + A22 * z * z
+				+ 2.0 * (A01 * x * y + A02 * x * z + A12 * y * z)
+				+ 2.0 * (B0 * x + B1 * y + B2 * z)
+				+ C;
+			return Weight > 0.0 ? std::abs(r) / Weight : 0.0;
+		}
+	};
+
+	// Border planes are weighted up so open edges keep their outline
+	static constexpr float BorderWeight = 10.0f;
+
+	enum class VertexKind : uint8_t
+	{
+		Manifold,  // Interior, collapses along any edge
+		Border,    // On an open edge, collapses along the border only
+		Seam,      // Two wedges sharing a position, collapses along the seam only
+		Locked     // Never moves (seam corners, non-manifold geometry)
+	};
+
+	struct EdgeRef
+	{
+		uint64_t Key;     // (lower position id << 32) | higher position id
+		unsigned int WedgeLo;
+		unsigned int WedgeHi;
+	};
+
+	struct EdgeInfo
+	{
+		unsigned int A, B;  // Position ids
+		unsigned int Count;
+		bool Seam;
+	};
+
+	struct Collapse
+	{
+		unsigned int From, To;  // Position ids
+		float Cost;
+	};
+
+	//==========================================================================
+	// Helpers
+	//==========================================================================
+	// Map every vertex to the first vertex with a bitwise identical position
+	static std::vector<unsigned int> BuildPositionRemap(const std::vector<glm::vec3>& positions)
+	{
+		size_t tableSize = 16;
+		while (tableSize < positions.size() * 2)
+		{
+			tableSize *= 2;
+		}
+		std::vector<unsigned int> table(tableSize, ~0u);
+		std::vector<unsigned int> remap(positions.size());
+
+		for (size_t i = 0; i < positions.size(); i++)
+		{
+			size_t slot = static_cast<size_t>(Hash::Bytes(&positions[i], sizeof(glm::vec3))) & (tableSize - 1);
+			while (table[slot] != ~0u && std::memcmp(&positions[table[slot]], &positions[i], sizeof(glm::vec3)) != 0)
+			{
+				slot = (slot + 1) & (tableSize - 1);
+			}
+			if (table[slot] == ~0u)
+			{
+				table[slot] = static_cast<unsigned int>(i);
+			}
+			remap[i] = table[slot];
+		}
+		return remap;
+	}
+
+	static glm::vec3 TriangleNormal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+	{
+		return glm::cross(b - a, c - a);
+	}
+
+	//==========================================================================
+	// MeshSimplifier
+	//==========================================================================
+	std::vector<unsigned int> MeshSimplifier::Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+		size_t targetIndexCount, float maxError, float* resultError)
+	{
+		if (resultError)
+		{
+			*resultError = 0.0f;
+		}
+
+		size_t vertexCount = vertices.size();
+		if (indices.size() % 3 != 0 || indices.size() <= targetIndexCount ||
+			std::any_of(indices.begin(), indices.end(), [vertexCount](unsigned int i) { return i >= vertexCount; }))
+		{
+			return indices;
+		}
+
+		// Work in positions normalized to the unit cube so errors are relative to the extent
+		glm::vec3 boundsMin(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+		for (const Vertex& vertex : vertices)
+		{
+			boundsMin = glm::min(boundsMin, glm::vec3(vertex.Position));
+			boundsMax = glm::max(boundsMax, glm::vec3(vertex.Position));
+		}
+		glm::vec3 extent = boundsMax - boundsMin;
+		float scale = std::max(extent.x, std::max(extent.y, extent.z));
+		float invScale = scale > 0.0f ? 1.0f / scale : 0.0f;
+
+		std::vector<glm::vec3> positions(vertexCount);
+		for (size_t i = 0; i < vertexCount; i++)
+		{
+			positions[i] = (glm::vec3(vertices[i].Position) - boundsMin) * invScale;
+		}
+
+		// Vertices with the same position ("wedges") are simplified together
+		std::vector<unsigned int> position = BuildPositionRemap(positions);
+		std::vector<unsigned int> wedgeCount(vertexCount, 0);
+		std::vector<unsigned int> wedgeOffsets(vertexCount + 1, 0);
+		for (size_t i = 0; i < vertexCount; i++)
+		{
+			wedgeCount[position[i]]++;
+		}
+		for (size_t i = 0; i < vertexCount; i++)
+		{
+			wedgeOffsets[i + 1] = wedgeOffsets[i] + wedgeCount[i];
+		}
+		std::vector<unsigned int> wedges(vertexCount);
+		{
+			std::vector<unsigned int> fill(wedgeOffsets.begin(), wedgeOffsets.end() - 1);
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				wedges[fill[position[i]]++] = static_cast<unsigned int>(i);
+			}
+		}
+
+		std::vector<unsigned int> current = indices;
+		std::vector<Quadric> quadrics(vertexCount);
+		std::vector<EdgeRef> edgeRefs;
+		std::vector<EdgeInfo> edges;
+		std::vector<VertexKind> kinds(vertexCount);
+		std::vector<Collapse> collapses;
+		std::vector<unsigned int> adjacencyOffsets(vertexCount + 1);
+		std::vector<unsigned int> adjacency;
+		std::vector<unsigned int> wedgeRemap(vertexCount);
+		std::vector<bool> locked(vertexCount);
+
+		auto buildEdges = [&]()
+		{
+			edgeRefs.clear();
+			for (size_t t = 0; t < current.size(); t += 3)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					unsigned int w0 = current[t + k];
+					unsigned int w1 = current[t + (k + 1) % 3];
+					unsigned int p0 = position[w0], p1 = position[w1];
+					if (p0 > p1)
+					{
+						std::swap(p0, p1);
+						std::swap(w0, w1);
+					}
+					edgeRefs.push_back({ (uint64_t(p0) << 32) | p1, w0, w1 });
+				}
+			}
+			std::sort(edgeRefs.begin(), edgeRefs.end(), [](const EdgeRef& a, const EdgeRef& b) { return a.Key < b.Key; });
+
+			edges.clear();
+			for (size_t i = 0; i < edgeRefs.size();)
+			{
+				EdgeInfo edge = { static_cast<unsigned int>(edgeRefs[i].Key >> 32),
+					static_cast<unsigned int>(edgeRefs[i].Key & 0xFFFFFFFFu), 0, false };
+				size_t j = i;
+				for (; j < edgeRefs.size() && edgeRefs[j].Key == edgeRefs[i].Key; j++)
+				{
+					edge.Count++;
+					edge.Seam |= edgeRefs[j].WedgeLo != edgeRefs[i].WedgeLo || edgeRefs[j].WedgeHi != edgeRefs[i].WedgeHi;
+				}
+				edges.push_back(edge);
+				i = j;
+			}
+		};
+
+		// Plane quadrics of every triangle, plus border constraint planes
+		buildEdges();
+		for (size_t t = 0; t < current.size(); t += 3)
+		{
+			const glm::vec3& a = positions[current[t]];
+			const glm::vec3& b = positions[current[t + 1]];
+			const glm::vec3& c = positions[current[t + 2]];
+			glm::vec3 normal = TriangleNormal(a, b, c);
+			float length = glm::length(normal);
+			if (length <= 0.0f)
+			{
+				continue;
+			}
+			normal /= length;
+			Quadric q = Quadric::FromPlane(normal, -glm::dot(normal, a), length * 0.5f);
+			for (int k = 0; k < 3; k++)
+			{
+				quadrics[position[current[t + k]]] += q;
+			}
+
+			for (int k = 0; k < 3; k++)
+			{
+				unsigned int p0 = position[current[t + k]];
+				unsigned int p1 = position[current[t + (k + 1) % 3]];
+				uint64_t key = (uint64_t(std::min(p0, p1)) << 32) | std::max(p0, p1);
+				auto it = std::lower_bound(edges.begin(), edges.end(), key,
+					[](const EdgeInfo& e, uint64_t k) { return ((uint64_t(e.A) << 32) | e.B) < k; });
+				if (it == edges.end() || it->Count != 1)
+				{
+					continue;
+				}
+				glm::vec3 edge = positions[p1] - positions[p0];
+				glm::vec3 borderNormal = glm::cross(edge, normal);
+				float borderLength = glm::length(borderNormal);
+				if (borderLength <= 0.0f)
+				{
+					continue;
+				}
+				borderNormal /= borderLength;
+				Quadric border = Quadric::FromPlane(borderNormal, -glm::dot(borderNormal, positions[p0]),
+					glm::dot(edge, edge) * BorderWeight);
+				quadrics[p0] += border;
+				quadrics[p1] += border;
+			}
+		}
+
+		double maxErrorSq = double(maxError) * double(maxError);
+		double worstCollapse = 0.0;
+
+		while (current.size() > targetIndexCount)
+		{
+			if (edges.empty())
+			{
+				buildEdges();
+			}
+
+			// Classify positions from the current topology
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				unsigned int count = wedgeCount[i];
+				kinds[i] = count > 2 ? VertexKind::Locked : count == 2 ? VertexKind::Seam : VertexKind::Manifold;
+			}
+			for (const EdgeInfo& edge : edges)
+			{
+				for (unsigned int p : { edge.A, edge.B })
+				{
+					if (edge.Count > 2)
+						kinds[p] = VertexKind::Locked;
+					else if (edge.Count == 1 && kinds[p] == VertexKind::Manifold)
+						kinds[p] = VertexKind::Border;
+					else if (edge.Count == 1 && kinds[p] == VertexKind::Seam)
+						kinds[p] = VertexKind::Locked;
+				}
+			}
+
+			// Candidate collapses, cheapest first
+			collapses.clear();
+			for (const EdgeInfo& edge : edges)
+			{
+				if (edge.Count > 2)
+				{
+					continue;
+				}
+				for (int dir = 0; dir < 2; dir++)
+				{
+					unsigned int from = dir == 0 ? edge.A : edge.B;
+					unsigned int to = dir == 0 ? edge.B : edge.A;
+					VertexKind kind = kinds[from];
+					bool allowed = kind == VertexKind::Manifold ||
+						(kind == VertexKind::Border && edge.Count == 1) ||
+						(kind == VertexKind::Seam && edge.Seam && edge.Count == 2);
+					if (!allowed)
+					{
+						continue;
+					}
+
+					Quadric q = quadrics[from];
+					q += quadrics[to];
+					collapses.push_back({ from, to, static_cast<float>(q.Evaluate(positions[to])) });
+				}
+			}
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+			// Position -> triangle adjacency
+			std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+			for (unsigned int w : current)
+			{
+				adjacencyOffsets[position[w] + 1]++;
+			}
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+			}
+			adjacency.resize(current.size());
+			{
+				std::vector<unsigned int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (size_t i = 0; i < current.size(); i++)
+				{
+					adjacency[fill[position[current[i]]]++] = static_cast<unsigned int>(i / 3);
+				}
+			}
+
+			// Collapse an independent set: a collapse locks both ends and the
+			// one-ring of the removed vertex, keeping the flip test valid
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				wedgeRemap[i] = static_cast<unsigned int>(i);
+			}
+			std::fill(locked.begin(), locked.end(), false);
+
+			size_t triangleCount = current.size() / 3;
+			size_t maxCollapses = (triangleCount - targetIndexCount / 3) / 2 + 1;
+			size_t performed = 0;
+
+			for (const Collapse& collapse : collapses)
+			{
+				if (collapse.Cost > maxErrorSq || performed >= maxCollapses)
+				{
+					break;
+				}
+				unsigned int from = collapse.From, to = collapse.To;
+				if (locked[from] || locked[to])
+				{
+					continue;
+				}
+
+				bool flips = false;
+				unsigned int fallbackWedge = ~0u;
+				for (unsigned int a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1] && !flips; a++)
+				{
+					const unsigned int* tri = &current[size_t(adjacency[a]) * 3];
+					int corner = -1;
+					bool removed = false;
+					for (int k = 0; k < 3; k++)
+					{
+						if (position[tri[k]] == from) corner = k;
+						if (position[tri[k]] == to) removed = true;
+					}
+					if (removed || corner < 0)
+					{
+						continue;
+					}
+
+					glm::vec3 p[3] = { positions[tri[0]], positions[tri[1]], positions[tri[2]] };
+					glm::vec3 before = TriangleNormal(p[0], p[1], p[2]);
+					p[corner] = positions[to];
+					glm::vec3 after = TriangleNormal(p[0], p[1], p[2]);
+					flips = glm::dot(before, after) <= 0.0f;
+				}
+				if (flips)
+				{
+					continue;
+				}
+
+				// Wedges of `from` move to the wedge of `to` they share a triangle with
+				for (unsigned int a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; a++)
+				{
+					const unsigned int* tri = &current[size_t(adjacency[a]) * 3];
+					unsigned int fromWedge = ~0u, toWedge = ~0u;
+					for (int k = 0; k < 3; k++)
+					{
+						if (position[tri[k]] == from) fromWedge = tri[k];
+						if (position[tri[k]] == to) toWedge = tri[k];
+					}
+					if (fromWedge != ~0u && toWedge != ~0u)
+					{
+						wedgeRemap[fromWedge] = toWedge;
+						fallbackWedge = toWedge;
+					}
+				}
+				if (fallbackWedge == ~0u)
+				{
+					continue;
+				}
+				for (unsigned int w = wedgeOffsets[from]; w < wedgeOffsets[from + 1]; w++)
+				{
+					if (wedgeRemap[wedges[w]] == wedges[w])
+					{
+						wedgeRemap[wedges[w]] = fallbackWedge;
+					}
+				}
+
+				quadrics[to] += quadrics[from];
+				worstCollapse = std::max(worstCollapse, static_cast<double>(collapse.Cost));
+
+				locked[from] = locked[to] = true;
+				for (unsigned int a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; a++)
+				{
+					const unsigned int* tri = &current[size_t(adjacency[a]) * 3];
+					for (int k = 0; k < 3; k++)
+					{
+						locked[position[tri[k]]] = true;
+					}
+				}
+				performed++;
+			}
+
+			if (performed == 0)
+			{
+				break;
+			}
+
+			// Apply the collapses and drop triangles that became degenerate
+			std::vector<unsigned int> next;
+			next.reserve(current.size());
+			for (size_t t = 0; t < current.size(); t += 3)
+			{
+				unsigned int a = wedgeRemap[current[t]];
+				unsigned int b = wedgeRemap[current[t + 1]];
+				unsigned int c = wedgeRemap[current[t + 2]];
+				if (position[a] != position[b] && position[b] != position[c] && position[a] != position[c])
+				{
+					next.push_back(a);
+					next.push_back(b);
+					next.push_back(c);
+				}
+			}
+			current.swap(next);
+			edges.clear();
+		}
+
+		if (resultError)
+		{
+			*resultError = static_cast<float>(std::sqrt(worstCollapse));
+		}
+		return current;
+	}
+
+	std::vector<MeshLod> MeshSimplifier::GenerateLods(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+		const LodOptions& options)
+	{
+		std::vector<MeshLod> lods;
+		lods.push_back({ 0, static_cast<uint32_t>(indices.size()), 0.0f });
+
+		// Each level simplifies the previous one; errors add up along the chain
+		std::vector<unsigned int> source = indices;
+		for (uint32_t level = 1; level < options.MaxLods; level++)
+		{
+			size_t targetTriangles = static_cast<size_t>(static_cast<float>(source.size() / 3) * options.Ratio);
+			float budget = options.MaxError - lods.back().Error;
+			if (targetTriangles < options.MinTriangles || budget <= 0.0f)
+			{
+				break;
+			}
+
+			float error = 0.0f;
+			std::vector<unsigned int> simplified = Simplify(vertices, source, targetTriangles * 3, budget, &error);
+
+			// Not worth a level if the simplifier got stuck (locked seams, error budget)
+			if (simplified.empty() || simplified.size() > source.size() * 9 / 10)
+			{
+				break;
+			}
+
+			MeshLod lod;
+			lod.FirstIndex = static_cast<uint32_t>(indices.size());
+			lod.IndexCount = static_cast<uint32_t>(simplified.size());
+			lod.Error = lods.back().Error + error;
+			lods.push_back(lod);
+
+			indices.insert(indices.end(), simplified.begin(), simplified.end());
+			source.swap(simplified);
+		}
+		return lods;
+	}
+}
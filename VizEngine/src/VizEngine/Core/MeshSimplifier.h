@@ -0,0 +1,53 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VizEngine
+{
+	struct Vertex;
+	struct MeshLod;
+
+	/**
+	 * Settings for MeshSimplifier::GenerateLods().
+	 */
+	struct LodOptions
+	{
+		uint32_t MaxLods = 4;         // Including LOD 0 (the source mesh)
+		float Ratio = 0.5f;           // Target triangle count of each level relative to the previous one
+		float MaxError = 0.05f;       // Largest allowed error, relative to the mesh extent
+		uint32_t MinTriangles = 32;   // Stop once a level gets this small
+	};
+
+	/**
+	 * Quadric error metric mesh simplification (Garland & Heckbert) using
+	 * half-edge collapses, so every level reuses the source vertex buffer and
+	 * only the index buffer changes.
+	 *
+	 * Open borders only collapse along themselves, attribute seams (vertices
+	 * sharing a position) only along the seam, and collapses that would flip
+	 * a triangle are rejected.
+	 */
+	class VizEngine_API MeshSimplifier
+	{
+	public:
+		/**
+		 * Simplify towards `targetIndexCount` without exceeding `maxError`
+		 * (relative to the mesh extent).
+		 * @param resultError Receives the error of the result (relative), may be nullptr
+		 * @return The simplified index list (same vertex buffer)
+		 */
+		static std::vector<unsigned int> Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+			size_t targetIndexCount, float maxError, float* resultError = nullptr);
+
+		/**
+		 * Build a LOD chain. LOD 0 is `indices` as given; every further level is
+		 * appended to `indices`, so one index buffer holds the whole chain.
+		 * @return One range per level (at least LOD 0)
+		 */
+		static std::vector<MeshLod> GenerateLods(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+			const LodOptions& options = {});
+	};
+}
@@ -0,0 +1,223 @@
+#include "Meshlet.h"
+#include "VizEngine/Core/Mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace VizEngine
+{
+	// Cones wider than this (minimum dot product with the axis) can't cull anything useful
+	static constexpr float MinConeDot = 0.1f;
+
+	static void ComputeBounds(const std::vector<Vertex>& vertices, const unsigned int* indices, size_t indexCount, Meshlet& meshlet)
+	{
+		glm::vec3 boundsMin(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			glm::vec3 p = glm::vec3(vertices[indices[i]].Position);
+			boundsMin = glm::min(boundsMin, p);
+			boundsMax = glm::max(boundsMax, p);
+		}
+
+		meshlet.Center = (boundsMin + boundsMax) * 0.5f;
+		meshlet.Radius = 0.0f;
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			meshlet.Radius = std::max(meshlet.Radius, glm::length(glm::vec3(vertices[indices[i]].Position) - meshlet.Center));
+		}
+
+		// Normal cone from the face normals (vertex normals may be smoothed across the silhouette)
+		std::vector<glm::vec3> normals;
+		normals.reserve(indexCount / 3);
+		glm::vec3 axis(0.0f);
+		for (size_t t = 0; t + 2 < indexCount; t += 3)
+		{
+			glm::vec3 a = glm::vec3(vertices[indices[t]].Position);
+			glm::vec3 b = glm::vec3(vertices[indices[t + 1]].Position);
+			glm::vec3 c = glm::vec3(vertices[indices[t + 2]].Position);
+			glm::vec3 n = glm::cross(b - a, c - a);
+			float length = glm::length(n);
+			if (length > 0.0f)
+			{
+				normals.push_back(n / length);
+				axis += n / length;
+			}
+		}
+
+		float axisLength = glm::length(axis);
+		if (normals.empty() || axisLength <= 0.0f)
+		{
+			meshlet.ConeAxis = glm::vec3(0.0f);
+			meshlet.ConeCutoff = 1.0f;
+			return;
+		}
+		axis /= axisLength;
+
+		float minDot = 1.0f;
+		for (const glm::vec3& n : normals)
+		{
+			minDot = std::min(minDot, glm::dot(axis, n));
+		}
+
+		meshlet.ConeAxis = axis;
+		meshlet.ConeCutoff = minDot <= MinConeDot ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+	}
+
+	std::vector<Meshlet> MeshletBuilder::Build(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+		size_t firstIndex, size_t indexCount, const MeshletOptions& options)
+	{
+		std::vector<Meshlet> meshlets;
+		size_t vertexCount = vertices.size();
+		size_t triangleCount = indexCount / 3;
+		if (triangleCount == 0 || firstIndex + indexCount > indices.size() || options.MaxVertices < 3 || options.MaxTriangles == 0)
+		{
+			return meshlets;
+		}
+
+		const unsigned int* source = indices.data() + firstIndex;
+		for (size_t i = 0; i < triangleCount * 3; i++)
+		{
+			if (source[i] >= vertexCount)
+			{
+				return meshlets;
+			}
+		}
+
+		// Vertex -> triangle adjacency
+		std::vector<unsigned int> adjacencyOffsets(vertexCount + 1, 0);
+		for (size_t i = 0; i < triangleCount * 3; i++)
+		{
+			adjacencyOffsets[source[i] + 1]++;
+		}
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+		}
+		std::vector<unsigned int> adjacency(triangleCount * 3);
+		{
+			std::vector<unsigned int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (size_t i = 0; i < triangleCount * 3; i++)
+			{
+				adjacency[fill[source[i]]++] = static_cast<unsigned int>(i / 3);
+			}
+		}
+
+		std::vector<glm::vec3> centroids(triangleCount);
+		std::vector<glm::vec3> normals(triangleCount);
+		for (size_t t = 0; t < triangleCount; t++)
+		{
+			glm::vec3 a = glm::vec3(vertices[source[t * 3]].Position);
+			glm::vec3 b = glm::vec3(vertices[source[t * 3 + 1]].Position);
+			glm::vec3 c = glm::vec3(vertices[source[t * 3 + 2]].Position);
+			centroids[t] = (a + b + c) / 3.0f;
+			glm::vec3 n = glm::cross(b - a, c - a);
+			float length = glm::length(n);
+			normals[t] = length > 0.0f ? n / length : glm::vec3(0.0f);
+		}
+
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<unsigned int> vertexMeshlet(vertexCount, ~0u);  // Meshlet that last used each vertex
+		std::vector<unsigned int> meshletVertices;
+		std::vector<unsigned int> reordered;
+		reordered.reserve(triangleCount * 3);
+
+		size_t scan = 0;
+		while (true)
+		{
+			while (scan < triangleCount && emitted[scan])
+			{
+				scan++;
+			}
+			if (scan == triangleCount)
+			{
+				break;
+			}
+
+			unsigned int id = static_cast<unsigned int>(meshlets.size());
+			Meshlet meshlet;
+			meshlet.FirstIndex = static_cast<uint32_t>(firstIndex + reordered.size());
+			meshletVertices.clear();
+
+			glm::vec3 centroidSum(0.0f);
+			glm::vec3 normalSum(0.0f);
+			float radius = 0.0f;
+			uint32_t meshletTriangles = 0;
+
+			auto addTriangle = [&](size_t t)
+			{
+				emitted[t] = true;
+				for (int k = 0; k < 3; k++)
+				{
+					unsigned int v = source[t * 3 + k];
+					if (vertexMeshlet[v] != id)
+					{
+						vertexMeshlet[v] = id;
+						meshletVertices.push_back(v);
+					}
+					reordered.push_back(v);
+				}
+				meshletTriangles++;
+				centroidSum += centroids[t];
+				normalSum += normals[t];
+				radius = std::max(radius, glm::length(centroids[t] - centroidSum / static_cast<float>(meshletTriangles)));
+			};
+
+			addTriangle(scan);
+			while (meshletTriangles < options.MaxTriangles)
+			{
+				glm::vec3 center = centroidSum / static_cast<float>(meshletTriangles);
+				float normalLength = glm::length(normalSum);
+				glm::vec3 axis = normalLength > 0.0f ? normalSum / normalLength : glm::vec3(0.0f);
+
+				size_t best = triangleCount;
+				float bestScore = std::numeric_limits<float>::max();
+				for (unsigned int v : meshletVertices)
+				{
+					for (unsigned int a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; a++)
+					{
+						unsigned int t = adjacency[a];
+						if (emitted[t])
+						{
+							continue;
+						}
+
+						unsigned int newVertices = 0;
+						for (int k = 0; k < 3; k++)
+						{
+							newVertices += vertexMeshlet[source[t * 3 + k]] != id ? 1u : 0u;
+						}
+						if (meshletVertices.size() + newVertices > options.MaxVertices)
+						{
+							continue;
+						}
+
+						// Fewest new vertices first, then compactness and facing
+						float spread = glm::length(centroids[t] - center) / std::max(radius, 1e-6f);
+						float facing = 1.0f - glm::dot(normals[t], axis);
+						float score = static_cast<float>(newVertices) + 0.5f * spread + options.ConeWeight * facing;
+						if (score < bestScore)
+						{
+							bestScore = score;
+							best = t;
+						}
+					}
+				}
+
+				if (best == triangleCount)
+				{
+					break;
+				}
+				addTriangle(best);
+			}
+
+			meshlet.IndexCount = meshletTriangles * 3;
+			ComputeBounds(vertices, reordered.data() + (meshlet.FirstIndex - firstIndex), meshlet.IndexCount, meshlet);
+			meshlets.push_back(meshlet);
+		}
+
+		std::copy(reordered.begin(), reordered.end(), indices.begin() + static_cast<std::ptrdiff_t>(firstIndex));
+		return meshlets;
+	}
+}
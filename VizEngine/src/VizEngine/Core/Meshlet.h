@@ -0,0 +1,81 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/Frustum.h"
+#include "glm.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VizEngine
+{
+	struct Vertex;
+
+	/**
+	 * A small cluster of triangles: a contiguous range of the mesh's index
+	 * buffer plus the bounds needed to cull it on the CPU.
+	 * Bounds are in object space.
+	 */
+	struct Meshlet
+	{
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;
+		glm::vec3 Center = glm::vec3(0.0f);    // Bounding sphere
+		float Radius = 0.0f;
+		glm::vec3 ConeAxis = glm::vec3(0.0f);  // Average facing of the triangles
+		float ConeCutoff = 1.0f;               // Sine of the cone's half angle; 1 = never backface culled
+	};
+
+	/**
+	 * Settings for MeshletBuilder::Build().
+	 */
+	struct MeshletOptions
+	{
+		uint32_t MaxVertices = 64;
+		uint32_t MaxTriangles = 124;
+		float ConeWeight = 0.5f;         // Favors triangles facing like the cluster (tighter cones, better backface culling)
+		uint32_t MinTriangles = 512;     // Meshes smaller than this are drawn whole
+	};
+
+	/**
+	 * Splits index ranges into meshlets and culls them against a frustum
+	 * and against their normal cones.
+	 */
+	class VizEngine_API MeshletBuilder
+	{
+	public:
+		/**
+		 * Reorder the triangles of indices[firstIndex, firstIndex + indexCount)
+		 * so every meshlet is contiguous. Triangles are grown greedily from
+		 * neighbours that add the fewest new vertices and stay close to the
+		 * cluster.
+		 * @return The meshlets, with FirstIndex relative to the whole index buffer
+		 */
+		static std::vector<Meshlet> Build(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+			size_t firstIndex, size_t indexCount, const MeshletOptions& options = {});
+
+		/**
+		 * Frustum and backface cone test. Both the frustum and the camera
+		 * position must be in the meshlet's object space.
+		 */
+		static bool IsVisible(const Meshlet& meshlet, const Frustum& frustum, const glm::vec3& cameraPosition, bool backfaceCulling)
+		{
+			if (!frustum.IntersectsSphere(meshlet.Center, meshlet.Radius))
+			{
+				return false;
+			}
+
+			// Every triangle faces away if the view direction lies inside the
+			// cone, conservatively widened by the bounding sphere
+			if (backfaceCulling && meshlet.ConeCutoff < 1.0f)
+			{
+				glm::vec3 toCenter = meshlet.Center - cameraPosition;
+				if (glm::dot(toCenter, meshlet.ConeAxis) >= meshlet.ConeCutoff * glm::length(toCenter) + meshlet.Radius)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+}
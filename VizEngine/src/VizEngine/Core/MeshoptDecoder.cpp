@@ -0,0 +1,530 @@
+#include "MeshoptDecoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace VizEngine
+{
+	namespace
+	{
+		// Stream headers: high nibble identifies the codec, low nibble its version
+		constexpr uint8_t VertexHeader = 0xA0;
+		constexpr uint8_t IndexHeader = 0xE0;
+		constexpr uint8_t SequenceHeader = 0xD0;
+
+		constexpr size_t ByteGroupSize = 16;
+		constexpr size_t ByteGroupDecodeLimit = 24;   // Most bytes one group can read (4-bit values + 16 escapes)
+		constexpr size_t VertexBlockSizeBytes = 8192;
+		constexpr size_t VertexBlockMaxSize = 256;
+		constexpr size_t VertexTailMinSize = 32;
+		constexpr size_t IndexTailSize = 16;          // Codeaux table of the triangle codec
+		constexpr size_t SequenceTailSize = 4;
+
+		//======================================================================
+		// Vertex codec
+		//======================================================================
+
+		size_t GetVertexBlockSize(size_t stride)
+		{
+			// A block fits the 8 KB scratch and is a whole number of byte groups
+			size_t size = (VertexBlockSizeBytes / stride) & ~(ByteGroupSize - 1);
+			return std::min(size, VertexBlockMaxSize);
+		}
+
+		uint8_t Unzigzag8(uint8_t value)
+		{
+			return static_cast<uint8_t>(-(value & 1) ^ (value >> 1));
+		}
+
+		// One group of 16 byte deltas; the caller guarantees ByteGroupDecodeLimit readable bytes
+		const uint8_t* DecodeBytesGroup(const uint8_t* data, uint8_t* out, int bitsLog2)
+		{
+			switch (bitsLog2)
+			{
+				case 0:
+					std::memset(out, 0, ByteGroupSize);
+					return data;
+
+				case 1:
+				case 2:
+				{
+					// 2 or 4 bits per value, first value in the high bits. The all-ones
+					// value escapes to a full byte, stored in order after the packed bits.
+					int bits = 1 << bitsLog2;
+					unsigned int escape = (1u << bits) - 1;
+					const uint8_t* extra = data + ByteGroupSize * bits / 8;
+					for (size_t i = 0; i < ByteGroupSize; i++)
+					{
+						size_t bit = i * bits;
+						unsigned int value = (data[bit / 8] >> (8 - bits - bit % 8)) & escape;
+						out[i] = value == escape ? *extra++ : static_cast<uint8_t>(value);
+					}
+					return extra;
+				}
+
+				default:
+					std::memcpy(out, data, ByteGroupSize);
+					return data + ByteGroupSize;
+			}
+		}
+
+		const uint8_t* DecodeBytes(const uint8_t* data, const uint8_t* end, uint8_t* out, size_t count)
+		{
+			// 2 bits of header per group select its width: 0, 2, 4 or 8 bits per value
+			size_t groups = count / ByteGroupSize;
+			size_t headerSize = (groups + 3) / 4;
+			if (static_cast<size_t>(end - data) < headerSize)
+			{
+				return nullptr;
+			}
+
+			const uint8_t* header = data;
+			data += headerSize;
+			for (size_t group = 0; group < groups; group++)
+			{
+				if (static_cast<size_t>(end - data) < ByteGroupDecodeLimit)
+				{
+					return nullptr;
+				}
+				int bitsLog2 = (header[group / 4] >> ((group % 4) * 2)) & 3;
+				data = DecodeBytesGroup(data, out + group * ByteGroupSize, bitsLog2);
+			}
+			return data;
+		}
+
+		const uint8_t* DecodeVertexBlock(const uint8_t* data, const uint8_t* end, uint8_t* dst,
+			size_t count, size_t stride, uint8_t last[256])
+		{
+			uint8_t deltas[VertexBlockMaxSize];
+			size_t alignedCount = (count + ByteGroupSize - 1) & ~(ByteGroupSize - 1);
+
+			// Byte k of every element is stored as one delta stream against byte k of the previous element
+			for (size_t k = 0; k < stride; k++)
+			{
+				data = DecodeBytes(data, end, deltas, alignedCount);
+				if (!data)
+				{
+					return nullptr;
+				}
+
+				uint8_t value = last[k];
+				for (size_t i = 0; i < count; i++)
+				{
+					value = static_cast<uint8_t>(value + Unzigzag8(deltas[i]));
+					dst[i * stride + k] = value;
+				}
+			}
+
+			std::memcpy(last, dst + (count - 1) * stride, stride);
+			return data;
+		}
+
+		//======================================================================
+		// Index codecs
+		//======================================================================
+
+		uint32_t DecodeVByte(const uint8_t*& data)
+		{
+			uint8_t lead = *data++;
+			if (lead < 128)
+			{
+				return lead;
+			}
+
+			// Up to 5 bytes, 7 bits each, little-endian
+			uint32_t result = lead & 127;
+			uint32_t shift = 7;
+			for (int i = 0; i < 4; i++)
+			{
+				uint8_t group = *data++;
+				result |= static_cast<uint32_t>(group & 127) << shift;
+				shift += 7;
+				if (group < 128)
+				{
+					break;
+				}
+			}
+			return result;
+		}
+
+		uint32_t DecodeIndex(const uint8_t*& data, uint32_t last)
+		{
+			uint32_t v = DecodeVByte(data);
+			uint32_t delta = (v >> 1) ^ (0u - (v & 1));
+			return last + delta;
+		}
+
+		void WriteIndex(void* dst, size_t i, size_t indexSize, uint32_t index)
+		{
+			if (indexSize == 2)
+			{
+				static_cast<uint16_t*>(dst)[i] = static_cast<uint16_t>(index);
+			}
+			else
+			{
+				static_cast<uint32_t*>(dst)[i] = index;
+			}
+		}
+
+		struct IndexFifos
+		{
+			uint32_t Edges[16][2];
+			uint32_t Vertices[16];
+			size_t EdgeOffset = 0;
+			size_t VertexOffset = 0;
+
+			IndexFifos()
+			{
+				std::memset(Edges, -1, sizeof(Edges));
+				std::memset(Vertices, -1, sizeof(Vertices));
+			}
+
+			void PushEdge(uint32_t a, uint32_t b)
+			{
+				Edges[EdgeOffset][0] = a;
+				Edges[EdgeOffset][1] = b;
+				EdgeOffset = (EdgeOffset + 1) & 15;
+			}
+
+			// The slot is always written; it is only kept when `advance` is set
+			void PushVertex(uint32_t v, bool advance = true)
+			{
+				Vertices[VertexOffset] = v;
+				VertexOffset = (VertexOffset + (advance ? 1 : 0)) & 15;
+			}
+		};
+
+		//======================================================================
+		// Filters
+		//======================================================================
+
+		template<typename T>
+		T RoundToInt(float value)
+		{
+			return static_cast<T>(static_cast<int>(value + (value >= 0.0f ? 0.5f : -0.5f)));
+		}
+
+		template<typename T>
+		void DecodeOctahedralFilter(T* data, size_t count)
+		{
+			const float maxValue = static_cast<float>((1 << (sizeof(T) * 8 - 1)) - 1);
+			for (size_t i = 0; i < count; i++)
+			{
+				T* element = data + i * 4;
+
+				// z stores 1.0 at the same bit count, so the fold needs no rescaling
+				float x = static_cast<float>(element[0]);
+				float y = static_cast<float>(element[1]);
+				float z = static_cast<float>(element[2]) - std::abs(x) - std::abs(y);
+
+				// Unfold the lower hemisphere
+				float t = std::min(z, 0.0f);
+				x += x >= 0.0f ? t : -t;
+				y += y >= 0.0f ? t : -t;
+
+				float length = std::sqrt(x * x + y * y + z * z);
+				float scale = length > 0.0f ? maxValue / length : 0.0f;
+				element[0] = RoundToInt<T>(x * scale);
+				element[1] = RoundToInt<T>(y * scale);
+				element[2] = RoundToInt<T>(z * scale);
+				// w (e.g. tangent handedness) is stored unchanged
+			}
+		}
+
+		void DecodeQuaternionFilter(int16_t* data, size_t count)
+		{
+			const float scale = 1.0f / std::sqrt(2.0f);
+			for (size_t i = 0; i < count; i++)
+			{
+				int16_t* element = data + i * 4;
+
+				// The high bits of w hold the component range, the low 2 bits the index of the dropped component
+				int range = element[3] | 3;
+				float s = scale / static_cast<float>(range);
+				float x = static_cast<float>(element[0]) * s;
+				float y = static_cast<float>(element[1]) * s;
+				float z = static_cast<float>(element[2]) * s;
+				float w = std::sqrt(std::max(1.0f - x * x - y * y - z * z, 0.0f));
+
+				int dropped = element[3] & 3;
+				int16_t xf = RoundToInt<int16_t>(x * 32767.0f);
+				int16_t yf = RoundToInt<int16_t>(y * 32767.0f);
+				int16_t zf = RoundToInt<int16_t>(z * 32767.0f);
+				int16_t wf = RoundToInt<int16_t>(w * 32767.0f);
+				element[(dropped + 1) & 3] = xf;
+				element[(dropped + 2) & 3] = yf;
+				element[(dropped + 3) & 3] = zf;
+				element[(dropped + 0) & 3] = wf;
+			}
+		}
+
+		void DecodeExponentialFilter(uint32_t* data, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				// Signed 24-bit mantissa, signed 8-bit exponent: value = m * 2^e
+				int32_t mantissa = static_cast<int32_t>(data[i] << 8) >> 8;
+				int32_t exponent = static_cast<int32_t>(data[i]) >> 24;
+				float value = std::ldexp(static_cast<float>(mantissa), exponent);
+				std::memcpy(&data[i], &value, sizeof(float));
+			}
+		}
+	}
+
+	//==========================================================================
+	// MeshoptDecoder
+	//==========================================================================
+
+	bool MeshoptDecoder::Decode(void* dst, size_t count, size_t stride, const uint8_t* src, size_t size,
+		MeshoptMode mode, MeshoptFilter filter)
+	{
+		switch (mode)
+		{
+			case MeshoptMode::Attributes:
+			{
+				bool validFilter =
+					filter == MeshoptFilter::None ||
+					(filter == MeshoptFilter::Octahedral && (stride == 4 || stride == 8)) ||
+					(filter == MeshoptFilter::Quaternion && stride == 8) ||
+					filter == MeshoptFilter::Exponential;
+				if (!validFilter || !DecodeVertexBuffer(dst, count, stride, src, size))
+				{
+					return false;
+				}
+				ApplyFilter(dst, count, stride, filter);
+				return true;
+			}
+
+			case MeshoptMode::Triangles:
+				return filter == MeshoptFilter::None && DecodeIndexBuffer(dst, count, stride, src, size);
+
+			case MeshoptMode::Indices:
+				return filter == MeshoptFilter::None && DecodeIndexSequence(dst, count, stride, src, size);
+		}
+		return false;
+	}
+
+	bool MeshoptDecoder::DecodeVertexBuffer(void* dst, size_t count, size_t stride, const uint8_t* src, size_t size)
+	{
+		if (stride == 0 || stride > 256 || stride % 4 != 0 || size < 1 + stride)
+		{
+			return false;
+		}
+
+		// EXT_meshopt_compression only allows version 0 of the vertex codec
+		if (src[0] != VertexHeader)
+		{
+			return false;
+		}
+
+		// The last `stride` bytes hold the element the first deltas are relative to
+		const uint8_t* data = src + 1;
+		const uint8_t* end = src + size;
+		uint8_t last[256];
+		std::memcpy(last, end - stride, stride);
+
+		uint8_t* out = static_cast<uint8_t*>(dst);
+		size_t blockSize = GetVertexBlockSize(stride);
+		for (size_t first = 0; first < count; first += blockSize)
+		{
+			size_t blockCount = std::min(blockSize, count - first);
+			data = DecodeVertexBlock(data, end, out + first * stride, blockCount, stride, last);
+			if (!data)
+			{
+				return false;
+			}
+		}
+
+		// The encoder pads the tail so group reads never need bounds checks
+		size_t tailSize = std::max(stride, VertexTailMinSize);
+		return static_cast<size_t>(end - data) == tailSize;
+	}
+
+	bool MeshoptDecoder::DecodeIndexBuffer(void* dst, size_t count, size_t indexSize, const uint8_t* src, size_t size)
+	{
+		if (count % 3 != 0 || (indexSize != 2 && indexSize != 4))
+		{
+			return false;
+		}
+
+		// One code byte per triangle, then the variable-length data, then the codeaux table
+		if (size < 1 + count / 3 + IndexTailSize || (src[0] & 0xF0) != IndexHeader)
+		{
+			return false;
+		}
+		int version = src[0] & 0x0F;
+		if (version > 1)
+		{
+			return false;
+		}
+
+		const uint8_t* code = src + 1;
+		const uint8_t* data = code + count / 3;
+		const uint8_t* dataSafeEnd = src + size - IndexTailSize;
+		const uint8_t* codeauxTable = dataSafeEnd;
+
+		IndexFifos fifo;
+		uint32_t next = 0;
+		uint32_t last = 0;
+		int fecMax = version >= 1 ? 13 : 15;
+
+		for (size_t i = 0; i < count; i += 3)
+		{
+			// A triangle reads at most 16 bytes (codeaux + 3 varints), which the table tail covers
+			if (data > dataSafeEnd)
+			{
+				return false;
+			}
+
+			uint32_t a, b, c;
+			uint8_t codetri = *code++;
+			if (codetri < 0xF0)
+			{
+				// Triangle shares an edge from the FIFO; the third vertex is new, from the FIFO or explicit
+				int fe = codetri >> 4;
+				a = fifo.Edges[(fifo.EdgeOffset - 1 - fe) & 15][0];
+				b = fifo.Edges[(fifo.EdgeOffset - 1 - fe) & 15][1];
+
+				int fec = codetri & 15;
+				if (fec < fecMax)
+				{
+					c = fec == 0 ? next++ : fifo.Vertices[(fifo.VertexOffset - 1 - fec) & 15];
+					fifo.PushVertex(c, fec == 0);
+				}
+				else
+				{
+					// Version 1 encodes last - 1 and last + 1 as 13 and 14
+					last = c = fec != 15 ? last + (fec - (fec ^ 3)) : DecodeIndex(data, last);
+					fifo.PushVertex(c);
+				}
+
+				fifo.PushEdge(c, b);
+				fifo.PushEdge(a, c);
+			}
+			else
+			{
+				int fea, feb, fec;
+				if (codetri < 0xFE)
+				{
+					// Common vertex patterns come from the 16-entry table, `a` is always new
+					uint8_t codeaux = codeauxTable[codetri & 15];
+					fea = 0;
+					feb = codeaux >> 4;
+					fec = codeaux & 15;
+				}
+				else
+				{
+					uint8_t codeaux = *data++;
+					fea = codetri == 0xFE ? 0 : 15;
+					feb = codeaux >> 4;
+					fec = codeaux & 15;
+
+					// A zero codeaux outside the table restarts the new-vertex counter
+					if (codeaux == 0)
+					{
+						next = 0;
+					}
+				}
+
+				// New vertices are numbered before explicit ones are read, matching the encoder
+				a = fea == 0 ? next++ : 0;
+				b = feb == 0 ? next++ : fifo.Vertices[(fifo.VertexOffset - feb) & 15];
+				c = fec == 0 ? next++ : fifo.Vertices[(fifo.VertexOffset - fec) & 15];
+
+				if (fea == 15)
+				{
+					last = a = DecodeIndex(data, last);
+				}
+				if (feb == 15)
+				{
+					last = b = DecodeIndex(data, last);
+				}
+				if (fec == 15)
+				{
+					last = c = DecodeIndex(data, last);
+				}
+
+				fifo.PushVertex(a);
+				fifo.PushVertex(b, feb == 0 || feb == 15);
+				fifo.PushVertex(c, fec == 0 || fec == 15);
+
+				fifo.PushEdge(b, a);
+				fifo.PushEdge(c, b);
+				fifo.PushEdge(a, c);
+			}
+
+			WriteIndex(dst, i + 0, indexSize, a);
+			WriteIndex(dst, i + 1, indexSize, b);
+			WriteIndex(dst, i + 2, indexSize, c);
+		}
+
+		// All data must be consumed, ending exactly at the codeaux table
+		return data == dataSafeEnd;
+	}
+
+	bool MeshoptDecoder::DecodeIndexSequence(void* dst, size_t count, size_t indexSize, const uint8_t* src, size_t size)
+	{
+		if (indexSize != 2 && indexSize != 4)
+		{
+			return false;
+		}
+
+		// At least one byte per index plus the tail
+		if (size < 1 + count + SequenceTailSize || (src[0] & 0xF0) != SequenceHeader || (src[0] & 0x0F) > 1)
+		{
+			return false;
+		}
+
+		const uint8_t* data = src + 1;
+		const uint8_t* dataSafeEnd = src + size - SequenceTailSize;
+
+		// Deltas are relative to one of two baselines, selected by the low bit
+		uint32_t last[2] = {};
+		for (size_t i = 0; i < count; i++)
+		{
+			// A varint reads at most 5 bytes, which the tail covers
+			if (data >= dataSafeEnd)
+			{
+				return false;
+			}
+
+			uint32_t v = DecodeVByte(data);
+			uint32_t baseline = v & 1;
+			v >>= 1;
+			uint32_t index = last[baseline] + ((v >> 1) ^ (0u - (v & 1)));
+			last[baseline] = index;
+			WriteIndex(dst, i, indexSize, index);
+		}
+
+		return data == dataSafeEnd;
+	}
+
+	void MeshoptDecoder::ApplyFilter(void* data, size_t count, size_t stride, MeshoptFilter filter)
+	{
+		switch (filter)
+		{
+			case MeshoptFilter::Octahedral:
+				if (stride == 4)
+				{
+					DecodeOctahedralFilter(static_cast<int8_t*>(data), count);
+				}
+				else
+				{
+					DecodeOctahedralFilter(static_cast<int16_t*>(data), count);
+				}
+				break;
+
+			case MeshoptFilter::Quaternion:
+				DecodeQuaternionFilter(static_cast<int16_t*>(data), count);
+				break;
+
+			case MeshoptFilter::Exponential:
+				DecodeExponentialFilter(static_cast<uint32_t*>(data), count * (stride / 4));
+				break;
+
+			case MeshoptFilter::None:
+				break;
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace VizEngine
+{
+	/**
+	 * Codec of a compressed bufferView (EXT_meshopt_compression "mode").
+	 */
+	enum class MeshoptMode
+	{
+		Attributes,  // Vertex codec: byte-wise deltas in blocks of up to 256 elements
+		Triangles,   // Index codec: triangle lists through edge and vertex FIFOs
+		Indices      // Index sequence codec: any index data, delta + varint
+	};
+
+	/**
+	 * Post-decode transform of Attributes data (EXT_meshopt_compression "filter").
+	 */
+	enum class MeshoptFilter
+	{
+		None,
+		Octahedral,   // 4 x snorm8 / snorm16 normals or tangents stored as octahedral x, y
+		Quaternion,   // 4 x snorm16 rotations stored as 3 components and the index of the largest
+		Exponential   // 32-bit floats stored as a 24-bit mantissa and a shared or per-value exponent
+	};
+
+	/**
+	 * Decoder for the meshoptimizer bitstreams used by EXT_meshopt_compression
+	 * (vertex codec version 0, index codecs versions 0 and 1).
+	 *
+	 * The decoders are self-contained and reentrant; each call decodes one
+	 * bufferView, so a glTF with many compressed views decodes them in
+	 * parallel. Malformed input is rejected without reading past `size`.
+	 */
+	class VizEngine_API MeshoptDecoder
+	{
+	public:
+		/**
+		 * Decode `count` elements of `stride` bytes into `dst` (count * stride
+		 * bytes) and apply `filter`.
+		 * @return false if the data is malformed or the stride, mode and
+		 *         filter combination is not allowed by the extension
+		 */
+		static bool Decode(void* dst, size_t count, size_t stride, const uint8_t* src, size_t size,
+			MeshoptMode mode, MeshoptFilter filter);
+
+		static bool DecodeVertexBuffer(void* dst, size_t count, size_t stride, const uint8_t* src, size_t size);
+		static bool DecodeIndexBuffer(void* dst, size_t count, size_t indexSize, const uint8_t* src, size_t size);
+		static bool DecodeIndexSequence(void* dst, size_t count, size_t indexSize, const uint8_t* src, size_t size);
+
+		/**
+		 * Apply `filter` in place to `count` decoded elements of `stride` bytes.
+		 * The stride must be valid for the filter (see Decode).
+		 */
+		static void ApplyFilter(void* data, size_t count, size_t stride, MeshoptFilter filter);
+	};
+}
@@ -0,0 +1,345 @@
+#include "MipGenerator.h"
+#include "VizEngine/Core/Hash.h"
+#include "VizEngine/Core/ThreadPool.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace VizEngine
+{
+	// Bump when the filters change, so cached chains are rebuilt
+	static constexpr uint32_t FilterVersion = 1;
+
+	//==========================================================================
+	// sRGB conversion
+	//==========================================================================
+	static constexpr int LinearTableSize = 16384;
+
+	static const float* SrgbToLinearTable()
+	{
+		static const std::vector<float> table = []()
+		{
+			std::vector<float> values(256);
+			for (int i = 0; i < 256; i++)
+			{
+				float c = i / 255.0f;
+				values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+			return values;
+		}();
+		return table.data();
+	}
+
+	static const uint8_t* LinearToSrgbTable()
+	{
+		static const std::vector<uint8_t> table = []()
+		{
+			std::vector<uint8_t> values(LinearTableSize);
+			for (int i = 0; i < LinearTableSize; i++)
+			{
+				float l = i / float(LinearTableSize - 1);
+				float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+				values[i] = static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+			}
+			return values;
+		}();
+		return table.data();
+	}
+
+	static uint8_t ToUnorm8(float value)
+	{
+		return static_cast<uint8_t>(std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f));
+	}
+
+	//==========================================================================
+	// Filter kernels
+	//==========================================================================
+
+	// Modified Bessel function of the first kind, order 0 (series expansion)
+	static float BesselI0(float x)
+	{
+		float sum = 1.0f, term = 1.0f;
+		float half = x * 0.5f;
+		for (int k = 1; k < 32; k++)
+		{
+			term *= (half / k) * (half / k);
+			sum += term;
+			if (term < sum * 1e-8f)
+			{
+				break;
+			}
+		}
+		return sum;
+	}
+
+	static float Sinc(float x)
+	{
+		static constexpr float Pi = 3.14159265358979f;
+		return std::fabs(x) < 1e-6f ? 1.0f : std::sin(Pi * x) / (Pi * x);
+	}
+
+	// Weights from source texels to each destination texel along one axis.
+	// Taps outside the image clamp to the edge.
+	struct Kernel
+	{
+		int Taps = 0;
+		std::vector<int> Indices;    // Destination texel * Taps
+		std::vector<float> Weights;
+	};
+
+	static Kernel BuildKernel(int sourceSize, int targetSize, const MipOptions& options)
+	{
+		float scale = static_cast<float>(sourceSize) / targetSize;
+		bool box = options.Filter == MipFilter::Box;
+		float radius = box ? 0.5f : std::max(options.KaiserWidth * 0.5f, 0.5f);  // In destination texels
+		float windowNorm = BesselI0(options.KaiserAlpha);
+
+		Kernel kernel;
+		kernel.Taps = static_cast<int>(std::ceil(radius * scale * 2.0f)) + 1;
+		kernel.Indices.resize(static_cast<size_t>(targetSize) * kernel.Taps);
+		kernel.Weights.resize(kernel.Indices.size());
+
+		for (int x = 0; x < targetSize; x++)
+		{
+			float center = (x + 0.5f) * scale;
+			int first = static_cast<int>(std::floor(center - radius * scale));
+			float total = 0.0f;
+			for (int t = 0; t < kernel.Taps; t++)
+			{
+				int i = first + t;
+				float d = (i + 0.5f - center) / scale;
+				float weight = 0.0f;
+				if (box)
+				{
+					weight = std::fabs(d) < radius ? 1.0f : 0.0f;
+				}
+				else if (std::fabs(d) < radius)
+				{
+					float r = d / radius;
+					weight = Sinc(d) * BesselI0(options.KaiserAlpha * std::sqrt(1.0f - r * r)) / windowNorm;
+				}
+
+				size_t slot = static_cast<size_t>(x) * kernel.Taps + t;
+				kernel.Indices[slot] = std::clamp(i, 0, sourceSize - 1);
+				kernel.Weights[slot] = weight;
+				total += weight;
+			}
+
+			for (int t = 0; t < kernel.Taps; t++)
+			{
+				kernel.Weights[static_cast<size_t>(x) * kernel.Taps + t] /= total;
+			}
+		}
+		return kernel;
+	}
+
+	//==========================================================================
+	// Levels
+	//==========================================================================
+
+	// RGBA float texels of one level
+	struct FloatImage
+	{
+		int Width = 0;
+		int Height = 0;
+		std::vector<float> Texels;
+	};
+
+	// Rows in chunks sized so every worker gets a few
+	template<typename Body>
+	static void ForEachRow(int height, const Body& body)
+	{
+		ThreadPool& pool = ThreadPool::Get();
+		size_t grain = std::max<size_t>(1, height / (pool.GetThreadCount() * 4 + 1));
+		pool.ParallelFor(static_cast<size_t>(height), grain, [&body](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; y++)
+			{
+				body(y);
+			}
+		});
+	}
+
+	static FloatImage Downsample(const FloatImage& source, const MipOptions& options)
+	{
+		FloatImage target;
+		target.Width = std::max(source.Width / 2, 1);
+		target.Height = std::max(source.Height / 2, 1);
+		target.Texels.resize(static_cast<size_t>(target.Width) * target.Height * 4);
+
+		Kernel horizontal = BuildKernel(source.Width, target.Width, options);
+		Kernel vertical = BuildKernel(source.Height, target.Height, options);
+
+		// Separable: rows first (source height x target width), then columns
+		std::vector<float> rows(static_cast<size_t>(target.Width) * source.Height * 4);
+		ForEachRow(source.Height, [&](size_t y)
+		{
+			const float* in = source.Texels.data() + y * source.Width * 4;
+			float* out = rows.data() + y * target.Width * 4;
+			for (int x = 0; x < target.Width; x++)
+			{
+				float sum[4] = {};
+				for (int t = 0; t < horizontal.Taps; t++)
+				{
+					size_t slot = static_cast<size_t>(x) * horizontal.Taps + t;
+					const float* texel = in + horizontal.Indices[slot] * 4;
+					float weight = horizontal.Weights[slot];
+					for (int c = 0; c < 4; c++)
+					{
+						sum[c] += texel[c] * weight;
+					}
+				}
+				std::memcpy(out + x * 4, sum, sizeof(sum));
+			}
+		});
+
+		ForEachRow(target.Height, [&](size_t y)
+		{
+			float* out = target.Texels.data() + y * target.Width * 4;
+			std::fill(out, out + target.Width * 4, 0.0f);
+			for (int t = 0; t < vertical.Taps; t++)
+			{
+				size_t slot = y * vertical.Taps + t;
+				const float* in = rows.data() + static_cast<size_t>(vertical.Indices[slot]) * target.Width * 4;
+				float weight = vertical.Weights[slot];
+				for (int i = 0; i < target.Width * 4; i++)
+				{
+					out[i] += in[i] * weight;
+				}
+			}
+		});
+		return target;
+	}
+
+	// Clamp away the sinc's overshoot (renormalizing normals), then store as RGBA8
+	static void Encode(FloatImage& image, MipContent content, uint8_t* out)
+	{
+		const uint8_t* toSrgb = LinearToSrgbTable();
+		ForEachRow(image.Height, [&](size_t y)
+		{
+			for (size_t i = y * image.Width; i < (y + 1) * image.Width; i++)
+			{
+				float* texel = image.Texels.data() + i * 4;
+				if (content == MipContent::NormalMap)
+				{
+					float length = std::sqrt(texel[0] * texel[0] + texel[1] * texel[1] + texel[2] * texel[2]);
+					if (length > 1e-6f)
+					{
+						texel[0] /= length;
+						texel[1] /= length;
+						texel[2] /= length;
+					}
+					else
+					{
+						texel[0] = texel[1] = 0.0f;
+						texel[2] = 1.0f;
+					}
+				}
+				else
+				{
+					for (int c = 0; c < 3; c++)
+					{
+						texel[c] = std::clamp(texel[c], 0.0f, 1.0f);
+					}
+				}
+				texel[3] = std::clamp(texel[3], 0.0f, 1.0f);
+
+				for (int c = 0; c < 3; c++)
+				{
+					switch (content)
+					{
+						case MipContent::Color:     out[i * 4 + c] = toSrgb[static_cast<int>(texel[c] * (LinearTableSize - 1) + 0.5f)]; break;
+						case MipContent::Linear:    out[i * 4 + c] = ToUnorm8(texel[c]); break;
+						case MipContent::NormalMap: out[i * 4 + c] = ToUnorm8(texel[c] * 0.5f + 0.5f); break;
+					}
+				}
+				out[i * 4 + 3] = ToUnorm8(texel[3]);
+			}
+		});
+	}
+
+	//==========================================================================
+	// MipGenerator
+	//==========================================================================
+	bool MipGenerator::Generate(const uint8_t* rgba, int width, int height, MipContent content,
+		const MipOptions& options, TextureData& out)
+	{
+		out = TextureData();
+		if (!rgba || width <= 0 || height <= 0)
+		{
+			VP_CORE_ERROR("MipGenerator: invalid image ({}x{})", width, height);
+			return false;
+		}
+
+		out.InternalFormat = GL_RGBA8;
+		out.Format = GL_RGBA;
+		out.Type = GL_UNSIGNED_BYTE;
+
+		size_t total = 0;
+		for (int level = 0; ; level++)
+		{
+			TextureData::Level entry;
+			entry.Width = std::max(width >> level, 1);
+			entry.Height = std::max(height >> level, 1);
+			entry.Offset = total;
+			entry.Size = static_cast<size_t>(entry.Width) * entry.Height * 4;
+			total += entry.Size;
+			out.Levels.push_back(entry);
+			if (entry.Width == 1 && entry.Height == 1)
+			{
+				break;
+			}
+		}
+		out.Bytes.resize(total);
+		std::memcpy(out.Bytes.data(), rgba, out.Levels[0].Size);
+
+		// Level 0 in filtering space
+		FloatImage current;
+		current.Width = width;
+		current.Height = height;
+		current.Texels.resize(static_cast<size_t>(width) * height * 4);
+		const float* fromSrgb = SrgbToLinearTable();
+		ForEachRow(height, [&](size_t y)
+		{
+			for (size_t i = y * width * 4; i < (y + 1) * width * 4; i++)
+			{
+				bool alpha = (i & 3) == 3;
+				float value = rgba[i] / 255.0f;
+				if (!alpha && content == MipContent::Color)
+				{
+					value = fromSrgb[rgba[i]];
+				}
+				else if (!alpha && content == MipContent::NormalMap)
+				{
+					value = value * 2.0f - 1.0f;
+				}
+				current.Texels[i] = value;
+			}
+		});
+
+		for (size_t level = 1; level < out.Levels.size(); level++)
+		{
+			current = Downsample(current, options);
+			Encode(current, content, out.Bytes.data() + out.Levels[level].Offset);
+		}
+		return true;
+	}
+
+	uint64_t MipGenerator::GetOptionsHash(MipContent content, const MipOptions& options)
+	{
+		uint64_t hash = Hash::Combine(Hash::FNV1a("MipGenerator"), FilterVersion);
+		hash = Hash::Combine(hash, static_cast<uint64_t>(content));
+		hash = Hash::Combine(hash, static_cast<uint64_t>(options.Filter));
+		if (options.Filter == MipFilter::Kaiser)
+		{
+			hash = Hash::Combine(hash, Hash::Bytes(&options.KaiserAlpha, sizeof(float)));
+			hash = Hash::Combine(hash, Hash::Bytes(&options.KaiserWidth, sizeof(float)));
+		}
+		return hash;
+	}
+}
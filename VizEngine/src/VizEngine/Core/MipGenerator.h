@@ -0,0 +1,58 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/TextureData.h"
+#include <cstdint>
+
+namespace VizEngine
+{
+	enum class MipFilter
+	{
+		Box,    // 2x2 average: fastest, slightly blurry
+		Kaiser  // Kaiser-windowed sinc: sharper mips without visible ringing
+	};
+
+	/**
+	 * What the texels mean, which decides how they may be averaged.
+	 */
+	enum class MipContent
+	{
+		Color,      // sRGB encoded color: filtered in linear space
+		Linear,     // Data (metallic/roughness, occlusion, masks): filtered as stored
+		NormalMap   // Tangent-space normals: filtered, then renormalized
+	};
+
+	struct MipOptions
+	{
+		MipFilter Filter = MipFilter::Kaiser;
+		float KaiserAlpha = 4.0f;   // Window shape: higher is smoother, less ringing
+		float KaiserWidth = 3.0f;   // Filter support in destination texels
+	};
+
+	/**
+	 * Builds complete RGBA8 mip chains on the CPU, so textures upload with
+	 * their mips instead of calling glGenerateMipmap on the GL thread.
+	 *
+	 * Unlike glGenerateMipmap (which averages the stored values), color is
+	 * converted to linear light before filtering and normal maps are
+	 * renormalized per level. Each level is filtered from the previous one in
+	 * floating point, with the rows of every pass spread over the ThreadPool
+	 * (the calling thread helps, so this may run inside a pool job).
+	 */
+	class VizEngine_API MipGenerator
+	{
+	public:
+		/**
+		 * Build the chain down to 1x1 for an RGBA8 image.
+		 * `out` holds GL_RGBA8 levels, level 0 being a copy of `rgba`.
+		 * @return false for empty images
+		 */
+		static bool Generate(const uint8_t* rgba, int width, int height, MipContent content,
+			const MipOptions& options, TextureData& out);
+
+		/**
+		 * Hash of everything that changes the generated chain.
+		 */
+		static uint64_t GetOptionsHash(MipContent content, const MipOptions& options);
+	};
+}
@@ -1,5 +1,15 @@
 #include "Model.h"
+#include "AccessorDecoder.h"
+#include "AssetManager.h"
+#include "Hash.h"
+#include "Ktx2.h"
+#include "MeshCache.h"
+#include "MeshoptDecoder.h"
+#include "ThreadPool.h"
+#include "UploadQueue.h"
 #include "VizEngine/Log.h"
+#include "stb_image.h"
+#include "gtc/quaternion.hpp"
 
 // tinygltf is header-only, implementation is in TinyGLTF.cpp
 // Must match the defines used in TinyGLTF.cpp
@@ -8,35 +18,202 @@
 #define TINYGLTF_NO_INCLUDE_STB_IMAGE_WRITE
 #include "tiny_gltf.h"
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <future>
+#include <limits>
 
 namespace VizEngine
 {
 	// Default material for meshes without one assigned
 	PBRMaterial Model::s_DefaultMaterial = PBRMaterial(glm::vec4(0.8f, 0.8f, 0.8f, 1.0f), 0.0f, 0.5f);
 
+
 	//==========================================================================
-	// ModelLoader - Internal helper class to keep tinygltf out of header
+	// Image decoding (runs on ThreadPool workers, no GL calls)
 	//==========================================================================
-	class Model::ModelLoader
+	struct DecodedImage
 	{
-	public:
-		static std::unique_ptr<Model> Load(const std::string& filepath);
+		std::unique_ptr<stbi_uc, void(*)(void*)> Pixels{ nullptr, stbi_image_free };
+		int Width = 0;
+		int Height = 0;
+		int Channels = 0;
+		double DecodeMs = 0.0;
+		const char* Error = nullptr;  // stb_image failure reason (thread-local, so captured here)
+
+		// KTX2 images (KHR_texture_basisu) and compressed images keep their
+		// block-compressed mips instead of Pixels. Container holds the KTX2
+		// encoding of compressed images for the mesh cache.
+		std::unique_ptr<TextureData> Prepared;
+		std::vector<uint8_t> Container;
+		bool Compressed = false;   // Encoded during this load
+		bool CacheHit = false;     // Read from the texture cache
+		bool Mipmapped = false;    // Uncompressed mips built during this load
+		std::string CachePath;     // Texture cache file of compressed images
+
+		// AssetManager key of the encoded image; Shared is set (and Pixels not)
+		// when a live texture with the same content was found
+		uint64_t ContentKey = 0;
+		std::shared_ptr<Texture> Shared;
+	};
 
-	private:
-		ModelLoader(Model* model, const std::string& filepath);
+	/**
+	 * Everything a mesh cache write reads. Data points into the vectors and
+	 * pixel buffers moved in here, so the worker that writes the cache owns
+	 * only CPU memory - never a texture or the loader (GL objects must be
+	 * destroyed on the GL thread).
+	 */
+	struct PendingCacheWrite
+	{
+		std::string FilePath;
+		std::string CacheDirectory;
+		MeshCacheData Data;
+		std::vector<std::vector<Vertex>> Vertices;
+		std::vector<std::vector<PackedVertex>> PackedVertices;
+		std::vector<std::vector<unsigned int>> Indices;
+		std::vector<std::vector<MeshLod>> Lods;
+		std::vector<std::vector<Meshlet>> Meshlets;
+		std::vector<std::vector<unsigned char>> EncodedImages;
+		std::vector<std::unique_ptr<stbi_uc, void(*)(void*)>> Pixels;
+		std::vector<std::vector<uint8_t>> Containers;
+	};
 
-		void LoadMaterials(const tinygltf::Model& gltfModel);
-		void LoadMeshes(const tinygltf::Model& gltfModel);
-		void LoadIndices(const tinygltf::Model& gltfModel,
-			const tinygltf::Accessor& accessor,
-			std::vector<unsigned int>& indices);
-		std::shared_ptr<Texture> LoadTexture(const tinygltf::Model& gltfModel, int textureIndex);
+	// Distinguishes glTF images (RGBA8, not flipped) from other users of the texture table
+	static constexpr uint64_t GltfImageTag = Hash::FNV1a("glTF image RGBA8");
+
+	// Decode encoded image bytes.
+	// Always expands to RGBA, matching tinygltf's default image loader.
+	// KTX2 containers are parsed (and transcoded, for Basis) instead.
+	static DecodedImage DecodeImage(const unsigned char* bytes, size_t size)
+	{
+		auto start = std::chrono::steady_clock::now();
+		DecodedImage result;
+		int channelsInFile = 0;
+
+		if (Ktx2::IsKtx2(bytes, size))
+		{
+			auto prepared = std::make_unique<TextureData>();
+			if (Ktx2::Parse(bytes, size, *prepared, "glTF image"))
+			{
+				result.Width = prepared->GetWidth();
+				result.Height = prepared->GetHeight();
+				result.Prepared = std::move(prepared);
+			}
+			else
+			{
+				result.Error = "unsupported KTX2 image";
+			}
+			result.DecodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			return result;
+		}
+
+		// glTF uses a top-left UV origin, so images are never flipped.
+		// The thread-local setting leaves Texture(path)'s global flip alone.
+		stbi_set_flip_vertically_on_load_thread(0);
+
+		stbi_uc* pixels = nullptr;
+		if (bytes && size > 0)
+		{
+			pixels = stbi_load_from_memory(bytes, static_cast<int>(size), &result.Width, &result.Height, &channelsInFile, 4);
+		}
+
+		result.Pixels.reset(pixels);
+		result.Channels = pixels ? 4 : 0;
+		if (!pixels)
+		{
+			result.Error = stbi_failure_reason() ? stbi_failure_reason() : "no image data";
+		}
+		result.DecodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return result;
+	}
+
+	// Decode and compress to BCn, or read an earlier result from the texture cache.
+	static DecodedImage DecodeCompressed(const unsigned char* bytes, size_t size, const std::string& cachePath,
+		MipContent content, const MipOptions& mips, const TextureCompressionOptions& options)
+	{
+		auto start = std::chrono::steady_clock::now();
+		auto prepared = std::make_unique<TextureData>();
+		DecodedImage result;
+		result.CachePath = cachePath;
+
+		if (TextureCompressor::LoadCached(cachePath, *prepared))
+		{
+			result.CacheHit = true;
+		}
+		else
+		{
+			DecodedImage decoded = DecodeImage(bytes, size);
+			if (!decoded.Pixels)
+			{
+				return decoded;
+			}
+			BlockFormat format = TextureCompressor::ChooseFormat(decoded.Pixels.get(), decoded.Width, decoded.Height, content, options);
+			TextureCompressor::Compress(decoded.Pixels.get(), decoded.Width, decoded.Height, format, content, mips, *prepared);
+			TextureCompressor::Store(cachePath, *prepared);
+			result.Compressed = true;
+		}
+
+		result.Width = prepared->GetWidth();
+		result.Height = prepared->GetHeight();
+		result.Prepared = std::move(prepared);
+		result.DecodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return result;
+	}
+
+	// Decode and build the RGBA8 mip chain (see MipGenerator).
+	static DecodedImage DecodeWithMips(const unsigned char* bytes, size_t size, MipContent content, const MipOptions& mips)
+	{
+		auto start = std::chrono::steady_clock::now();
+		DecodedImage decoded = DecodeImage(bytes, size);
+		if (!decoded.Pixels)
+		{
+			return decoded;
+		}
+
+		auto prepared = std::make_unique<TextureData>();
+		if (MipGenerator::Generate(decoded.Pixels.get(), decoded.Width, decoded.Height, content, mips, *prepared))
+		{
+			decoded.Pixels.reset();
+			decoded.Channels = 0;
+			decoded.Prepared = std::move(prepared);
+			decoded.Mipmapped = true;
+		}
+		decoded.DecodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return decoded;
+	}
+
+	// tinygltf image callback: keep the encoded bytes and defer decoding to
+	// the worker pool instead of decoding serially during parsing.
+	static bool CaptureEncodedImage(tinygltf::Image* image, const int imageIndex,
+		std::string* err, std::string* warn, int reqWidth, int reqHeight,
+		const unsigned char* bytes, int size, void* userData)
+	{
+		(void)image; (void)warn; (void)reqWidth; (void)reqHeight;
+
+		if (imageIndex < 0 || !bytes || size <= 0)
+		{
+			if (err)
+			{
+				*err += "Invalid image data for image " + std::to_string(imageIndex) + "\n";
+			}
+			return false;
+		}
+
+		auto& encodedImages = *static_cast<std::vector<std::vector<unsigned char>>*>(userData);
+		if (encodedImages.size() <= static_cast<size_t>(imageIndex))
+		{
+			encodedImages.resize(static_cast<size_t>(imageIndex) + 1);
+		}
+		encodedImages[imageIndex].assign(bytes, bytes + size);
+		return true;
+	}
 
-		Model* m_Model;
-		std::string m_Directory;
-		std::unordered_map<int, std::shared_ptr<Texture>> m_TextureCache;
-	};
 
 	//==========================================================================
 	// Helper functions
@@ -59,214 +236,1420 @@ namespace VizEngine
 		return str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
 	}
 
-	template<typename T>
-	static const T* GetBufferData(const tinygltf::Model& model, const tinygltf::Accessor& accessor)
+	static std::string ResolveUri(const std::string& directory, const std::string& uri)
+	{
+		return directory.empty() ? uri : directory + "/" + uri;
+	}
+
+	static bool IsDataUri(const std::string& uri)
+	{
+		return uri.compare(0, 5, "data:") == 0;
+	}
+
+	static double ElapsedMs(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	static void LogLoadStats(const std::string& name, const ModelLoadStats& stats)
+	{
+		VP_CORE_INFO("Load breakdown '{}': {} {:.2f} ms, meshes {:.2f} ms, "
+			"{} KB of vertices, {} KB of indices, {} textures (decode {:.2f} ms across {} workers, waited {:.2f} ms, upload {:.2f} ms), "
+			"{} textures and {} meshes shared",
+			name, stats.FromCache ? "cache read" : "parse", stats.ParseMs, stats.MeshMs, stats.VertexBytes / 1024, stats.IndexBytes / 1024,
+			stats.TexturesLoaded, stats.DecodeWorkerMs, ThreadPool::Get().GetThreadCount(),
+			stats.DecodeWaitMs, stats.UploadMs, stats.TexturesShared, stats.MeshesShared);
+
+		if (stats.CacheAfter.Triangles > 0)
+		{
+			VP_CORE_INFO("Mesh optimization '{}': {:.2f} ms, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+				name, stats.OptimizeMs, stats.CacheBefore.GetACMR(), stats.CacheAfter.GetACMR(),
+				stats.CacheBefore.GetATVR(), stats.CacheAfter.GetATVR());
+		}
+
+		if (stats.LodLevels > 0)
+		{
+			VP_CORE_INFO("LOD generation '{}': {:.2f} ms, {} levels", name, stats.LodMs, stats.LodLevels);
+		}
+
+		if (stats.Meshlets > 0)
+		{
+			VP_CORE_INFO("Meshlets '{}': {:.2f} ms, {} meshlets", name, stats.MeshletMs, stats.Meshlets);
+		}
+
+		if (stats.MeshoptViews > 0 || stats.QuantizedMeshes > 0)
+		{
+			VP_CORE_INFO("Compressed glTF '{}': {} bufferViews ({} KB) decoded in {:.2f} ms, {} meshes packed from quantized positions",
+				name, stats.MeshoptViews, stats.MeshoptBytes / 1024, stats.MeshoptMs, stats.QuantizedMeshes);
+		}
+
+		if (stats.TexturesCompressed > 0 || stats.TextureCacheHits > 0)
+		{
+			VP_CORE_INFO("Texture compression '{}': {} compressed, {} from the texture cache",
+				name, stats.TexturesCompressed, stats.TextureCacheHits);
+		}
+		if (stats.TexturesMipmapped > 0)
+		{
+			VP_CORE_INFO("Texture mips '{}': {} chains built on the workers", name, stats.TexturesMipmapped);
+		}
+	}
+
+	uint64_t Model::GetOptionsHash(const ModelLoadOptions& options)
+	{
+		uint64_t hash = Hash::FNV1a("ModelLoadOptions");
+		hash = Hash::Combine(hash, options.PackVertices ? 1 : 0);
+		hash = Hash::Combine(hash, static_cast<uint64_t>(options.Packing.Position));
+		hash = Hash::Combine(hash, static_cast<uint64_t>(options.Packing.Normal));
+		hash = Hash::Combine(hash, options.OptimizeMeshes ? 1 : 0);
+		hash = Hash::Combine(hash, options.GenerateLods ? 1 : 0);
+		if (options.GenerateLods)
+		{
+			hash = Hash::Combine(hash, options.Lods.MaxLods);
+			hash = Hash::Combine(hash, Hash::Bytes(&options.Lods.Ratio, sizeof(float)));
+			hash = Hash::Combine(hash, Hash::Bytes(&options.Lods.MaxError, sizeof(float)));
+			hash = Hash::Combine(hash, options.Lods.MinTriangles);
+		}
+		hash = Hash::Combine(hash, options.BuildMeshlets ? 1 : 0);
+		if (options.BuildMeshlets)
+		{
+			hash = Hash::Combine(hash, options.Meshlets.MaxVertices);
+			hash = Hash::Combine(hash, options.Meshlets.MaxTriangles);
+			hash = Hash::Combine(hash, Hash::Bytes(&options.Meshlets.ConeWeight, sizeof(float)));
+			hash = Hash::Combine(hash, options.Meshlets.MinTriangles);
+		}
+		hash = Hash::Combine(hash, options.CompressTextures ? 1 : 0);
+		if (options.CompressTextures)
+		{
+			hash = Hash::Combine(hash, TextureCompressor::GetOptionsHash(options.Compression, MipContent::Color, options.Mips));
+		}
+		hash = Hash::Combine(hash, options.GenerateMips ? 1 : 0);
+		if (options.GenerateMips)
+		{
+			hash = Hash::Combine(hash, MipGenerator::GetOptionsHash(MipContent::Color, options.Mips));
+		}
+		return hash;
+	}
+
+	static size_t ImageBytes(const MeshCacheImage& image)
+	{
+		return static_cast<size_t>(image.Width) * image.Height * image.Channels;
+	}
+
+	// Image index referenced by a glTF texture, or -1
+	static int GetImageIndex(const tinygltf::Model& gltfModel, int textureIndex)
+	{
+		if (textureIndex < 0 || textureIndex >= static_cast<int>(gltfModel.textures.size()))
+		{
+			return -1;
+		}
+		const tinygltf::Texture& texture = gltfModel.textures[textureIndex];
+		int source = texture.source;
+
+		// KHR_texture_basisu points at a KTX2 image; `source` is then an optional
+		// PNG/JPEG fallback for loaders that can't transcode it
+		auto basisu = texture.extensions.find("KHR_texture_basisu");
+		if (basisu != texture.extensions.end() && basisu->second.Has("source") &&
+			(Ktx2::IsTranscoderAvailable() || source < 0))
+		{
+			source = basisu->second.Get("source").GetNumberAsInt();
+		}
+		return (source >= 0 && source < static_cast<int>(gltfModel.images.size())) ? source : -1;
+	}
+
+	static int ComponentsPerElement(int type)
+	{
+		switch (type)
+		{
+			case TINYGLTF_TYPE_SCALAR: return 1;
+			case TINYGLTF_TYPE_VEC2:   return 2;
+			case TINYGLTF_TYPE_VEC3:   return 3;
+			case TINYGLTF_TYPE_VEC4:   return 4;
+			case TINYGLTF_TYPE_MAT2:   return 4;
+			case TINYGLTF_TYPE_MAT3:   return 9;
+			case TINYGLTF_TYPE_MAT4:   return 16;
+			default:                   return 0;
+		}
+	}
+
+	// Pointer to `requiredBytes` at `byteOffset` inside a bufferView, or nullptr if out of bounds
+	static const uint8_t* GetBufferViewData(const tinygltf::Model& model, int bufferViewIndex,
+		size_t byteOffset, size_t requiredBytes, const std::string& attributeName)
 	{
 		// Validate bufferView index
-		if (accessor.bufferView < 0 || accessor.bufferView >= static_cast<int>(model.bufferViews.size()))
+		if (bufferViewIndex < 0 || bufferViewIndex >= static_cast<int>(model.bufferViews.size()))
 		{
-			VP_CORE_ERROR("Accessor bufferView index {} out of range", accessor.bufferView);
+			VP_CORE_WARN("{} bufferView index {} out of range", attributeName, bufferViewIndex);
 			return nullptr;
 		}
-		
-		const auto& bufferView = model.bufferViews[accessor.bufferView];
-		
+
+		const auto& bufferView = model.bufferViews[bufferViewIndex];
+
 		// Validate buffer index
 		if (bufferView.buffer < 0 || bufferView.buffer >= static_cast<int>(model.buffers.size()))
 		{
-			VP_CORE_ERROR("BufferView buffer index {} out of range", bufferView.buffer);
+			VP_CORE_WARN("{} buffer index {} out of range", attributeName, bufferView.buffer);
 			return nullptr;
 		}
-		
+
 		const auto& buffer = model.buffers[bufferView.buffer];
-		
-		// Calculate expected element size based on accessor type
-		// VEC3 = 3 components, VEC4 = 4 components, VEC2 = 2 components, SCALAR = 1 component
-		size_t componentsPerElement = 1;
-		switch (accessor.type)
-		{
-			case TINYGLTF_TYPE_SCALAR: componentsPerElement = 1; break;
-			case TINYGLTF_TYPE_VEC2:   componentsPerElement = 2; break;
-			case TINYGLTF_TYPE_VEC3:   componentsPerElement = 3; break;
-			case TINYGLTF_TYPE_VEC4:   componentsPerElement = 4; break;
-			case TINYGLTF_TYPE_MAT2:   componentsPerElement = 4; break;
-			case TINYGLTF_TYPE_MAT3:   componentsPerElement = 9; break;
-			case TINYGLTF_TYPE_MAT4:   componentsPerElement = 16; break;
-		}
-		size_t elementSize = componentsPerElement * sizeof(T);
-		
-		// Check for interleaved data - stride must be 0 (tightly packed) or match element size
-		if (bufferView.byteStride != 0 && bufferView.byteStride != elementSize)
+
+		// Data must lie within the bufferView, and the bufferView within the buffer
+		size_t viewEnd = static_cast<size_t>(bufferView.byteOffset) + static_cast<size_t>(bufferView.byteLength);
+		if (viewEnd > buffer.data.size() || byteOffset > bufferView.byteLength ||
+			requiredBytes > bufferView.byteLength - byteOffset)
 		{
-			VP_CORE_ERROR("glTF buffer has unsupported byteStride ({}), expected 0 or {}", 
-				bufferView.byteStride, elementSize);
+			VP_CORE_WARN("{} data (offset {} + {} bytes) exceeds its bufferView ({} bytes)",
+				attributeName, byteOffset, requiredBytes, static_cast<size_t>(bufferView.byteLength));
 			return nullptr;
 		}
-		
-		// Validate that offsets don't exceed buffer size
-		size_t totalOffset = bufferView.byteOffset + accessor.byteOffset;
-		if (totalOffset > buffer.data.size())
+
+		return buffer.data.data() + bufferView.byteOffset + byteOffset;
+	}
+
+	// Resolve an accessor (any stride, component type or sparse) to a bounds-checked view
+	static bool GetAccessorView(const tinygltf::Model& model, const tinygltf::Accessor& accessor,
+		AccessorView& view, const std::string& attributeName)
+	{
+		view = AccessorView();
+		view.Count = accessor.count;
+		view.Component = static_cast<AccessorComponent>(accessor.componentType);
+		view.Components = ComponentsPerElement(accessor.type);
+		view.Normalized = accessor.normalized;
+
+		size_t componentSize = AccessorDecoder::ComponentSize(view.Component);
+		if (componentSize == 0 || view.Components < 1 || view.Components > 4)
 		{
-			VP_CORE_ERROR("Buffer offset ({}) exceeds buffer size ({})", totalOffset, buffer.data.size());
-			return nullptr;
+			VP_CORE_WARN("{} has an unsupported format (component type {}, type {})",
+				attributeName, accessor.componentType, accessor.type);
+			return false;
 		}
-		
-		// Validate that the entire data range is within bounds
-		size_t requiredBytes = accessor.count * elementSize;
-		if (totalOffset + requiredBytes > buffer.data.size())
+		size_t elementSize = componentSize * view.Components;
+
+		// Dense data (absent for sparse accessors that only store overrides)
+		if (accessor.bufferView >= 0)
 		{
-			VP_CORE_ERROR("Buffer data range (offset {} + {} bytes) exceeds buffer size ({})", 
-				totalOffset, requiredBytes, buffer.data.size());
-			return nullptr;
+			size_t byteStride = 0;
+			if (accessor.bufferView < static_cast<int>(model.bufferViews.size()))
+			{
+				byteStride = model.bufferViews[accessor.bufferView].byteStride;
+			}
+			view.Stride = byteStride != 0 ? byteStride : elementSize;
+			if (view.Stride < elementSize)
+			{
+				VP_CORE_WARN("{} byteStride ({}) is smaller than its element size ({})",
+					attributeName, view.Stride, elementSize);
+				return false;
+			}
+
+			size_t requiredBytes = view.Count > 0 ? view.Stride * (view.Count - 1) + elementSize : 0;
+			view.Data = GetBufferViewData(model, accessor.bufferView, accessor.byteOffset, requiredBytes, attributeName);
+			if (!view.Data)
+			{
+				return false;
+			}
 		}
-		
-		return reinterpret_cast<const T*>(
-			buffer.data.data() + totalOffset
-		);
+		else
+		{
+			view.Stride = elementSize;
+		}
+
+		if (accessor.sparse.isSparse && accessor.sparse.count > 0)
+		{
+			const auto& sparse = accessor.sparse;
+			view.SparseCount = static_cast<size_t>(sparse.count);
+			view.SparseIndexComponent = static_cast<AccessorComponent>(sparse.indices.componentType);
+
+			size_t indexSize = AccessorDecoder::ComponentSize(view.SparseIndexComponent);
+			if (indexSize == 0 || view.SparseIndexComponent == AccessorComponent::Byte ||
+				view.SparseIndexComponent == AccessorComponent::Short || view.SparseIndexComponent == AccessorComponent::Float)
+			{
+				VP_CORE_WARN("{} has an unsupported sparse index type {}", attributeName, sparse.indices.componentType);
+				return false;
+			}
+
+			view.SparseIndices = GetBufferViewData(model, sparse.indices.bufferView,
+				sparse.indices.byteOffset, view.SparseCount * indexSize, attributeName + " sparse indices");
+			view.SparseValues = GetBufferViewData(model, sparse.values.bufferView,
+				sparse.values.byteOffset, view.SparseCount * elementSize, attributeName + " sparse values");
+			if (!view.SparseIndices || !view.SparseValues)
+			{
+				return false;
+			}
+		}
+
+		return true;
 	}
 
-	// Helper function to validate buffer bounds for vertex attributes
-	static bool ValidateAttributeBuffer(
-		const tinygltf::Model& gltfModel,
-		const tinygltf::Accessor& accessor,
-		size_t vertexCount,
-		size_t componentsPerVertex,
-		const std::string& attributeName)
+	// Look up an optional vertex attribute with `count` elements (warns if it is present but unusable)
+	static bool FindAttributeView(const tinygltf::Model& gltfModel, const tinygltf::Primitive& primitive,
+		const char* attributeName, size_t count, AccessorView& view)
 	{
-		// Validate bufferView index
-		if (accessor.bufferView < 0 || accessor.bufferView >= static_cast<int>(gltfModel.bufferViews.size()))
+		auto it = primitive.attributes.find(attributeName);
+		if (it == primitive.attributes.end())
 		{
-			VP_CORE_WARN("{} bufferView index out of range, skipping attribute", attributeName);
 			return false;
 		}
-		
-		const auto& bufferView = gltfModel.bufferViews[accessor.bufferView];
-		
-		// Validate buffer index
-		if (bufferView.buffer < 0 || bufferView.buffer >= static_cast<int>(gltfModel.buffers.size()))
+
+		int accessorIndex = it->second;
+		if (accessorIndex < 0 || accessorIndex >= static_cast<int>(gltfModel.accessors.size()))
 		{
-			VP_CORE_WARN("{} buffer index out of range, skipping attribute", attributeName);
+			VP_CORE_WARN("{} accessor index {} out of range", attributeName, accessorIndex);
 			return false;
 		}
-		
-		const auto& buffer = gltfModel.buffers[bufferView.buffer];
-		size_t requiredBytes = vertexCount * componentsPerVertex * sizeof(float);
-		
-		// Check for underflow before calculating available bytes
-		size_t totalOffset = bufferView.byteOffset + accessor.byteOffset;
-		if (totalOffset > buffer.data.size())
+
+		const auto& accessor = gltfModel.accessors[accessorIndex];
+		if (accessor.count != count)
 		{
-			VP_CORE_WARN("{} buffer offset exceeds buffer size, skipping attribute", attributeName);
+			VP_CORE_WARN("{} has {} elements, expected {}, skipping attribute",
+				attributeName, accessor.count, count);
 			return false;
 		}
-		
-		size_t availableBytes = buffer.data.size() - totalOffset;
-		if (requiredBytes > availableBytes)
+		return GetAccessorView(gltfModel, accessor, view, attributeName);
+	}
+
+	static constexpr float PositionDefaults[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	static constexpr float NormalDefaults[4] = { 0.0f, 1.0f, 0.0f, 0.0f };
+	static constexpr float ColorDefaults[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	static constexpr float TexCoordDefaults[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+	// Decode an optional vertex attribute into `vertices`, or fill it with `defaults`
+	static void LoadAttribute(const tinygltf::Model& gltfModel, const tinygltf::Primitive& primitive,
+		const char* attributeName, std::vector<Vertex>& vertices, size_t memberOffset,
+		int components, const float defaults[4])
+	{
+		uint8_t* dst = reinterpret_cast<uint8_t*>(vertices.data()) + memberOffset;
+
+		AccessorView view;
+		if (FindAttributeView(gltfModel, primitive, attributeName, vertices.size(), view) &&
+			AccessorDecoder::DecodeFloat(view, dst, sizeof(Vertex), components, defaults))
 		{
-			VP_CORE_WARN("{} buffer too small, skipping attribute", attributeName);
-			return false;
+			return;
 		}
-		return true;
+
+		AccessorDecoder::Fill(dst, sizeof(Vertex), vertices.size(), components, defaults);
 	}
 
 	//==========================================================================
-	// Model public interface
+	// KHR_mesh_quantization
 	//==========================================================================
-	std::unique_ptr<Model> Model::LoadFromFile(const std::string& filepath)
+	// Quantized positions are integers; the exporter moves the dequantization
+	// (scale and offset back to model units) into the node that instances the
+	// mesh. Meshes with integer positions therefore take their node's world
+	// transform, while float meshes stay in mesh space as before.
+
+	// Local transform of a node: its matrix, or translation * rotation * scale
+	static glm::mat4 GetNodeTransform(const tinygltf::Node& node)
 	{
-		return ModelLoader::Load(filepath);
+		glm::mat4 transform(1.0f);
+		if (node.matrix.size() == 16)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				transform[i / 4][i % 4] = static_cast<float>(node.matrix[i]);
+			}
+			return transform;
+		}
+
+		if (node.translation.size() == 3)
+		{
+			transform = glm::translate(transform, glm::vec3(static_cast<float>(node.translation[0]),
+				static_cast<float>(node.translation[1]), static_cast<float>(node.translation[2])));
+		}
+		if (node.rotation.size() == 4)
+		{
+			// glTF stores x, y, z, w; glm::quat takes w first
+			glm::quat rotation(static_cast<float>(node.rotation[3]), static_cast<float>(node.rotation[0]),
+				static_cast<float>(node.rotation[1]), static_cast<float>(node.rotation[2]));
+			transform = transform * glm::mat4_cast(rotation);
+		}
+		if (node.scale.size() == 3)
+		{
+			transform = glm::scale(transform, glm::vec3(static_cast<float>(node.scale[0]),
+				static_cast<float>(node.scale[1]), static_cast<float>(node.scale[2])));
+		}
+		return transform;
 	}
 
-	size_t Model::GetMaterialIndexForMesh(size_t meshIndex) const
+	// World transform of the first node instancing each mesh (identity for meshes no node uses)
+	static std::vector<glm::mat4> GetMeshTransforms(const tinygltf::Model& gltfModel)
 	{
-		if (meshIndex < m_MeshMaterialIndices.size())
+		std::vector<glm::mat4> transforms(gltfModel.meshes.size(), glm::mat4(1.0f));
+		std::vector<bool> assigned(gltfModel.meshes.size(), false);
+		std::vector<bool> visited(gltfModel.nodes.size(), false);
+
+		auto visit = [&](auto&& self, int nodeIndex, const glm::mat4& parent) -> void
 		{
-			return m_MeshMaterialIndices[meshIndex];
+			// Malformed files may share or loop nodes; each is visited once
+			if (nodeIndex < 0 || nodeIndex >= static_cast<int>(gltfModel.nodes.size()) || visited[nodeIndex])
+			{
+				return;
+			}
+			visited[nodeIndex] = true;
+
+			const tinygltf::Node& node = gltfModel.nodes[nodeIndex];
+			glm::mat4 world = parent * GetNodeTransform(node);
+			if (node.mesh >= 0 && node.mesh < static_cast<int>(transforms.size()) && !assigned[node.mesh])
+			{
+				transforms[node.mesh] = world;
+				assigned[node.mesh] = true;
+			}
+			for (int child : node.children)
+			{
+				self(self, child, world);
+			}
+		};
+
+		// Roots of the default scene, or every node that is nobody's child
+		std::vector<int> roots;
+		if (!gltfModel.scenes.empty())
+		{
+			int scene = gltfModel.defaultScene >= 0 && gltfModel.defaultScene < static_cast<int>(gltfModel.scenes.size())
+				? gltfModel.defaultScene : 0;
+			roots = gltfModel.scenes[scene].nodes;
 		}
-		return 0;
+		else
+		{
+			std::vector<bool> isChild(gltfModel.nodes.size(), false);
+			for (const tinygltf::Node& node : gltfModel.nodes)
+			{
+				for (int child : node.children)
+				{
+					if (child >= 0 && child < static_cast<int>(isChild.size()))
+					{
+						isChild[child] = true;
+					}
+				}
+			}
+			for (size_t i = 0; i < gltfModel.nodes.size(); i++)
+			{
+				if (!isChild[i])
+				{
+					roots.push_back(static_cast<int>(i));
+				}
+			}
+		}
+
+		for (int root : roots)
+		{
+			visit(visit, root, glm::mat4(1.0f));
+		}
+		return transforms;
 	}
 
-	const PBRMaterial& Model::GetMaterialForMesh(size_t meshIndex) const
+	// Positive per-axis scale plus translation: representable by VertexFormat's scale and offset
+	static bool IsAxisAlignedScale(const glm::mat4& m)
 	{
-		size_t matIndex = GetMaterialIndexForMesh(meshIndex);
-		if (matIndex < m_Materials.size())
+		for (int column = 0; column < 3; column++)
 		{
-			return m_Materials[matIndex];
+			for (int row = 0; row < 4; row++)
+			{
+				if (row != column && m[column][row] != 0.0f)
+				{
+					return false;
+				}
+			}
+			if (m[column][column] <= 0.0f)
+			{
+				return false;
+			}
 		}
-		return s_DefaultMaterial;
+		return m[3][3] == 1.0f;
 	}
 
-	//==========================================================================
-	// ModelLoader implementation
-	//==========================================================================
-	Model::ModelLoader::ModelLoader(Model* model, const std::string& filepath)
-		: m_Model(model)
-		, m_Directory(GetDirectory(filepath))
+	// Bake a node transform into decoded vertices; mirroring transforms also flip the winding
+	static void TransformVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, const glm::mat4& transform)
 	{
+		glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+		for (Vertex& vertex : vertices)
+		{
+			vertex.Position = glm::vec4(glm::vec3(transform * glm::vec4(glm::vec3(vertex.Position), 1.0f)), vertex.Position.w);
+			glm::vec3 normal = normalMatrix * vertex.Normal;
+			float length = glm::length(normal);
+			vertex.Normal = length > 0.0f ? normal / length : vertex.Normal;
+		}
+
+		if (glm::determinant(glm::mat3(transform)) < 0.0f)
+		{
+			for (size_t i = 0; i + 2 < indices.size(); i += 3)
+			{
+				std::swap(indices[i + 1], indices[i + 2]);
+			}
+		}
+	}
+
+	static int32_t ReadInteger(const uint8_t* data, AccessorComponent component)
+	{
+		switch (component)
+		{
+			case AccessorComponent::Byte:          return static_cast<int8_t>(data[0]);
+			case AccessorComponent::UnsignedByte:  return data[0];
+			case AccessorComponent::Short:         { int16_t v; std::memcpy(&v, data, sizeof(v)); return v; }
+			case AccessorComponent::UnsignedShort: { uint16_t v; std::memcpy(&v, data, sizeof(v)); return v; }
+			default:                               return 0;
+		}
+	}
+
+	static float QuantizationStep(AccessorComponent component, bool normalized)
+	{
+		if (!normalized)
+		{
+			return 1.0f;
+		}
+		switch (component)
+		{
+			case AccessorComponent::Byte:          return 1.0f / 127.0f;
+			case AccessorComponent::UnsignedByte:  return 1.0f / 255.0f;
+			case AccessorComponent::Short:         return 1.0f / 32767.0f;
+			default:                               return 1.0f / 65535.0f;
+		}
+	}
+
+	// Decode rows [first, first + count) of an attribute into `dst`, or fill them with `defaults`
+	static void DecodeAttributeRows(const AccessorView* view, size_t first, size_t count,
+		Vertex* dst, size_t memberOffset, int components, const float defaults[4])
+	{
+		uint8_t* out = reinterpret_cast<uint8_t*>(dst) + memberOffset;
+		if (view)
+		{
+			AccessorView rows = *view;
+			rows.Data = view->Data ? view->Data + first * view->Stride : nullptr;
+			rows.Count = count;
+			if (AccessorDecoder::DecodeFloat(rows, out, sizeof(Vertex), components, defaults))
+			{
+				return;
+			}
+		}
+		AccessorDecoder::Fill(out, sizeof(Vertex), count, components, defaults);
+	}
+
+	// Quantized positions already lie on an integer grid, so they are rebased
+	// onto unorm16 per axis (within a fraction of one grid step) and the grid,
+	// followed by the node's dequantization (`transform`, which must pass
+	// IsAxisAlignedScale), becomes the format's scale and offset; the mesh
+	// never exists as float32. Normals, colors and texture coordinates are
+	// re-encoded in small batches.
+	// @return false if the primitive can't take this path (sparse data)
+	static bool PackQuantizedVertices(const tinygltf::Model& gltfModel, const tinygltf::Primitive& primitive,
+		const AccessorView& positions, const glm::mat4& transform, const VertexPackingOptions& options,
+		std::vector<PackedVertex>& out, VertexFormat& format)
+	{
+		size_t count = positions.Count;
+		AccessorView normals, colors, texCoords;
+		bool hasNormals = FindAttributeView(gltfModel, primitive, "NORMAL", count, normals);
+		bool hasColors = FindAttributeView(gltfModel, primitive, "COLOR_0", count, colors);
+		bool hasTexCoords = FindAttributeView(gltfModel, primitive, "TEXCOORD_0", count, texCoords);
+		if (count == 0 || positions.SparseCount > 0 || (hasNormals && normals.SparseCount > 0) ||
+			(hasColors && colors.SparseCount > 0) || (hasTexCoords && texCoords.SparseCount > 0))
+		{
+			return false;
+		}
+
+		size_t componentSize = AccessorDecoder::ComponentSize(positions.Component);
+		int components = std::min(positions.Components, 3);
+		auto readPosition = [&](size_t i, int c)
+		{
+			return positions.Data && c < components
+				? ReadInteger(positions.Data + i * positions.Stride + c * componentSize, positions.Component)
+				: 0;
+		};
+
+		int32_t rawMin[3];
+		int32_t rawMax[3];
+		std::fill(rawMin, rawMin + 3, std::numeric_limits<int32_t>::max());
+		std::fill(rawMax, rawMax + 3, std::numeric_limits<int32_t>::min());
+		for (size_t i = 0; i < count; i++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				int32_t value = readPosition(i, c);
+				rawMin[c] = std::min(rawMin[c], value);
+				rawMax[c] = std::max(rawMax[c], value);
+			}
+		}
+
+		float step = QuantizationStep(positions.Component, positions.Normalized);
+		format = VertexFormat();
+		format.Packed = true;
+		format.Position = PositionPrecision::Unorm16;
+		format.Normal = options.Normal;
+		for (int c = 0; c < 3; c++)
+		{
+			format.PositionOffset[c] = static_cast<float>(rawMin[c]) * step;
+			format.PositionScale[c] = static_cast<float>(rawMax[c] - rawMin[c]) * step;
+		}
+		glm::vec3 axisScale(transform[0][0], transform[1][1], transform[2][2]);
+		format.PositionOffset = format.PositionOffset * axisScale + glm::vec3(transform[3]);
+		format.PositionScale *= axisScale;
+		bool rescaleNormals = axisScale.x != axisScale.y || axisScale.x != axisScale.z;
+
+		out.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				int64_t range = rawMax[c] - rawMin[c];
+				int64_t offset = readPosition(i, c) - rawMin[c];
+				out[i].Position[c] = range > 0 ? static_cast<uint16_t>((offset * 65535 + range / 2) / range) : 0;
+			}
+			out[i].Position[3] = 0;
+		}
+
+		static constexpr size_t BatchSize = 1024;
+		std::vector<Vertex> batch(std::min(count, BatchSize));
+		for (size_t first = 0; first < count; first += BatchSize)
+		{
+			size_t rows = std::min(count - first, BatchSize);
+			DecodeAttributeRows(hasNormals ? &normals : nullptr, first, rows, batch.data(), offsetof(Vertex, Normal), 3, NormalDefaults);
+			DecodeAttributeRows(hasColors ? &colors : nullptr, first, rows, batch.data(), offsetof(Vertex, Color), 4, ColorDefaults);
+			DecodeAttributeRows(hasTexCoords ? &texCoords : nullptr, first, rows, batch.data(), offsetof(Vertex, TexCoords), 2, TexCoordDefaults);
+			if (rescaleNormals)
+			{
+				// Inverse transpose of a diagonal scale
+				for (size_t i = 0; i < rows; i++)
+				{
+					batch[i].Normal = glm::normalize(batch[i].Normal / axisScale);
+				}
+			}
+			VertexFormat::PackAttributes(batch.data(), rows, options, out.data() + first);
+		}
+		return true;
+	}
+
+	//==========================================================================
+	// EXT_meshopt_compression
+	//==========================================================================
+	// A compressed bufferView names the buffer holding its compressed bytes in
+	// the extension; the view itself describes where the decoded data goes, in
+	// a "fallback" buffer that normally has no data (no uri, or data meant for
+	// loaders without the extension). tinygltf refuses to load such buffers, so
+	// they get a one-byte placeholder before parsing and are sized afterwards,
+	// when the compressed views are decoded into them.
+
+	static constexpr const char* MeshoptExtension = "EXT_meshopt_compression";
+	static constexpr const char* PlaceholderBufferUri = "data:application/octet-stream;base64,AA==";
+	static constexpr uint32_t GlbJsonChunk = 0x4E4F534A;  // "JSON"
+
+	static bool ReadFileContents(const std::string& path, std::string& contents)
+	{
+		std::ifstream input(path, std::ios::binary);
+		if (!input)
+		{
+			return false;
+		}
+		contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+		return !input.bad();
+	}
+
+	/**
+	 * Replace the fallback buffers of a glTF JSON document with placeholders.
+	 * @param fallbackSizes Receives the real byteLength per buffer (0 = untouched)
+	 * @return true if the document was changed
+	 */
+	static bool ReplaceMeshoptFallbacks(std::string& json, std::vector<size_t>& fallbackSizes)
+	{
+		if (json.find(MeshoptExtension) == std::string::npos)
+		{
+			return false;
+		}
+
+		// tinygltf's bundled JSON parser; errors are left for tinygltf to report
+		nlohmann::json document = nlohmann::json::parse(json, nullptr, false);
+		if (document.is_discarded() || !document.is_object())
+		{
+			return false;
+		}
+		auto buffers = document.find("buffers");
+		if (buffers == document.end() || !buffers->is_array())
+		{
+			return false;
+		}
+
+		bool changed = false;
+		fallbackSizes.assign(buffers->size(), 0);
+		for (size_t i = 0; i < buffers->size(); i++)
+		{
+			nlohmann::json& buffer = (*buffers)[i];
+			auto extensions = buffer.find("extensions");
+			if (extensions == buffer.end() || !extensions->is_object())
+			{
+				continue;
+			}
+			auto meshopt = extensions->find(MeshoptExtension);
+			if (meshopt == extensions->end() || !meshopt->is_object())
+			{
+				continue;
+			}
+			auto fallback = meshopt->find("fallback");
+			auto byteLength = buffer.find("byteLength");
+			if (fallback == meshopt->end() || !fallback->is_boolean() || !fallback->get<bool>() ||
+				byteLength == buffer.end() || !byteLength->is_number_unsigned())
+			{
+				continue;
+			}
+
+			fallbackSizes[i] = byteLength->get<size_t>();
+			buffer["uri"] = PlaceholderBufferUri;
+			buffer["byteLength"] = 1;
+			changed = true;
+		}
+
+		if (changed)
+		{
+			json = document.dump();
+		}
+		return changed;
+	}
+
+	// GLB: 12-byte header, then the JSON chunk (length, type, data) and the BIN chunk
+	static bool ReadGlbJson(const std::string& file, std::string& json)
+	{
+		if (file.size() < 20)
+		{
+			return false;
+		}
+		uint32_t length, type;
+		std::memcpy(&length, file.data() + 12, sizeof(length));
+		std::memcpy(&type, file.data() + 16, sizeof(type));
+		if (type != GlbJsonChunk || length > file.size() - 20)
+		{
+			return false;
+		}
+		json.assign(file, 20, length);
+		return true;
+	}
+
+	static void WriteGlbJson(std::string& file, std::string json)
+	{
+		uint32_t oldLength;
+		std::memcpy(&oldLength, file.data() + 12, sizeof(oldLength));
+
+		// Chunks are 4-byte aligned; the JSON chunk is padded with spaces
+		json.resize((json.size() + 3) & ~size_t(3), ' ');
+		uint32_t length = static_cast<uint32_t>(json.size());
+
+		std::string result = file.substr(0, 12);
+		result.append(reinterpret_cast<const char*>(&length), sizeof(length));
+		result.append(reinterpret_cast<const char*>(&GlbJsonChunk), sizeof(GlbJsonChunk));
+		result += json;
+		result.append(file, 20 + size_t(oldLength), std::string::npos);
+
+		uint32_t total = static_cast<uint32_t>(result.size());
+		std::memcpy(result.data() + 8, &total, sizeof(total));
+		file = std::move(result);
+	}
+
+	struct MeshoptView
+	{
+		const uint8_t* Source = nullptr;
+		size_t SourceSize = 0;
+		uint8_t* Destination = nullptr;
+		size_t Count = 0;
+		size_t Stride = 0;
+		MeshoptMode Mode = MeshoptMode::Attributes;
+		MeshoptFilter Filter = MeshoptFilter::None;
+	};
+
+	// Resolve a bufferView's extension object to bounds-checked source and destination ranges
+	static bool GetMeshoptView(tinygltf::Model& model, const tinygltf::BufferView& bufferView,
+		const tinygltf::Value& extension, MeshoptView& view)
+	{
+		auto number = [&](const char* key, double fallback)
+		{
+			return extension.Has(key) && extension.Get(key).IsNumber() ? extension.Get(key).GetNumberAsDouble() : fallback;
+		};
+		auto string = [&](const char* key, const char* fallback)
+		{
+			return extension.Has(key) && extension.Get(key).IsString() ? extension.Get(key).Get<std::string>() : std::string(fallback);
+		};
+
+		double sourceBuffer = number("buffer", -1.0);
+		double sourceOffset = number("byteOffset", 0.0);
+		double sourceLength = number("byteLength", -1.0);
+		double stride = number("byteStride", 0.0);
+		double count = number("count", -1.0);
+		// JSON numbers are doubles; only cast integral values that fit in size_t
+		auto isSize = [](double value)
+		{
+			return value >= 0.0 && value < static_cast<double>(SIZE_MAX) && value == std::floor(value);
+		};
+		if (!isSize(sourceBuffer) || !isSize(sourceOffset) || !isSize(sourceLength) || !isSize(stride) || !isSize(count) ||
+			sourceBuffer >= static_cast<double>(model.buffers.size()) || stride < 1.0 || stride > 256.0)
+		{
+			return false;
+		}
+
+		static const std::pair<const char*, MeshoptMode> modes[] = {
+			{ "ATTRIBUTES", MeshoptMode::Attributes },
+			{ "TRIANGLES", MeshoptMode::Triangles },
+			{ "INDICES", MeshoptMode::Indices } };
+		static const std::pair<const char*, MeshoptFilter> filters[] = {
+			{ "NONE", MeshoptFilter::None },
+			{ "OCTAHEDRAL", MeshoptFilter::Octahedral },
+			{ "QUATERNION", MeshoptFilter::Quaternion },
+			{ "EXPONENTIAL", MeshoptFilter::Exponential } };
+
+		std::string mode = string("mode", "");
+		auto modeIt = std::find_if(std::begin(modes), std::end(modes), [&](const auto& m) { return mode == m.first; });
+		std::string filter = string("filter", "NONE");
+		auto filterIt = std::find_if(std::begin(filters), std::end(filters), [&](const auto& f) { return filter == f.first; });
+		if (modeIt == std::end(modes) || filterIt == std::end(filters))
+		{
+			return false;
+		}
+		view.Mode = modeIt->second;
+		view.Filter = filterIt->second;
+
+		view.Count = static_cast<size_t>(count);
+		view.Stride = static_cast<size_t>(stride);
+		if (view.Count > SIZE_MAX / view.Stride)
+		{
+			return false;
+		}
+		view.SourceSize = static_cast<size_t>(sourceLength);
+
+		const std::vector<unsigned char>& source = model.buffers[static_cast<size_t>(sourceBuffer)].data;
+		size_t offset = static_cast<size_t>(sourceOffset);
+		if (offset > source.size() || view.SourceSize > source.size() - offset)
+		{
+			return false;
+		}
+		view.Source = source.data() + offset;
+
+		if (bufferView.buffer < 0 || bufferView.buffer >= static_cast<int>(model.buffers.size()))
+		{
+			return false;
+		}
+		std::vector<unsigned char>& destination = model.buffers[bufferView.buffer].data;
+		size_t decodedSize = view.Count * view.Stride;
+		if (decodedSize > bufferView.byteLength || bufferView.byteOffset > destination.size() ||
+			decodedSize > destination.size() - bufferView.byteOffset)
+		{
+			return false;
+		}
+		view.Destination = destination.data() + bufferView.byteOffset;
+		return true;
+	}
+
+	//==========================================================================
+	// ModelLoader - Internal helper class to keep tinygltf out of header
+	//==========================================================================
+	// Loading is split into stages so it can run across threads:
+	//   CPU stage (any thread)  - map the mesh cache, or parse the glTF and
+	//                             convert meshes/materials into m_Data
+	//   Image decodes           - one ThreadPool job per image
+	//   GPU stage (GL thread)   - one step per mesh and per texture, then
+	//                             FinishModel() assembles the Model
+	// Load() runs the GPU stage inline; LoadAsync() schedules each step on
+	// the UploadQueue so it is spread over frames.
+	class Model::ModelLoader : public std::enable_shared_from_this<Model::ModelLoader>
+	{
+	public:
+		ModelLoader(const std::string& filepath, const ModelLoadOptions& options);
+
+		static std::unique_ptr<Model> Load(const std::string& filepath, const ModelLoadOptions& options);
+		static AsyncHandle<Model> LoadAsync(const std::string& filepath, const ModelLoadOptions& options);
+
+	private:
+		// CPU stage
+		bool Parse();
+		bool ReadCache();
+		bool ParseGltf();
+		bool DecodeMeshoptBuffers(tinygltf::Model& gltfModel, const std::vector<size_t>& fallbackSizes);
+		void Convert();
+		void LoadMaterials(const tinygltf::Model& gltfModel);
+		void LoadMeshes(const tinygltf::Model& gltfModel);
+		void LoadIndices(const tinygltf::Model& gltfModel,
+			const tinygltf::Accessor& accessor,
+			std::vector<unsigned int>& indices);
+		void OptimizeMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, const std::string& name);
+		std::vector<MeshLod> GenerateLods(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, const std::string& name);
+		std::vector<Meshlet> BuildMeshlets(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, std::vector<MeshLod>& lods);
+		void LoadImageTable(const tinygltf::Model& gltfModel);
+		std::vector<int> GetUsedImages() const;
+		bool NeedsDecode(int imageIndex) const { return !m_Data.Images[imageIndex].Pixels; }
+		MipContent GetImageContent(int imageIndex) const;
+		void DecodeImageAt(int imageIndex);
+
+		// GPU stage
+		void CreateMesh(size_t meshIndex);
+		void CreateTexture(int imageIndex);
+		std::unique_ptr<Model> FinishModel();
+		std::unique_ptr<PendingCacheWrite> TakeCacheWrite() { return std::move(m_CacheWrite); }
+		static void WriteCache(PendingCacheWrite& write);
+
+		// Async bookkeeping
+		void CompleteAsyncStep();
+
+		std::string m_FilePath;
+		std::string m_Directory;
+		ModelLoadOptions m_Options;
+		std::chrono::steady_clock::time_point m_StartTime;
+
+		std::unique_ptr<Model> m_Model;
+
+		// Meshes, materials and images in mesh cache layout. Pointers reference
+		// the storage below (fresh load) or m_CacheFile (warm load).
+		MeshCacheData m_Data;
+		MappedFile m_CacheFile;
+		bool m_FromCache = false;
+		std::unique_ptr<tinygltf::Model> m_Gltf;  // Released after Convert()
+		std::vector<std::vector<Vertex>> m_Vertices;
+		std::vector<std::vector<PackedVertex>> m_PackedVertices;
+		std::vector<std::vector<unsigned int>> m_Indices;
+		std::vector<std::vector<MeshLod>> m_Lods;
+		std::vector<std::vector<Meshlet>> m_Meshlets;
+		std::vector<uint64_t> m_MeshKeys;  // Content keys for AssetManager, per mesh
+
+		// Per image index: encoded bytes captured while parsing, decoded pixels
+		// (written by one decode job each) and the uploaded texture. Textures
+		// sharing an image share a GL texture.
+		std::vector<std::vector<unsigned char>> m_EncodedImages;
+		std::vector<DecodedImage> m_DecodedImages;
+		std::vector<std::shared_ptr<Texture>> m_Textures;
+
+		// Set by FinishModel() when the mesh cache should be written
+		std::unique_ptr<PendingCacheWrite> m_CacheWrite;
+
+		// LoadAsync only
+		std::promise<std::shared_ptr<Model>> m_Promise;
+		std::atomic<size_t> m_PendingSteps{ 0 };
+	};
+
+	//==========================================================================
+	// Model public interface
+	//==========================================================================
+	std::unique_ptr<Model> Model::LoadFromFile(const std::string& filepath, const ModelLoadOptions& options)
+	{
+		return ModelLoader::Load(filepath, options);
+	}
+
+	AsyncHandle<Model> Model::LoadAsync(const std::string& filepath, const ModelLoadOptions& options)
+	{
+		return ModelLoader::LoadAsync(filepath, options);
+	}
+
+	size_t Model::GetMaterialIndexForMesh(size_t meshIndex) const
+	{
+		if (meshIndex < m_MeshMaterialIndices.size())
+		{
+			return m_MeshMaterialIndices[meshIndex];
+		}
+		return 0;
+	}
+
+	const PBRMaterial& Model::GetMaterialForMesh(size_t meshIndex) const
+	{
+		size_t matIndex = GetMaterialIndexForMesh(meshIndex);
+		if (matIndex < m_Materials.size())
+		{
+			return m_Materials[matIndex];
+		}
+		return s_DefaultMaterial;
+	}
+
+	//==========================================================================
+	// ModelLoader implementation
+	//==========================================================================
+	Model::ModelLoader::ModelLoader(const std::string& filepath, const ModelLoadOptions& options)
+		: m_FilePath(filepath)
+		, m_Directory(GetDirectory(filepath))
+		, m_Options(options)
+		, m_StartTime(std::chrono::steady_clock::now())
+		, m_Model(new Model())
+	{
+		m_Model->m_FilePath = filepath;
+		m_Model->m_Name = GetFilename(filepath);
+		m_Model->m_Directory = m_Directory;
+	}
+
+	std::unique_ptr<Model> Model::ModelLoader::Load(const std::string& filepath, const ModelLoadOptions& options)
+	{
+		ModelLoader loader(filepath, options);
+		if (!loader.Parse())
+		{
+			return nullptr;
+		}
+
+		// Images decode on the worker pool while meshes are converted and
+		// uploaded here; textures are then uploaded as their decodes finish.
+		std::vector<std::pair<int, std::future<void>>> textures;
+		for (int imageIndex : loader.GetUsedImages())
+		{
+			std::future<void> decode;
+			if (loader.NeedsDecode(imageIndex))
+			{
+				decode = ThreadPool::Get().Submit([&loader, imageIndex]() { loader.DecodeImageAt(imageIndex); });
+			}
+			textures.emplace_back(imageIndex, std::move(decode));
+		}
+
+		loader.Convert();
+		for (size_t i = 0; i < loader.m_Data.Meshes.size(); i++)
+		{
+			loader.CreateMesh(i);
+		}
+
+		ModelLoadStats& stats = loader.m_Model->m_LoadStats;
+		for (auto& [imageIndex, decode] : textures)
+		{
+			if (decode.valid())
+			{
+				auto waitStart = std::chrono::steady_clock::now();
+				decode.get();
+				stats.DecodeWaitMs += ElapsedMs(waitStart);
+			}
+			loader.CreateTexture(imageIndex);
+		}
+
+		std::unique_ptr<Model> model = loader.FinishModel();
+		if (std::unique_ptr<PendingCacheWrite> write = loader.TakeCacheWrite())
+		{
+			WriteCache(*write);
+		}
+		return model;
+	}
+
+	AsyncHandle<Model> Model::ModelLoader::LoadAsync(const std::string& filepath, const ModelLoadOptions& options)
+	{
+		auto loader = std::make_shared<ModelLoader>(filepath, options);
+		AsyncHandle<Model> handle(loader->m_Promise.get_future().share());
+
+		ThreadPool::Get().Submit([loader]()
+		{
+			if (!loader->Parse())
+			{
+				loader->m_Promise.set_value(nullptr);
+				return;
+			}
+
+			std::vector<int> images = loader->GetUsedImages();
+
+			// One step per image, plus one for conversion (which adds the mesh
+			// steps before completing, so the count cannot reach zero early)
+			loader->m_PendingSteps = images.size() + 1;
+
+			for (int imageIndex : images)
+			{
+				auto upload = [loader, imageIndex]()
+				{
+					loader->CreateTexture(imageIndex);
+					loader->CompleteAsyncStep();
+				};
+
+				if (!loader->NeedsDecode(imageIndex))
+				{
+					UploadQueue::Get().Enqueue(upload);
+					continue;
+				}
+
+				ThreadPool::Get().Submit([loader, imageIndex, upload]()
+				{
+					loader->DecodeImageAt(imageIndex);
+					UploadQueue::Get().Enqueue(upload);
+				});
+			}
+
+			loader->Convert();
+
+			size_t meshCount = loader->m_Data.Meshes.size();
+			loader->m_PendingSteps += meshCount;
+			for (size_t i = 0; i < meshCount; i++)
+			{
+				UploadQueue::Get().Enqueue([loader, i]()
+				{
+					loader->CreateMesh(i);
+					loader->CompleteAsyncStep();
+				});
+			}
+
+			loader->CompleteAsyncStep();
+		});
+
+		return handle;
+	}
+
+	void Model::ModelLoader::CompleteAsyncStep()
+	{
+		if (--m_PendingSteps != 0)
+		{
+			return;
+		}
+
+		// Last step may complete on a worker (conversion); finishing touches
+		// materials and textures, so always finish on the GL thread
+		auto self = shared_from_this();
+		UploadQueue::Get().Enqueue([self]()
+		{
+			self->m_Promise.set_value(std::shared_ptr<Model>(self->FinishModel()));
+
+			// Writing the cache hashes the source file - keep it off the main thread.
+			// The job gets the cache data only, never the loader.
+			std::shared_ptr<PendingCacheWrite> write = self->TakeCacheWrite();
+			if (write)
+			{
+				ThreadPool::Get().Submit([write]() { WriteCache(*write); });
+			}
+		});
+	}
+
+	//--------------------------------------------------------------------------
+	// CPU stage
+	//--------------------------------------------------------------------------
+	bool Model::ModelLoader::Parse()
+	{
+		VP_CORE_INFO("Loading model: {}", m_FilePath);
+
+		// Check if file exists first for clearer error messages
+		if (!std::filesystem::exists(m_FilePath))
+		{
+			VP_CORE_ERROR("Model file not found: {}", m_FilePath);
+			return false;
+		}
+
+		bool success = (m_Options.UseCache && ReadCache()) || ParseGltf();
+		if (success)
+		{
+			m_DecodedImages.resize(m_Data.Images.size());
+			m_Textures.resize(m_Data.Images.size());
+			m_Model->m_LoadStats.FromCache = m_FromCache;
+			m_Model->m_LoadStats.ParseMs = ElapsedMs(m_StartTime);
+		}
+		return success;
+	}
+
+	bool Model::ModelLoader::ReadCache()
+	{
+		if (!MeshCache::Read(m_FilePath, m_Options.CacheDirectory, m_CacheFile, m_Data))
+		{
+			return false;
+		}
+
+		// An entry converted with other import options is rebuilt
+		if (m_Data.OptionsHash != GetOptionsHash(m_Options))
+		{
+			VP_CORE_TRACE("Mesh cache for '{}' was built with different import options, rebuilding", m_FilePath);
+			m_Data = MeshCacheData{};
+			m_CacheFile.Close();
+			return false;
+		}
+		m_FromCache = true;
+		return true;
+	}
+
+	bool Model::ModelLoader::ParseGltf()
+	{
+		m_Gltf = std::make_unique<tinygltf::Model>();
+		tinygltf::TinyGLTF loader;
+		loader.SetImageLoader(CaptureEncodedImage, &m_EncodedImages);
+		std::string err, warn;
+
+		bool binary = EndsWith(m_FilePath, ".glb");
+		if (!binary && !EndsWith(m_FilePath, ".gltf"))
+		{
+			VP_CORE_ERROR("Unsupported model format: {}", m_FilePath);
+			return false;
+		}
+
+		std::string file;
+		if (!ReadFileContents(m_FilePath, file))
+		{
+			VP_CORE_ERROR("Failed to read model: {}", m_FilePath);
+			return false;
+		}
+
+		// Compressed files need their fallback buffers replaced before parsing
+		std::vector<size_t> fallbackSizes;
+		bool success = false;
+		if (binary)
+		{
+			std::string json;
+			if (ReadGlbJson(file, json) && ReplaceMeshoptFallbacks(json, fallbackSizes))
+			{
+				WriteGlbJson(file, std::move(json));
+			}
+			success = loader.LoadBinaryFromMemory(m_Gltf.get(), &err, &warn,
+				reinterpret_cast<const unsigned char*>(file.data()), static_cast<unsigned int>(file.size()), m_Directory);
+		}
+		else
+		{
+			ReplaceMeshoptFallbacks(file, fallbackSizes);
+			success = loader.LoadASCIIFromString(m_Gltf.get(), &err, &warn,
+				file.data(), static_cast<unsigned int>(file.size()), m_Directory);
+		}
+		file = std::string();
+
+		if (!warn.empty())
+		{
+			VP_CORE_WARN("glTF warning: {}", warn);
+		}
+
+		if (!err.empty())
+		{
+			VP_CORE_ERROR("glTF error: {}", err);
+		}
+
+		if (!success)
+		{
+			VP_CORE_ERROR("Failed to load model: {}", m_FilePath);
+			return false;
+		}
+
+		// Compressed bufferViews must be decoded before anything reads buffer data
+		if (!DecodeMeshoptBuffers(*m_Gltf, fallbackSizes))
+		{
+			VP_CORE_ERROR("Failed to decode compressed buffers: {}", m_FilePath);
+			return false;
+		}
+
+		// Materials are needed before decoding (to know which images are used)
+		LoadMaterials(*m_Gltf);
+		LoadImageTable(*m_Gltf);
+		return true;
+	}
+
+	bool Model::ModelLoader::DecodeMeshoptBuffers(tinygltf::Model& gltfModel, const std::vector<size_t>& fallbackSizes)
+	{
+		for (size_t i = 0; i < fallbackSizes.size() && i < gltfModel.buffers.size(); i++)
+		{
+			if (fallbackSizes[i] > 0)
+			{
+				gltfModel.buffers[i].data.assign(fallbackSizes[i], 0);
+			}
+		}
+
+		std::vector<MeshoptView> views;
+		for (size_t i = 0; i < gltfModel.bufferViews.size(); i++)
+		{
+			const tinygltf::BufferView& bufferView = gltfModel.bufferViews[i];
+			auto extension = bufferView.extensions.find(MeshoptExtension);
+			if (extension == bufferView.extensions.end())
+			{
+				continue;
+			}
+
+			MeshoptView view;
+			if (!GetMeshoptView(gltfModel, bufferView, extension->second, view))
+			{
+				VP_CORE_ERROR("bufferView {} has an invalid {} description", i, MeshoptExtension);
+				return false;
+			}
+			views.push_back(view);
+		}
+
+		if (views.empty())
+		{
+			return true;
+		}
+
+		// Views decode independently into disjoint ranges, one worker job each
+		auto start = std::chrono::steady_clock::now();
+		std::vector<uint8_t> decoded(views.size(), 0);
+		ThreadPool::Get().ParallelFor(views.size(), 1, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				const MeshoptView& view = views[i];
+				decoded[i] = MeshoptDecoder::Decode(view.Destination, view.Count, view.Stride,
+					view.Source, view.SourceSize, view.Mode, view.Filter) ? 1 : 0;
+			}
+		});
+
+		ModelLoadStats& stats = m_Model->m_LoadStats;
+		stats.MeshoptMs += ElapsedMs(start);
+		for (size_t i = 0; i < views.size(); i++)
+		{
+			if (!decoded[i])
+			{
+				VP_CORE_ERROR("Compressed bufferView ({} elements of {} bytes) is corrupt", views[i].Count, views[i].Stride);
+				return false;
+			}
+			stats.MeshoptViews++;
+			stats.MeshoptBytes += views[i].Count * views[i].Stride;
+		}
+
+		VP_CORE_TRACE("Decoded {} compressed bufferViews ({} KB) in {:.2f} ms",
+			stats.MeshoptViews, stats.MeshoptBytes / 1024, stats.MeshoptMs);
+		return true;
+	}
+
+	void Model::ModelLoader::Convert()
+	{
+		// Warm loads skip this: meshes reference the mapped cache file
+		if (m_Gltf)
+		{
+			auto meshStart = std::chrono::steady_clock::now();
+			LoadMeshes(*m_Gltf);
+			m_Model->m_LoadStats.MeshMs += ElapsedMs(meshStart);
+
+			// Everything needed from the glTF (including buffers) has been copied out
+			m_Gltf.reset();
+		}
+
+		// AssetManager keys, hashed here so CreateMesh only does a lookup on the GL thread
+		m_MeshKeys.clear();
+		for (const MeshCacheMesh& mesh : m_Data.Meshes)
+		{
+			const void* vertices = mesh.Format.Packed ? static_cast<const void*>(mesh.PackedVertices) : mesh.Vertices;
+			uint64_t key = Hash::Bytes(vertices, size_t(mesh.VertexCount) * mesh.Format.GetStride());
+			key = Hash::Bytes(mesh.Indices, size_t(mesh.IndexCount) * sizeof(unsigned int), key);
+			key = Hash::Bytes(mesh.Lods, size_t(mesh.LodCount) * sizeof(MeshLod), key);
+			key = Hash::Bytes(mesh.Meshlets, size_t(mesh.MeshletCount) * sizeof(Meshlet), key);
+			key = Hash::Combine(key, (uint64_t(mesh.Format.Position) << 8) | uint64_t(mesh.Format.Normal));
+			key = Hash::Bytes(&mesh.Format.PositionScale, sizeof(glm::vec3), key);
+			key = Hash::Bytes(&mesh.Format.PositionOffset, sizeof(glm::vec3), key);
+			m_MeshKeys.push_back(key);
+		}
+	}
+
+	void Model::ModelLoader::LoadImageTable(const tinygltf::Model& gltfModel)
+	{
+		// Image table mirrors gltfModel.images so material image indices stay valid.
+		// External files are referenced by URI; embedded images get their pixels
+		// once decoded (see CreateTexture).
+		for (const auto& image : gltfModel.images)
+		{
+			MeshCacheImage entry;
+			if (!image.uri.empty() && !IsDataUri(image.uri))
+			{
+				entry.Uri = image.uri;
+			}
+			m_Data.Images.push_back(std::move(entry));
+		}
+
+		// External files whose changes must invalidate the cache entry
+		for (const auto& buffer : gltfModel.buffers)
+		{
+			if (!buffer.uri.empty() && !IsDataUri(buffer.uri))
+			{
+				m_Data.Dependencies.push_back(ResolveUri(m_Directory, buffer.uri));
+			}
+		}
+		for (const auto& image : gltfModel.images)
+		{
+			if (!image.uri.empty() && !IsDataUri(image.uri))
+			{
+				m_Data.Dependencies.push_back(ResolveUri(m_Directory, image.uri));
+			}
+		}
+	}
+
+	std::vector<int> Model::ModelLoader::GetUsedImages() const
+	{
+		// Only images that a material actually samples, and only once each
+		std::vector<bool> queued(m_Data.Images.size(), false);
+		std::vector<int> images;
+		for (const MeshCacheMaterial& material : m_Data.Materials)
+		{
+			for (int imageIndex : material.Images)
+			{
+				if (imageIndex < 0 || static_cast<size_t>(imageIndex) >= m_Data.Images.size() || queued[imageIndex])
+				{
+					continue;
+				}
+				queued[imageIndex] = true;
+				images.push_back(imageIndex);
+			}
+		}
+		return images;
+	}
+
+	MipContent Model::ModelLoader::GetImageContent(int imageIndex) const
+	{
+		// An image shared between slots is filtered for the most demanding one
+		MipContent content = MipContent::Linear;
+		for (const MeshCacheMaterial& material : m_Data.Materials)
+		{
+			if (material.Images[MeshCacheMaterial::Normal] == imageIndex)
+			{
+				return MipContent::NormalMap;
+			}
+			if (material.Images[MeshCacheMaterial::BaseColor] == imageIndex ||
+				material.Images[MeshCacheMaterial::Emissive] == imageIndex)
+			{
+				content = MipContent::Color;
+			}
+		}
+		return content;
 	}
 
-	std::unique_ptr<Model> Model::ModelLoader::Load(const std::string& filepath)
+	void Model::ModelLoader::DecodeImageAt(int imageIndex)
 	{
-		VP_CORE_INFO("Loading model: {}", filepath);
-
-		// Check if file exists first for clearer error messages
-		if (!std::filesystem::exists(filepath))
+		// Runs on a worker: only touches this image's slots
+		const std::vector<unsigned char>* encoded = static_cast<size_t>(imageIndex) < m_EncodedImages.size()
+			? &m_EncodedImages[imageIndex]
+			: nullptr;
+
+		const std::string& uri = m_Data.Images[imageIndex].Uri;
+
+		// External images are mapped so the same bytes are hashed and decoded
+		MappedFile file;
+		const unsigned char* bytes = nullptr;
+		size_t size = 0;
+		if (encoded && !encoded->empty())
 		{
-			VP_CORE_ERROR("Model file not found: {}", filepath);
-			return nullptr;
+			bytes = encoded->data();
+			size = encoded->size();
+		}
+		else if (!uri.empty() && file.Open(ResolveUri(m_Directory, uri)))
+		{
+			bytes = file.GetData();
+			size = file.GetSize();
+		}
+		if (!bytes)
+		{
+			m_DecodedImages[imageIndex].Error = "no image data";
+			return;
 		}
 
-		tinygltf::Model gltfModel;
-		tinygltf::TinyGLTF loader;
-		std::string err, warn;
-
-		// Load based on file extension
-		bool success = false;
-		if (EndsWith(filepath, ".glb"))
+		// Another model (or an earlier load of this one) may have uploaded the
+		// same image. Embedded pixels of a fresh load are still decoded, since
+		// they are written into the mesh cache.
+		uint64_t sourceKey = Hash::Bytes(bytes, size);
+		uint64_t contentKey = Hash::Combine(sourceKey, GltfImageTag);
+		bool isKtx2 = Ktx2::IsKtx2(bytes, size);
+		bool compress = m_Options.CompressTextures && !isKtx2;
+		bool generateMips = m_Options.GenerateMips && !isKtx2;
+		MipContent content = compress || generateMips ? GetImageContent(imageIndex) : MipContent::Color;
+		if (compress)
 		{
-			success = loader.LoadBinaryFromFile(&gltfModel, &err, &warn, filepath);
+			contentKey = Hash::Combine(contentKey, TextureCompressor::GetOptionsHash(m_Options.Compression, content, m_Options.Mips));
 		}
-		else if (EndsWith(filepath, ".gltf"))
+		else if (generateMips)
 		{
-			success = loader.LoadASCIIFromFile(&gltfModel, &err, &warn, filepath);
+			contentKey = Hash::Combine(contentKey, MipGenerator::GetOptionsHash(content, m_Options.Mips));
 		}
-		else
+		bool cachesPixels = uri.empty() && m_Options.UseCache && !m_FromCache;
+		if (!cachesPixels)
 		{
-			VP_CORE_ERROR("Unsupported model format: {}", filepath);
-			return nullptr;
+			if (std::shared_ptr<Texture> shared = AssetManager::Get().FindTexture(contentKey))
+			{
+				m_DecodedImages[imageIndex].ContentKey = contentKey;
+				m_DecodedImages[imageIndex].Shared = std::move(shared);
+				return;
+			}
 		}
 
-		if (!warn.empty())
+		if (compress)
 		{
-			VP_CORE_WARN("glTF warning: {}", warn);
+			std::string cachePath = TextureCompressor::GetCachePath(m_FilePath, sourceKey, content, m_Options.Mips, m_Options.Compression);
+			m_DecodedImages[imageIndex] = DecodeCompressed(bytes, size, cachePath, content, m_Options.Mips, m_Options.Compression);
 		}
-
-		if (!err.empty())
+		else if (generateMips)
 		{
-			VP_CORE_ERROR("glTF error: {}", err);
+			m_DecodedImages[imageIndex] = DecodeWithMips(bytes, size, content, m_Options.Mips);
 		}
-
-		if (!success)
+		else
 		{
-			VP_CORE_ERROR("Failed to load model: {}", filepath);
-			return nullptr;
+			m_DecodedImages[imageIndex] = DecodeImage(bytes, size);
 		}
 
-		// Create model instance
-		auto model = std::unique_ptr<Model>(new Model());
-		model->m_FilePath = filepath;
-		model->m_Name = GetFilename(filepath);
-		model->m_Directory = GetDirectory(filepath);
-
-		// Use ModelLoader to do the actual loading
-		ModelLoader modelLoader(model.get(), filepath);
-		modelLoader.LoadMaterials(gltfModel);
-		modelLoader.LoadMeshes(gltfModel);
-
-		VP_CORE_INFO("Loaded model '{}': {} meshes, {} materials",
-			model->m_Name, model->m_Meshes.size(), model->m_Materials.size());
-
-		return model;
+		DecodedImage& decoded = m_DecodedImages[imageIndex];
+		if ((compress || generateMips) && decoded.Prepared && cachesPixels)
+		{
+			// The mesh cache stores the finished mips, not the pixels
+			Ktx2::Serialize(*decoded.Prepared, decoded.Container);
+		}
+		decoded.ContentKey = contentKey;
 	}
 
 	void Model::ModelLoader::LoadMaterials(const tinygltf::Model& gltfModel)
@@ -288,30 +1671,6 @@ namespace VizEngine
 			material.Metallic = static_cast<float>(pbr.metallicFactor);
 			material.Roughness = static_cast<float>(pbr.roughnessFactor);
 
-			if (pbr.baseColorTexture.index >= 0)
-			{
-				material.BaseColorTexture = LoadTexture(gltfModel, pbr.baseColorTexture.index);
-			}
-
-			if (pbr.metallicRoughnessTexture.index >= 0)
-			{
-				material.MetallicRoughnessTexture = LoadTexture(gltfModel, pbr.metallicRoughnessTexture.index);
-			}
-
-			if (gltfMat.normalTexture.index >= 0)
-			{
-				material.NormalTexture = LoadTexture(gltfModel, gltfMat.normalTexture.index);
-			}
-
-			if (gltfMat.occlusionTexture.index >= 0)
-			{
-				material.OcclusionTexture = LoadTexture(gltfModel, gltfMat.occlusionTexture.index);
-			}
-
-			if (gltfMat.emissiveTexture.index >= 0)
-			{
-				material.EmissiveTexture = LoadTexture(gltfModel, gltfMat.emissiveTexture.index);
-			}
 			material.EmissiveFactor = glm::vec3(
 				static_cast<float>(gltfMat.emissiveFactor[0]),
 				static_cast<float>(gltfMat.emissiveFactor[1]),
@@ -334,19 +1693,26 @@ namespace VizEngine
 
 			material.DoubleSided = gltfMat.doubleSided;
 
-			m_Model->m_Materials.push_back(std::move(material));
-		}
-
-		if (m_Model->m_Materials.empty())
-		{
-			m_Model->m_Materials.push_back(Model::s_DefaultMaterial);
+			// Textures are referenced by image and attached in FinishModel(),
+			// once their GPU upload is done
+			MeshCacheMaterial entry;
+			entry.Material = std::move(material);
+			entry.Images[MeshCacheMaterial::BaseColor] = GetImageIndex(gltfModel, pbr.baseColorTexture.index);
+			entry.Images[MeshCacheMaterial::MetallicRoughness] = GetImageIndex(gltfModel, pbr.metallicRoughnessTexture.index);
+			entry.Images[MeshCacheMaterial::Normal] = GetImageIndex(gltfModel, gltfMat.normalTexture.index);
+			entry.Images[MeshCacheMaterial::Occlusion] = GetImageIndex(gltfModel, gltfMat.occlusionTexture.index);
+			entry.Images[MeshCacheMaterial::Emissive] = GetImageIndex(gltfModel, gltfMat.emissiveTexture.index);
+			m_Data.Materials.push_back(std::move(entry));
 		}
 	}
 
+
 	void Model::ModelLoader::LoadMeshes(const tinygltf::Model& gltfModel)
 	{
-		for (const auto& gltfMesh : gltfModel.meshes)
+		std::vector<glm::mat4> meshTransforms = GetMeshTransforms(gltfModel);
+		for (size_t meshIndex = 0; meshIndex < gltfModel.meshes.size(); meshIndex++)
 		{
+			const auto& gltfMesh = gltfModel.meshes[meshIndex];
 			for (const auto& primitive : gltfMesh.primitives)
 			{
 				if (primitive.mode != TINYGLTF_MODE_TRIANGLES && primitive.mode != -1)
@@ -371,132 +1737,43 @@ namespace VizEngine
 					continue;
 				}
 				const auto& posAccessor = gltfModel.accessors[posAccessorIndex];
-				const float* positions = GetBufferData<float>(gltfModel, posAccessor);
-				if (!positions)
+				AccessorView positions;
+				if (!GetAccessorView(gltfModel, posAccessor, positions, "POSITION"))
 				{
 					VP_CORE_ERROR("Failed to load positions for mesh, skipping primitive");
 					continue;
 				}
 				size_t vertexCount = posAccessor.count;
 
-
-
-				const float* normals = nullptr;  // nullptr check deferred to vertex loop
-				if (primitive.attributes.find("NORMAL") != primitive.attributes.end())
-				{
-					int normAccessorIndex = primitive.attributes.at("NORMAL");
-					if (normAccessorIndex >= 0 && normAccessorIndex < static_cast<int>(gltfModel.accessors.size()))
-					{
-						const auto& normAccessor = gltfModel.accessors[normAccessorIndex];
-						if (ValidateAttributeBuffer(gltfModel, normAccessor, vertexCount, 3, "Normal"))
-						{
-							normals = GetBufferData<float>(gltfModel, normAccessor);
-						}
-					}
-					else
-					{
-						VP_CORE_WARN("NORMAL accessor index {} out of range", normAccessorIndex);
-					}
-				}
-
-				const float* texCoords = nullptr;  // nullptr check deferred to vertex loop
-				if (primitive.attributes.find("TEXCOORD_0") != primitive.attributes.end())
-				{
-					int uvAccessorIndex = primitive.attributes.at("TEXCOORD_0");
-					if (uvAccessorIndex >= 0 && uvAccessorIndex < static_cast<int>(gltfModel.accessors.size()))
-					{
-						const auto& uvAccessor = gltfModel.accessors[uvAccessorIndex];
-						if (ValidateAttributeBuffer(gltfModel, uvAccessor, vertexCount, 2, "TexCoord"))
-						{
-							texCoords = GetBufferData<float>(gltfModel, uvAccessor);
-						}
-					}
-					else
-					{
-						VP_CORE_WARN("TEXCOORD_0 accessor index {} out of range", uvAccessorIndex);
-					}
-				}
-
-				const float* colors = nullptr;  // nullptr check deferred to vertex loop
-				int colorComponents = 0;
-				if (primitive.attributes.find("COLOR_0") != primitive.attributes.end())
-				{
-					int colorAccessorIndex = primitive.attributes.at("COLOR_0");
-					if (colorAccessorIndex >= 0 && colorAccessorIndex < static_cast<int>(gltfModel.accessors.size()))
-					{
-						const auto& colorAccessor = gltfModel.accessors[colorAccessorIndex];
-						colorComponents = (colorAccessor.type == TINYGLTF_TYPE_VEC4) ? 4 : 3;
-						if (colorAccessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT)
-						{
-							if (ValidateAttributeBuffer(gltfModel, colorAccessor, vertexCount, colorComponents, "Color"))
-							{
-								colors = GetBufferData<float>(gltfModel, colorAccessor);
-							}
-						}
-						else if (colorAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE ||
-						         colorAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
-						{
-							VP_CORE_WARN("Normalized integer COLOR_0 not yet supported, using default color");
-						}
-					}
-					else
-					{
-						VP_CORE_WARN("COLOR_0 accessor index {} out of range", colorAccessorIndex);
-					}
-				}
-
-				vertices.reserve(vertexCount);
-				for (size_t i = 0; i < vertexCount; i++)
+				// Quantized positions (KHR_mesh_quantization) are dequantized by their
+				// node's transform. They skip the float vertices when packing is
+				// requested, no step below works on float positions and the
+				// transform fits the packed scale and offset (see ModelLoadOptions).
+				std::vector<PackedVertex> packed;
+				VertexFormat format;
+				bool integerPositions = positions.Component != AccessorComponent::Float &&
+					positions.Component != AccessorComponent::UnsignedInt;
+				const glm::mat4& nodeTransform = meshTransforms[meshIndex];
+				bool packQuantized = integerPositions && m_Options.PackVertices &&
+					m_Options.Packing.Position == PositionPrecision::Unorm16 &&
+					!m_Options.OptimizeMeshes && !m_Options.GenerateLods && !m_Options.BuildMeshlets &&
+					IsAxisAlignedScale(nodeTransform);
+				bool quantized = packQuantized &&
+					PackQuantizedVertices(gltfModel, primitive, positions, nodeTransform, m_Options.Packing, packed, format);
+
+				// Otherwise each attribute is decoded straight into its member of the vertex array
+				if (!quantized)
 				{
-					Vertex v;
-
-					v.Position = glm::vec4(
-						positions[i * 3 + 0],
-						positions[i * 3 + 1],
-						positions[i * 3 + 2],
-						1.0f
-					);
-
-					if (normals)
-					{
-						v.Normal = glm::vec3(
-							normals[i * 3 + 0],
-							normals[i * 3 + 1],
-							normals[i * 3 + 2]
-						);
-					}
-					else
-					{
-						v.Normal = glm::vec3(0.0f, 1.0f, 0.0f);
-					}
-
-					if (texCoords)
-					{
-						v.TexCoords = glm::vec2(
-							texCoords[i * 2 + 0],
-							texCoords[i * 2 + 1]
-						);
-					}
-					else
-					{
-						v.TexCoords = glm::vec2(0.0f);
-					}
-
-					if (colors)
-					{
-						v.Color = glm::vec4(
-							colors[i * colorComponents + 0],
-							colors[i * colorComponents + 1],
-							colors[i * colorComponents + 2],
-							colorComponents == 4 ? colors[i * colorComponents + 3] : 1.0f
-						);
-					}
-					else
+					vertices.resize(vertexCount);
+					if (!AccessorDecoder::DecodeFloat(positions, reinterpret_cast<uint8_t*>(vertices.data()) + offsetof(Vertex, Position),
+						sizeof(Vertex), 4, PositionDefaults))
 					{
-						v.Color = glm::vec4(1.0f);
+						VP_CORE_ERROR("Unsupported POSITION format, skipping primitive");
+						continue;
 					}
-
-					vertices.push_back(v);
+					LoadAttribute(gltfModel, primitive, "NORMAL", vertices, offsetof(Vertex, Normal), 3, NormalDefaults);
+					LoadAttribute(gltfModel, primitive, "TEXCOORD_0", vertices, offsetof(Vertex, TexCoords), 2, TexCoordDefaults);
+					LoadAttribute(gltfModel, primitive, "COLOR_0", vertices, offsetof(Vertex, Color), 4, ColorDefaults);
 				}
 
 				if (primitive.indices >= 0)
@@ -525,14 +1802,16 @@ namespace VizEngine
 					}
 				}
 
-				auto mesh = std::make_shared<Mesh>(vertices, indices);
-				m_Model->m_Meshes.push_back(mesh);
+				if (integerPositions && !quantized && nodeTransform != glm::mat4(1.0f))
+				{
+					TransformVertices(vertices, indices, nodeTransform);
+				}
 
 				size_t materialIndex = 0;
 				if (primitive.material >= 0)
 				{
 					size_t matIdx = static_cast<size_t>(primitive.material);
-					if (matIdx < m_Model->m_Materials.size())
+					if (matIdx < gltfModel.materials.size())
 					{
 						materialIndex = matIdx;
 					}
@@ -541,9 +1820,140 @@ namespace VizEngine
 						VP_CORE_WARN("Material index {} out of bounds, using default", matIdx);
 					}
 				}
-				m_Model->m_MeshMaterialIndices.push_back(materialIndex);
+
+				if (m_Options.OptimizeMeshes)
+				{
+					OptimizeMesh(vertices, indices, gltfMesh.name);
+				}
+
+				std::vector<MeshLod> lods;
+				if (m_Options.GenerateLods)
+				{
+					lods = GenerateLods(vertices, indices, gltfMesh.name);
+				}
+
+				std::vector<Meshlet> meshlets;
+				if (m_Options.BuildMeshlets && indices.size() / 3 >= m_Options.Meshlets.MinTriangles)
+				{
+					meshlets = BuildMeshlets(vertices, indices, lods);
+				}
+
+				// Moving the vectors keeps their heap buffers, so the pointers stay valid
+				MeshCacheMesh entry;
+				entry.VertexCount = static_cast<uint32_t>(quantized ? packed.size() : vertices.size());
+				if (m_Options.PackVertices)
+				{
+					if (quantized)
+					{
+						m_Model->m_LoadStats.QuantizedMeshes++;
+					}
+					else
+					{
+						packed.resize(vertices.size());
+						format = VertexFormat::Pack(vertices.data(), vertices.size(), m_Options.Packing, packed.data());
+					}
+					entry.Format = format;
+					m_PackedVertices.push_back(std::move(packed));
+					entry.PackedVertices = m_PackedVertices.back().data();
+				}
+				else
+				{
+					m_Vertices.push_back(std::move(vertices));
+					entry.Vertices = m_Vertices.back().data();
+				}
+				m_Indices.push_back(std::move(indices));
+				entry.Indices = m_Indices.back().data();
+				entry.IndexCount = static_cast<uint32_t>(m_Indices.back().size());
+				if (!lods.empty())
+				{
+					m_Lods.push_back(std::move(lods));
+					entry.Lods = m_Lods.back().data();
+					entry.LodCount = static_cast<uint32_t>(m_Lods.back().size());
+				}
+				if (!meshlets.empty())
+				{
+					m_Meshlets.push_back(std::move(meshlets));
+					entry.Meshlets = m_Meshlets.back().data();
+					entry.MeshletCount = static_cast<uint32_t>(m_Meshlets.back().size());
+				}
+				entry.MaterialIndex = static_cast<uint32_t>(materialIndex);
+				m_Data.Meshes.push_back(entry);
+			}
+		}
+	}
+
+
+	void Model::ModelLoader::OptimizeMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+		const std::string& name)
+	{
+		ModelLoadStats& stats = m_Model->m_LoadStats;
+		auto start = std::chrono::steady_clock::now();
+
+		VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+		size_t verticesBefore = vertices.size();
+		MeshOptimizer::Optimize(vertices, indices);
+		VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+
+		stats.CacheBefore += before;
+		stats.CacheAfter += after;
+		stats.OptimizeMs += ElapsedMs(start);
+
+		VP_CORE_TRACE("Optimized mesh '{}': {} -> {} vertices, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+			name, verticesBefore, vertices.size(), before.GetACMR(), after.GetACMR(), before.GetATVR(), after.GetATVR());
+	}
+
+	std::vector<MeshLod> Model::ModelLoader::GenerateLods(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+		const std::string& name)
+	{
+		ModelLoadStats& stats = m_Model->m_LoadStats;
+		auto start = std::chrono::steady_clock::now();
+
+		std::vector<MeshLod> lods = MeshSimplifier::GenerateLods(vertices, indices, m_Options.Lods);
+
+		// The simplifier leaves triangles in collapse order; re-sort the coarse levels
+		if (m_Options.OptimizeMeshes)
+		{
+			for (size_t level = 1; level < lods.size(); level++)
+			{
+				auto first = indices.begin() + lods[level].FirstIndex;
+				std::vector<unsigned int> range(first, first + lods[level].IndexCount);
+				MeshOptimizer::OptimizeVertexCache(range, vertices.size());
+				std::copy(range.begin(), range.end(), first);
 			}
 		}
+
+		stats.LodLevels += lods.size();
+		stats.LodMs += ElapsedMs(start);
+
+		VP_CORE_TRACE("Generated {} LODs for mesh '{}': {} triangles down to {} (error {:.4f})",
+			lods.size(), name, lods.front().IndexCount / 3, lods.back().IndexCount / 3, lods.back().Error);
+		return lods;
+	}
+
+	std::vector<Meshlet> Model::ModelLoader::BuildMeshlets(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+		std::vector<MeshLod>& lods)
+	{
+		ModelLoadStats& stats = m_Model->m_LoadStats;
+		auto start = std::chrono::steady_clock::now();
+
+		// Meshlets are referenced through the LOD table, so a mesh without LODs gets one level
+		if (lods.empty())
+		{
+			lods.push_back({ 0, static_cast<uint32_t>(indices.size()), 0.0f });
+		}
+
+		std::vector<Meshlet> meshlets;
+		for (MeshLod& lod : lods)
+		{
+			std::vector<Meshlet> levelMeshlets = MeshletBuilder::Build(vertices, indices, lod.FirstIndex, lod.IndexCount, m_Options.Meshlets);
+			lod.FirstMeshlet = static_cast<uint32_t>(meshlets.size());
+			lod.MeshletCount = static_cast<uint32_t>(levelMeshlets.size());
+			meshlets.insert(meshlets.end(), levelMeshlets.begin(), levelMeshlets.end());
+		}
+
+		stats.Meshlets += meshlets.size();
+		stats.MeshletMs += ElapsedMs(start);
+		return meshlets;
 	}
 
 	void Model::ModelLoader::LoadIndices(const tinygltf::Model& gltfModel,
@@ -630,52 +2040,277 @@ namespace VizEngine
 		}
 	}
 
-	std::shared_ptr<Texture> Model::ModelLoader::LoadTexture(const tinygltf::Model& gltfModel, int textureIndex)
+
+	//--------------------------------------------------------------------------
+	// GPU stage (GL thread only)
+	//--------------------------------------------------------------------------
+	void Model::ModelLoader::CreateMesh(size_t meshIndex)
 	{
-		if (textureIndex < 0 || textureIndex >= static_cast<int>(gltfModel.textures.size()))
+		auto start = std::chrono::steady_clock::now();
+
+		const MeshCacheMesh& data = m_Data.Meshes[meshIndex];
+		AssetManager& assets = AssetManager::Get();
+		bool hasKey = meshIndex < m_MeshKeys.size();
+		std::shared_ptr<Mesh> mesh = hasKey ? assets.FindMesh(m_MeshKeys[meshIndex]) : nullptr;
+		if (mesh)
 		{
-			return nullptr;
+			m_Model->m_LoadStats.MeshesShared++;
+		}
+		else
+		{
+			if (data.Format.Packed)
+			{
+				mesh = std::make_shared<Mesh>(data.PackedVertices, data.VertexCount, data.Format, data.Indices, data.IndexCount);
+			}
+			else
+			{
+				mesh = std::make_shared<Mesh>(
+					reinterpret_cast<const float*>(data.Vertices),
+					size_t(data.VertexCount) * sizeof(Vertex),
+					data.Indices,
+					data.IndexCount
+				);
+			}
+			if (data.LodCount > 0)
+			{
+				mesh->SetLods(std::vector<MeshLod>(data.Lods, data.Lods + data.LodCount));
+			}
+			if (data.MeshletCount > 0)
+			{
+				mesh->SetMeshlets(std::vector<Meshlet>(data.Meshlets, data.Meshlets + data.MeshletCount));
+			}
+			if (hasKey)
+			{
+				mesh = assets.AddMesh(m_MeshKeys[meshIndex], std::move(mesh));
+			}
 		}
+		m_Model->m_LoadStats.VertexBytes += size_t(data.VertexCount) * data.Format.GetStride();
+		m_Model->m_LoadStats.IndexBytes += size_t(data.IndexCount) * mesh->GetIndexBuffer().GetIndexSize();
 
-		if (m_TextureCache.find(textureIndex) != m_TextureCache.end())
+		if (m_Model->m_Meshes.size() <= meshIndex)
 		{
-			return m_TextureCache[textureIndex];
+			m_Model->m_Meshes.resize(meshIndex + 1);
 		}
+		m_Model->m_Meshes[meshIndex] = std::move(mesh);
+
+		m_Model->m_LoadStats.MeshMs += ElapsedMs(start);
+	}
 
-		const auto& texture = gltfModel.textures[textureIndex];
+	void Model::ModelLoader::CreateTexture(int imageIndex)
+	{
+		ModelLoadStats& stats = m_Model->m_LoadStats;
+		MeshCacheImage& image = m_Data.Images[imageIndex];
+		AssetManager& assets = AssetManager::Get();
 
-		if (texture.source < 0 || texture.source >= static_cast<int>(gltfModel.images.size()))
+		// Embedded KTX2 images are cached as the container itself (Channels = 0)
+		if (image.Pixels && image.Channels == 0)
 		{
-			return nullptr;
+			uint64_t contentKey = Hash::Combine(Hash::Bytes(image.Pixels, image.PixelBytes), GltfImageTag);
+			if ((m_Textures[imageIndex] = assets.FindTexture(contentKey)))
+			{
+				stats.TexturesShared++;
+				return;
+			}
+
+			auto prepared = std::make_shared<TextureData>();
+			if (!Ktx2::Parse(image.Pixels, image.PixelBytes, *prepared, m_Model->m_Name))
+			{
+				return;
+			}
+			auto uploadStart = std::chrono::steady_clock::now();
+			m_Textures[imageIndex] = assets.AddTexture(contentKey, std::make_shared<Texture>(*prepared,
+				m_Options.StreamTextures ? TextureStreamer::FromMemory(prepared) : TextureStreamSource()));
+			stats.UploadMs += ElapsedMs(uploadStart);
+			stats.TexturesLoaded++;
+			return;
+		}
+
+		// Embedded images of a warm load upload straight from the mapped file
+		if (image.Pixels)
+		{
+			uint64_t contentKey = Hash::Combine(Hash::Bytes(image.Pixels, image.PixelBytes),
+				Hash::Combine(GltfImageTag, (uint64_t(image.Width) << 32) | uint32_t(image.Height)));
+			if ((m_Textures[imageIndex] = assets.FindTexture(contentKey)))
+			{
+				stats.TexturesShared++;
+				return;
+			}
+
+			auto uploadStart = std::chrono::steady_clock::now();
+			m_Textures[imageIndex] = assets.AddTexture(contentKey,
+				std::make_shared<Texture>(image.Pixels, image.Width, image.Height, image.Channels));
+			stats.UploadMs += ElapsedMs(uploadStart);
+			stats.TexturesLoaded++;
+			return;
 		}
 
-		const auto& image = gltfModel.images[texture.source];
-		std::shared_ptr<Texture> tex;
+		DecodedImage& decoded = m_DecodedImages[imageIndex];
+		stats.DecodeWorkerMs += decoded.DecodeMs;
 
-		if (!image.image.empty())
+		if (decoded.Shared)
 		{
-			tex = std::make_shared<Texture>(
-				image.image.data(),
-				image.width,
-				image.height,
-				image.component
-			);
-			VP_CORE_TRACE("Loaded embedded texture: {}x{}", image.width, image.height);
+			m_Textures[imageIndex] = std::move(decoded.Shared);
+			stats.TexturesShared++;
+			return;
+		}
+
+		if (decoded.Prepared)
+		{
+			stats.TexturesCompressed += decoded.Compressed ? 1 : 0;
+			stats.TextureCacheHits += decoded.CacheHit ? 1 : 0;
+			stats.TexturesMipmapped += decoded.Mipmapped ? 1 : 0;
+			if ((m_Textures[imageIndex] = assets.FindTexture(decoded.ContentKey)))
+			{
+				stats.TexturesShared++;
+			}
+			else
+			{
+				// Compressed results stream from the texture cache if it was written
+				std::shared_ptr<const TextureData> prepared(std::move(decoded.Prepared));
+				TextureStreamSource source;
+				std::error_code ec;
+				if (m_Options.StreamTextures)
+				{
+					source = !decoded.CachePath.empty() && std::filesystem::exists(decoded.CachePath, ec)
+						? TextureStreamer::FromKtx2File(decoded.CachePath)
+						: TextureStreamer::FromMemory(prepared);
+				}
+
+				auto uploadStart = std::chrono::steady_clock::now();
+				m_Textures[imageIndex] = assets.AddTexture(decoded.ContentKey, std::make_shared<Texture>(*prepared, std::move(source)));
+				stats.UploadMs += ElapsedMs(uploadStart);
+				stats.TexturesLoaded++;
+			}
+
+			// Prepared mips are already GPU-ready: cache the container, not pixels
+			const std::vector<unsigned char>* container = !decoded.Container.empty() ? &decoded.Container
+				: static_cast<size_t>(imageIndex) < m_EncodedImages.size() ? &m_EncodedImages[imageIndex] : nullptr;
+			if (m_Options.UseCache && image.Uri.empty() && container && Ktx2::IsKtx2(container->data(), container->size()))
+			{
+				image.Pixels = container->data();
+				image.PixelBytes = container->size();
+				image.Width = decoded.Width;
+				image.Height = decoded.Height;
+				image.Channels = 0;
+			}
+			decoded.Prepared.reset();
+			return;
+		}
+
+		if (!decoded.Pixels)
+		{
+			VP_CORE_ERROR("Failed to decode texture {} of model '{}' ({})",
+				image.Uri.empty() ? std::to_string(imageIndex) : image.Uri, m_Model->m_Name,
+				decoded.Error ? decoded.Error : "no image data");
+			return;
+		}
+
+		// Pixels decoded for the mesh cache may still match a live texture
+		if ((m_Textures[imageIndex] = assets.FindTexture(decoded.ContentKey)))
+		{
+			stats.TexturesShared++;
+		}
+		else
+		{
+			auto uploadStart = std::chrono::steady_clock::now();
+			m_Textures[imageIndex] = assets.AddTexture(decoded.ContentKey,
+				std::make_shared<Texture>(decoded.Pixels.get(), decoded.Width, decoded.Height, decoded.Channels));
+			stats.UploadMs += ElapsedMs(uploadStart);
+			stats.TexturesLoaded++;
+
+			VP_CORE_TRACE("Loaded texture: {} ({}x{})",
+				image.Uri.empty() ? "embedded" : image.Uri, decoded.Width, decoded.Height);
+		}
+
+		if (m_Options.UseCache && image.Uri.empty())
+		{
+			// Embedded pixels go into the mesh cache; keep them until WriteCache()
+			image.Pixels = decoded.Pixels.get();
+			image.Width = decoded.Width;
+			image.Height = decoded.Height;
+			image.Channels = decoded.Channels;
+			image.PixelBytes = ImageBytes(image);
+		}
+		else
+		{
+			decoded.Pixels.reset();
+		}
+	}
+
+	std::unique_ptr<Model> Model::ModelLoader::FinishModel()
+	{
+		ModelLoadStats& stats = m_Model->m_LoadStats;
+
+		auto getTexture = [&](int imageIndex) -> std::shared_ptr<Texture>
+		{
+			if (imageIndex < 0 || static_cast<size_t>(imageIndex) >= m_Textures.size())
+			{
+				return nullptr;
+			}
+			return m_Textures[imageIndex];
+		};
+
+		for (const MeshCacheMaterial& entry : m_Data.Materials)
+		{
+			PBRMaterial material = entry.Material;
+			material.BaseColorTexture = getTexture(entry.Images[MeshCacheMaterial::BaseColor]);
+			material.MetallicRoughnessTexture = getTexture(entry.Images[MeshCacheMaterial::MetallicRoughness]);
+			material.NormalTexture = getTexture(entry.Images[MeshCacheMaterial::Normal]);
+			material.OcclusionTexture = getTexture(entry.Images[MeshCacheMaterial::Occlusion]);
+			material.EmissiveTexture = getTexture(entry.Images[MeshCacheMaterial::Emissive]);
+			m_Model->m_Materials.push_back(std::move(material));
+		}
+
+		if (m_Model->m_Materials.empty())
+		{
+			m_Model->m_Materials.push_back(Model::s_DefaultMaterial);
 		}
-		else if (!image.uri.empty())
+
+		for (const MeshCacheMesh& mesh : m_Data.Meshes)
 		{
-			std::string fullPath = m_Directory.empty()
-				? image.uri
-				: m_Directory + "/" + image.uri;
-			tex = std::make_shared<Texture>(fullPath);
-			VP_CORE_TRACE("Loaded external texture: {}", image.uri);
+			m_Model->m_MeshMaterialIndices.push_back(
+				mesh.MaterialIndex < m_Model->m_Materials.size() ? mesh.MaterialIndex : 0);
 		}
 
-		if (tex)
+		stats.TotalMs = ElapsedMs(m_StartTime);
+		VP_CORE_INFO("Loaded model '{}'{}: {} meshes, {} materials ({:.2f} ms)",
+			m_Model->m_Name, m_FromCache ? " from cache" : "",
+			m_Model->m_Meshes.size(), m_Model->m_Materials.size(), stats.TotalMs);
+		LogLoadStats(m_Model->m_Name, stats);
+
+		if (m_Options.UseCache && !m_FromCache && !m_Data.Meshes.empty())
 		{
-			m_TextureCache[textureIndex] = tex;
+			auto write = std::make_unique<PendingCacheWrite>();
+			write->FilePath = m_FilePath;
+			write->CacheDirectory = m_Options.CacheDirectory;
+			write->Data = std::move(m_Data);
+			write->Data.OptionsHash = GetOptionsHash(m_Options);
+			write->Vertices = std::move(m_Vertices);
+			write->PackedVertices = std::move(m_PackedVertices);
+			write->Indices = std::move(m_Indices);
+			write->Lods = std::move(m_Lods);
+			write->Meshlets = std::move(m_Meshlets);
+			write->EncodedImages = std::move(m_EncodedImages);
+			for (DecodedImage& decoded : m_DecodedImages)
+			{
+				write->Pixels.push_back(std::move(decoded.Pixels));
+				write->Containers.push_back(std::move(decoded.Container));
+			}
+			m_CacheWrite = std::move(write);
 		}
 
-		return tex;
+		// Texture references are dropped here, on the GL thread, not with the
+		// loader: its last reference may be released by a worker
+		m_Textures.clear();
+		m_DecodedImages.clear();
+
+		return std::move(m_Model);
+	}
+
+	void Model::ModelLoader::WriteCache(PendingCacheWrite& write)
+	{
+		auto start = std::chrono::steady_clock::now();
+		MeshCache::Write(write.FilePath, write.CacheDirectory, write.Data);
+		VP_CORE_TRACE("Mesh cache for '{}' written in {:.2f} ms", write.FilePath, ElapsedMs(start));
 	}
 }
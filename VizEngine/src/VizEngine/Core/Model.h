@@ -3,6 +3,10 @@
 #include "VizEngine/Core.h"
 #include "VizEngine/Core/Mesh.h"
 #include "VizEngine/Core/Material.h"
+#include "VizEngine/Core/AsyncHandle.h"
+#include "VizEngine/Core/MeshOptimizer.h"
+#include "VizEngine/Core/MeshSimplifier.h"
+#include "VizEngine/Core/TextureCompressor.h"
 #include "VizEngine/OpenGL/Texture.h"
 #include "glm.hpp"
 #include <vector>
@@ -12,6 +16,111 @@
 
 namespace VizEngine
 {
+	/**
+	 * Options controlling how Model::LoadFromFile() loads a file.
+	 */
+	struct ModelLoadOptions
+	{
+		// Read/write the binary mesh cache (see MeshCache). A warm load skips
+		// glTF parsing and vertex conversion entirely.
+		bool UseCache = true;
+
+		// Directory for cache files (relative to the working directory)
+		std::string CacheDirectory = "cache/models";
+
+		// Upload meshes in the compact PackedVertex format (20 instead of 52
+		// bytes per vertex). Shaders decode them with the PositionScale and
+		// PositionOffset terms of the ObjectData block (see ObjectUniforms).
+		// Quantized glTF positions (KHR_mesh_quantization) are then packed
+		// directly, without a float copy, and the node's dequantization
+		// transform is folded into the position scale/offset. This direct
+		// path needs Unorm16 positions and no float vertices, so it is skipped
+		// when OptimizeMeshes, GenerateLods or BuildMeshlets is set, or when
+		// the node transform rotates; those meshes are dequantized into Vertex
+		// first and packed afterwards.
+		bool PackVertices = false;
+		VertexPackingOptions Packing;
+
+		// Weld duplicate vertices and reorder triangles/vertices for the
+		// post-transform cache, overdraw and vertex fetch (see MeshOptimizer).
+		// Costs import time only; the result is stored in the mesh cache.
+		bool OptimizeMeshes = false;
+
+		// Build a LOD chain per mesh (see MeshSimplifier). Levels share the
+		// vertex buffer and are appended to the index buffer; Scene::Render
+		// picks one by projected error.
+		bool GenerateLods = false;
+		LodOptions Lods;
+
+		// Split every LOD into meshlets for per-cluster culling in Scene::Render
+		// (meshes under MeshletOptions::MinTriangles stay whole).
+		bool BuildMeshlets = false;
+		MeshletOptions Meshlets;
+
+		// Compress PNG/JPEG images to BC1/BC5/BC7 with a full mip chain on the
+		// decode workers (see TextureCompressor). Results are cached next to
+		// the model, so later loads skip both decoding and compression.
+		bool CompressTextures = false;
+		TextureCompressionOptions Compression;
+
+		// Build mip chains on the decode workers (see MipGenerator): base color
+		// and emissive are filtered in linear light, normal maps renormalized.
+		// Embedded images keep their mips in the mesh cache. Compressed
+		// textures always use MipGenerator; this only affects the others.
+		// Same default as Texture::SetMipsOnLoad for textures loaded by path.
+		bool GenerateMips = true;
+		MipOptions Mips;
+
+		// Upload only the smallest mips of textures that have a chain (KTX2,
+		// compressed or GenerateMips) and let the TextureStreamer load finer
+		// ones as the scene needs them. Compressed textures stream from the
+		// texture cache; the others keep their chain in system memory.
+		bool StreamTextures = false;
+	};
+
+	/**
+	 * Where the time went while loading a model (all values in milliseconds).
+	 * Texture decoding runs on the ThreadPool, so DecodeWorkerMs (summed over
+	 * workers) can exceed the wall-clock time the main thread spent waiting.
+	 */
+	struct ModelLoadStats
+	{
+		bool FromCache = false;
+		double ParseMs = 0.0;         // glTF parse, or cache map + validation
+		double MeshMs = 0.0;          // Vertex conversion and buffer upload
+		double DecodeWorkerMs = 0.0;  // Image decoding, summed over workers
+		double DecodeWaitMs = 0.0;    // Main thread blocked on decodes
+		double UploadMs = 0.0;        // Texture uploads
+		double TotalMs = 0.0;         // Start of loading until the Model is complete
+		size_t TexturesLoaded = 0;
+		size_t TexturesShared = 0;    // Reused from the AssetManager instead of decoded / uploaded
+		size_t TexturesCompressed = 0;  // Encoded to BCn during this load (CompressTextures)
+		size_t TextureCacheHits = 0;    // Compressed results read from the texture cache
+		size_t TexturesMipmapped = 0;   // Mip chains built on the workers (GenerateMips)
+		size_t MeshesShared = 0;
+		size_t VertexBytes = 0;       // Size of all vertex buffers
+		size_t IndexBytes = 0;        // Size of all index buffers (16-bit where possible)
+
+		// Mesh optimization (fresh loads with OptimizeMeshes only; part of MeshMs)
+		double OptimizeMs = 0.0;
+		VertexCacheStats CacheBefore;
+		VertexCacheStats CacheAfter;
+
+		// LOD generation (fresh loads with GenerateLods only; part of MeshMs)
+		double LodMs = 0.0;
+		size_t LodLevels = 0;         // Summed over meshes, LOD 0 included
+
+		// Meshlet building (fresh loads with BuildMeshlets only; part of MeshMs)
+		double MeshletMs = 0.0;
+		size_t Meshlets = 0;
+
+		// Compressed glTF data (fresh loads only)
+		double MeshoptMs = 0.0;       // EXT_meshopt_compression bufferViews decoded across workers; part of ParseMs
+		size_t MeshoptViews = 0;
+		size_t MeshoptBytes = 0;      // Decoded size of those bufferViews
+		size_t QuantizedMeshes = 0;   // Packed straight from KHR_mesh_quantization positions
+	};
+
 	/**
 	 * Model represents a loaded 3D model file (glTF/GLB).
 	 * 
@@ -29,9 +138,24 @@ namespace VizEngine
 	public:
 		/**
 		 * Load a model from a glTF or GLB file.
+		 * Uses the binary mesh cache when it is up to date with the source file.
 		 * Returns nullptr on failure.
 		 */
-		static std::unique_ptr<Model> LoadFromFile(const std::string& filepath);
+		static std::unique_ptr<Model> LoadFromFile(const std::string& filepath, const ModelLoadOptions& options = {});
+
+		/**
+		 * Load a model without blocking the calling thread.
+		 * Parsing, vertex conversion and image decoding run on the ThreadPool;
+		 * GPU buffers and textures are created on the main thread by the
+		 * UploadQueue, a few per frame. The handle yields nullptr on failure.
+		 */
+		static AsyncHandle<Model> LoadAsync(const std::string& filepath, const ModelLoadOptions& options = {});
+
+		/**
+		 * Hash of everything in `options` that changes the converted data
+		 * (cache entries and AssetManager keys).
+		 */
+		static uint64_t GetOptionsHash(const ModelLoadOptions& options);
 
 		~Model() = default;
 
@@ -56,6 +180,7 @@ namespace VizEngine
 		// Model info
 		const std::string& GetName() const { return m_Name; }
 		const std::string& GetFilePath() const { return m_FilePath; }
+		const ModelLoadStats& GetLoadStats() const { return m_LoadStats; }
 		size_t GetMeshCount() const { return m_Meshes.size(); }
 		size_t GetMaterialCount() const { return m_Materials.size(); }
 
@@ -79,8 +204,7 @@ namespace VizEngine
 		std::vector<PBRMaterial> m_Materials;
 		std::vector<size_t> m_MeshMaterialIndices;  // Material index for each mesh
 
-		// Texture cache to avoid reloading same texture
-		std::unordered_map<int, std::shared_ptr<Texture>> m_TextureCache;
+		ModelLoadStats m_LoadStats;
 
 		// Default material for meshes without one
 		static PBRMaterial s_DefaultMaterial;
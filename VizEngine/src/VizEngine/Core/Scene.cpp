@@ -1,5 +1,8 @@
 #include "Scene.h"
+#include "VizEngine/Core/TextureStreamer.h"
 #include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
 
 namespace VizEngine
 {
@@ -38,32 +41,63 @@ namespace VizEngine
 
 	void Scene::Render(Renderer& renderer, Shader& shader, const Camera& camera)
 	{
-		shader.Bind();
+		// Shared by every program; a pass with the same camera sends nothing
+		renderer.GetFrameUniforms().SetCamera(camera);
+		renderer.UploadFrameUniforms();
+		UpdateObjectUniforms();
 
-		// Explicitly set the main texture to slot 0 (prevents issues if textures bound to other slots)
-		shader.SetInt("u_MainTex", 0);
+		// Group objects by the variant they need, in scene order within a group
+		uint64_t supported = shader.GetSupportedKeywords();
+		m_DrawOrder.clear();
+		for (size_t i = 0; i < m_Objects.size(); i++)
+		{
+			const SceneObject& obj = m_Objects[i];
+			if (obj.Active && obj.MeshPtr)
+			{
+				m_DrawOrder.emplace_back((renderer.GetKeywords() | GetMaterialKeywords(obj)) & supported, i);
+			}
+		}
+		std::stable_sort(m_DrawOrder.begin(), m_DrawOrder.end(),
+			[](const auto& a, const auto& b) { return a.first < b.first; });
+
+		// Pixels per unit of world-space size at distance 1
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		float projectionScale = camera.GetProjectionMatrix()[1][1] * static_cast<float>(viewport[3]) * 0.5f;
+		glm::vec3 cameraPosition = camera.GetPosition();
+		glm::mat4 viewProjection = camera.GetViewProjectionMatrix();
+		Frustum frustum = Frustum::FromMatrix(viewProjection);
+		m_CullingStats = {};
 
-		for (auto& obj : m_Objects)
+		Shader* variant = nullptr;
+		for (const auto& [keywords, i] : m_DrawOrder)
 		{
-			// Skip inactive or invalid objects
-			if (!obj.Active) continue;
-			if (!obj.MeshPtr) continue;
+			SceneObject& obj = m_Objects[i];
+			if (!variant || variant->GetKeywords() != keywords)
+			{
+				variant = &shader.GetVariant(keywords);
+				variant->Bind();
+				renderer.CheckUniformBlocks(*variant);
 
-			// Calculate matrices
-			glm::mat4 model = obj.ObjectTransform.GetModelMatrix();
-			glm::mat4 mvp = camera.GetViewProjectionMatrix() * model;
+				// Explicitly set the main texture to slot 0 (prevents issues if textures bound to other slots)
+				if (variant->HasUniform("u_MainTex"))
+				{
+					variant->SetInt("u_MainTex", 0);
+				}
+			}
 
-			// Set uniforms - both MVP and Model (for lighting)
-			shader.SetMatrix4fv("u_MVP", mvp);
-			shader.SetMatrix4fv("u_Model", model);
-			shader.SetVec4("u_ObjectColor", obj.Color);
-			shader.SetColor("u_Color", obj.Color);  // Legacy support
-			shader.SetFloat("u_Roughness", obj.Roughness);
+			const glm::mat4& model = m_ModelMatrices[i];
+			m_ObjectUniforms.Bind(i);
+			m_MaterialUniforms.Bind(i);
 
 			// Draw the object
 			// Bind per-object texture if available
 			if (obj.TexturePtr)
 			{
+				if (obj.TexturePtr->IsStreamed())
+				{
+					RequestTextureLevel(obj, model, frustum, cameraPosition, projectionScale);
+				}
 				obj.TexturePtr->Bind();
 			}
 			else
@@ -71,9 +105,164 @@ namespace VizEngine
 				// Unbind texture for objects without textures
 				glBindTexture(GL_TEXTURE_2D, 0);
 			}
+			obj.LodLevel = SelectLod(obj, model, cameraPosition, projectionScale);
+			const MeshLod& lod = obj.MeshPtr->GetLod(obj.LodLevel);
+
 			obj.MeshPtr->Bind();
-			renderer.Draw(obj.MeshPtr->GetVertexArray(), obj.MeshPtr->GetIndexBuffer(), shader);
+			if (m_CullingSettings.Enabled && lod.MeshletCount > 0)
+			{
+				CullMeshlets(*obj.MeshPtr, lod, viewProjection * model, model, cameraPosition);
+				renderer.MultiDraw(obj.MeshPtr->GetVertexArray(), obj.MeshPtr->GetIndexBuffer(), *variant, m_DrawRanges);
+			}
+			else
+			{
+				renderer.Draw(obj.MeshPtr->GetVertexArray(), obj.MeshPtr->GetIndexBuffer(), *variant, lod.IndexCount, lod.FirstIndex);
+			}
+		}
+	}
+
+	void Scene::RenderDepth(Renderer& renderer, Shader& shader, size_t lodBias)
+	{
+		Shader& variant = shader.GetVariant(renderer.GetKeywords());
+		variant.Bind();
+		renderer.CheckUniformBlocks(variant);
+		UpdateObjectUniforms();
+
+		for (size_t i = 0; i < m_Objects.size(); i++)
+		{
+			const SceneObject& obj = m_Objects[i];
+			if (!obj.Active || !obj.MeshPtr) continue;
+
+			m_ObjectUniforms.Bind(i);
+			const MeshLod& lod = obj.MeshPtr->GetLod(obj.LodLevel + lodBias);
+
+			obj.MeshPtr->Bind();
+			renderer.Draw(obj.MeshPtr->GetVertexArray(), obj.MeshPtr->GetIndexBuffer(), variant, lod.IndexCount, lod.FirstIndex);
+		}
+	}
+
+	uint64_t Scene::GetMaterialKeywords(const SceneObject& obj)
+	{
+		static const uint64_t textured = ShaderKeywords::Get("TEXTURED");
+		return obj.TexturePtr ? textured : 0;
+	}
+
+	void Scene::UpdateObjectUniforms()
+	{
+		m_ObjectUniforms.Resize(m_Objects.size());
+		m_MaterialUniforms.Resize(m_Objects.size());
+		m_ModelMatrices.resize(m_Objects.size());
+
+		for (size_t i = 0; i < m_Objects.size(); i++)
+		{
+			const SceneObject& obj = m_Objects[i];
+			if (!obj.Active || !obj.MeshPtr) continue;
+
+			glm::mat4 model = obj.ObjectTransform.GetModelMatrix();
+			m_ModelMatrices[i] = model;
+
+			// Once per object here instead of per vertex in the shader
+			const VertexFormat& format = obj.MeshPtr->GetVertexFormat();
+			bool octahedral = format.Packed && format.Normal == NormalEncoding::Octahedral;
+			ObjectUniforms object;
+			object.Model = model;
+			object.NormalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(model))));
+			object.PositionScale = glm::vec4(format.PositionScale, octahedral ? 1.0f : 0.0f);
+			object.PositionOffset = glm::vec4(format.PositionOffset, 0.0f);
+			m_ObjectUniforms.Set(i, &object);
+
+			MaterialUniforms material;
+			material.Color = obj.Color;
+			material.Params = glm::vec4(obj.Roughness, 0.0f, 0.0f, 0.0f);
+			m_MaterialUniforms.Set(i, &material);
+		}
+
+		m_UniformUploadBytes = m_ObjectUniforms.Upload() + m_MaterialUniforms.Upload();
+	}
+
+	void Scene::CullMeshlets(const Mesh& mesh, const MeshLod& lod, const glm::mat4& mvp, const glm::mat4& model, const glm::vec3& cameraPosition)
+	{
+		// Test in object space: planes straight from the MVP, camera moved by the inverse model matrix
+		Frustum frustum = Frustum::FromMatrix(mvp);
+		glm::vec3 objectCamera = glm::vec3(glm::inverse(model) * glm::vec4(cameraPosition, 1.0f));
+		unsigned int indexSize = mesh.GetIndexBuffer().GetIndexSize();
+
+		const std::vector<Meshlet>& meshlets = mesh.GetMeshlets();
+		size_t last = std::min<size_t>(size_t(lod.FirstMeshlet) + lod.MeshletCount, meshlets.size());
+
+		m_DrawRanges.Clear();
+		for (size_t i = lod.FirstMeshlet; i < last; i++)
+		{
+			const Meshlet& meshlet = meshlets[i];
+			if (MeshletBuilder::IsVisible(meshlet, frustum, objectCamera, m_CullingSettings.Backface))
+			{
+				m_DrawRanges.Add(meshlet.FirstIndex, meshlet.IndexCount, indexSize);
+				m_CullingStats.Visible++;
+			}
+		}
+		m_CullingStats.Meshlets += lod.MeshletCount;
+		m_CullingStats.DrawRanges += m_DrawRanges.Counts.size();
+	}
+
+	void Scene::RequestTextureLevel(const SceneObject& obj, const glm::mat4& model, const Frustum& frustum,
+		const glm::vec3& cameraPosition, float projectionScale) const
+	{
+		const Mesh& mesh = *obj.MeshPtr;
+		glm::vec3 boundsMin = mesh.GetBoundsMin();
+		glm::vec3 boundsMax = mesh.GetBoundsMax();
+		float maxScale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+		glm::vec3 center = glm::vec3(model * glm::vec4((boundsMin + boundsMax) * 0.5f, 1.0f));
+		float radius = glm::length(boundsMax - boundsMin) * 0.5f * maxScale;
+		if (!frustum.IntersectsSphere(center, radius))
+		{
+			return;
+		}
+
+		// Texels per pixel, assuming the UVs span the object's projected diameter once
+		float distance = std::max(glm::length(center - cameraPosition) - radius, 1e-3f);
+		float pixels = std::max(2.0f * radius * projectionScale / distance, 1.0f);
+		float texels = static_cast<float>(std::max(obj.TexturePtr->GetWidth(), obj.TexturePtr->GetHeight()));
+		TextureStreamer::Get().Request(*obj.TexturePtr, std::log2(std::max(texels / pixels, 1.0f)));
+	}
+
+	size_t Scene::SelectLod(const SceneObject& obj, const glm::mat4& model, const glm::vec3& cameraPosition, float projectionScale) const
+	{
+		const Mesh& mesh = *obj.MeshPtr;
+		size_t lodCount = mesh.GetLodCount();
+		if (!m_LodSettings.Enabled || lodCount <= 1)
+		{
+			return 0;
+		}
+
+		// LOD errors are relative to the largest extent; bring that into world space
+		glm::vec3 boundsMin = mesh.GetBoundsMin();
+		glm::vec3 boundsMax = mesh.GetBoundsMax();
+		glm::vec3 extent = boundsMax - boundsMin;
+		float maxScale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+		float worldExtent = std::max(extent.x, std::max(extent.y, extent.z)) * maxScale;
+
+		// Distance to the bounding sphere, not its center, so large objects refine up close
+		glm::vec3 center = glm::vec3(model * glm::vec4((boundsMin + boundsMax) * 0.5f, 1.0f));
+		float radius = glm::length(extent) * 0.5f * maxScale;
+		float distance = std::max(glm::length(center - cameraPosition) - radius, 1e-3f);
+		float pixelsPerError = worldExtent * projectionScale / distance;
+
+		size_t current = std::min(obj.LodLevel, lodCount - 1);
+		size_t selected = 0;
+		for (size_t level = lodCount - 1; level > 0; level--)
+		{
+			float threshold = m_LodSettings.ErrorPixels;
+			if (level > current)
+			{
+				threshold *= 1.0f - m_LodSettings.Hysteresis;
+			}
+			if (mesh.GetLod(level).Error * pixelsPerError <= threshold)
+			{
+				selected = level;
+				break;
+			}
 		}
+		return selected;
 	}
 }
 
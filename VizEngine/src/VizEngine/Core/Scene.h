@@ -5,11 +5,43 @@
 #include "VizEngine/Core/Camera.h"
 #include "VizEngine/OpenGL/Renderer.h"
 #include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/Renderer/UniformBlocks.h"
+#include <cstdint>
+#include <utility>
 #include <vector>
 #include <memory>
 
 namespace VizEngine
 {
+	/**
+	 * Screen-size driven mesh LOD selection.
+	 */
+	struct LodSettings
+	{
+		bool Enabled = true;
+		float ErrorPixels = 1.0f;   // Largest acceptable projected LOD error, in pixels
+		float Hysteresis = 0.25f;   // A coarser LOD must be this much under the threshold before switching
+	};
+
+	/**
+	 * Per-meshlet CPU culling for meshes that have meshlets.
+	 */
+	struct ClusterCullingSettings
+	{
+		bool Enabled = true;
+		bool Backface = false;  // Normal cone culling; only for closed, single-sided meshes
+	};
+
+	/**
+	 * Meshlet counts of the last Scene::Render.
+	 */
+	struct ClusterCullingStats
+	{
+		size_t Meshlets = 0;
+		size_t Visible = 0;
+		size_t DrawRanges = 0;  // Index ranges submitted after merging adjacent meshlets
+	};
+
 	/**
 	 * Scene manages a collection of SceneObjects.
 	 * 
@@ -93,14 +125,78 @@ namespace VizEngine
 
 		/**
 		 * Render all active objects in the scene.
+		 * Each object is drawn with the variant of `shader` for the renderer's
+		 * keywords plus its material's (TEXTURED if it has a texture); objects
+		 * are grouped by variant so each program is bound once.
+		 * The camera goes into the renderer's FrameData block (uploaded if it
+		 * changed); each object's transform and material live in the
+		 * ObjectData / MaterialData arrays, re-sent only when they change,
+		 * so a draw costs two buffer range binds instead of its uniforms.
 		 * @param renderer The renderer to use for draw calls
 		 * @param shader The shader program to use
 		 * @param camera The camera for view/projection matrices
 		 */
 		void Render(Renderer& renderer, Shader& shader, const Camera& camera);
 
+		/**
+		 * Depth-only pass (e.g. a shadow map) with the LODs picked by the last
+		 * Render, optionally `lodBias` levels coarser. The view comes from the
+		 * FrameData block the caller uploaded (u_LightSpaceMatrix for shadows).
+		 */
+		void RenderDepth(Renderer& renderer, Shader& shader, size_t lodBias = 0);
+
+		// Bytes of object / material uniforms the last Render or RenderDepth uploaded
+		size_t GetUniformUploadBytes() const { return m_UniformUploadBytes; }
+
+		void SetLodSettings(const LodSettings& settings) { m_LodSettings = settings; }
+		const LodSettings& GetLodSettings() const { return m_LodSettings; }
+
+		void SetClusterCullingSettings(const ClusterCullingSettings& settings) { m_CullingSettings = settings; }
+		const ClusterCullingSettings& GetClusterCullingSettings() const { return m_CullingSettings; }
+		const ClusterCullingStats& GetClusterCullingStats() const { return m_CullingStats; }
+
 	private:
+		/**
+		 * Pick the coarsest LOD whose error projects under LodSettings::ErrorPixels.
+		 * Moving to a coarser level needs a margin (hysteresis) so objects near a
+		 * threshold don't flicker between levels; refining happens immediately.
+		 */
+		size_t SelectLod(const SceneObject& obj, const glm::mat4& model, const glm::vec3& cameraPosition, float projectionScale) const;
+
+		/**
+		 * Tell the TextureStreamer which mip the object's texture needs, from
+		 * its projected size. Objects outside the frustum request nothing.
+		 */
+		void RequestTextureLevel(const SceneObject& obj, const glm::mat4& model, const Frustum& frustum,
+			const glm::vec3& cameraPosition, float projectionScale) const;
+
+		/**
+		 * Collect the meshlets of `lod` that pass the frustum (and optionally
+		 * normal cone) test into m_DrawRanges.
+		 */
+		void CullMeshlets(const Mesh& mesh, const MeshLod& lod, const glm::mat4& mvp, const glm::mat4& model, const glm::vec3& cameraPosition);
+
+		/**
+		 * Fill the ObjectData / MaterialData arrays and m_ModelMatrices, and
+		 * upload the objects that changed.
+		 */
+		void UpdateObjectUniforms();
+
+		// Keywords an object's material adds to the renderer's
+		static uint64_t GetMaterialKeywords(const SceneObject& obj);
+
 		std::vector<SceneObject> m_Objects;
+		LodSettings m_LodSettings;
+		ClusterCullingSettings m_CullingSettings;
+		ClusterCullingStats m_CullingStats;
+		DrawRanges m_DrawRanges;  // Scratch, reused across objects and frames
+
+		// One element per object, indexed like m_Objects
+		UniformBlockArray m_ObjectUniforms{ sizeof(ObjectUniforms), UniformBlockBinding::Object };
+		UniformBlockArray m_MaterialUniforms{ sizeof(MaterialUniforms), UniformBlockBinding::Material };
+		std::vector<glm::mat4> m_ModelMatrices;
+		size_t m_UniformUploadBytes = 0;
+		std::vector<std::pair<uint64_t, size_t>> m_DrawOrder;  // Scratch: (variant keywords, object index)
 	};
 }
 
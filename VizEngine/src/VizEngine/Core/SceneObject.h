@@ -24,6 +24,7 @@ namespace VizEngine
 		glm::vec4 Color = glm::vec4(1.0f);          // Per-object tint color
 		float Roughness = 0.5f;                      // Material roughness (0 = shiny, 1 = matte)
 		bool Active = true;                          // Enable/disable rendering
+		size_t LodLevel = 0;                         // Mesh LOD picked by the last Scene::Render
 		std::string Name = "Object";                 // Display name for UI
 
 		SceneObject() = default;
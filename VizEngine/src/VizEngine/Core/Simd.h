@@ -0,0 +1,15 @@
+#pragma once
+
+// =============================================================================
+// SIMD feature detection
+// =============================================================================
+// SSE2 is part of the x86-64 baseline, so it is always available on the
+// platforms we ship. Kernels using it must keep a scalar fallback for other
+// architectures (guarded by VP_SIMD_SSE2).
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define VP_SIMD_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define VP_SIMD_SSE2 0
+#endif
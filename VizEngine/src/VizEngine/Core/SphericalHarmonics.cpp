@@ -0,0 +1,223 @@
+#include "SphericalHarmonics.h"
+#include "VizEngine/Core/Half.h"
+#include "VizEngine/Core/ThreadPool.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace VizEngine
+{
+	static constexpr double Pi = 3.14159265358979323846;
+
+	// Real SH basis, evaluated for a unit direction
+	static void EvaluateBasis(double x, double y, double z, double basis[9])
+	{
+		basis[0] = 0.282095;
+		basis[1] = 0.488603 * y;
+		basis[2] = 0.488603 * z;
+		basis[3] = 0.488603 * x;
+		basis[4] = 1.092548 * x * y;
+		basis[5] = 1.092548 * y * z;
+		basis[6] = 0.315392 * (3.0 * z * z - 1.0);
+		basis[7] = 1.092548 * x * z;
+		basis[8] = 0.546274 * (x * x - y * y);
+	}
+
+	// Direction through (sc, tc) in [-1, 1] of a cubemap face (GL conventions)
+	static void FaceDirection(int face, double sc, double tc, double& x, double& y, double& z)
+	{
+		switch (face)
+		{
+		case 0: x = 1.0;  y = -tc;  z = -sc;  break;  // +X
+		case 1: x = -1.0; y = -tc;  z = sc;   break;  // -X
+		case 2: x = sc;   y = 1.0;  z = tc;   break;  // +Y
+		case 3: x = sc;   y = -1.0; z = -tc;  break;  // -Y
+		case 4: x = sc;   y = -tc;  z = 1.0;  break;  // +Z
+		default: x = -sc; y = -tc;  z = -1.0; break;  // -Z
+		}
+	}
+
+	// Solid angle of the face rectangle from the center to (x, y)
+	static double AreaElement(double x, double y)
+	{
+		return std::atan2(x * y, std::sqrt(x * x + y * y + 1.0));
+	}
+
+	// RGB of texel `index` of one face
+	static bool ReadTexel(const TextureData& data, const uint8_t* face, size_t index, double rgb[3])
+	{
+		switch (data.Type)
+		{
+		case GL_UNSIGNED_BYTE:
+		{
+			size_t channels = data.Format == GL_RGBA ? 4 : 3;
+			for (int c = 0; c < 3; c++)
+			{
+				rgb[c] = face[index * channels + c] / 255.0;
+			}
+			return true;
+		}
+		case GL_HALF_FLOAT:
+		{
+			size_t channels = data.Format == GL_RGBA ? 4 : 3;
+			for (int c = 0; c < 3; c++)
+			{
+				uint16_t half;
+				std::memcpy(&half, face + (index * channels + c) * 2, 2);
+				rgb[c] = Half::ToFloat(half);
+			}
+			return true;
+		}
+		case GL_FLOAT:
+		{
+			size_t channels = data.Format == GL_RGBA ? 4 : 3;
+			for (int c = 0; c < 3; c++)
+			{
+				float value;
+				std::memcpy(&value, face + (index * channels + c) * 4, 4);
+				rgb[c] = value;
+			}
+			return true;
+		}
+		case GL_UNSIGNED_INT_5_9_9_9_REV:
+		{
+			uint32_t packed;
+			std::memcpy(&packed, face + index * 4, 4);
+			double scale = std::ldexp(1.0, static_cast<int>(packed >> 27) - 24);
+			rgb[0] = (packed & 511) * scale;
+			rgb[1] = ((packed >> 9) & 511) * scale;
+			rgb[2] = ((packed >> 18) & 511) * scale;
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
+	bool SphericalHarmonics::ProjectCubemap(const TextureData& cubemap, SH9& out)
+	{
+		out = SH9();
+		bool supported = cubemap.Type == GL_UNSIGNED_BYTE || cubemap.Type == GL_HALF_FLOAT ||
+			cubemap.Type == GL_FLOAT || cubemap.Type == GL_UNSIGNED_INT_5_9_9_9_REV;
+		if (!cubemap.IsValid() || cubemap.Faces != 6 || cubemap.Compressed || !supported ||
+			cubemap.GetWidth() != cubemap.GetHeight())
+		{
+			VP_CORE_ERROR("SphericalHarmonics: unsupported cubemap (GL format 0x{:X}, {} faces)",
+				cubemap.InternalFormat, cubemap.Faces);
+			return false;
+		}
+
+		// Per-face partial sums, reduced below in a fixed order
+		struct FaceSum
+		{
+			double Coefficients[9][3] = {};
+			double Weight = 0.0;
+		};
+		std::array<FaceSum, 6> sums;
+
+		int size = cubemap.GetWidth();
+		double texel = 2.0 / size;
+		ThreadPool::Get().ParallelFor(6, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t face = begin; face < end; face++)
+			{
+				FaceSum& sum = sums[face];
+				const uint8_t* data = cubemap.GetFaceData(0, static_cast<unsigned int>(face));
+				for (int y = 0; y < size; y++)
+				{
+					double tc = (y + 0.5) * texel - 1.0;
+					for (int x = 0; x < size; x++)
+					{
+						double sc = (x + 0.5) * texel - 1.0;
+						double x0 = sc - texel * 0.5, x1 = sc + texel * 0.5;
+						double y0 = tc - texel * 0.5, y1 = tc + texel * 0.5;
+						double weight = AreaElement(x0, y0) - AreaElement(x0, y1) - AreaElement(x1, y0) + AreaElement(x1, y1);
+
+						double dx, dy, dz;
+						FaceDirection(static_cast<int>(face), sc, tc, dx, dy, dz);
+						double length = std::sqrt(dx * dx + dy * dy + dz * dz);
+						double basis[9];
+						EvaluateBasis(dx / length, dy / length, dz / length, basis);
+
+						double rgb[3];
+						ReadTexel(cubemap, data, static_cast<size_t>(y) * size + x, rgb);
+						for (int i = 0; i < 9; i++)
+						{
+							for (int c = 0; c < 3; c++)
+							{
+								sum.Coefficients[i][c] += rgb[c] * basis[i] * weight;
+							}
+						}
+						sum.Weight += weight;
+					}
+				}
+			}
+		});
+
+		double coefficients[9][3] = {};
+		double totalWeight = 0.0;
+		for (const FaceSum& sum : sums)
+		{
+			for (int i = 0; i < 9; i++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					coefficients[i][c] += sum.Coefficients[i][c];
+				}
+			}
+			totalWeight += sum.Weight;
+		}
+
+		// The texel solid angles add up to 4 pi; renormalize away rounding
+		double normalization = 4.0 * Pi / totalWeight;
+		for (int i = 0; i < 9; i++)
+		{
+			out.Coefficients[i] = glm::vec3(
+				static_cast<float>(coefficients[i][0] * normalization),
+				static_cast<float>(coefficients[i][1] * normalization),
+				static_cast<float>(coefficients[i][2] * normalization));
+		}
+		return true;
+	}
+
+	SH9 SphericalHarmonics::ToIrradiance(const SH9& radiance)
+	{
+		// Cosine lobe convolution per band (pi, 2pi/3, pi/4), then 1/pi for Lambert
+		static constexpr float Band[9] = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f,
+			0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+		SH9 irradiance;
+		for (int i = 0; i < 9; i++)
+		{
+			irradiance.Coefficients[i] = radiance.Coefficients[i] * Band[i];
+		}
+		return irradiance;
+	}
+
+	glm::vec3 SphericalHarmonics::Evaluate(const SH9& sh, const glm::vec3& direction)
+	{
+		glm::vec3 n = glm::normalize(direction);
+		double basis[9];
+		EvaluateBasis(n.x, n.y, n.z, basis);
+		glm::vec3 result(0.0f);
+		for (int i = 0; i < 9; i++)
+		{
+			result += sh.Coefficients[i] * static_cast<float>(basis[i]);
+		}
+		return result;
+	}
+
+	SHUniformBlock SphericalHarmonics::ToUniformBlock(const SH9& irradiance, float intensity)
+	{
+		SHUniformBlock block;
+		for (int i = 0; i < 9; i++)
+		{
+			block.Coefficients[i] = glm::vec4(irradiance.Coefficients[i], 0.0f);
+		}
+		block.Params = glm::vec4(intensity, 0.0f, 0.0f, 0.0f);
+		return block;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/TextureData.h"
+#include "glm.hpp"
+
+namespace VizEngine
+{
+	/**
+	 * Order-2 (9 coefficient) real spherical harmonics of an RGB signal.
+	 * Coefficient order: L00, L1-1, L10, L11, L2-2, L2-1, L20, L21, L22.
+	 */
+	struct SH9
+	{
+		glm::vec3 Coefficients[9] = {};
+	};
+
+	/**
+	 * std140 layout of the EnvironmentLighting block in lit.shader
+	 * (binding SphericalHarmonics::UniformBinding).
+	 */
+	struct SHUniformBlock
+	{
+		glm::vec4 Coefficients[9];   // rgb used, w padding
+		glm::vec4 Params;            // x = intensity (lit.shader reads it with ENV_DIFFUSE,
+		                             //     which callers turn off at 0 for u_LightAmbient)
+		                             // y = specular IBL intensity, 0 = none;
+		                             // z = last mip of the prefiltered map (see CubemapUtils::PrefilterSpecular)
+	};
+
+	/**
+	 * Diffuse image-based lighting from spherical harmonics.
+	 *
+	 * ProjectCubemap() reduces an environment cubemap to 9 radiance
+	 * coefficients (each face reduced in parallel on the ThreadPool, texels
+	 * weighted by their solid angle). ToIrradiance() convolves them with the
+	 * cosine lobe, so shaders evaluate diffuse lighting with a few multiply-adds
+	 * per pixel and no irradiance map or convolution pass.
+	 *
+	 * Small cubemap mips give the same result as the full face (SH9 keeps only
+	 * low frequencies), e.g. CubemapUtils::ReadFaces with a level near 32x32.
+	 */
+	class VizEngine_API SphericalHarmonics
+	{
+	public:
+		static constexpr unsigned int UniformBinding = 3;
+
+		/**
+		 * Project level 0 of a cubemap (Faces = 6; RGB8, RGB16F, RGBA16F,
+		 * RGB9E5 or float) onto SH9 radiance coefficients.
+		 * @return false for unsupported data
+		 */
+		static bool ProjectCubemap(const TextureData& cubemap, SH9& out);
+
+		/**
+		 * Convolve radiance with the clamped cosine lobe and divide by pi:
+		 * Evaluate() of the result is the light reflected by a white
+		 * Lambertian surface with that normal.
+		 */
+		static SH9 ToIrradiance(const SH9& radiance);
+
+		static glm::vec3 Evaluate(const SH9& sh, const glm::vec3& direction);
+
+		static SHUniformBlock ToUniformBlock(const SH9& irradiance, float intensity);
+	};
+}
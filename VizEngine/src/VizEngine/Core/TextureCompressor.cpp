@@ -0,0 +1,634 @@
+#include "TextureCompressor.h"
+#include "VizEngine/Core/Hash.h"
+#include "VizEngine/Core/Ktx2.h"
+#include "VizEngine/Core/Simd.h"
+#include "VizEngine/Core/ThreadPool.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace VizEngine
+{
+	// Bump when the encoders change, so cached results are rebuilt
+	static constexpr uint32_t EncoderVersion = 2;
+
+	// BC7 4-bit index weights (out of 64)
+	static constexpr int Bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	//==========================================================================
+	// Index fitting
+	//==========================================================================
+
+	// Nearest palette entry for each of the 16 pixels.
+	// @return Summed squared error
+	static uint32_t FitIndices(const uint8_t* pixels, const uint8_t (*palette)[4], int paletteSize, bool useAlpha, uint8_t indices[16])
+	{
+#if VP_SIMD_SSE2
+		// Four pixels per pass, 16-bit differences squared and summed with madd
+		const __m128i channelMask = _mm_set1_epi32(useAlpha ? -1 : 0x00FFFFFF);
+		const __m128i zero = _mm_setzero_si128();
+		uint32_t error = 0;
+
+		for (int group = 0; group < 4; group++)
+		{
+			__m128i px = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + group * 16)), channelMask);
+			__m128i pxLo = _mm_unpacklo_epi8(px, zero);
+			__m128i pxHi = _mm_unpackhi_epi8(px, zero);
+			__m128i best = _mm_set1_epi32(0x7FFFFFFF);
+			__m128i bestIndex = zero;
+
+			for (int i = 0; i < paletteSize; i++)
+			{
+				int32_t color;
+				std::memcpy(&color, palette[i], sizeof(color));
+				__m128i entry = _mm_unpacklo_epi8(_mm_and_si128(_mm_set1_epi32(color), channelMask), zero);
+
+				__m128i dLo = _mm_sub_epi16(pxLo, entry);
+				__m128i dHi = _mm_sub_epi16(pxHi, entry);
+				__m128i sLo = _mm_madd_epi16(dLo, dLo);  // [r2+g2, b2+a2] per pixel
+				__m128i sHi = _mm_madd_epi16(dHi, dHi);
+				sLo = _mm_add_epi32(sLo, _mm_shuffle_epi32(sLo, _MM_SHUFFLE(2, 3, 0, 1)));
+				sHi = _mm_add_epi32(sHi, _mm_shuffle_epi32(sHi, _MM_SHUFFLE(2, 3, 0, 1)));
+				__m128i distance = _mm_castps_si128(_mm_shuffle_ps(
+					_mm_castsi128_ps(sLo), _mm_castsi128_ps(sHi), _MM_SHUFFLE(2, 0, 2, 0)));
+
+				__m128i closer = _mm_cmplt_epi32(distance, best);
+				best = _mm_or_si128(_mm_and_si128(closer, distance), _mm_andnot_si128(closer, best));
+				bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(i)), _mm_andnot_si128(closer, bestIndex));
+			}
+
+			alignas(16) int32_t groupIndices[4];
+			alignas(16) int32_t groupErrors[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(groupIndices), bestIndex);
+			_mm_store_si128(reinterpret_cast<__m128i*>(groupErrors), best);
+			for (int k = 0; k < 4; k++)
+			{
+				indices[group * 4 + k] = static_cast<uint8_t>(groupIndices[k]);
+				error += static_cast<uint32_t>(groupErrors[k]);
+			}
+		}
+		return error;
+#else
+		int channels = useAlpha ? 4 : 3;
+		uint32_t error = 0;
+		for (int p = 0; p < 16; p++)
+		{
+			const uint8_t* px = pixels + p * 4;
+			uint32_t best = ~0u;
+			for (int i = 0; i < paletteSize; i++)
+			{
+				uint32_t distance = 0;
+				for (int c = 0; c < channels; c++)
+				{
+					int d = int(px[c]) - int(palette[i][c]);
+					distance += static_cast<uint32_t>(d * d);
+				}
+				if (distance < best)
+				{
+					best = distance;
+					indices[p] = static_cast<uint8_t>(i);
+				}
+			}
+			error += best;
+		}
+		return error;
+#endif
+	}
+
+	//==========================================================================
+	// Endpoint search
+	//==========================================================================
+
+	// Mean and principal axis (power iteration on the covariance) of the
+	// block's colors, using the first `channels` components
+	static void PrincipalAxis(const uint8_t* pixels, int channels, float mean[4], float axis[4])
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			mean[c] = 0.0f;
+			axis[c] = 0.0f;
+		}
+		for (int p = 0; p < 16; p++)
+		{
+			for (int c = 0; c < channels; c++)
+			{
+				mean[c] += pixels[p * 4 + c];
+			}
+		}
+		for (int c = 0; c < channels; c++)
+		{
+			mean[c] /= 16.0f;
+		}
+
+		float covariance[4][4] = {};
+		for (int p = 0; p < 16; p++)
+		{
+			float d[4];
+			for (int c = 0; c < channels; c++)
+			{
+				d[c] = pixels[p * 4 + c] - mean[c];
+			}
+			for (int i = 0; i < channels; i++)
+			{
+				for (int j = i; j < channels; j++)
+				{
+					covariance[i][j] += d[i] * d[j];
+				}
+			}
+		}
+		for (int i = 0; i < channels; i++)
+		{
+			for (int j = 0; j < i; j++)
+			{
+				covariance[i][j] = covariance[j][i];
+			}
+		}
+
+		// Start from the channel with the largest variance
+		int start = 0;
+		for (int c = 1; c < channels; c++)
+		{
+			start = covariance[c][c] > covariance[start][start] ? c : start;
+		}
+		for (int c = 0; c < channels; c++)
+		{
+			axis[c] = covariance[start][c];
+		}
+
+		for (int iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = {};
+			float length = 0.0f;
+			for (int i = 0; i < channels; i++)
+			{
+				for (int j = 0; j < channels; j++)
+				{
+					next[i] += covariance[i][j] * axis[j];
+				}
+				length = std::max(length, std::fabs(next[i]));
+			}
+			if (length <= 0.0f)
+			{
+				break;  // Flat block: any axis works
+			}
+			for (int c = 0; c < channels; c++)
+			{
+				axis[c] = next[c] / length;
+			}
+		}
+
+		float length = 0.0f;
+		for (int c = 0; c < channels; c++)
+		{
+			length += axis[c] * axis[c];
+		}
+		length = std::sqrt(length);
+		for (int c = 0; c < channels; c++)
+		{
+			axis[c] = length > 0.0f ? axis[c] / length : 0.0f;
+		}
+	}
+
+	// Extremes of the block projected on the principal axis
+	static void AxisEndpoints(const uint8_t* pixels, int channels, float e0[4], float e1[4])
+	{
+		float mean[4], axis[4];
+		PrincipalAxis(pixels, channels, mean, axis);
+
+		float tMin = 0.0f, tMax = 0.0f;
+		for (int p = 0; p < 16; p++)
+		{
+			float t = 0.0f;
+			for (int c = 0; c < channels; c++)
+			{
+				t += (pixels[p * 4 + c] - mean[c]) * axis[c];
+			}
+			tMin = std::min(tMin, t);
+			tMax = std::max(tMax, t);
+		}
+		for (int c = 0; c < 4; c++)
+		{
+			e0[c] = c < channels ? std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f) : 255.0f;
+			e1[c] = c < channels ? std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f) : 255.0f;
+		}
+	}
+
+	// Least-squares endpoints for fixed indices; weights[i] is how far index i
+	// lies from e0 towards e1. @return false if the system is degenerate.
+	static bool RefineEndpoints(const uint8_t* pixels, int channels, const uint8_t indices[16], const float* weights, float e0[4], float e1[4])
+	{
+		float a = 0.0f, b = 0.0f, c = 0.0f;
+		float x0[4] = {}, x1[4] = {};
+		for (int p = 0; p < 16; p++)
+		{
+			float t = weights[indices[p]];
+			float s = 1.0f - t;
+			a += s * s;
+			b += s * t;
+			c += t * t;
+			for (int k = 0; k < channels; k++)
+			{
+				x0[k] += s * pixels[p * 4 + k];
+				x1[k] += t * pixels[p * 4 + k];
+			}
+		}
+
+		float determinant = a * c - b * b;
+		if (std::fabs(determinant) < 1e-6f)
+		{
+			return false;
+		}
+		for (int k = 0; k < channels; k++)
+		{
+			e0[k] = std::clamp((c * x0[k] - b * x1[k]) / determinant, 0.0f, 255.0f);
+			e1[k] = std::clamp((a * x1[k] - b * x0[k]) / determinant, 0.0f, 255.0f);
+		}
+		return true;
+	}
+
+	//==========================================================================
+	// BC1
+	//==========================================================================
+	static uint16_t Pack565(const float color[4])
+	{
+		int r = static_cast<int>(color[0] * 31.0f / 255.0f + 0.5f);
+		int g = static_cast<int>(color[1] * 63.0f / 255.0f + 0.5f);
+		int b = static_cast<int>(color[2] * 31.0f / 255.0f + 0.5f);
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	static void Unpack565(uint16_t packed, uint8_t out[4])
+	{
+		int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+		out[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+		out[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+		out[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+		out[3] = 255;
+	}
+
+	// Four-color mode requires c0 > c1; equal endpoints make a flat block
+	static uint32_t FitBC1(const uint8_t* pixels, uint16_t& c0, uint16_t& c1, uint8_t indices[16])
+	{
+		if (c0 < c1)
+		{
+			std::swap(c0, c1);
+		}
+
+		uint8_t palette[4][4];
+		Unpack565(c0, palette[0]);
+		Unpack565(c1, palette[1]);
+		for (int c = 0; c < 3; c++)
+		{
+			palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+			palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+		}
+		palette[2][3] = palette[3][3] = 255;
+
+		return FitIndices(pixels, palette, c0 == c1 ? 1 : 4, false, indices);
+	}
+
+	void TextureCompressor::EncodeBC1(const uint8_t rgba[64], uint8_t out[8])
+	{
+		static constexpr float Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+		float e0[4], e1[4];
+		AxisEndpoints(rgba, 3, e0, e1);
+		uint16_t c0 = Pack565(e1), c1 = Pack565(e0);
+		uint8_t indices[16];
+		uint32_t error = FitBC1(rgba, c0, c1, indices);
+
+		if (c0 != c1 && RefineEndpoints(rgba, 3, indices, Weights, e0, e1))
+		{
+			uint16_t r0 = Pack565(e0), r1 = Pack565(e1);
+			uint8_t refined[16];
+			uint32_t refinedError = FitBC1(rgba, r0, r1, refined);
+			if (refinedError < error)
+			{
+				c0 = r0;
+				c1 = r1;
+				std::memcpy(indices, refined, sizeof(refined));
+			}
+		}
+
+		uint32_t bits = 0;
+		for (int p = 0; p < 16; p++)
+		{
+			bits |= static_cast<uint32_t>(indices[p]) << (p * 2);
+		}
+		std::memcpy(out, &c0, 2);
+		std::memcpy(out + 2, &c1, 2);
+		std::memcpy(out + 4, &bits, 4);
+	}
+
+	//==========================================================================
+	// BC4 / BC5
+	//==========================================================================
+	static void EncodeBC4(const uint8_t* rgba, int channel, uint8_t out[8])
+	{
+		int lo = 255, hi = 0;
+		for (int p = 0; p < 16; p++)
+		{
+			lo = std::min(lo, int(rgba[p * 4 + channel]));
+			hi = std::max(hi, int(rgba[p * 4 + channel]));
+		}
+
+		// Eight-value mode (e0 > e1): code 0 = e0, 1 = e1, 2..7 = blends towards e1
+		out[0] = static_cast<uint8_t>(hi);
+		out[1] = static_cast<uint8_t>(lo);
+		uint64_t bits = 0;
+		int range = hi - lo;
+		if (range > 0)
+		{
+			for (int p = 0; p < 16; p++)
+			{
+				int step = ((hi - rgba[p * 4 + channel]) * 7 + range / 2) / range;
+				uint64_t code = step == 0 ? 0 : (step == 7 ? 1 : static_cast<uint64_t>(step + 1));
+				bits |= code << (p * 3);
+			}
+		}
+		for (int i = 0; i < 6; i++)
+		{
+			out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+		}
+	}
+
+	void TextureCompressor::EncodeBC5(const uint8_t rgba[64], uint8_t out[16])
+	{
+		EncodeBC4(rgba, 0, out);
+		EncodeBC4(rgba, 1, out + 8);
+	}
+
+	//==========================================================================
+	// BC7 (mode 6)
+	//==========================================================================
+
+	// 7-bit endpoint plus shared p-bit closest to `color`
+	static void QuantizeBc7Endpoint(const float color[4], uint8_t quantized[4], uint8_t& pBit)
+	{
+		float bestError = 0.0f;
+		for (uint8_t p = 0; p < 2; p++)
+		{
+			uint8_t candidate[4];
+			float error = 0.0f;
+			for (int c = 0; c < 4; c++)
+			{
+				int q = static_cast<int>(std::lround((color[c] - p) * 0.5f));
+				candidate[c] = static_cast<uint8_t>(std::clamp(q, 0, 127));
+				float d = static_cast<float>(candidate[c] * 2 + p) - color[c];
+				error += d * d;
+			}
+			if (p == 0 || error < bestError)
+			{
+				bestError = error;
+				pBit = p;
+				std::memcpy(quantized, candidate, 4);
+			}
+		}
+	}
+
+	static uint32_t FitBC7(const uint8_t* pixels, const float e0[4], const float e1[4],
+		uint8_t q0[4], uint8_t q1[4], uint8_t pBits[2], uint8_t indices[16])
+	{
+		QuantizeBc7Endpoint(e0, q0, pBits[0]);
+		QuantizeBc7Endpoint(e1, q1, pBits[1]);
+
+		uint8_t palette[16][4];
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				int a = q0[c] * 2 + pBits[0];
+				int b = q1[c] * 2 + pBits[1];
+				palette[i][c] = static_cast<uint8_t>(((64 - Bc7Weights[i]) * a + Bc7Weights[i] * b + 32) >> 6);
+			}
+		}
+		return FitIndices(pixels, palette, 16, true, indices);
+	}
+
+	void TextureCompressor::EncodeBC7(const uint8_t rgba[64], uint8_t out[16])
+	{
+		static const float* Weights = []()
+		{
+			static float weights[16];
+			for (int i = 0; i < 16; i++)
+			{
+				weights[i] = Bc7Weights[i] / 64.0f;
+			}
+			return weights;
+		}();
+
+		float e0[4], e1[4];
+		AxisEndpoints(rgba, 4, e0, e1);
+		uint8_t q0[4], q1[4], pBits[2], indices[16];
+		uint32_t error = FitBC7(rgba, e0, e1, q0, q1, pBits, indices);
+
+		if (RefineEndpoints(rgba, 4, indices, Weights, e0, e1))
+		{
+			uint8_t r0[4], r1[4], rBits[2], refined[16];
+			if (FitBC7(rgba, e0, e1, r0, r1, rBits, refined) < error)
+			{
+				std::memcpy(q0, r0, 4);
+				std::memcpy(q1, r1, 4);
+				std::memcpy(pBits, rBits, 2);
+				std::memcpy(indices, refined, 16);
+			}
+		}
+
+		// The first index is stored with an implicit 0 MSB
+		if (indices[0] & 8)
+		{
+			std::swap_ranges(q0, q0 + 4, q1);
+			std::swap(pBits[0], pBits[1]);
+			for (uint8_t& index : indices)
+			{
+				index = static_cast<uint8_t>(15 - index);
+			}
+		}
+
+		uint64_t bits[2] = { 0, 0 };
+		int position = 0;
+		auto write = [&bits, &position](uint64_t value, int count)
+		{
+			for (int i = 0; i < count; i++, position++)
+			{
+				bits[position >> 6] |= ((value >> i) & 1) << (position & 63);
+			}
+		};
+
+		write(1ull << 6, 7);  // Mode 6
+		for (int c = 0; c < 4; c++)
+		{
+			write(q0[c], 7);
+			write(q1[c], 7);
+		}
+		write(pBits[0], 1);
+		write(pBits[1], 1);
+		write(indices[0], 3);
+		for (int p = 1; p < 16; p++)
+		{
+			write(indices[p], 4);
+		}
+		std::memcpy(out, bits, 16);
+	}
+
+	//==========================================================================
+	// Images
+	//==========================================================================
+
+	static void EncodeLevel(const uint8_t* rgba, int width, int height, BlockFormat format, uint8_t* out)
+	{
+		int blocksX = (width + 3) / 4;
+		int blocksY = (height + 3) / 4;
+		size_t blockBytes = format == BlockFormat::BC1 ? 8 : 16;
+
+		ThreadPool& pool = ThreadPool::Get();
+		size_t grain = std::max<size_t>(1, blocksY / (pool.GetThreadCount() * 4 + 1));
+		pool.ParallelFor(static_cast<size_t>(blocksY), grain, [&](size_t begin, size_t end)
+		{
+			uint8_t block[64];
+			for (size_t by = begin; by < end; by++)
+			{
+				for (int bx = 0; bx < blocksX; bx++)
+				{
+					// Partial edge blocks repeat the last row / column
+					for (int y = 0; y < 4; y++)
+					{
+						int sy = std::min(static_cast<int>(by) * 4 + y, height - 1);
+						for (int x = 0; x < 4; x++)
+						{
+							int sx = std::min(bx * 4 + x, width - 1);
+							std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+						}
+					}
+
+					uint8_t* target = out + (by * blocksX + bx) * blockBytes;
+					switch (format)
+					{
+						case BlockFormat::BC1: TextureCompressor::EncodeBC1(block, target); break;
+						case BlockFormat::BC5: TextureCompressor::EncodeBC5(block, target); break;
+						case BlockFormat::BC7: TextureCompressor::EncodeBC7(block, target); break;
+					}
+				}
+			}
+		});
+	}
+
+	BlockFormat TextureCompressor::ChooseFormat(const uint8_t* rgba, int width, int height, MipContent content,
+		const TextureCompressionOptions& options)
+	{
+		if (content == MipContent::NormalMap && options.NormalsAsBC5)
+		{
+			return BlockFormat::BC5;
+		}
+		if (!options.OpaqueAsBC1)
+		{
+			return BlockFormat::BC7;
+		}
+
+		size_t pixelCount = static_cast<size_t>(width) * height;
+		for (size_t i = 0; i < pixelCount; i++)
+		{
+			if (rgba[i * 4 + 3] != 255)
+			{
+				return BlockFormat::BC7;
+			}
+		}
+		return BlockFormat::BC1;
+	}
+
+	bool TextureCompressor::Compress(const uint8_t* rgba, int width, int height, BlockFormat format,
+		MipContent content, const MipOptions& mips, TextureData& out)
+	{
+		TextureData chain;
+		if (!MipGenerator::Generate(rgba, width, height, content, mips, chain))
+		{
+			out = TextureData();
+			return false;
+		}
+		return Compress(chain, format, out);
+	}
+
+	bool TextureCompressor::Compress(const TextureData& mips, BlockFormat format, TextureData& out)
+	{
+		out = TextureData();
+		if (!mips.IsValid() || mips.Compressed || mips.InternalFormat != GL_RGBA8)
+		{
+			VP_CORE_ERROR("TextureCompressor: expected an RGBA8 mip chain");
+			return false;
+		}
+
+		out.Compressed = true;
+		switch (format)
+		{
+			case BlockFormat::BC1: out.InternalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
+			case BlockFormat::BC5: out.InternalFormat = GL_COMPRESSED_RG_RGTC2; break;
+			case BlockFormat::BC7: out.InternalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+		}
+		size_t blockBytes = format == BlockFormat::BC1 ? 8 : 16;
+
+		size_t total = 0;
+		out.Levels.resize(mips.Levels.size());
+		for (size_t level = 0; level < mips.Levels.size(); level++)
+		{
+			TextureData::Level& entry = out.Levels[level];
+			entry.Width = mips.Levels[level].Width;
+			entry.Height = mips.Levels[level].Height;
+			entry.Offset = total;
+			entry.Size = static_cast<size_t>((entry.Width + 3) / 4) * ((entry.Height + 3) / 4) * blockBytes;
+			total += entry.Size;
+		}
+		out.Bytes.resize(total);
+
+		for (size_t level = 0; level < out.Levels.size(); level++)
+		{
+			const TextureData::Level& entry = out.Levels[level];
+			EncodeLevel(mips.GetLevelData(level), entry.Width, entry.Height, format, out.Bytes.data() + entry.Offset);
+		}
+		return true;
+	}
+
+	//==========================================================================
+	// Cache
+	//==========================================================================
+	uint64_t TextureCompressor::GetOptionsHash(const TextureCompressionOptions& options, MipContent content,
+		const MipOptions& mips)
+	{
+		uint64_t flags = (options.OpaqueAsBC1 ? 1u : 0u) | (options.NormalsAsBC5 ? 2u : 0u);
+		return Hash::Combine(Hash::Combine(EncoderVersion, flags), MipGenerator::GetOptionsHash(content, mips));
+	}
+
+	std::string TextureCompressor::GetCachePath(const std::string& assetPath, uint64_t sourceKey, MipContent content,
+		const MipOptions& mips, const TextureCompressionOptions& options)
+	{
+		uint64_t key = Hash::Combine(sourceKey, GetOptionsHash(options, content, mips));
+
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.ktx2", static_cast<unsigned long long>(key));
+		std::filesystem::path directory = std::filesystem::path(assetPath).parent_path() / options.CacheFolder;
+		return (directory / name).string();
+	}
+
+	bool TextureCompressor::LoadCached(const std::string& cachePath, TextureData& out)
+	{
+		std::error_code ec;
+		if (!std::filesystem::exists(cachePath, ec))
+		{
+			return false;
+		}
+		return Ktx2::Load(cachePath, out);
+	}
+
+	void TextureCompressor::Store(const std::string& cachePath, const TextureData& data)
+	{
+		if (Ktx2::Write(cachePath, data))
+		{
+			VP_CORE_TRACE("Texture cache written: {}", cachePath);
+		}
+	}
+}
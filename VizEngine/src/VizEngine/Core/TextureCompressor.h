@@ -0,0 +1,101 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/MipGenerator.h"
+#include "VizEngine/Core/TextureData.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace VizEngine
+{
+	enum class BlockFormat
+	{
+		BC1,  // RGB, 4 bpp
+		BC5,  // Two channels (tangent-space normal X/Y), 8 bpp
+		BC7   // RGBA, 8 bpp
+	};
+
+	/**
+	 * Options for compressing RGBA8 images into BCn at import.
+	 */
+	struct TextureCompressionOptions
+	{
+		// Opaque color images use BC1 (8:1) instead of BC7 (4:1)
+		bool OpaqueAsBC1 = true;
+
+		// Normal maps keep X/Y in BC5; shaders rebuild Z = sqrt(1 - x^2 - y^2)
+		bool NormalsAsBC5 = true;
+
+		// Compressed results are cached in this folder next to the source asset
+		std::string CacheFolder = ".vpcache";
+	};
+
+	/**
+	 * Multi-threaded BC1 / BC5 / BC7 encoder with an on-disk cache.
+	 *
+	 * Mips come from MipGenerator (gamma-correct, normal-aware filtering).
+	 * Blocks are encoded in parallel on the ThreadPool (the calling thread
+	 * helps). Endpoints come from the principal axis of each block, refined
+	 * once by least squares; index selection uses SSE2 where available.
+	 * BC7 uses mode 6 only (one subset, 4-bit indices), which covers most
+	 * color and alpha content at a fraction of a full mode search.
+	 *
+	 * Results are written as KTX2 files named after a hash of the source data
+	 * and the options, so a later load skips both the decode and the encode.
+	 */
+	class VizEngine_API TextureCompressor
+	{
+	public:
+		/**
+		 * Format for an RGBA8 image: BC5 for normal maps, BC7 when any pixel
+		 * is translucent, BC1 otherwise (see TextureCompressionOptions).
+		 */
+		static BlockFormat ChooseFormat(const uint8_t* rgba, int width, int height, MipContent content,
+			const TextureCompressionOptions& options = {});
+
+		/**
+		 * Build a mip chain for an RGBA8 image and encode every level.
+		 * @return false for empty images
+		 */
+		static bool Compress(const uint8_t* rgba, int width, int height, BlockFormat format,
+			MipContent content, const MipOptions& mips, TextureData& out);
+
+		/**
+		 * Encode every level of an uncompressed RGBA8 chain (see MipGenerator).
+		 * @return false if `mips` isn't RGBA8
+		 */
+		static bool Compress(const TextureData& mips, BlockFormat format, TextureData& out);
+
+		/**
+		 * Hash of everything that changes the result for a given source image
+		 * (options, content type, mip filter, encoder version).
+		 */
+		static uint64_t GetOptionsHash(const TextureCompressionOptions& options, MipContent content,
+			const MipOptions& mips);
+
+		/**
+		 * Cache file for a source image.
+		 * @param assetPath File the image belongs to (the image itself or its model)
+		 * @param sourceKey Hash of the encoded source image
+		 */
+		static std::string GetCachePath(const std::string& assetPath, uint64_t sourceKey, MipContent content,
+			const MipOptions& mips, const TextureCompressionOptions& options = {});
+
+		/**
+		 * Read a cached result written by Store().
+		 * @return false on a miss (or an unreadable entry)
+		 */
+		static bool LoadCached(const std::string& cachePath, TextureData& out);
+
+		/**
+		 * Write a compressed result to the cache. Failures are logged and ignored.
+		 */
+		static void Store(const std::string& cachePath, const TextureData& data);
+
+		// Single-block encoders: `rgba` is 4x4 pixels, row by row
+		static void EncodeBC1(const uint8_t rgba[64], uint8_t out[8]);
+		static void EncodeBC5(const uint8_t rgba[64], uint8_t out[16]);
+		static void EncodeBC7(const uint8_t rgba[64], uint8_t out[16]);
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// S3TC is an extension (EXT_texture_compression_s3tc), so the core glad header
+// doesn't define it. Every desktop driver supports it.
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+namespace VizEngine
+{
+	/**
+	 * A texture prepared on the CPU with its complete mip chain, ready to be
+	 * uploaded as-is by Texture(const TextureData&): no decode and no
+	 * glGenerateMipmap on the GL thread.
+	 *
+	 * Block-compressed data (Compressed = true) is uploaded with
+	 * glCompressedTexImage2D; uncompressed data with glTexImage2D using
+	 * Format / Type. Levels are tightly packed (no row padding).
+	 *
+	 * Cubemaps have Faces = 6: each level then holds its faces back to back
+	 * in GL order (+X, -X, +Y, -Y, +Z, -Z), as KTX2 stores them.
+	 */
+	struct TextureData
+	{
+		struct Level
+		{
+			size_t Offset = 0;  // Into Bytes
+			size_t Size = 0;    // All faces
+			int Width = 0;
+			int Height = 0;
+		};
+
+		unsigned int InternalFormat = 0;  // GL sized or compressed internal format
+		unsigned int Format = 0;          // Uncompressed only (e.g. GL_RGBA)
+		unsigned int Type = 0;            // Uncompressed only (e.g. GL_UNSIGNED_BYTE)
+		bool Compressed = false;
+		unsigned int Faces = 1;
+
+		std::vector<Level> Levels;        // Level 0 is the full resolution image
+		std::vector<uint8_t> Bytes;
+
+		bool IsValid() const { return InternalFormat != 0 && !Levels.empty(); }
+		int GetWidth() const { return Levels.empty() ? 0 : Levels[0].Width; }
+		int GetHeight() const { return Levels.empty() ? 0 : Levels[0].Height; }
+		const uint8_t* GetLevelData(size_t level) const { return Bytes.data() + Levels[level].Offset; }
+		const uint8_t* GetFaceData(size_t level, unsigned int face) const
+		{
+			return GetLevelData(level) + Levels[level].Size / Faces * face;
+		}
+	};
+}
@@ -0,0 +1,324 @@
+#include "TextureStreamer.h"
+#include "VizEngine/Core/Ktx2.h"
+#include "VizEngine/Core/ThreadPool.h"
+#include "VizEngine/Core/UploadQueue.h"
+#include "VizEngine/OpenGL/Texture.h"
+#include "VizEngine/Log.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+namespace VizEngine
+{
+	static constexpr int NotRequested = INT_MAX;
+
+	TextureStreamer& TextureStreamer::Get()
+	{
+		static TextureStreamer instance;
+		return instance;
+	}
+
+	//==========================================================================
+	// Registration
+	//==========================================================================
+	uint64_t TextureStreamer::Register(Texture& texture, const TextureData& data, TextureStreamSource source)
+	{
+		Entry entry;
+		entry.Owner = &texture;
+		entry.Source = std::move(source);
+		entry.Layout.InternalFormat = data.InternalFormat;
+		entry.Layout.Format = data.Format;
+		entry.Layout.Type = data.Type;
+		entry.Layout.Compressed = data.Compressed;
+		entry.Layout.Levels = data.Levels;
+
+		// Finest level that is small enough to keep resident at all times
+		int levelCount = static_cast<int>(data.Levels.size());
+		entry.MinLevel = levelCount - 1;
+		for (int level = 0; level < levelCount; level++)
+		{
+			if (std::max(data.Levels[level].Width, data.Levels[level].Height) <= m_Settings.MinResidentSize)
+			{
+				entry.MinLevel = level;
+				break;
+			}
+		}
+		entry.Resident = entry.MinLevel;
+		entry.Wanted = entry.MinLevel;
+		entry.Requested = NotRequested;
+
+		texture.Reallocate(entry.Layout, entry.Resident, levelCount, &data);
+		m_ResidentBytes += LevelBytes(entry, entry.Resident, levelCount);
+
+		uint64_t id = m_NextId++;
+		m_Entries.emplace(id, std::move(entry));
+		return id;
+	}
+
+	void TextureStreamer::Unregister(uint64_t id)
+	{
+		auto it = m_Entries.find(id);
+		if (it == m_Entries.end())
+		{
+			return;
+		}
+		const Entry& entry = it->second;
+		m_ResidentBytes -= LevelBytes(entry, entry.Resident, static_cast<int>(entry.Layout.Levels.size()));
+		m_PendingBytes -= entry.PendingBytes;
+		m_Entries.erase(it);
+	}
+
+	void TextureStreamer::Relocate(uint64_t id, Texture& texture)
+	{
+		auto it = m_Entries.find(id);
+		if (it != m_Entries.end())
+		{
+			it->second.Owner = &texture;
+		}
+	}
+
+	size_t TextureStreamer::LevelBytes(const Entry& entry, int first, int last)
+	{
+		size_t bytes = 0;
+		for (int level = first; level < last; level++)
+		{
+			bytes += entry.Layout.Levels[level].Size;
+		}
+		return bytes;
+	}
+
+	//==========================================================================
+	// Per frame
+	//==========================================================================
+	void TextureStreamer::Request(const Texture& texture, float level)
+	{
+		if (texture.m_StreamId == 0)
+		{
+			return;
+		}
+		auto it = m_Entries.find(texture.m_StreamId);
+		if (it == m_Entries.end())
+		{
+			return;
+		}
+
+		Entry& entry = it->second;
+		int finest = std::clamp(static_cast<int>(std::floor(level + m_Settings.MipBias)), 0, entry.MinLevel);
+		entry.Requested = std::min(entry.Requested, finest);
+	}
+
+	void TextureStreamer::Update()
+	{
+		m_Frame++;
+
+		// Fold the last frame's requests into what each texture needs
+		std::vector<uint64_t> loads;
+		for (auto& [id, entry] : m_Entries)
+		{
+			if (entry.Requested != NotRequested)
+			{
+				entry.Wanted = entry.Requested;
+				entry.LastUsed = m_Frame;
+			}
+			else if (m_Frame - entry.LastUsed > m_Settings.KeepFrames)
+			{
+				entry.Wanted = entry.MinLevel;
+			}
+			entry.Requested = NotRequested;
+
+			if (m_Settings.Enabled && entry.Source && !entry.Loading && entry.Wanted < entry.Resident)
+			{
+				loads.push_back(id);
+			}
+		}
+
+		// Most missing detail first
+		std::sort(loads.begin(), loads.end(), [this](uint64_t a, uint64_t b)
+		{
+			const Entry& ea = m_Entries.at(a);
+			const Entry& eb = m_Entries.at(b);
+			return ea.Resident - ea.Wanted > eb.Resident - eb.Wanted;
+		});
+
+		for (uint64_t id : loads)
+		{
+			if (m_LoadsInFlight >= m_Settings.MaxLoadsInFlight)
+			{
+				break;
+			}
+
+			Entry& entry = m_Entries.at(id);
+			int level = entry.Wanted;
+			while (level < entry.Resident && !MakeRoom(LevelBytes(entry, level, entry.Resident), id))
+			{
+				level++;
+			}
+			if (level < entry.Resident)
+			{
+				StartLoad(id, entry, level);
+			}
+		}
+	}
+
+	//==========================================================================
+	// Budget
+	//==========================================================================
+	bool TextureStreamer::MakeRoom(size_t bytes, uint64_t requester)
+	{
+		auto fits = [&]() { return m_ResidentBytes + m_PendingBytes + bytes <= m_Settings.BudgetBytes; };
+		if (fits())
+		{
+			return true;
+		}
+
+		// Least recently used first
+		std::vector<std::pair<uint64_t, Entry*>> candidates;
+		for (auto& [id, entry] : m_Entries)
+		{
+			if (id != requester && !entry.Loading && entry.Resident < entry.MinLevel)
+			{
+				candidates.emplace_back(entry.LastUsed, &entry);
+			}
+		}
+		std::sort(candidates.begin(), candidates.end(),
+			[](const auto& a, const auto& b) { return a.first < b.first; });
+
+		// Mips finer than anyone asked for go first, then everything above the
+		// resident minimum of textures used less recently than the requester
+		for (auto& [lastUsed, entry] : candidates)
+		{
+			if (entry->Resident < entry->Wanted)
+			{
+				Evict(*entry, entry->Wanted);
+				if (fits())
+				{
+					return true;
+				}
+			}
+		}
+
+		uint64_t requesterUsed = m_Entries.at(requester).LastUsed;
+		for (auto& [lastUsed, entry] : candidates)
+		{
+			if (lastUsed < requesterUsed && entry->Resident < entry->MinLevel)
+			{
+				Evict(*entry, entry->MinLevel);
+				if (fits())
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	void TextureStreamer::Evict(Entry& entry, int level)
+	{
+		int levelCount = static_cast<int>(entry.Layout.Levels.size());
+		if (level <= entry.Resident || level >= levelCount)
+		{
+			return;
+		}
+		entry.Owner->Reallocate(entry.Layout, level, entry.Resident, nullptr);
+		m_ResidentBytes -= LevelBytes(entry, entry.Resident, level);
+		entry.Resident = level;
+		m_Evictions++;
+	}
+
+	//==========================================================================
+	// Loading
+	//==========================================================================
+	void TextureStreamer::StartLoad(uint64_t id, Entry& entry, int level)
+	{
+		entry.Loading = true;
+		entry.PendingBytes = LevelBytes(entry, level, entry.Resident);
+		m_PendingBytes += entry.PendingBytes;
+		m_LoadsInFlight++;
+
+		ThreadPool::Get().Submit([this, id, level, source = entry.Source]()
+		{
+			std::shared_ptr<const TextureData> data;
+			try
+			{
+				data = source();
+			}
+			catch (const std::exception& e)
+			{
+				VP_CORE_ERROR("Texture streaming: source threw: {}", e.what());
+			}
+			UploadQueue::Get().Enqueue([this, id, level, data]() { FinishLoad(id, level, data); });
+		});
+	}
+
+	void TextureStreamer::FinishLoad(uint64_t id, int level, std::shared_ptr<const TextureData> data)
+	{
+		m_LoadsInFlight--;
+		auto it = m_Entries.find(id);
+		if (it == m_Entries.end())
+		{
+			return;  // Texture destroyed while loading
+		}
+
+		Entry& entry = it->second;
+		m_PendingBytes -= entry.PendingBytes;
+		entry.PendingBytes = 0;
+		entry.Loading = false;
+
+		bool matches = data && data->InternalFormat == entry.Layout.InternalFormat &&
+			data->Compressed == entry.Layout.Compressed && data->Levels.size() == entry.Layout.Levels.size() &&
+			data->GetWidth() == entry.Layout.GetWidth() && data->GetHeight() == entry.Layout.GetHeight();
+		if (!matches)
+		{
+			VP_CORE_WARN("Texture streaming: source of '{}' failed or changed, keeping mips from level {}",
+				entry.Owner->m_FilePath, entry.Resident);
+			entry.Source = nullptr;
+			return;
+		}
+
+		// Other textures may have been evicted or loaded meanwhile; the level
+		// only ever gets finer here
+		if (level < entry.Resident)
+		{
+			int previous = entry.Resident;
+			entry.Owner->Reallocate(entry.Layout, level, previous, data.get());
+			m_ResidentBytes += LevelBytes(entry, level, previous);
+			entry.Resident = level;
+			m_Loads++;
+		}
+	}
+
+	TextureStreamingStats TextureStreamer::GetStats() const
+	{
+		TextureStreamingStats stats;
+		stats.Textures = m_Entries.size();
+		stats.ResidentBytes = m_ResidentBytes;
+		stats.PendingBytes = m_PendingBytes;
+		stats.LoadsInFlight = m_LoadsInFlight;
+		stats.Loads = m_Loads;
+		stats.Evictions = m_Evictions;
+		for (const auto& [id, entry] : m_Entries)
+		{
+			stats.FullBytes += LevelBytes(entry, 0, static_cast<int>(entry.Layout.Levels.size()));
+		}
+		return stats;
+	}
+
+	//==========================================================================
+	// Sources
+	//==========================================================================
+	TextureStreamSource TextureStreamer::FromMemory(std::shared_ptr<const TextureData> data)
+	{
+		return [data]() { return data; };
+	}
+
+	TextureStreamSource TextureStreamer::FromKtx2File(const std::string& path)
+	{
+		return [path]() -> std::shared_ptr<const TextureData>
+		{
+			auto data = std::make_shared<TextureData>();
+			return Ktx2::Load(path, *data) ? data : nullptr;
+		};
+	}
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "VizEngine/Core/TextureData.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace VizEngine
+{
+	class Texture;
+
+	/**
+	 * Produces the complete mip chain of a streamed texture. Called on a
+	 * ThreadPool worker whenever finer mips must be loaded, so it may read
+	 * and decode files. Returns nullptr on failure.
+	 */
+	using TextureStreamSource = std::function<std::shared_ptr<const TextureData>()>;
+
+	struct TextureStreamingSettings
+	{
+		bool Enabled = true;
+
+		// GPU memory for all streamed textures together. Top mips of the least
+		// recently used textures are evicted to stay under it.
+		size_t BudgetBytes = size_t(256) << 20;
+
+		// Mips this size (largest side, in texels) and smaller stay resident
+		int MinResidentSize = 64;
+
+		// Added to the requested mip level: positive values stream less detail
+		float MipBias = 0.0f;
+
+		// A texture not requested for this many frames may lose all streamed mips
+		uint32_t KeepFrames = 120;
+
+		// Source loads running at the same time
+		size_t MaxLoadsInFlight = 4;
+	};
+
+	struct TextureStreamingStats
+	{
+		size_t Textures = 0;
+		size_t ResidentBytes = 0;   // Streamed textures as currently resident
+		size_t FullBytes = 0;       // Same textures with every mip resident
+		size_t PendingBytes = 0;    // Loads in flight
+		size_t LoadsInFlight = 0;
+		size_t Loads = 0;           // Completed since startup
+		size_t Evictions = 0;
+	};
+
+	/**
+	 * Mip residency for streamed textures (see Texture(const TextureData&,
+	 * TextureStreamSource)).
+	 *
+	 * A streamed texture starts with only its smallest mips on the GPU.
+	 * Renderers report the finest mip each texture needs this frame with
+	 * Request() (Scene::Render derives it from projected texel density);
+	 * Update() then loads finer mips on the ThreadPool and uploads them
+	 * through the UploadQueue. When a load would exceed the budget, the top
+	 * mips of the least recently used textures are evicted first; a load
+	 * that still doesn't fit settles for a coarser level.
+	 *
+	 * Changing residency recreates the GL texture with the new level range
+	 * and copies the mips it keeps on the GPU (glCopyImageSubData), so only
+	 * the new levels are uploaded.
+	 *
+	 * Main thread only.
+	 */
+	class VizEngine_API TextureStreamer
+	{
+	public:
+		static TextureStreamer& Get();
+
+		// Non-copyable
+		TextureStreamer(const TextureStreamer&) = delete;
+		TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+		void SetSettings(const TextureStreamingSettings& settings) { m_Settings = settings; }
+		const TextureStreamingSettings& GetSettings() const { return m_Settings; }
+
+		/**
+		 * Finest mip level `texture` needs this frame (fractional levels round
+		 * down). No-op for textures that aren't streamed.
+		 */
+		void Request(const Texture& texture, float level);
+
+		/**
+		 * Apply the requests of the last frame: start loads, evict over budget.
+		 * Called once per frame by the Engine.
+		 */
+		void Update();
+
+		TextureStreamingStats GetStats() const;
+
+		// Sources for the common cases
+		static TextureStreamSource FromMemory(std::shared_ptr<const TextureData> data);
+		static TextureStreamSource FromKtx2File(const std::string& path);
+
+	private:
+		friend class Texture;
+
+		struct Entry
+		{
+			Texture* Owner = nullptr;
+			TextureStreamSource Source;   // Empty once a load failed
+			TextureData Layout;           // Levels and format, no bytes
+			int MinLevel = 0;             // Always resident from here down
+			int Resident = 0;             // Finest resident level
+			int Requested = 0;            // Finest level requested this frame
+			int Wanted = 0;               // Finest level the last requests need
+			uint64_t LastUsed = 0;        // Frame of the last request
+			bool Loading = false;
+			size_t PendingBytes = 0;
+		};
+
+		TextureStreamer() = default;
+
+		// Called by Texture: uploads the resident levels of `data`
+		uint64_t Register(Texture& texture, const TextureData& data, TextureStreamSource source);
+		void Unregister(uint64_t id);
+		void Relocate(uint64_t id, Texture& texture);
+
+		bool MakeRoom(size_t bytes, uint64_t requester);
+		void Evict(Entry& entry, int level);
+		void StartLoad(uint64_t id, Entry& entry, int level);
+		void FinishLoad(uint64_t id, int level, std::shared_ptr<const TextureData> data);
+		static size_t LevelBytes(const Entry& entry, int first, int last);
+
+		TextureStreamingSettings m_Settings;
+		std::unordered_map<uint64_t, Entry> m_Entries;
+		uint64_t m_NextId = 1;
+		uint64_t m_Frame = 0;
+		size_t m_ResidentBytes = 0;
+		size_t m_PendingBytes = 0;
+		size_t m_LoadsInFlight = 0;
+		size_t m_Loads = 0;
+		size_t m_Evictions = 0;
+	};
+}
@@ -0,0 +1,121 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace VizEngine
+{
+	ThreadPool& ThreadPool::Get()
+	{
+		// hardware_concurrency() may return 0 when it cannot be determined
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		static ThreadPool instance(hardwareThreads > 1 ? hardwareThreads - 1 : 1);
+		return instance;
+	}
+
+	ThreadPool::ThreadPool(size_t threadCount)
+	{
+		threadCount = std::max<size_t>(threadCount, 1);
+		m_Workers.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; i++)
+		{
+			m_Workers.emplace_back([this]() { WorkerLoop(); });
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_Condition.notify_all();
+
+		for (auto& worker : m_Workers)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+	}
+
+	void ThreadPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body)
+	{
+		grain = std::max<size_t>(grain, 1);
+		size_t chunkCount = (count + grain - 1) / grain;
+		if (chunkCount <= 1)
+		{
+			if (count > 0)
+			{
+				body(0, count);
+			}
+			return;
+		}
+
+		struct State
+		{
+			std::atomic<size_t> Next{ 0 };
+			std::atomic<size_t> Done{ 0 };
+			std::mutex Mutex;
+			std::condition_variable Finished;
+		};
+		auto state = std::make_shared<State>();
+
+		// Helpers that start after every chunk is claimed return without
+		// touching `body`, so it may safely go out of scope when we return
+		auto run = [state, &body, count, grain, chunkCount]()
+		{
+			for (size_t chunk = state->Next++; chunk < chunkCount; chunk = state->Next++)
+			{
+				size_t begin = chunk * grain;
+				body(begin, std::min(begin + grain, count));
+				if (++state->Done == chunkCount)
+				{
+					std::lock_guard<std::mutex> lock(state->Mutex);
+					state->Finished.notify_all();
+				}
+			}
+		};
+
+		size_t helpers = std::min(chunkCount - 1, m_Workers.size());
+		for (size_t i = 0; i < helpers; i++)
+		{
+			Enqueue(run);
+		}
+		run();
+
+		std::unique_lock<std::mutex> lock(state->Mutex);
+		state->Finished.wait(lock, [&state, chunkCount]() { return state->Done == chunkCount; });
+	}
+
+	void ThreadPool::Enqueue(std::function<void()> job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Jobs.push(std::move(job));
+		}
+		m_Condition.notify_one();
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		for (;;)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_Condition.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+
+				// Drain remaining jobs before exiting so no future is left unsatisfied
+				if (m_Jobs.empty())
+				{
+					return;
+				}
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop();
+			}
+			job();
+		}
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace VizEngine
+{
+	/**
+	 * Shared worker pool for CPU-side asset work (image decoding, conversion).
+	 *
+	 * Jobs must not touch OpenGL - the GL context is only current on the main
+	 * thread. Decode on a worker, then upload from the main thread.
+	 *
+	 * Usage:
+	 *   auto future = ThreadPool::Get().Submit([]{ return DecodeSomething(); });
+	 *   auto result = future.get();
+	 */
+	class VizEngine_API ThreadPool
+	{
+	public:
+		/**
+		 * Engine-wide pool. Created on first use with one worker per hardware
+		 * thread, minus one for the main thread.
+		 */
+		static ThreadPool& Get();
+
+		explicit ThreadPool(size_t threadCount);
+		~ThreadPool();
+
+		// Non-copyable, non-movable (workers reference this)
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * Queue a job. The returned future holds the job's result
+		 * (or rethrows its exception).
+		 */
+		template<typename F>
+		auto Submit(F&& job) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+		{
+			using Result = std::invoke_result_t<std::decay_t<F>>;
+			auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+			std::future<Result> future = task->get_future();
+			Enqueue([task]() { (*task)(); });
+			return future;
+		}
+
+		/**
+		 * Run body(begin, end) over [0, count) in chunks of `grain` items and
+		 * wait for all of them. The calling thread works on chunks too, so
+		 * this may be called from inside a pool job without deadlocking.
+		 */
+		void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+		size_t GetThreadCount() const { return m_Workers.size(); }
+
+	private:
+		void Enqueue(std::function<void()> job);
+		void WorkerLoop();
+
+		std::vector<std::thread> m_Workers;
+		std::queue<std::function<void()>> m_Jobs;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_Stopping = false;
+	};
+}
@@ -0,0 +1,80 @@
+#include "UploadQueue.h"
+
+#include <chrono>
+
+namespace VizEngine
+{
+	UploadQueue& UploadQueue::Get()
+	{
+		static UploadQueue instance;
+		return instance;
+	}
+
+	void UploadQueue::Enqueue(std::function<void()> task)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Tasks.push_back(std::move(task));
+	}
+
+	bool UploadQueue::RunNext()
+	{
+		std::function<void()> task;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_Tasks.empty())
+			{
+				return false;
+			}
+			task = std::move(m_Tasks.front());
+			m_Tasks.pop_front();
+		}
+
+		// Run outside the lock: tasks may enqueue follow-up work
+		task();
+		return true;
+	}
+
+	size_t UploadQueue::Process(double budgetMs)
+	{
+		auto start = std::chrono::steady_clock::now();
+		size_t count = 0;
+
+		while (RunNext())
+		{
+			count++;
+			double elapsedMs = std::chrono::duration<double, std::milli>(
+				std::chrono::steady_clock::now() - start).count();
+			if (elapsedMs >= budgetMs)
+			{
+				break;
+			}
+		}
+		return count;
+	}
+
+	size_t UploadQueue::Flush()
+	{
+		size_t count = 0;
+		while (RunNext())
+		{
+			count++;
+		}
+		return count;
+	}
+
+	void UploadQueue::Clear()
+	{
+		std::deque<std::function<void()>> dropped;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			dropped.swap(m_Tasks);
+		}
+		// Destroyed here, outside the lock
+	}
+
+	size_t UploadQueue::GetPendingCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Tasks.size();
+	}
+}
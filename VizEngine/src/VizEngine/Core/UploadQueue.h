@@ -0,0 +1,63 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace VizEngine
+{
+	/**
+	 * Main-thread work queue for finalizing background loads.
+	 *
+	 * Worker threads prepare data (parse, convert, decode) and enqueue the
+	 * small GL part - buffer and texture creation - here. The engine drains
+	 * the queue once per frame within EngineConfig::UploadBudgetMs, so large
+	 * loads are spread over several frames instead of causing a hitch.
+	 */
+	class VizEngine_API UploadQueue
+	{
+	public:
+		static UploadQueue& Get();
+
+		// Non-copyable
+		UploadQueue(const UploadQueue&) = delete;
+		UploadQueue& operator=(const UploadQueue&) = delete;
+
+		/**
+		 * Queue a task to run on the main (GL) thread. Callable from any thread.
+		 */
+		void Enqueue(std::function<void()> task);
+
+		/**
+		 * Run queued tasks until budgetMs has elapsed. At least one task runs
+		 * per call, so progress is made even if a single task exceeds the budget.
+		 * Main thread only.
+		 * @return Number of tasks run
+		 */
+		size_t Process(double budgetMs);
+
+		/**
+		 * Run every queued task, including ones queued while flushing.
+		 * Main thread only.
+		 * @return Number of tasks run
+		 */
+		size_t Flush();
+
+		/**
+		 * Drop all queued tasks without running them (used at shutdown,
+		 * while the GL context is still alive to release their resources).
+		 */
+		void Clear();
+
+		size_t GetPendingCount() const;
+
+	private:
+		UploadQueue() = default;
+
+		bool RunNext();
+
+		mutable std::mutex m_Mutex;
+		std::deque<std::function<void()>> m_Tasks;
+	};
+}
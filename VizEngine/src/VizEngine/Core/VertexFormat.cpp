@@ -0,0 +1,158 @@
+#include "VertexFormat.h"
+#include "VizEngine/Core/Half.h"
+#include "VizEngine/Core/Mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace VizEngine
+{
+	static int16_t ToSnorm16(float value)
+	{
+		return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+	}
+
+	static float FromSnorm16(int16_t value)
+	{
+		return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+	}
+
+	static uint16_t ToUnorm16(float value)
+	{
+		return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+	}
+
+	static uint8_t ToUnorm8(float value)
+	{
+		return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+	}
+
+	// 1 / extent, or 0 for flat axes (every vertex then decodes to the offset)
+	static glm::vec3 SafeReciprocal(const glm::vec3& extent)
+	{
+		return glm::vec3(
+			extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+			extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+			extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+	}
+
+	size_t VertexFormat::GetStride() const
+	{
+		return Packed ? sizeof(PackedVertex) : sizeof(Vertex);
+	}
+
+	uint32_t VertexFormat::EncodeOctahedral(const glm::vec3& normal)
+	{
+		// Project onto the octahedron |x| + |y| + |z| = 1, fold the lower half over
+		float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+		glm::vec2 e = l1 > 0.0f ? glm::vec2(normal.x, normal.y) / l1 : glm::vec2(0.0f);
+		if (l1 > 0.0f && normal.z < 0.0f)
+		{
+			glm::vec2 folded = glm::vec2(1.0f - std::abs(e.y), 1.0f - std::abs(e.x));
+			e.x = e.x >= 0.0f ? folded.x : -folded.x;
+			e.y = e.y >= 0.0f ? folded.y : -folded.y;
+		}
+
+		uint16_t x = static_cast<uint16_t>(ToSnorm16(e.x));
+		uint16_t y = static_cast<uint16_t>(ToSnorm16(e.y));
+		return static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 16);
+	}
+
+	glm::vec3 VertexFormat::DecodeOctahedral(uint32_t encoded)
+	{
+		// Mirrors DecodeOctahedral() in the shaders
+		glm::vec3 n(
+			FromSnorm16(static_cast<int16_t>(encoded & 0xFFFF)),
+			FromSnorm16(static_cast<int16_t>(encoded >> 16)),
+			0.0f);
+		n.z = 1.0f - std::abs(n.x) - std::abs(n.y);
+		float t = std::max(-n.z, 0.0f);
+		n.x += n.x >= 0.0f ? -t : t;
+		n.y += n.y >= 0.0f ? -t : t;
+		return glm::normalize(n);
+	}
+
+	uint32_t VertexFormat::EncodeSnorm10(const glm::vec3& normal)
+	{
+		auto component = [](float value)
+		{
+			int v = static_cast<int>(std::lround(std::clamp(value, -1.0f, 1.0f) * 511.0f));
+			return static_cast<uint32_t>(v) & 0x3FFu;
+		};
+		return component(normal.x) | (component(normal.y) << 10) | (component(normal.z) << 20);
+	}
+
+	VertexFormat VertexFormat::Pack(const Vertex* vertices, size_t count, const VertexPackingOptions& options, PackedVertex* out)
+	{
+		VertexFormat format;
+		format.Packed = true;
+		format.Position = options.Position;
+		format.Normal = options.Normal;
+
+		if (count == 0)
+		{
+			return format;
+		}
+
+		glm::vec3 boundsMin(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+		for (size_t i = 0; i < count; i++)
+		{
+			glm::vec3 p(vertices[i].Position);
+			boundsMin = glm::min(boundsMin, p);
+			boundsMax = glm::max(boundsMax, p);
+		}
+
+		// Unorm16 maps [min, max] to [0, 1]; Half maps [min, max] to [-1, 1]
+		if (options.Position == PositionPrecision::Half)
+		{
+			format.PositionOffset = (boundsMin + boundsMax) * 0.5f;
+			format.PositionScale = (boundsMax - boundsMin) * 0.5f;
+		}
+		else
+		{
+			format.PositionOffset = boundsMin;
+			format.PositionScale = boundsMax - boundsMin;
+		}
+		glm::vec3 invScale = SafeReciprocal(format.PositionScale);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const Vertex& src = vertices[i];
+			PackedVertex& dst = out[i];
+
+			glm::vec3 p = (glm::vec3(src.Position) - format.PositionOffset) * invScale;
+			for (int c = 0; c < 3; c++)
+			{
+				dst.Position[c] = options.Position == PositionPrecision::Half
+					? Half::FromFloat(std::clamp(p[c], -1.0f, 1.0f))
+					: ToUnorm16(p[c]);
+			}
+			dst.Position[3] = 0;
+		}
+
+		PackAttributes(vertices, count, options, out);
+		return format;
+	}
+
+	void VertexFormat::PackAttributes(const Vertex* vertices, size_t count, const VertexPackingOptions& options, PackedVertex* out)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			const Vertex& src = vertices[i];
+			PackedVertex& dst = out[i];
+
+			dst.Normal = options.Normal == NormalEncoding::Octahedral
+				? EncodeOctahedral(src.Normal)
+				: EncodeSnorm10(src.Normal);
+
+			for (int c = 0; c < 4; c++)
+			{
+				dst.Color[c] = ToUnorm8(src.Color[c]);
+			}
+			dst.TexCoords[0] = Half::FromFloat(src.TexCoords.x);
+			dst.TexCoords[1] = Half::FromFloat(src.TexCoords.y);
+		}
+	}
+}
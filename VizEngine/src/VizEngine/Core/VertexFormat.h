@@ -0,0 +1,80 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include "glm.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace VizEngine
+{
+	struct Vertex;
+
+	/**
+	 * Encoding of packed positions. Both are stored relative to the mesh bounds
+	 * and expanded in the vertex shader with u_PositionScale / u_PositionOffset.
+	 */
+	enum class PositionPrecision : uint32_t
+	{
+		Unorm16 = 0,  // Uniform 1/65535 steps across the bounds
+		Half = 1      // Finer near the mesh centre, coarser at the edges
+	};
+
+	enum class NormalEncoding : uint32_t
+	{
+		Octahedral = 0,  // 2 x snorm16, decoded in the vertex shader
+		Snorm10 = 1      // 10:10:10:2 snorm, decoded by the vertex fetch
+	};
+
+	struct VertexPackingOptions
+	{
+		PositionPrecision Position = PositionPrecision::Unorm16;
+		NormalEncoding Normal = NormalEncoding::Octahedral;
+	};
+
+	/**
+	 * Compact vertex: 20 bytes instead of the 52 of Vertex.
+	 * Color is unorm8 and TexCoords are half floats.
+	 */
+	struct PackedVertex
+	{
+		uint16_t Position[4];  // xyz + padding, see PositionPrecision
+		uint32_t Normal;       // See NormalEncoding
+		uint8_t Color[4];
+		uint16_t TexCoords[2];
+	};
+
+	static_assert(sizeof(PackedVertex) == 20, "PackedVertex must stay tightly packed");
+
+	/**
+	 * Describes how a mesh's vertex buffer is encoded.
+	 * Shaders reconstruct positions as u_PositionOffset + u_PositionScale * aPos.xyz,
+	 * which is the identity for float vertices.
+	 */
+	struct VizEngine_API VertexFormat
+	{
+		bool Packed = false;
+		PositionPrecision Position = PositionPrecision::Unorm16;
+		NormalEncoding Normal = NormalEncoding::Octahedral;
+		glm::vec3 PositionScale = glm::vec3(1.0f);
+		glm::vec3 PositionOffset = glm::vec3(0.0f);
+
+		size_t GetStride() const;
+
+		/**
+		 * Pack `count` vertices into `out` (which must hold `count` entries).
+		 * @return The format describing the packed data
+		 */
+		static VertexFormat Pack(const Vertex* vertices, size_t count, const VertexPackingOptions& options, PackedVertex* out);
+
+		/**
+		 * Pack everything but the position (normal, color, texture coordinates),
+		 * for loaders that write PackedVertex::Position themselves.
+		 */
+		static void PackAttributes(const Vertex* vertices, size_t count, const VertexPackingOptions& options, PackedVertex* out);
+
+		// Individual encoders, exposed for loaders that produce packed data directly
+		static uint32_t EncodeOctahedral(const glm::vec3& normal);
+		static glm::vec3 DecodeOctahedral(uint32_t encoded);
+		static uint32_t EncodeSnorm10(const glm::vec3& normal);
+	};
+}
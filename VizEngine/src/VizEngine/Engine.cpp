@@ -6,8 +6,13 @@
 #include "OpenGL/GLFWManager.h"
 #include "OpenGL/Renderer.h"
 #include "OpenGL/ErrorHandling.h"
+#include "OpenGL/CubemapUtils.h"
+#include "OpenGL/Shader.h"
 #include "GUI/UIManager.h"
 #include "Core/Input.h"
+#include "Core/UploadQueue.h"
+#include "Core/AssetManager.h"
+#include "Core/TextureStreamer.h"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -37,6 +42,7 @@ namespace VizEngine
 		}
 
 		m_Running = true;
+		m_UploadBudgetMs = config.UploadBudgetMs;
 
 		bool appCreated = false;
 		try
@@ -62,6 +68,12 @@ namespace VizEngine
 				m_Window->ProcessInput();
 				m_UIManager->BeginFrame();
 
+				// Stream texture mips requested by the last frame, then finish
+				// background loads (GPU uploads) within the frame budget
+				UpdateShaderWarmup();
+				TextureStreamer::Get().Update();
+				UploadQueue::Get().Process(m_UploadBudgetMs);
+
 				// Application hooks (scroll data is now current-frame)
 				app->OnUpdate(m_DeltaTime);
 				app->OnRender();
@@ -175,10 +187,57 @@ namespace VizEngine
 		// Enable OpenGL debug output
 		ErrorHandling::HandleErrors();
 
+		// The driver compiles these while the application loads and the
+		// first frames render
+		BeginShaderWarmup(config.WarmupShaders);
+
 		VP_CORE_INFO("Engine initialized successfully");
 		return true;
 	}
 
+	void Engine::BeginShaderWarmup(const std::vector<std::string>& paths)
+	{
+		m_WarmupStart = glfwGetTime();
+		for (const std::string& path : paths)
+		{
+			if (std::shared_ptr<Shader> shader = AssetManager::Get().LoadShaderAsync(path))
+			{
+				m_WarmupShaders.push_back(std::move(shader));
+			}
+		}
+		m_WarmupPending = m_WarmupShaders.size();
+
+		if (!m_WarmupShaders.empty())
+		{
+			VP_CORE_INFO("Shader warm-up: {} programs issued ({})", m_WarmupShaders.size(),
+				Shader::IsParallelCompileSupported() ? "parallel" : "finished on first use");
+		}
+	}
+
+	void Engine::UpdateShaderWarmup()
+	{
+		if (m_WarmupPending == 0)
+		{
+			return;
+		}
+
+		size_t pending = 0;
+		for (const std::shared_ptr<Shader>& shader : m_WarmupShaders)
+		{
+			if (!shader->IsReady())
+			{
+				pending++;
+			}
+		}
+		m_WarmupPending = pending;
+
+		if (pending == 0)
+		{
+			VP_CORE_INFO("Shader warm-up: {} programs ready after {:.1f} ms", m_WarmupShaders.size(),
+				(glfwGetTime() - m_WarmupStart) * 1000.0);
+		}
+	}
+
 	void Engine::OnEvent(Event& e)
 	{
 		// Give ImGui first chance to handle events
@@ -195,6 +254,13 @@ namespace VizEngine
 	{
 		VP_CORE_INFO("Shutting down Engine...");
 
+		// Unfinished loads hold GL resources; release them while the context exists
+		UploadQueue::Get().Clear();
+		AssetManager::Get().Clear();
+		CubemapUtils::ReleaseResources();
+		m_WarmupShaders.clear();
+		m_WarmupPending = 0;
+
 		// Reset subsystems in reverse order of creation
 		m_Renderer.reset();
 		m_UIManager.reset();
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include <cstdint>
 #include "Core.h"
 
@@ -13,6 +14,7 @@ namespace VizEngine
 	class Renderer;
 	class UIManager;
 	class Event;
+	class Shader;
 
 	/**
 	 * Configuration for the Engine.
@@ -24,6 +26,15 @@ namespace VizEngine
 		uint32_t Width = 800;
 		uint32_t Height = 800;
 		bool VSync = true;
+
+		// Main-thread time per frame for finishing background loads
+		// (GPU uploads queued by Model::LoadAsync / Texture::LoadAsync)
+		float UploadBudgetMs = 2.0f;
+
+		// Shader files compiled in parallel from Init while the first frames
+		// render (see AssetManager::LoadShaderAsync); loading one of them
+		// later returns the warmed-up program
+		std::vector<std::string> WarmupShaders;
 	};
 
 	/**
@@ -86,6 +97,13 @@ namespace VizEngine
 		 */
 		void Shutdown();
 
+		/**
+		 * Issue the compiles of EngineConfig::WarmupShaders, and finish the
+		 * ones the driver is done with (once per frame until all are ready).
+		 */
+		void BeginShaderWarmup(const std::vector<std::string>& paths);
+		void UpdateShaderWarmup();
+
 		// Subsystems
 		std::unique_ptr<GLFWManager> m_Window;
 		std::unique_ptr<Renderer> m_Renderer;
@@ -93,6 +111,12 @@ namespace VizEngine
 
 		Application* m_App = nullptr;  // Stored for event routing
 		float m_DeltaTime = 0.0f;
+		float m_UploadBudgetMs = 2.0f;
 		bool m_Running = false;
+
+		// Kept until shutdown, so warmed-up programs outlive the AssetManager's weak references
+		std::vector<std::shared_ptr<Shader>> m_WarmupShaders;
+		size_t m_WarmupPending = 0;
+		double m_WarmupStart = 0.0;
 	};
 }
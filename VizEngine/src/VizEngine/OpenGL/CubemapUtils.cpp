@@ -6,81 +6,208 @@
 #include "Framebuffer.h"
 #include "VertexArray.h"
 #include "VertexBuffer.h"
+#include "VizEngine/Core/AssetManager.h"
+#include "VizEngine/Core/Half.h"
+#include "VizEngine/Core/Hash.h"
+#include "VizEngine/Core/Ktx2.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "VizEngine/Core/Simd.h"
+#include "VizEngine/Core/ThreadPool.h"
+#include "VizEngine/Core/UploadQueue.h"
 #include "VizEngine/Log.h"
 
 #include <glad/glad.h>
 #include <glm.hpp>
 #include <gtc/matrix_transform.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
 namespace VizEngine
 {
-	std::shared_ptr<Texture> CubemapUtils::EquirectangularToCubemap(
-		std::shared_ptr<Texture> equirectangularMap,
-		int resolution)
+	// Bump when the conversion changes, so stale cache entries are ignored
+	static constexpr uint32_t ConverterVersion = 1;
+
+	//==========================================================================
+	// Conversion resources
+	//==========================================================================
+
+	// Shared by all conversions until ReleaseResources(). The framebuffer and
+	// its depth buffer are recreated when the resolution changes.
+	struct ConversionResources
 	{
-		if (!equirectangularMap)
+		std::shared_ptr<Shader> ConversionShader;
+		std::unique_ptr<VertexBuffer> CubeVBO;
+		std::unique_ptr<VertexArray> CubeVAO;
+		std::unique_ptr<Framebuffer> CaptureFramebuffer;
+		unsigned int DepthBuffer = 0;
+		int Resolution = 0;
+
+		std::shared_ptr<Shader> PrefilterShader;
+		std::shared_ptr<Texture> BrdfLut;
+	};
+
+	static ConversionResources s_Resources;
+
+	static ConversionResources* GetResources(int resolution)
+	{
+		ConversionResources& resources = s_Resources;
+
+		if (!resources.ConversionShader)
 		{
-			VP_CORE_ERROR("Cubemap conversion: Input texture is null!");
-			return nullptr;
+			auto shader = AssetManager::Get().LoadShader("resources/shaders/equirect_to_cube.shader");
+			if (!shader || !shader->IsValid())
+			{
+				VP_CORE_ERROR("Cubemap conversion: Failed to load shader 'resources/shaders/equirect_to_cube.shader'");
+				return nullptr;
+			}
+			resources.ConversionShader = std::move(shader);
+
+			// Cube vertices (positions only, for fullscreen rendering)
+			float cubeVertices[] = {
+				// Positions
+				-1.0f, -1.0f, -1.0f,
+				 1.0f,  1.0f, -1.0f,
+				 1.0f, -1.0f, -1.0f,
+				 1.0f,  1.0f, -1.0f,
+				-1.0f, -1.0f, -1.0f,
+				-1.0f,  1.0f, -1.0f,
+
+				-1.0f, -1.0f,  1.0f,
+				 1.0f, -1.0f,  1.0f,
+				 1.0f,  1.0f,  1.0f,
+				 1.0f,  1.0f,  1.0f,
+				-1.0f,  1.0f,  1.0f,
+				-1.0f, -1.0f,  1.0f,
+
+				-1.0f,  1.0f,  1.0f,
+				-1.0f,  1.0f, -1.0f,
+				-1.0f, -1.0f, -1.0f,
+				-1.0f, -1.0f, -1.0f,
+				-1.0f, -1.0f,  1.0f,
+				-1.0f,  1.0f,  1.0f,
+
+				 1.0f,  1.0f,  1.0f,
+				 1.0f, -1.0f, -1.0f,
+				 1.0f,  1.0f, -1.0f,
+				 1.0f, -1.0f, -1.0f,
+				 1.0f,  1.0f,  1.0f,
+				 1.0f, -1.0f,  1.0f,
+
+				-1.0f, -1.0f, -1.0f,
+				 1.0f, -1.0f, -1.0f,
+				 1.0f, -1.0f,  1.0f,
+				 1.0f, -1.0f,  1.0f,
+				-1.0f, -1.0f,  1.0f,
+				-1.0f, -1.0f, -1.0f,
+
+				-1.0f,  1.0f, -1.0f,
+				 1.0f,  1.0f,  1.0f,
+				 1.0f,  1.0f, -1.0f,
+				 1.0f,  1.0f,  1.0f,
+				-1.0f,  1.0f, -1.0f,
+				-1.0f,  1.0f,  1.0f
+			};
+
+			resources.CubeVBO = std::make_unique<VertexBuffer>(cubeVertices, sizeof(cubeVertices));
+			VertexBufferLayout layout;
+			layout.Push<float>(3);  // Position
+
+			resources.CubeVAO = std::make_unique<VertexArray>();
+			resources.CubeVAO->LinkVertexBuffer(*resources.CubeVBO, layout);
 		}
 
-		// Validate resolution bounds
-		if (resolution <= 0 || resolution > 8192)
+		if (resources.Resolution != resolution)
 		{
-			VP_CORE_ERROR("Cubemap conversion: Invalid resolution {} (must be 1-8192)", resolution);
-			return nullptr;
+			if (resources.DepthBuffer != 0)
+			{
+				glDeleteRenderbuffers(1, &resources.DepthBuffer);
+				resources.DepthBuffer = 0;
+			}
+			resources.Resolution = 0;
+
+			// Create framebuffer for rendering to cubemap faces
+			resources.CaptureFramebuffer = std::make_unique<Framebuffer>(resolution, resolution);
+
+			// Create depth renderbuffer (we don't need to sample it)
+			glGenRenderbuffers(1, &resources.DepthBuffer);
+			if (resources.DepthBuffer == 0)
+			{
+				VP_CORE_ERROR("Cubemap conversion: Failed to generate renderbuffer");
+				return nullptr;
+			}
+
+			glBindRenderbuffer(GL_RENDERBUFFER, resources.DepthBuffer);
+			glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, resolution, resolution);
+			glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+			// Attach depth renderbuffer to framebuffer
+			resources.CaptureFramebuffer->Bind();
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, resources.DepthBuffer);
+
+			// Verify framebuffer usability (at least depth attached)
+			bool complete = resources.CaptureFramebuffer->IsComplete();
+			resources.CaptureFramebuffer->Unbind();
+			if (!complete)
+			{
+				VP_CORE_ERROR("Cubemap conversion: Framebuffer incomplete after depth attachment");
+				return nullptr;
+			}
+			resources.Resolution = resolution;
 		}
 
-		VP_CORE_INFO("Converting equirectangular map to cubemap ({}x{} per face)...", resolution, resolution);
+		return &resources;
+	}
 
-		// Create empty cubemap texture
-		auto cubemap = std::make_shared<Texture>(resolution, equirectangularMap->IsHDR());
-		if (!cubemap)
+	void CubemapUtils::ReleaseResources()
+	{
+		if (s_Resources.DepthBuffer != 0)
 		{
-			VP_CORE_ERROR("Cubemap conversion: Failed to create cubemap texture (resolution: {}x{})", resolution, resolution);
-			return nullptr;
+			glDeleteRenderbuffers(1, &s_Resources.DepthBuffer);
 		}
+		s_Resources = ConversionResources();
+	}
 
-		// Create framebuffer for rendering to cubemap faces
-		auto framebuffer = std::make_shared<Framebuffer>(resolution, resolution);
-
-		if (!framebuffer)
+	//==========================================================================
+	// Conversion
+	//==========================================================================
+	std::shared_ptr<Texture> CubemapUtils::EquirectangularToCubemap(
+		std::shared_ptr<Texture> equirectangularMap,
+		int resolution)
+	{
+		if (!equirectangularMap)
 		{
-			VP_CORE_ERROR("Cubemap conversion: Failed to create framebuffer");
+			VP_CORE_ERROR("Cubemap conversion: Input texture is null!");
 			return nullptr;
 		}
 
-		// Create depth renderbuffer (we don't need to sample it)
-		unsigned int rbo;
-		glGenRenderbuffers(1, &rbo);
-		if (rbo == 0)
+		// Validate resolution bounds
+		if (resolution <= 0 || resolution > 8192)
 		{
-			VP_CORE_ERROR("Cubemap conversion: Failed to generate renderbuffer");
+			VP_CORE_ERROR("Cubemap conversion: Invalid resolution {} (must be 1-8192)", resolution);
 			return nullptr;
 		}
 
-		glBindRenderbuffer(GL_RENDERBUFFER, rbo);
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, resolution, resolution);
-		glBindRenderbuffer(GL_RENDERBUFFER, 0);
-
-		// Attach depth renderbuffer to framebuffer
-		framebuffer->Bind();
-		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rbo);
+		VP_CORE_INFO("Converting equirectangular map to cubemap ({}x{} per face)...", resolution, resolution);
 
-		// Verify framebuffer usability (at least depth attached)
-		if (!framebuffer->IsComplete())
+		ConversionResources* resources = GetResources(resolution);
+		if (!resources)
 		{
-			VP_CORE_ERROR("Cubemap conversion: Framebuffer incomplete after depth attachment");
-			glDeleteRenderbuffers(1, &rbo);
 			return nullptr;
 		}
+		Shader& shader = *resources->ConversionShader;
+		Framebuffer& framebuffer = *resources->CaptureFramebuffer;
 
-		// Load conversion shader
-		auto shader = std::make_shared<Shader>("resources/shaders/equirect_to_cube.shader");
-		if (!shader->IsValid())
+		// Create empty cubemap texture
+		auto cubemap = std::make_shared<Texture>(resolution, equirectangularMap->IsHDR());
+		if (!cubemap)
 		{
-			VP_CORE_ERROR("Cubemap conversion: Failed to load shader 'resources/shaders/equirect_to_cube.shader'");
-			glDeleteRenderbuffers(1, &rbo);
+			VP_CORE_ERROR("Cubemap conversion: Failed to create cubemap texture (resolution: {}x{})", resolution, resolution);
 			return nullptr;
 		}
 
@@ -97,77 +224,23 @@ namespace VizEngine
 			glm::lookAt(glm::vec3(0.0f), glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f))   // -Z
 		};
 
-		// Cube vertices (positions only, for fullscreen rendering)
-		float cubeVertices[] = {
-			// Positions
-			-1.0f, -1.0f, -1.0f,
-			 1.0f,  1.0f, -1.0f,
-			 1.0f, -1.0f, -1.0f,
-			 1.0f,  1.0f, -1.0f,
-			-1.0f, -1.0f, -1.0f,
-			-1.0f,  1.0f, -1.0f,
-
-			-1.0f, -1.0f,  1.0f,
-			 1.0f, -1.0f,  1.0f,
-			 1.0f,  1.0f,  1.0f,
-			 1.0f,  1.0f,  1.0f,
-			-1.0f,  1.0f,  1.0f,
-			-1.0f, -1.0f,  1.0f,
-
-			-1.0f,  1.0f,  1.0f,
-			-1.0f,  1.0f, -1.0f,
-			-1.0f, -1.0f, -1.0f,
-			-1.0f, -1.0f, -1.0f,
-			-1.0f, -1.0f,  1.0f,
-			-1.0f,  1.0f,  1.0f,
-
-			 1.0f,  1.0f,  1.0f,
-			 1.0f, -1.0f, -1.0f,
-			 1.0f,  1.0f, -1.0f,
-			 1.0f, -1.0f, -1.0f,
-			 1.0f,  1.0f,  1.0f,
-			 1.0f, -1.0f,  1.0f,
-
-			-1.0f, -1.0f, -1.0f,
-			 1.0f, -1.0f, -1.0f,
-			 1.0f, -1.0f,  1.0f,
-			 1.0f, -1.0f,  1.0f,
-			-1.0f, -1.0f,  1.0f,
-			-1.0f, -1.0f, -1.0f,
-
-			-1.0f,  1.0f, -1.0f,
-			 1.0f,  1.0f,  1.0f,
-			 1.0f,  1.0f, -1.0f,
-			 1.0f,  1.0f,  1.0f,
-			-1.0f,  1.0f, -1.0f,
-			-1.0f,  1.0f,  1.0f
-		};
-
-		// Setup cube VAO/VBO
-		auto cubeVBO = std::make_shared<VertexBuffer>(cubeVertices, sizeof(cubeVertices));
-		VertexBufferLayout layout;
-		layout.Push<float>(3);  // Position
-
-		auto cubeVAO = std::make_shared<VertexArray>();
-		cubeVAO->LinkVertexBuffer(*cubeVBO, layout);
-
 		// Bind shader and equirectangular map
-		shader->Bind();
-		shader->SetMatrix4fv("u_Projection", captureProjection);
+		shader.Bind();
+		shader.SetMatrix4fv("u_Projection", captureProjection);
 		equirectangularMap->Bind(0);
-		shader->SetInt("u_EquirectangularMap", 0);
+		shader.SetInt("u_EquirectangularMap", 0);
 
 		// Save current viewport
 		GLint prevViewport[4];
 		glGetIntegerv(GL_VIEWPORT, prevViewport);
 
 		glViewport(0, 0, resolution, resolution);
-		framebuffer->Bind();
+		framebuffer.Bind();
 
 		// Render to each cubemap face
 		for (unsigned int i = 0; i < 6; ++i)
 		{
-			shader->SetMatrix4fv("u_View", captureViews[i]);
+			shader.SetMatrix4fv("u_View", captureViews[i]);
 
 			// Attach current cubemap face to framebuffer
 			glFramebufferTexture2D(
@@ -182,7 +255,7 @@ namespace VizEngine
 			if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 			{
 				VP_CORE_ERROR("Cubemap conversion: FBO incomplete for face {}", i);
-				glDeleteRenderbuffers(1, &rbo);
+				framebuffer.Unbind();
 				glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
 				return nullptr;
 			}
@@ -190,11 +263,11 @@ namespace VizEngine
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 			// Render cube
-			cubeVAO->Bind();
+			resources->CubeVAO->Bind();
 			glDrawArrays(GL_TRIANGLES, 0, 36);
 		}
 
-		framebuffer->Unbind();
+		framebuffer.Unbind();
 
 		// Restore previous viewport
 		glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
@@ -205,11 +278,648 @@ namespace VizEngine
 		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
-		// Cleanup
-		glDeleteRenderbuffers(1, &rbo);
-
 		VP_CORE_INFO("Cubemap conversion complete (with mipmaps)!");
 
 		return cubemap;
 	}
+
+	//==========================================================================
+	// Specular prefiltering
+	//==========================================================================
+	static constexpr int MaxPrefilterMips = 8;   // Output images of prefilter_specular.shader
+	static constexpr int MaxPrefilterResolution = 1024;
+	static constexpr int BrdfLutSize = 256;
+	static constexpr int BrdfLutSamples = 1024;
+
+	static std::shared_ptr<Shader> LoadComputeShader(const std::string& path)
+	{
+		try
+		{
+			std::shared_ptr<Shader> shader = AssetManager::Get().LoadShader(path);
+			if (shader && shader->IsValid() && shader->IsCompute())
+			{
+				return shader;
+			}
+		}
+		catch (const std::exception&)
+		{
+			// Logged by the Shader
+		}
+		VP_CORE_ERROR("Cubemap conversion: Failed to load compute shader '{}'", path);
+		return nullptr;
+	}
+
+	int CubemapUtils::GetPrefilterMipCount(const SpecularPrefilterOptions& options)
+	{
+		int fullChain = 1;
+		while ((options.Resolution >> fullChain) > 0)
+		{
+			++fullChain;
+		}
+		return std::clamp(options.MipLevels, 1, std::min(fullChain, MaxPrefilterMips));
+	}
+
+	std::shared_ptr<Texture> CubemapUtils::PrefilterSpecular(const Texture& environment,
+		const SpecularPrefilterOptions& options)
+	{
+		if (!environment.IsCubemap() || environment.GetID() == 0)
+		{
+			VP_CORE_ERROR("Specular prefilter: Input is not a cubemap!");
+			return nullptr;
+		}
+
+		// Workgroups of all mips share the dispatch's x dimension
+		if (options.Resolution <= 0 || options.Resolution > MaxPrefilterResolution)
+		{
+			VP_CORE_ERROR("Specular prefilter: Invalid resolution {} (must be 1-{})",
+				options.Resolution, MaxPrefilterResolution);
+			return nullptr;
+		}
+
+		if (!s_Resources.PrefilterShader)
+		{
+			s_Resources.PrefilterShader = LoadComputeShader("resources/shaders/prefilter_specular.shader");
+			if (!s_Resources.PrefilterShader)
+			{
+				return nullptr;
+			}
+		}
+		Shader& shader = *s_Resources.PrefilterShader;
+
+		int mipCount = GetPrefilterMipCount(options);
+
+		// Number the 8x8 tiles of all mips, and split the sample budget evenly
+		// between the rough mips (mip 0 is a mirror, one sample per texel)
+		uint64_t minSamples = static_cast<uint64_t>(std::max(options.MinSamples, 1));
+		uint64_t maxSamples = std::max(static_cast<uint64_t>(std::max(options.MaxSamples, 1)), minSamples);
+		int tileStart[MaxPrefilterMips] = {};
+		int sampleCount[MaxPrefilterMips] = {};
+		int tiles = 0;
+		uint64_t totalSamples = 0;
+		uint64_t share = mipCount > 1 ? options.SampleBudget / static_cast<uint64_t>(mipCount - 1) : 0;
+		for (int mip = 0; mip < mipCount; ++mip)
+		{
+			int size = std::max(options.Resolution >> mip, 1);
+			int tilesPerRow = (size + 7) / 8;
+			tileStart[mip] = tiles;
+			tiles += tilesPerRow * tilesPerRow;
+
+			uint64_t texels = 6ull * size * size;
+			if (mip == 0)
+			{
+				sampleCount[mip] = 1;
+			}
+			else
+			{
+				sampleCount[mip] = static_cast<int>(std::clamp(share / texels, minSamples, maxSamples));
+			}
+			totalSamples += texels * static_cast<uint64_t>(sampleCount[mip]);
+		}
+
+		auto prefiltered = std::make_shared<Texture>(options.Resolution, GL_RGBA16F, mipCount);
+		if (prefiltered->GetID() == 0)
+		{
+			VP_CORE_ERROR("Specular prefilter: Failed to create cubemap ({}x{}, {} mips)",
+				options.Resolution, options.Resolution, mipCount);
+			return nullptr;
+		}
+
+		shader.Bind();
+		environment.Bind(0);
+		shader.SetInt("u_Environment", 0);
+		shader.SetFloat("u_EnvironmentSize", static_cast<float>(environment.GetWidth()));
+		shader.SetInt("u_Resolution", options.Resolution);
+		shader.SetInt("u_MipCount", mipCount);
+		shader.SetIntArray("u_TileStart", tileStart, mipCount);
+		shader.SetIntArray("u_SampleCount", sampleCount, mipCount);
+
+		// Every mip as a layered image, so the workgroup's z picks the face
+		for (int mip = 0; mip < mipCount; ++mip)
+		{
+			glBindImageTexture(mip, prefiltered->GetID(), mip, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+		}
+
+		glDispatchCompute(static_cast<GLuint>(tiles), 1, 6);
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+		for (int mip = 0; mip < mipCount; ++mip)
+		{
+			glBindImageTexture(mip, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+		}
+		environment.Unbind();
+		shader.Unbind();
+
+		VP_CORE_INFO("Specular prefilter: {}x{}, {} mips, {:.1f}M GGX samples",
+			options.Resolution, options.Resolution, mipCount, static_cast<double>(totalSamples) / 1.0e6);
+
+		return prefiltered;
+	}
+
+	std::shared_ptr<Texture> CubemapUtils::GetBrdfLut()
+	{
+		if (s_Resources.BrdfLut)
+		{
+			return s_Resources.BrdfLut;
+		}
+
+		// Used once, so not kept with the other resources
+		std::shared_ptr<Shader> shader = LoadComputeShader("resources/shaders/brdf_lut.shader");
+		if (!shader)
+		{
+			return nullptr;
+		}
+
+		auto lut = std::make_shared<Texture>(BrdfLutSize, BrdfLutSize, GL_RG16F, GL_RG, GL_FLOAT);
+		if (lut->GetID() == 0)
+		{
+			VP_CORE_ERROR("BRDF LUT: Failed to create texture");
+			return nullptr;
+		}
+
+		shader->Bind();
+		shader->SetInt("u_Size", BrdfLutSize);
+		shader->SetInt("u_SampleCount", BrdfLutSamples);
+		glBindImageTexture(0, lut->GetID(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG16F);
+
+		glDispatchCompute((BrdfLutSize + 7) / 8, (BrdfLutSize + 7) / 8, 1);
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+		glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG16F);
+		shader->Unbind();
+
+		VP_CORE_INFO("BRDF LUT generated ({}x{}, {} samples per texel)", BrdfLutSize, BrdfLutSize, BrdfLutSamples);
+
+		s_Resources.BrdfLut = lut;
+		return lut;
+	}
+
+	//==========================================================================
+	// Cache
+	//==========================================================================
+	std::string CubemapUtils::GetCachePath(const std::string& equirectangularPath, uint64_t sourceKey,
+		int resolution, HdrFormat format)
+	{
+		uint64_t options = Hash::Combine(Hash::Combine(ConverterVersion, static_cast<uint64_t>(resolution)),
+			static_cast<uint64_t>(format));
+		uint64_t key = Hash::Combine(Hash::Combine(sourceKey, Hash::FNV1a("Cubemap")), options);
+
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.ktx2", static_cast<unsigned long long>(key));
+		std::filesystem::path directory = std::filesystem::path(equirectangularPath).parent_path() / ".vpcache";
+		return (directory / name).string();
+	}
+
+	bool CubemapUtils::ReadFaces(const Texture& cubemap, TextureData& out, int firstLevel)
+	{
+		out = TextureData();
+		int resolution = cubemap.GetWidth();
+		if (!cubemap.IsCubemap() || cubemap.GetID() == 0 || firstLevel < 0 || (resolution >> firstLevel) == 0)
+		{
+			return false;
+		}
+
+		// Same formats as Texture(resolution, isHDR); half floats for HDR
+		// keep the file at the size of the GPU copy
+		size_t texelBytes = cubemap.IsHDR() ? 6 : 3;
+		out.InternalFormat = cubemap.IsHDR() ? GL_RGB16F : GL_RGB8;
+		out.Format = GL_RGB;
+		out.Type = cubemap.IsHDR() ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+		out.Faces = 6;
+
+		for (int size = resolution >> firstLevel; ; size = std::max(size / 2, 1))
+		{
+			TextureData::Level level;
+			level.Offset = out.Bytes.size();
+			level.Width = size;
+			level.Height = size;
+			level.Size = static_cast<size_t>(size) * size * texelBytes * 6;
+			out.Levels.push_back(level);
+			out.Bytes.resize(level.Offset + level.Size);
+			if (size == 1)
+			{
+				break;
+			}
+		}
+
+		GLint alignment = 4;
+		glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.GetID());
+		for (size_t level = 0; level < out.Levels.size(); level++)
+		{
+			for (unsigned int face = 0; face < 6; face++)
+			{
+				glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, static_cast<GLint>(level) + firstLevel, out.Format, out.Type,
+					out.Bytes.data() + out.Levels[level].Offset + out.Levels[level].Size / 6 * face);
+			}
+		}
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		glPixelStorei(GL_PACK_ALIGNMENT, alignment);
+		return true;
+	}
+
+	bool CubemapUtils::ProjectIrradiance(const Texture& cubemap, SH9& irradiance)
+	{
+		// SH9 keeps only low frequencies, so a small mip gives the same result
+		static constexpr int ProjectionSize = 32;
+		int firstLevel = 0;
+		while ((cubemap.GetWidth() >> (firstLevel + 1)) >= ProjectionSize)
+		{
+			firstLevel++;
+		}
+
+		TextureData faces;
+		SH9 radiance;
+		if (!ReadFaces(cubemap, faces, firstLevel) || !SphericalHarmonics::ProjectCubemap(faces, radiance))
+		{
+			VP_CORE_ERROR("Cubemap irradiance: cannot read cubemap {}", cubemap.GetID());
+			return false;
+		}
+		irradiance = SphericalHarmonics::ToIrradiance(radiance);
+		return true;
+	}
+
+	AsyncHandle<Texture> CubemapUtils::LoadEquirectangularAsync(const std::string& path, int resolution)
+	{
+		auto promise = std::make_shared<std::promise<std::shared_ptr<Texture>>>();
+		AsyncHandle<Texture> handle(promise->get_future().share());
+		HdrFormat format = Texture::GetHdrFormat();
+
+		ThreadPool::Get().Submit([path, resolution, format, promise]()
+		{
+			MappedFile file;
+			if (!file.Open(path))
+			{
+				VP_CORE_ERROR("Failed to load environment: {}", path);
+				promise->set_value(nullptr);
+				return;
+			}
+			std::string cachePath = GetCachePath(path, Hash::Bytes(file.GetData(), file.GetSize()), resolution, format);
+			file.Close();
+
+			// Hit: the faces and mips are uploaded as stored
+			auto faces = std::make_shared<TextureData>();
+			std::error_code ec;
+			if (std::filesystem::exists(cachePath, ec) && Ktx2::Load(cachePath, *faces) &&
+				faces->Faces == 6 && faces->GetWidth() == resolution)
+			{
+				UploadQueue::Get().Enqueue([path, promise, faces]()
+				{
+					auto cubemap = std::make_shared<Texture>(*faces);
+					VP_CORE_INFO("Cubemap loaded from cache: {} ({}x{} per face, {} levels)", path,
+						faces->GetWidth(), faces->GetHeight(), faces->Levels.size());
+					promise->set_value(std::move(cubemap));
+				});
+				return;
+			}
+
+			// Miss: decode here, convert on the GPU, then write the cache from a worker
+			auto equirectangular = std::make_shared<TextureData>();
+			if (!HdrImage::Load(path, format, *equirectangular))
+			{
+				VP_CORE_ERROR("Failed to load environment: {}", path);
+				promise->set_value(nullptr);
+				return;
+			}
+
+			UploadQueue::Get().Enqueue([path, resolution, promise, equirectangular, cachePath]()
+			{
+				auto source = std::make_shared<Texture>(*equirectangular, true);
+				auto cubemap = EquirectangularToCubemap(source, resolution);
+
+				auto readback = std::make_shared<TextureData>();
+				if (cubemap && ReadFaces(*cubemap, *readback))
+				{
+					ThreadPool::Get().Submit([cachePath, readback]()
+					{
+						if (Ktx2::Write(cachePath, *readback))
+						{
+							VP_CORE_TRACE("Cubemap cache written: {}", cachePath);
+						}
+					});
+				}
+				promise->set_value(std::move(cubemap));
+			});
+		});
+
+		return handle;
+	}
+
+	//==========================================================================
+	// CPU conversion
+	//==========================================================================
+	static constexpr int TileSize = 32;
+	static constexpr float Pi = 3.14159265358979f;
+
+	// atan(a) for a in [0, 1], max error ~2e-7 rad
+	static constexpr float AtanCoefficients[] = {
+		0.99997726f, -0.33262347f, 0.19354346f, -0.11643287f, 0.05265332f, -0.01172120f
+	};
+
+	static float FastAtan2(float y, float x)
+	{
+		float ax = std::fabs(x), ay = std::fabs(y);
+		float largest = std::max(ax, ay);
+		float a = largest > 0.0f ? std::min(ax, ay) / largest : 0.0f;
+		float s = a * a;
+		float r = AtanCoefficients[5];
+		for (int i = 4; i >= 0; i--)
+		{
+			r = r * s + AtanCoefficients[i];
+		}
+		r *= a;
+		r = ay > ax ? Pi * 0.5f - r : r;
+		r = x < 0.0f ? Pi - r : r;
+		return y < 0.0f ? -r : r;
+	}
+
+	// Direction through texel (sc, tc) of `face`, in [-1, 1]; GL cubemap
+	// conventions (major axis table of the GL specification)
+	static void FaceDirection(int face, float sc, float tc, float& x, float& y, float& z)
+	{
+		switch (face)
+		{
+		case 0: x = 1.0f;  y = -tc;   z = -sc;   break;  // +X
+		case 1: x = -1.0f; y = -tc;   z = sc;    break;  // -X
+		case 2: x = sc;    y = 1.0f;  z = tc;    break;  // +Y
+		case 3: x = sc;    y = -1.0f; z = -tc;   break;  // -Y
+		case 4: x = sc;    y = -tc;   z = 1.0f;  break;  // +Z
+		default: x = -sc;  y = -tc;   z = -1.0f; break;  // -Z
+		}
+	}
+
+	// Bilinear sample of RGBA float rows at texel coordinates (u, v) - 0.5.
+	// Wraps horizontally, clamps vertically.
+	struct EquirectSampler
+	{
+		const float* Pixels;
+		int Width;
+		int Height;
+
+		void Sample(float u, float v, float* out) const
+		{
+			float px = u * Width - 0.5f;
+			float py = std::clamp(v * Height - 0.5f, 0.0f, static_cast<float>(Height - 1));
+			float fx = std::floor(px);
+			float fy = std::floor(py);
+			float tx = px - fx, ty = py - fy;
+
+			int x0 = static_cast<int>(fx) % Width;
+			x0 = x0 < 0 ? x0 + Width : x0;
+			int x1 = x0 + 1 == Width ? 0 : x0 + 1;
+			int y0 = static_cast<int>(fy);
+			int y1 = std::min(y0 + 1, Height - 1);
+
+			const float* p00 = Pixels + (static_cast<size_t>(y0) * Width + x0) * 4;
+			const float* p10 = Pixels + (static_cast<size_t>(y0) * Width + x1) * 4;
+			const float* p01 = Pixels + (static_cast<size_t>(y1) * Width + x0) * 4;
+			const float* p11 = Pixels + (static_cast<size_t>(y1) * Width + x1) * 4;
+			float w00 = (1.0f - tx) * (1.0f - ty), w10 = tx * (1.0f - ty);
+			float w01 = (1.0f - tx) * ty, w11 = tx * ty;
+#if VP_SIMD_SSE2
+			__m128 result = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p00), _mm_set1_ps(w00)), _mm_mul_ps(_mm_loadu_ps(p10), _mm_set1_ps(w10))),
+				_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p01), _mm_set1_ps(w01)), _mm_mul_ps(_mm_loadu_ps(p11), _mm_set1_ps(w11))));
+			_mm_storeu_ps(out, result);
+#else
+			for (int c = 0; c < 4; c++)
+			{
+				out[c] = p00[c] * w00 + p10[c] * w10 + p01[c] * w01 + p11[c] * w11;
+			}
+#endif
+		}
+	};
+
+#if VP_SIMD_SSE2
+	static __m128 FastAtan2(__m128 y, __m128 x)
+	{
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+		__m128 ax = _mm_and_ps(x, absMask);
+		__m128 ay = _mm_and_ps(y, absMask);
+		__m128 largest = _mm_max_ps(ax, ay);
+		__m128 a = _mm_div_ps(_mm_min_ps(ax, ay), _mm_max_ps(largest, _mm_set1_ps(1e-30f)));
+		__m128 s = _mm_mul_ps(a, a);
+		__m128 r = _mm_set1_ps(AtanCoefficients[5]);
+		for (int i = 4; i >= 0; i--)
+		{
+			r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(AtanCoefficients[i]));
+		}
+		r = _mm_mul_ps(r, a);
+
+		__m128 swapped = _mm_cmpgt_ps(ay, ax);
+		r = _mm_or_ps(_mm_and_ps(swapped, _mm_sub_ps(_mm_set1_ps(Pi * 0.5f), r)), _mm_andnot_ps(swapped, r));
+		__m128 negativeX = _mm_cmplt_ps(x, _mm_setzero_ps());
+		r = _mm_or_ps(_mm_and_ps(negativeX, _mm_sub_ps(_mm_set1_ps(Pi), r)), _mm_andnot_ps(negativeX, r));
+		__m128 negativeY = _mm_cmplt_ps(y, _mm_setzero_ps());
+		return _mm_or_ps(_mm_and_ps(negativeY, _mm_sub_ps(_mm_setzero_ps(), r)), _mm_andnot_ps(negativeY, r));
+	}
+#endif
+
+	// One row of a tile: `count` texels starting at column `x`, RGBA out
+	static void ProjectRow(const EquirectSampler& sampler, int face, int resolution, int x, int y, int count, float* out)
+	{
+		float invResolution = 2.0f / resolution;
+		float tc = (y + 0.5f) * invResolution - 1.0f;
+		int i = 0;
+#if VP_SIMD_SSE2
+		// Longitude / latitude for 4 texels at once, then one bilinear fetch each
+		for (; i + 4 <= count; i += 4)
+		{
+			float dx[4], dy[4], dz[4];
+			for (int lane = 0; lane < 4; lane++)
+			{
+				float sc = (x + i + lane + 0.5f) * invResolution - 1.0f;
+				FaceDirection(face, sc, tc, dx[lane], dy[lane], dz[lane]);
+			}
+			__m128 vx = _mm_loadu_ps(dx), vy = _mm_loadu_ps(dy), vz = _mm_loadu_ps(dz);
+			__m128 horizontal = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vz, vz)));
+			__m128 u = _mm_add_ps(_mm_mul_ps(FastAtan2(vz, vx), _mm_set1_ps(0.5f / Pi)), _mm_set1_ps(0.5f));
+			__m128 v = _mm_add_ps(_mm_mul_ps(FastAtan2(vy, horizontal), _mm_set1_ps(1.0f / Pi)), _mm_set1_ps(0.5f));
+
+			float us[4], vs[4];
+			_mm_storeu_ps(us, u);
+			_mm_storeu_ps(vs, v);
+			for (int lane = 0; lane < 4; lane++)
+			{
+				sampler.Sample(us[lane], vs[lane], out + (i + lane) * 4);
+			}
+		}
+#endif
+		for (; i < count; i++)
+		{
+			float dx, dy, dz;
+			float sc = (x + i + 0.5f) * invResolution - 1.0f;
+			FaceDirection(face, sc, tc, dx, dy, dz);
+			float u = FastAtan2(dz, dx) * (0.5f / Pi) + 0.5f;
+			float v = FastAtan2(dy, std::sqrt(dx * dx + dz * dz)) * (1.0f / Pi) + 0.5f;
+			sampler.Sample(u, v, out + i * 4);
+		}
+	}
+
+	// Level 0 of an HdrImage-style image as RGBA floats
+	static bool ExpandToRgba(const TextureData& image, std::vector<float>& out)
+	{
+		if (!image.IsValid() || image.Compressed || image.Faces != 1)
+		{
+			return false;
+		}
+		int channels = image.Format == GL_RGBA ? 4 : (image.Format == GL_RGB ? 3 : 0);
+		bool rgb9e5 = image.Type == GL_UNSIGNED_INT_5_9_9_9_REV;
+		if (channels == 0 || (!rgb9e5 && image.Type != GL_HALF_FLOAT && image.Type != GL_FLOAT))
+		{
+			return false;
+		}
+
+		size_t texels = static_cast<size_t>(image.GetWidth()) * image.GetHeight();
+		size_t texelBytes = rgb9e5 ? 4 : channels * (image.Type == GL_FLOAT ? 4 : 2);
+		if (image.Levels[0].Size < texels * texelBytes)
+		{
+			return false;
+		}
+
+		out.resize(texels * 4);
+		const uint8_t* data = image.GetLevelData(0);
+		size_t grain = std::max<size_t>(1, texels / (ThreadPool::Get().GetThreadCount() * 16 + 1));
+		ThreadPool::Get().ParallelFor(texels, grain, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				float* texel = &out[i * 4];
+				texel[3] = 1.0f;
+				if (rgb9e5)
+				{
+					uint32_t packed;
+					std::memcpy(&packed, data + i * 4, 4);
+					float scale = std::ldexp(1.0f, static_cast<int>(packed >> 27) - 24);
+					texel[0] = (packed & 511) * scale;
+					texel[1] = ((packed >> 9) & 511) * scale;
+					texel[2] = ((packed >> 18) & 511) * scale;
+				}
+				else if (image.Type == GL_HALF_FLOAT)
+				{
+					for (int c = 0; c < channels; c++)
+					{
+						uint16_t half;
+						std::memcpy(&half, data + (i * channels + c) * 2, 2);
+						texel[c] = Half::ToFloat(half);
+					}
+				}
+				else
+				{
+					std::memcpy(texel, data + i * channels * 4, channels * 4);
+				}
+			}
+		});
+		return true;
+	}
+
+	static bool ProjectToFaces(const std::vector<float>& rgba, int width, int height, int resolution,
+		HdrFormat format, TextureData& out)
+	{
+		auto start = std::chrono::steady_clock::now();
+		out = TextureData();
+		bool rgb9e5 = format == HdrFormat::RGB9E5;
+		size_t texelBytes = rgb9e5 ? 4 : 6;
+		out.InternalFormat = rgb9e5 ? GL_RGB9_E5 : GL_RGB16F;
+		out.Format = GL_RGB;
+		out.Type = rgb9e5 ? GL_UNSIGNED_INT_5_9_9_9_REV : GL_HALF_FLOAT;
+		out.Faces = 6;
+
+		TextureData::Level level;
+		level.Width = resolution;
+		level.Height = resolution;
+		level.Size = static_cast<size_t>(resolution) * resolution * texelBytes * 6;
+		out.Levels.push_back(level);
+		out.Bytes.resize(level.Size);
+
+		EquirectSampler sampler{ rgba.data(), width, height };
+		int tilesPerSide = (resolution + TileSize - 1) / TileSize;
+		size_t tileCount = static_cast<size_t>(6) * tilesPerSide * tilesPerSide;
+		size_t faceBytes = level.Size / 6;
+
+		// One job per tile of every face; tiles write disjoint texels
+		ThreadPool::Get().ParallelFor(tileCount, 1, [&](size_t begin, size_t end)
+		{
+			std::vector<float> rowRgba(TileSize * 4);
+			std::vector<float> rowRgb(TileSize * 3);
+			for (size_t tile = begin; tile < end; tile++)
+			{
+				int face = static_cast<int>(tile / (tilesPerSide * tilesPerSide));
+				int tileIndex = static_cast<int>(tile % (tilesPerSide * tilesPerSide));
+				int x0 = (tileIndex % tilesPerSide) * TileSize;
+				int y0 = (tileIndex / tilesPerSide) * TileSize;
+				int count = std::min(TileSize, resolution - x0);
+				uint8_t* faceData = out.Bytes.data() + faceBytes * face;
+
+				for (int y = y0; y < std::min(y0 + TileSize, resolution); y++)
+				{
+					ProjectRow(sampler, face, resolution, x0, y, count, rowRgba.data());
+					size_t texel = static_cast<size_t>(y) * resolution + x0;
+					if (rgb9e5)
+					{
+						uint32_t* target = reinterpret_cast<uint32_t*>(faceData) + texel;
+						for (int i = 0; i < count; i++)
+						{
+							target[i] = HdrImage::ToRgb9e5(rowRgba[i * 4], rowRgba[i * 4 + 1], rowRgba[i * 4 + 2]);
+						}
+					}
+					else
+					{
+						for (int i = 0; i < count; i++)
+						{
+							rowRgb[i * 3] = rowRgba[i * 4];
+							rowRgb[i * 3 + 1] = rowRgba[i * 4 + 1];
+							rowRgb[i * 3 + 2] = rowRgba[i * 4 + 2];
+						}
+						HdrImage::FloatToHalf(rowRgb.data(), reinterpret_cast<uint16_t*>(faceData) + texel * 3, count * 3);
+					}
+				}
+			}
+		});
+
+		VP_CORE_TRACE("Projected {}x{} equirectangular map to {}x{} cube faces on the CPU in {:.1f} ms",
+			width, height, resolution, resolution,
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		return true;
+	}
+
+	bool CubemapUtils::EquirectangularToCubemapCPU(const TextureData& equirectangular, int resolution,
+		TextureData& out, HdrFormat format)
+	{
+		if (resolution <= 0 || resolution > 8192)
+		{
+			VP_CORE_ERROR("Cubemap conversion: Invalid resolution {} (must be 1-8192)", resolution);
+			return false;
+		}
+		std::vector<float> rgba;
+		if (!ExpandToRgba(equirectangular, rgba))
+		{
+			VP_CORE_ERROR("Cubemap conversion: unsupported equirectangular image (GL format 0x{:X})",
+				equirectangular.InternalFormat);
+			return false;
+		}
+		return ProjectToFaces(rgba, equirectangular.GetWidth(), equirectangular.GetHeight(), resolution, format, out);
+	}
+
+	bool CubemapUtils::EquirectangularToCubemapCPU(const float* pixels, int width, int height, int channels,
+		int resolution, TextureData& out, HdrFormat format)
+	{
+		if (!pixels || width <= 0 || height <= 0 || (channels != 3 && channels != 4))
+		{
+			VP_CORE_ERROR("Cubemap conversion: invalid image ({}x{}, {} channels)", width, height, channels);
+			return false;
+		}
+		if (resolution <= 0 || resolution > 8192)
+		{
+			VP_CORE_ERROR("Cubemap conversion: Invalid resolution {} (must be 1-8192)", resolution);
+			return false;
+		}
+
+		std::vector<float> rgba(static_cast<size_t>(width) * height * 4, 1.0f);
+		for (size_t i = 0; i < static_cast<size_t>(width) * height; i++)
+		{
+			std::memcpy(&rgba[i * 4], pixels + i * channels, sizeof(float) * 3);
+		}
+		return ProjectToFaces(rgba, width, height, resolution, format, out);
+	}
 }
@@ -2,13 +2,31 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include "VizEngine/Core.h"
+#include "VizEngine/Core/AsyncHandle.h"
+#include "VizEngine/Core/HdrImage.h"
+#include "VizEngine/Core/SphericalHarmonics.h"
+#include "VizEngine/Core/TextureData.h"
 
 namespace VizEngine
 {
 	class Texture;
 
+	/**
+	 * Settings for CubemapUtils::PrefilterSpecular.
+	 */
+	struct SpecularPrefilterOptions
+	{
+		int Resolution = 256;            // Face size of mip 0 (roughness 0)
+		int MipLevels = 6;               // Roughness levels, 0 to 1 across the chain (at most 8)
+		uint32_t SampleBudget = 1u << 25; // GGX samples for the whole chain, shared evenly by the rough mips
+		int MinSamples = 16;             // Per texel bounds of each mip's share
+		int MaxSamples = 1024;
+	};
+
 	/**
 	 * Utilities for cubemap texture operations.
 	 */
@@ -18,7 +36,8 @@ namespace VizEngine
 		/**
 		 * Convert equirectangular HDR texture to cubemap.
 		 * Renders the equirectangular map to 6 cubemap faces using a shader.
-		 * This is a one-time conversion operation.
+		 * The shader, cube and framebuffer are kept for later conversions
+		 * (see ReleaseResources).
 		 * @param equirectangularMap Source HDR texture (2:1 aspect ratio)
 		 * @param resolution Resolution per cubemap face (e.g., 512, 1024)
 		 * @return Cubemap texture ready for use in skybox or IBL
@@ -27,5 +46,94 @@ namespace VizEngine
 			std::shared_ptr<Texture> equirectangularMap,
 			int resolution
 		);
+
+		/**
+		 * CPU version of EquirectangularToCubemap for tools and tests: makes no
+		 * GL calls. Tiles of all six faces are projected in parallel on the
+		 * ThreadPool with SSE2 direction-to-longitude/latitude math and
+		 * bilinear sampling (wrapping horizontally, so there is no seam).
+		 *
+		 * @param equirectangular Image as loaded by HdrImage (half, RGB9E5 or
+		 *        float; RGB or RGBA, alpha is dropped)
+		 * @param out One level with 6 faces, for Texture(const TextureData&),
+		 *        which creates the cubemap and builds its mips
+		 */
+		static bool EquirectangularToCubemapCPU(const TextureData& equirectangular, int resolution,
+			TextureData& out, HdrFormat format = HdrFormat::Half);
+
+		/**
+		 * As above, from float RGB / RGBA pixels (rows bottom to top).
+		 */
+		static bool EquirectangularToCubemapCPU(const float* pixels, int width, int height, int channels,
+			int resolution, TextureData& out, HdrFormat format = HdrFormat::Half);
+
+		/**
+		 * Load an equirectangular HDR image file as a cubemap without blocking.
+		 *
+		 * The converted faces and mips are cached next to the image (in
+		 * .vpcache, as KTX2) keyed by the file contents, resolution and
+		 * Texture::GetHdrFormat(). A hit skips decoding and conversion and
+		 * uploads the cached levels; a miss decodes on the ThreadPool,
+		 * converts on the main thread and writes the cache from a worker.
+		 */
+		static AsyncHandle<Texture> LoadEquirectangularAsync(const std::string& path, int resolution);
+
+		/**
+		 * Cache file for the cubemap of an equirectangular image.
+		 * @param sourceKey Hash of the image file
+		 */
+		static std::string GetCachePath(const std::string& equirectangularPath, uint64_t sourceKey,
+			int resolution, HdrFormat format);
+
+		/**
+		 * Read every face and mip of a cubemap created by
+		 * EquirectangularToCubemap back from the GPU (GL_RGB16F or GL_RGB8).
+		 * @param firstLevel Finest mip to read; it becomes level 0 of `out`
+		 */
+		static bool ReadFaces(const Texture& cubemap, TextureData& out, int firstLevel = 0);
+
+		/**
+		 * Diffuse irradiance of a cubemap as SH9 (see SphericalHarmonics):
+		 * reads back the mip closest to 32x32 and projects it on the CPU.
+		 */
+		static bool ProjectIrradiance(const Texture& cubemap, SH9& irradiance);
+
+		/**
+		 * Specular image-based lighting: prefilter an environment cubemap with
+		 * the GGX lobe, one roughness level per mip (roughness m / (mips - 1)),
+		 * for the split-sum approximation with GetBrdfLut().
+		 *
+		 * A single compute dispatch writes every face and mip. Each texel
+		 * importance-samples GGX; the rough mips split options.SampleBudget,
+		 * so small mips (wide lobes) get more samples per texel, and samples
+		 * read the environment mip matching their solid angle, so the
+		 * environment should have mips (as EquirectangularToCubemap and
+		 * LoadEquirectangularAsync make).
+		 *
+		 * @return GL_RGBA16F cubemap, or nullptr on failure
+		 */
+		static std::shared_ptr<Texture> PrefilterSpecular(const Texture& environment,
+			const SpecularPrefilterOptions& options = {});
+
+		/**
+		 * Mips PrefilterSpecular creates for `options`: MipLevels limited by
+		 * the resolution and the 8 output images. Shaders sample roughness r
+		 * at LOD r * (count - 1).
+		 */
+		static int GetPrefilterMipCount(const SpecularPrefilterOptions& options);
+
+		/**
+		 * Split-sum BRDF integration LUT (GL_RG16F, x = N.V, y = roughness):
+		 * specular = prefiltered * (F0 * lut.r + lut.g). It doesn't depend on
+		 * the environment, so it is computed on the first call and shared
+		 * until ReleaseResources().
+		 */
+		static std::shared_ptr<Texture> GetBrdfLut();
+
+		/**
+		 * Delete the shared conversion resources. Called by the Engine at
+		 * shutdown while the GL context still exists.
+		 */
+		static void ReleaseResources();
 	};
 }
@@ -1,14 +1,38 @@
 #include "IndexBuffer.h"
+#include <vector>
 
 namespace VizEngine
 {
 	// Constructor that generates a Elements Buffer Object and links it to indices
 	IndexBuffer::IndexBuffer(const unsigned int* indices, unsigned int count)
-		: m_ibo(0), m_Count(count)
+		: m_ibo(0), m_Count(count), m_IndexType(GL_UNSIGNED_INT)
 	{
+		// Narrow to 16-bit in one pass; give up at the first index that doesn't fit
+		std::vector<uint16_t> narrow(count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			if (indices[i] > 0xFFFF)
+			{
+				Upload(indices, count, GL_UNSIGNED_INT);
+				return;
+			}
+			narrow[i] = static_cast<uint16_t>(indices[i]);
+		}
+		Upload(narrow.data(), count, GL_UNSIGNED_SHORT);
+	}
+
+	IndexBuffer::IndexBuffer(const uint16_t* indices, unsigned int count)
+		: m_ibo(0), m_Count(count), m_IndexType(GL_UNSIGNED_SHORT)
+	{
+		Upload(indices, count, GL_UNSIGNED_SHORT);
+	}
+
+	void IndexBuffer::Upload(const void* indices, unsigned int count, unsigned int indexType)
+	{
+		m_IndexType = indexType;
 		glGenBuffers(1, &m_ibo);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(count) * GetIndexSize(), indices, GL_STATIC_DRAW);
 	}
 
 	IndexBuffer::~IndexBuffer()
@@ -21,7 +45,7 @@ namespace VizEngine
 
 	// Move constructor
 	IndexBuffer::IndexBuffer(IndexBuffer&& other) noexcept
-		: m_ibo(other.m_ibo), m_Count(other.m_Count)
+		: m_ibo(other.m_ibo), m_Count(other.m_Count), m_IndexType(other.m_IndexType)
 	{
 		other.m_ibo = 0;
 		other.m_Count = 0;
@@ -38,6 +62,7 @@ namespace VizEngine
 			}
 			m_ibo = other.m_ibo;
 			m_Count = other.m_Count;
+			m_IndexType = other.m_IndexType;
 			other.m_ibo = 0;
 			other.m_Count = 0;
 		}
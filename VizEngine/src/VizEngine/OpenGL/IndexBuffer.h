@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glad/glad.h>
+#include <cstdint>
 #include "VizEngine/Core.h"
 
 namespace VizEngine
@@ -8,8 +9,11 @@ namespace VizEngine
 	class VizEngine_API IndexBuffer
 	{
 	public:
-		// Constructor that generates a Elements Buffer Object and links it to indices
+		// Constructor that generates a Elements Buffer Object and links it to indices.
+		// Indices are stored as 16-bit whenever they all fit, halving the buffer size.
 		IndexBuffer(const unsigned int* indices, unsigned int count);
+		// 16-bit indices are uploaded as is
+		IndexBuffer(const uint16_t* indices, unsigned int count);
 		~IndexBuffer();
 
 		// Prevent copying (Rule of 5)
@@ -28,9 +32,15 @@ namespace VizEngine
 		// Getters
 		inline unsigned int GetID() const { return m_ibo; }
 		inline unsigned int GetCount() const { return m_Count; }
+		// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, as passed to glDrawElements
+		inline unsigned int GetIndexType() const { return m_IndexType; }
+		inline unsigned int GetIndexSize() const { return m_IndexType == GL_UNSIGNED_SHORT ? 2 : 4; }
 
 	private:
+		void Upload(const void* indices, unsigned int count, unsigned int indexType);
+
 		unsigned int m_ibo;
 		unsigned int m_Count;
+		unsigned int m_IndexType;
 	};
 }
\ No newline at end of file
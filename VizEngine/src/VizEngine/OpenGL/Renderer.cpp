@@ -1,4 +1,6 @@
 #include "Renderer.h"
+#include "VizEngine/Log.h"
+#include <cstring>
 
 namespace VizEngine
 {
@@ -24,7 +26,32 @@ namespace VizEngine
 		va.Bind();
 		ib.Bind();
 
-		glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr);
+		glDrawElements(GL_TRIANGLES, ib.GetCount(), ib.GetIndexType(), nullptr);
+	}
+
+	void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int indexCount, unsigned int firstIndex) const
+	{
+		shader.Bind();
+		va.Bind();
+		ib.Bind();
+
+		const void* offset = reinterpret_cast<const void*>(static_cast<uintptr_t>(firstIndex) * ib.GetIndexSize());
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), ib.GetIndexType(), offset);
+	}
+
+	void Renderer::MultiDraw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const DrawRanges& ranges) const
+	{
+		if (ranges.Empty())
+		{
+			return;
+		}
+
+		shader.Bind();
+		va.Bind();
+		ib.Bind();
+
+		glMultiDrawElements(GL_TRIANGLES, ranges.Counts.data(), ib.GetIndexType(), ranges.Offsets.data(),
+			static_cast<GLsizei>(ranges.Counts.size()));
 	}
 
 	void Renderer::EnablePolygonOffset(float factor, float units)
@@ -37,4 +64,44 @@ namespace VizEngine
 	{
 		glDisable(GL_POLYGON_OFFSET_FILL);
 	}
+
+	bool Renderer::UploadFrameUniforms()
+	{
+		if (!m_FrameBuffer)
+		{
+			m_FrameBuffer = std::make_unique<UniformBuffer>(sizeof(FrameUniforms), UniformBlockBinding::Frame, &m_FrameUniforms);
+		}
+		else if (std::memcmp(&m_FrameUniforms, &m_UploadedFrame, sizeof(FrameUniforms)) == 0)
+		{
+			return false;
+		}
+		else
+		{
+			m_FrameBuffer->SetData(&m_FrameUniforms, sizeof(FrameUniforms));
+		}
+		m_UploadedFrame = m_FrameUniforms;
+		m_FrameUploads++;
+		return true;
+	}
+
+	void Renderer::CheckUniformBlocks(const Shader& shader)
+	{
+		// Flagged on the Shader rather than by program name: GL reuses the
+		// names of programs deleted by variant eviction and reloads
+		if (shader.m_UniformBlocksChecked)
+		{
+			return;
+		}
+		shader.m_UniformBlocksChecked = true;
+		if (!ValidateUniformBlocks(shader))
+		{
+			VP_CORE_ERROR("Shader {}: uniform blocks don't match the engine's layout", shader.GetPath());
+		}
+	}
+
+	void Renderer::SetKeyword(std::string_view name, bool enabled)
+	{
+		uint64_t bit = ShaderKeywords::Get(name);
+		m_Keywords = enabled ? (m_Keywords | bit) : (m_Keywords & ~bit);
+	}
 }
@@ -4,20 +4,119 @@
 #include "VertexArray.h"
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
+#include "UniformBuffer.h"
 #include "VizEngine/Core.h"
+#include "VizEngine/Renderer/UniformBlocks.h"
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 namespace VizEngine
 {
+	/**
+	 * Index ranges for one glMultiDrawElements call.
+	 * Adjacent ranges are merged as they are added.
+	 */
+	struct DrawRanges
+	{
+		std::vector<int> Counts;
+		std::vector<const void*> Offsets;  // Byte offsets into the index buffer
+
+		void Clear()
+		{
+			Counts.clear();
+			Offsets.clear();
+			m_End = ~size_t(0);
+		}
+
+		bool Empty() const { return Counts.empty(); }
+
+		void Add(unsigned int firstIndex, unsigned int indexCount, unsigned int indexSize)
+		{
+			size_t begin = size_t(firstIndex) * indexSize;
+			if (begin == m_End)
+			{
+				Counts.back() += static_cast<int>(indexCount);
+			}
+			else
+			{
+				Counts.push_back(static_cast<int>(indexCount));
+				Offsets.push_back(reinterpret_cast<const void*>(begin));
+			}
+			m_End = begin + size_t(indexCount) * indexSize;
+		}
+
+	private:
+		size_t m_End = ~size_t(0);
+	};
+
 	class VizEngine_API Renderer
 	{
 	public:
+		Renderer() = default;
+
+		// Non-copyable (owns the frame uniform buffer)
+		Renderer(const Renderer&) = delete;
+		Renderer& operator=(const Renderer&) = delete;
+
 		void Clear(float clearColor[4]);
 		void ClearDepth();
 		void SetViewport(int x, int y, int width, int height);
 		void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
 
+		// Draw a sub-range of the index buffer (e.g. one mesh LOD)
+		void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int indexCount, unsigned int firstIndex = 0) const;
+
+		// Draw several sub-ranges in one call (e.g. the visible meshlets of a mesh)
+		void MultiDraw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const DrawRanges& ranges) const;
+
 		// Shadow mapping helpers
 		void EnablePolygonOffset(float factor, float units);
 		void DisablePolygonOffset();
+
+		// =====================================================================
+		// Per-frame uniforms (FrameData block, binding UniformBlockBinding::Frame)
+		// =====================================================================
+
+		/**
+		 * Camera, light and shadow state read by every program. Edit it, then
+		 * UploadFrameUniforms() before drawing; Scene::Render sets the camera.
+		 */
+		FrameUniforms& GetFrameUniforms() { return m_FrameUniforms; }
+
+		/**
+		 * Send the FrameData block if it changed since the last upload.
+		 * @return true if it was uploaded
+		 */
+		bool UploadFrameUniforms();
+
+		/**
+		 * ValidateUniformBlocks() once per Shader (one program); logs mismatches.
+		 */
+		void CheckUniformBlocks(const Shader& shader);
+
+		// Frame block uploads since startup
+		size_t GetFrameUploadCount() const { return m_FrameUploads; }
+
+		// =====================================================================
+		// Shader keywords
+		// =====================================================================
+
+		/**
+		 * Keywords every program is drawn with (e.g. SHADOWS while a shadow map
+		 * is bound). Scene::Render adds each material's own and draws with the
+		 * matching Shader::GetVariant, so features that are off cost no
+		 * branches in the shader.
+		 */
+		void SetKeyword(std::string_view name, bool enabled);
+		uint64_t GetKeywords() const { return m_Keywords; }
+
+	private:
+		FrameUniforms m_FrameUniforms;
+		FrameUniforms m_UploadedFrame;  // Last sent, to skip unchanged uploads
+		std::unique_ptr<UniformBuffer> m_FrameBuffer;
+		size_t m_FrameUploads = 0;
+		uint64_t m_Keywords = 0;
 	};
 }
\ No newline at end of file
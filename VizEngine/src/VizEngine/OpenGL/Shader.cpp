@@ -1,30 +1,214 @@
 #include "Shader.h"
+#include "ShaderCache.h"
+#include "VizEngine/Core/Hash.h"
 #include "VizEngine/Log.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace VizEngine
 {
+	//==========================================================================
+	// Parallel compile (GL_KHR_parallel_shader_compile, not in the glad loader)
+	//==========================================================================
+	static constexpr GLenum CompletionStatus = 0x91B1;  // GL_COMPLETION_STATUS_KHR / _ARB
+	typedef void (APIENTRYP MaxShaderCompilerThreadsProc)(GLuint count);
+
+	// Checked once, on the first compile
+	static bool InitParallelCompile()
+	{
+		static const bool supported = []
+		{
+			static const char* const extensions[][2] = {
+				{ "GL_KHR_parallel_shader_compile", "glMaxShaderCompilerThreadsKHR" },
+				{ "GL_ARB_parallel_shader_compile", "glMaxShaderCompilerThreadsARB" }
+			};
+			for (const auto& extension : extensions)
+			{
+				if (glfwExtensionSupported(extension[0]))
+				{
+					// 0xFFFFFFFF: as many threads as the driver likes
+					auto maxThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(glfwGetProcAddress(extension[1]));
+					if (maxThreads)
+					{
+						maxThreads(0xFFFFFFFFu);
+					}
+					VP_CORE_INFO("Parallel shader compile: {}", extension[0]);
+					return true;
+				}
+			}
+			VP_CORE_INFO("Parallel shader compile: not supported, programs finish on first use");
+			return false;
+		}();
+		return supported;
+	}
+
+	// Stages of a program the driver is still linking
+	struct Shader::PendingLink
+	{
+		std::string CachePath;   // Empty if the binary cache is off
+		std::string Label;       // File and keywords, for the log
+		uint64_t SourceKey = 0;
+		unsigned int Stages[2] = {};
+		const char* StageNames[2] = {};
+		int StageCount = 0;
+		std::chrono::steady_clock::time_point Start;
+	};
+
+	//==========================================================================
+	// Keywords and includes
+	//==========================================================================
+
+	static std::mutex s_KeywordMutex;
+	static std::vector<std::string> s_KeywordNames;   // Index = bit
+
+	uint64_t ShaderKeywords::Get(std::string_view name)
+	{
+		std::lock_guard<std::mutex> lock(s_KeywordMutex);
+		for (size_t i = 0; i < s_KeywordNames.size(); i++)
+		{
+			if (s_KeywordNames[i] == name)
+				return uint64_t(1) << i;
+		}
+		if (s_KeywordNames.size() >= 64)
+		{
+			VP_CORE_ERROR("Shader keyword {}: all 64 keyword bits are taken", name);
+			return 0;
+		}
+		s_KeywordNames.emplace_back(name);
+		return uint64_t(1) << (s_KeywordNames.size() - 1);
+	}
+
+	std::vector<std::string> ShaderKeywords::GetNames(uint64_t keywords)
+	{
+		std::lock_guard<std::mutex> lock(s_KeywordMutex);
+		std::vector<std::string> names;
+		for (size_t i = 0; i < s_KeywordNames.size(); i++)
+		{
+			if (keywords & (uint64_t(1) << i))
+				names.push_back(s_KeywordNames[i]);
+		}
+		return names;
+	}
+
+	// True for a directive line such as `#keywords A B` or `#include "x"`
+	static bool IsDirective(const std::string& line, std::string_view directive, size_t& end)
+	{
+		size_t start = line.find_first_not_of(" \t");
+		if (start == std::string::npos || line.compare(start, directive.size(), directive) != 0)
+			return false;
+		end = start + directive.size();
+		return end == line.size() || line[end] == ' ' || line[end] == '\t';
+	}
+
+	// `#include "file"`, the path relative to the including file
+	static bool ParseInclude(const std::string& line, std::string& target)
+	{
+		size_t end = 0;
+		if (!IsDirective(line, "#include", end))
+			return false;
+		size_t open = line.find('"', end);
+		size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+		if (close == std::string::npos)
+			return false;
+		target = line.substr(open + 1, close - open - 1);
+		return true;
+	}
+
+	// Appends a file to `out` with its #include lines expanded. Each file is
+	// pasted once per stage, so shared files may include each other.
+	static bool AppendInclude(const std::filesystem::path& path, std::ostream& out,
+		std::unordered_set<std::string>& included, int depth)
+	{
+		std::string key = path.lexically_normal().generic_string();
+		if (!included.insert(key).second)
+		{
+			return true;
+		}
+		if (depth > 16)
+		{
+			VP_CORE_ERROR("Shader include {}: nested too deep", key);
+			return false;
+		}
+
+		std::ifstream input(path, std::ios::binary);
+		if (!input)
+		{
+			VP_CORE_ERROR("Shader include not found: {}", key);
+			return false;
+		}
+
+		std::string line, target;
+		while (getline(input, line))
+		{
+			if (ParseInclude(line, target))
+			{
+				if (!AppendInclude(path.parent_path() / target, out, included, depth + 1))
+					return false;
+			}
+			else
+			{
+				out << line << '\n';
+			}
+		}
+		return true;
+	}
+
+	// Places `defines` right after #version, which has to stay the first statement
+	static std::string InjectDefines(const std::string& source, const std::string& defines)
+	{
+		if (source.empty() || defines.empty())
+		{
+			return source;
+		}
+		size_t insert = 0;
+		size_t version = source.find("#version");
+		if (version != std::string::npos)
+		{
+			size_t lineEnd = source.find('\n', version);
+			insert = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+		}
+		return source.substr(0, insert) + defines + source.substr(insert);
+	}
+
 	// Reads a .shader file and outputs two strings from the Shader Program Struct
 	ShaderPrograms Shader::ShaderParser(const std::string& shaderFile)
 	{
 		enum class ShaderType
 		{
-			NONE = -1, VERTEX = 0, FRAGMENT = 1
+			NONE = -1, VERTEX = 0, FRAGMENT = 1, COMPUTE = 2
 		};
 
 		std::ifstream input(shaderFile, std::ios::binary);
 		if (!input)
 		{
 			VP_CORE_ERROR("Failed to open shader file: {}", shaderFile);
-			return {"", ""};
+			return {};
 		}
 
-		std::string contents;
-		std::stringstream ss[2];
+		ShaderPrograms programs;
+		std::filesystem::path directory = std::filesystem::path(shaderFile).parent_path();
+		std::string contents, target;
+		std::stringstream ss[3];
+		std::unordered_set<std::string> included[3];
 		ShaderType shaderType = ShaderType::NONE;
+		size_t end = 0;
 		while (getline(input, contents))
 		{
-			if (contents.find("#shader") != std::string::npos)
+			if (IsDirective(contents, "#keywords", end))
+			{
+				std::istringstream names(contents.substr(end));
+				std::string name;
+				while (names >> name)
+				{
+					programs.Keywords.push_back(name);
+				}
+			}
+			else if (contents.find("#shader") != std::string::npos)
 			{
 				if (contents.find("vertex") != std::string::npos)
 				{
@@ -34,41 +218,261 @@ namespace VizEngine
 				{
 					shaderType = ShaderType::FRAGMENT;
 				}
+				else if (contents.find("compute") != std::string::npos)
+				{
+					shaderType = ShaderType::COMPUTE;
+				}
 			}
-			else
+			else if (shaderType != ShaderType::NONE)
 			{
-				if (shaderType != ShaderType::NONE)
+				int stage = static_cast<int>(shaderType);
+				if (ParseInclude(contents, target))
+				{
+					if (!AppendInclude(directory / target, ss[stage], included[stage], 1))
+					{
+						VP_CORE_ERROR("Failed to expand includes of shader file: {}", shaderFile);
+						return {};
+					}
+				}
+				else
 				{
-					ss[static_cast<int>(shaderType)] << contents << '\n';
+					ss[stage] << contents << '\n';
 				}
 			}
 		}
-		return {ss[0].str(), ss[1].str()};
+		programs.VertexProgram = ss[0].str();
+		programs.FragmentProgram = ss[1].str();
+		programs.ComputeProgram = ss[2].str();
+		return programs;
+	}
+
+	bool Shader::HashSource(const std::string& shaderFile, uint64_t& outHash)
+	{
+		ShaderPrograms programs = ShaderParser(shaderFile);
+		if (programs.ComputeProgram.empty() && (programs.VertexProgram.empty() || programs.FragmentProgram.empty()))
+		{
+			return false;
+		}
+
+		uint64_t hash = Hash::Bytes(programs.VertexProgram.data(), programs.VertexProgram.size());
+		hash = Hash::Combine(hash, Hash::Bytes(programs.FragmentProgram.data(), programs.FragmentProgram.size()));
+		hash = Hash::Combine(hash, Hash::Bytes(programs.ComputeProgram.data(), programs.ComputeProgram.size()));
+		for (const std::string& keyword : programs.Keywords)
+		{
+			hash = Hash::Combine(hash, Hash::FNV1a(keyword));
+		}
+		outHash = hash;
+		return true;
 	}
 
 	// Constructor that builds the final Shader
 	Shader::Shader(const std::string& shaderFile)
-		: m_shaderPath(shaderFile), m_program(0)
+		: Shader(shaderFile, DeferLink{})
+	{
+		if (!FinishLink())
+		{
+			VP_CORE_ERROR("Failed to compile/link shader: {}", shaderFile);
+			throw std::runtime_error("Failed to compile shader: " + shaderFile);
+		}
+	}
+
+	Shader::Shader(const std::string& shaderFile, DeferLink)
+		: Shader(shaderFile, std::make_shared<const ShaderPrograms>(ShaderParser(shaderFile)), 0, DeferLink{})
 	{
-		// Parse the shader file
-		ShaderPrograms shaders = ShaderParser(shaderFile);
-		if (shaders.VertexProgram.empty() || shaders.FragmentProgram.empty())
+	}
+
+	Shader::Shader(const std::string& shaderFile, std::shared_ptr<const ShaderPrograms> sources, uint64_t keywords, DeferLink)
+		: m_shaderPath(shaderFile), m_program(0), m_Sources(std::move(sources)), m_Keywords(keywords)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		const ShaderPrograms& programs = *m_Sources;
+		m_IsCompute = !programs.ComputeProgram.empty();
+		if (!m_IsCompute && (programs.VertexProgram.empty() || programs.FragmentProgram.empty()))
 		{
 			VP_CORE_ERROR("Failed to parse shader file: {}", shaderFile);
 			throw std::runtime_error("Failed to parse shader: " + shaderFile);
 		}
-		
-		// Compile and link
-		m_program = CreateShader(shaders.VertexProgram, shaders.FragmentProgram);
-		if (m_program == 0)
+		for (const std::string& keyword : programs.Keywords)
 		{
-			VP_CORE_ERROR("Failed to compile/link shader: {}", shaderFile);
-			throw std::runtime_error("Failed to compile shader: " + shaderFile);
+			m_SupportedKeywords |= ShaderKeywords::Get(keyword);
+		}
+
+		// Keywords become #defines in every stage; named in the log as "file [A B]"
+		std::string defines;
+		std::string label = shaderFile;
+		if (m_Keywords != 0)
+		{
+			label += " [";
+			for (const std::string& name : ShaderKeywords::GetNames(m_Keywords))
+			{
+				defines += "#define " + name + " 1\n";
+				label += (label.back() == '[' ? "" : " ") + name;
+			}
+			label += "]";
+		}
+		ShaderPrograms shaders;
+		shaders.VertexProgram = InjectDefines(programs.VertexProgram, defines);
+		shaders.FragmentProgram = InjectDefines(programs.FragmentProgram, defines);
+		shaders.ComputeProgram = InjectDefines(programs.ComputeProgram, defines);
+
+		// Linked programs are cached per source and driver (see ShaderCache);
+		// the key covers included files and defines, so each variant has its own entry
+		uint64_t sourceKey = Hash::Combine(Hash::Combine(
+			Hash::Bytes(shaders.VertexProgram.data(), shaders.VertexProgram.size()),
+			Hash::Bytes(shaders.FragmentProgram.data(), shaders.FragmentProgram.size())),
+			Hash::Bytes(shaders.ComputeProgram.data(), shaders.ComputeProgram.size()));
+		std::string cachePath = ShaderCache::IsEnabled() ? ShaderCache::GetCachePath(shaderFile, sourceKey) : std::string();
+		if (!cachePath.empty())
+		{
+			m_program = ShaderCache::Load(cachePath, sourceKey);
+			if (m_program != 0)
+			{
+				double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+				VP_CORE_INFO("Shader {}: loaded from binary cache in {:.2f} ms", label, ms);
+				return;
+			}
+		}
+
+		InitParallelCompile();
+
+		// Compile and link without asking for the status, which would wait
+		// for the driver; FinishLink() checks the result
+		auto pending = std::make_unique<PendingLink>();
+		pending->CachePath = std::move(cachePath);
+		pending->Label = std::move(label);
+		pending->SourceKey = sourceKey;
+		pending->Start = start;
+
+		auto addStage = [&](unsigned int type, const char* name, const std::string& source)
+		{
+			pending->Stages[pending->StageCount] = CompileShader(type, source);
+			pending->StageNames[pending->StageCount] = name;
+			pending->StageCount++;
+		};
+		if (m_IsCompute)
+		{
+			addStage(GL_COMPUTE_SHADER, "COMPUTE", shaders.ComputeProgram);
+		}
+		else
+		{
+			addStage(GL_VERTEX_SHADER, "VERTEX", shaders.VertexProgram);
+			addStage(GL_FRAGMENT_SHADER, "FRAGMENT", shaders.FragmentProgram);
+		}
+
+		unsigned int program = glCreateProgram();
+		for (int i = 0; i < pending->StageCount; i++)
+		{
+			glAttachShader(program, pending->Stages[i]);
+		}
+		if (!pending->CachePath.empty())
+		{
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+		glLinkProgram(program);
+
+		m_program = program;
+		m_Pending = std::move(pending);
+	}
+
+	std::shared_ptr<Shader> Shader::CompileAsync(const std::string& shaderFile)
+	{
+		try
+		{
+			return std::shared_ptr<Shader>(new Shader(shaderFile, DeferLink{}));
+		}
+		catch (const std::exception&)
+		{
+			return nullptr;  // Parse error, logged
+		}
+	}
+
+	bool Shader::IsParallelCompileSupported()
+	{
+		return InitParallelCompile();
+	}
+
+	bool Shader::IsReady()
+	{
+		if (!m_Pending)
+		{
+			return true;
 		}
+		if (InitParallelCompile())
+		{
+			int complete = GL_FALSE;
+			glGetProgramiv(m_program, CompletionStatus, &complete);
+			if (!complete)
+			{
+				return false;
+			}
+		}
+		FinishLink();
+		return true;
+	}
+
+	bool Shader::Wait()
+	{
+		return FinishLink();
+	}
+
+	bool Shader::FinishLink() const
+	{
+		if (!m_Pending)
+		{
+			return m_program != 0;
+		}
+		std::unique_ptr<PendingLink> pending = std::move(m_Pending);
+
+		int linked = GL_FALSE;
+		glGetProgramiv(m_program, GL_LINK_STATUS, &linked);
+		if (!linked)
+		{
+			// Report the stage that failed to compile, or the link error
+			bool compiled = true;
+			for (int i = 0; i < pending->StageCount; i++)
+			{
+				compiled &= CheckCompileErrors(pending->Stages[i], pending->StageNames[i]);
+			}
+			if (compiled)
+			{
+				CheckCompileErrors(m_program, "PROGRAM");
+			}
+		}
+
+		// Cleanup shader objects (attached to program, no longer needed)
+		for (int i = 0; i < pending->StageCount; i++)
+		{
+			glDetachShader(m_program, pending->Stages[i]);
+			glDeleteShader(pending->Stages[i]);
+		}
+
+		if (!linked)
+		{
+			glDeleteProgram(m_program);
+			m_program = 0;
+			return false;
+		}
+
+		if (!pending->CachePath.empty())
+		{
+			ShaderCache::Store(pending->CachePath, pending->SourceKey, m_program);
+		}
+
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pending->Start).count();
+		VP_CORE_INFO("Shader {}: compiled in {:.2f} ms", pending->Label, ms);
+		return true;
 	}
 
 	Shader::~Shader()
 	{
+		if (m_Pending)
+		{
+			for (int i = 0; i < m_Pending->StageCount; i++)
+			{
+				glDeleteShader(m_Pending->Stages[i]);
+			}
+		}
 		if (m_program != 0)
 		{
 			glDeleteProgram(m_program);
@@ -79,9 +483,23 @@ namespace VizEngine
 	Shader::Shader(Shader&& other) noexcept
 		: m_shaderPath(std::move(other.m_shaderPath)),
 		  m_program(other.m_program),
-		  m_LocationCache(std::move(other.m_LocationCache))
+		  m_Pending(std::move(other.m_Pending)),
+		  m_IsCompute(other.m_IsCompute),
+		  m_LocationCache(std::move(other.m_LocationCache)),
+		  m_UniformBlocks(std::move(other.m_UniformBlocks)),
+		  m_UniformBlocksReflected(other.m_UniformBlocksReflected),
+		  m_UniformBlocksChecked(other.m_UniformBlocksChecked),
+		  m_Sources(std::move(other.m_Sources)),
+		  m_Keywords(other.m_Keywords),
+		  m_SupportedKeywords(other.m_SupportedKeywords),
+		  m_Base(other.m_Base),
+		  m_Variants(std::move(other.m_Variants))
 	{
 		other.m_program = 0;
+		for (auto& [keywords, variant] : m_Variants)
+		{
+			variant->m_Base = this;
+		}
 	}
 
 	// Move assignment operator
@@ -89,21 +507,69 @@ namespace VizEngine
 	{
 		if (this != &other)
 		{
+			if (m_Pending)
+			{
+				for (int i = 0; i < m_Pending->StageCount; i++)
+				{
+					glDeleteShader(m_Pending->Stages[i]);
+				}
+			}
 			if (m_program != 0)
 			{
 				glDeleteProgram(m_program);
 			}
 			m_shaderPath = std::move(other.m_shaderPath);
 			m_program = other.m_program;
+			m_Pending = std::move(other.m_Pending);
+			m_IsCompute = other.m_IsCompute;
 			m_LocationCache = std::move(other.m_LocationCache);
+			m_UniformBlocks = std::move(other.m_UniformBlocks);
+			m_UniformBlocksReflected = other.m_UniformBlocksReflected;
+			m_UniformBlocksChecked = other.m_UniformBlocksChecked;
+			m_Sources = std::move(other.m_Sources);
+			m_Keywords = other.m_Keywords;
+			m_SupportedKeywords = other.m_SupportedKeywords;
+			m_Base = other.m_Base;
+			m_Variants = std::move(other.m_Variants);
 			other.m_program = 0;
+			for (auto& [keywords, variant] : m_Variants)
+			{
+				variant->m_Base = this;
+			}
 		}
 		return *this;
 	}
 
+	Shader& Shader::GetVariant(uint64_t keywords)
+	{
+		if (m_Base)
+		{
+			return m_Base->GetVariant(keywords);
+		}
+
+		keywords &= m_SupportedKeywords;
+		if (keywords == 0)
+		{
+			return *this;
+		}
+
+		auto it = m_Variants.find(keywords);
+		if (it == m_Variants.end())
+		{
+			auto variant = std::unique_ptr<Shader>(new Shader(m_shaderPath, m_Sources, keywords, DeferLink{}));
+			variant->m_Base = this;
+			it = m_Variants.emplace(keywords, std::move(variant)).first;
+		}
+		return *it->second;
+	}
+
 	// Bind the Shader Program
 	void Shader::Bind() const
 	{
+		if (m_Pending)
+		{
+			FinishLink();
+		}
 		glUseProgram(m_program);
 	}
 
@@ -129,95 +595,175 @@ namespace VizEngine
 		return id;
 	}
 
-	unsigned int Shader::CreateShader(const std::string& vert, const std::string& frag)
+	// utility uniform functions
+	void Shader::SetBool(UniformID id, bool value)
 	{
-		// Create Shader Program Object and get its reference
-		unsigned int program = glCreateProgram();
-
-		unsigned int vs = CompileShader(GL_VERTEX_SHADER, vert);
-		if (!CheckCompileErrors(vs, "VERTEX"))
-		{
-			glDeleteShader(vs);
-			glDeleteProgram(program);
-			return 0;
-		}
-
-		unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, frag);
-		if (!CheckCompileErrors(fs, "FRAGMENT"))
-		{
-			glDeleteShader(vs);
-			glDeleteShader(fs);
-			glDeleteProgram(program);
-			return 0;
-		}
+		glUniform1i(GetUniformLocation(id), static_cast<int>(value));
+	}
 
-		// Attach the Vertex and Fragment Shaders to the Shader Program
-		glAttachShader(program, vs);
-		glAttachShader(program, fs);
-		// Wrap-up/Link all the shaders together into the Shader Program
-		glLinkProgram(program);
-		glValidateProgram(program);
+	void Shader::SetInt(UniformID id, int value)
+	{
+		glUniform1i(GetUniformLocation(id), value);
+	}
 
-		// Cleanup shader objects (attached to program, no longer needed)
-		glDeleteShader(vs);
-		glDeleteShader(fs);
+	void Shader::SetIntArray(UniformID id, const int* values, int count)
+	{
+		glUniform1iv(GetUniformLocation(id), count, values);
+	}
 
-		if (!CheckCompileErrors(program, "PROGRAM"))
-		{
-			glDeleteProgram(program);
-			return 0;
-		}
+	void Shader::SetFloat(UniformID id, float value)
+	{
+		glUniform1f(GetUniformLocation(id), value);
+	}
 
-		return program;
+	void Shader::SetVec3(UniformID id, const glm::vec3& value)
+	{
+		glUniform3f(GetUniformLocation(id), value.x, value.y, value.z);
 	}
 
-	// utility uniform functions
-	void Shader::SetBool(const std::string& name, bool value)
+	void Shader::SetVec4(UniformID id, const glm::vec4& value)
 	{
-		glUniform1i(GetUniformLocation(name), static_cast<int>(value));
+		glUniform4f(GetUniformLocation(id), value.x, value.y, value.z, value.w);
 	}
 
-	void Shader::SetInt(const std::string& name, int value)
+	void Shader::SetColor(UniformID id, const glm::vec4& value)
 	{
-		glUniform1i(GetUniformLocation(name), value);
+		glUniform4f(GetUniformLocation(id), value.x, value.y, value.z, value.w);
 	}
 
-	void Shader::SetFloat(const std::string& name, float value)
+	void Shader::SetMatrix4fv(UniformID id, const glm::mat4& matrix)
 	{
-		glUniform1f(GetUniformLocation(name), value);
+		glUniformMatrix4fv(GetUniformLocation(id), 1, GL_FALSE, &matrix[0][0]);
 	}
 
-	void Shader::SetVec3(const std::string& name, const glm::vec3& value)
+	bool Shader::HasUniform(UniformID id)
 	{
-		glUniform3f(GetUniformLocation(name), value.x, value.y, value.z);
+		if (m_Pending)
+		{
+			FinishLink();
+		}
+
+		auto it = m_LocationCache.find(id.Key);
+		if (it != m_LocationCache.end())
+			return it->second != -1;
+
+		// Failed to compile or link: there is nothing to query
+		if (m_program == 0)
+			return false;
+
+		int location = glGetUniformLocation(m_program, id.Name);
+		m_LocationCache[id.Key] = location;
+		return location != -1;
 	}
 
-	void Shader::SetVec4(const std::string& name, const glm::vec4& value)
+	int Shader::GetUniformLocation(UniformID id)
 	{
-		glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w);
+		auto it = m_LocationCache.find(id.Key);
+		if (it != m_LocationCache.end())
+			return it->second;
+
+		if (m_Pending)
+		{
+			FinishLink();
+		}
+
+		// Failed to compile or link (already reported): no location, no warning
+		if (m_program == 0)
+			return -1;
+
+		int location = glGetUniformLocation(m_program, id.Name);
+		if (location == -1)
+			VP_CORE_WARN("Shader Uniform {} doesn't exist!", id.Name);
+
+		m_LocationCache[id.Key] = location;
+		return location;
 	}
 
-	void Shader::SetColor(const std::string& name, const glm::vec4& value)
+	const std::vector<UniformBlockInfo>& Shader::GetUniformBlocks() const
 	{
-		glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w);
+		if (!m_UniformBlocksReflected)
+		{
+			ReflectUniformBlocks();
+		}
+		return m_UniformBlocks;
 	}
 
-	void Shader::SetMatrix4fv(const std::string& name, const glm::mat4& matrix)
+	const UniformBlockInfo* Shader::FindUniformBlock(std::string_view name) const
 	{
-		glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]);
+		for (const UniformBlockInfo& block : GetUniformBlocks())
+		{
+			if (block.Name == name)
+				return &block;
+		}
+		return nullptr;
 	}
 
-	int Shader::GetUniformLocation(const std::string& name)
+	void Shader::ReflectUniformBlocks() const
 	{
-		if (m_LocationCache.find(name) != m_LocationCache.end())
-			return m_LocationCache[name];
+		if (m_Pending)
+		{
+			FinishLink();
+		}
+		m_UniformBlocksReflected = true;
+		m_UniformBlocks.clear();
+		if (m_program == 0)
+		{
+			return;
+		}
 
-		int location = glGetUniformLocation(m_program, name.c_str());
-		if (location == -1)
-			VP_CORE_WARN("Shader Uniform {} doesn't exist!", name);
+		GLint blockCount = 0, maxNameLength = 0;
+		glGetProgramInterfaceiv(m_program, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &blockCount);
+		glGetProgramInterfaceiv(m_program, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength);
+		GLint maxBlockNameLength = 0;
+		glGetProgramInterfaceiv(m_program, GL_UNIFORM_BLOCK, GL_MAX_NAME_LENGTH, &maxBlockNameLength);
+		std::vector<char> name(static_cast<size_t>(std::max(maxNameLength, maxBlockNameLength)) + 1);
 
-		m_LocationCache[name] = location;
-		return location;
+		for (GLint blockIndex = 0; blockIndex < blockCount; blockIndex++)
+		{
+			static const GLenum blockProps[] = { GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE, GL_NUM_ACTIVE_VARIABLES };
+			GLint blockValues[3] = {};
+			glGetProgramResourceiv(m_program, GL_UNIFORM_BLOCK, blockIndex, 3, blockProps, 3, nullptr, blockValues);
+
+			UniformBlockInfo block;
+			glGetProgramResourceName(m_program, GL_UNIFORM_BLOCK, blockIndex, static_cast<GLsizei>(name.size()), nullptr, name.data());
+			block.Name = name.data();
+			block.Binding = blockValues[0];
+			block.Size = blockValues[1];
+
+			std::vector<GLint> variables(static_cast<size_t>(blockValues[2]));
+			if (!variables.empty())
+			{
+				static const GLenum activeVariables = GL_ACTIVE_VARIABLES;
+				glGetProgramResourceiv(m_program, GL_UNIFORM_BLOCK, blockIndex, 1, &activeVariables,
+					static_cast<GLsizei>(variables.size()), nullptr, variables.data());
+			}
+
+			for (GLint variable : variables)
+			{
+				static const GLenum memberProps[] = { GL_TYPE, GL_OFFSET, GL_ARRAY_SIZE, GL_ARRAY_STRIDE, GL_MATRIX_STRIDE };
+				GLint memberValues[5] = {};
+				glGetProgramResourceiv(m_program, GL_UNIFORM, static_cast<GLuint>(variable), 5, memberProps, 5, nullptr, memberValues);
+
+				UniformBlockMember member;
+				glGetProgramResourceName(m_program, GL_UNIFORM, static_cast<GLuint>(variable), static_cast<GLsizei>(name.size()), nullptr, name.data());
+				member.Name = name.data();
+				// Arrays are reported as "name[0]"
+				if (member.Name.size() > 3 && member.Name.compare(member.Name.size() - 3, 3, "[0]") == 0)
+				{
+					member.Name.resize(member.Name.size() - 3);
+				}
+				member.Type = static_cast<unsigned int>(memberValues[0]);
+				member.Offset = memberValues[1];
+				member.ArraySize = memberValues[2];
+				member.ArrayStride = memberValues[3];
+				member.MatrixStride = memberValues[4];
+				block.Members.push_back(std::move(member));
+			}
+
+			std::sort(block.Members.begin(), block.Members.end(),
+				[](const UniformBlockMember& a, const UniformBlockMember& b) { return a.Offset < b.Offset; });
+			m_UniformBlocks.push_back(std::move(block));
+		}
 	}
 
 	// utility function for checking shader compilation/linking errors.
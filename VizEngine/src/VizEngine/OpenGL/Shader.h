@@ -5,17 +5,98 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <memory>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include "glm.hpp"
 #include "VizEngine/Core.h"
+#include "VizEngine/Core/Hash.h"
 
 namespace VizEngine
 {
 	// Struct to return two or more strings. For Vertex and Fragment Shader Programs from the same file.
+	// A file with a `#shader compute` section instead builds a compute program.
+	// Sections have their #include lines expanded; `#keywords A B` lines list
+	// the keywords the file has variants for (see Shader::GetVariant).
 	struct ShaderPrograms
 	{
 		std::string VertexProgram;
 		std::string FragmentProgram;
+		std::string ComputeProgram;
+		std::vector<std::string> Keywords;
+	};
+
+	/**
+	 * Engine-wide registry of shader keywords, one bit each (at most 64).
+	 * A keyword set is an OR of bits; files declare the keywords they use
+	 * with `#keywords`, and Shader::GetVariant builds a program with them
+	 * #defined.
+	 */
+	class VizEngine_API ShaderKeywords
+	{
+	public:
+		// Bit of `name`, registered on first use (0 once all 64 are taken). Thread-safe.
+		static uint64_t Get(std::string_view name);
+		// Names of the bits set in `keywords`, in bit order
+		static std::vector<std::string> GetNames(uint64_t keywords);
+	};
+
+	/**
+	 * Uniform name with its FNV-1a hash, the key of Shader's location cache.
+	 * String literals are hashed at compile time, so Set*("u_MVP", ...) makes
+	 * no std::string and hashes nothing per call; std::string names (built at
+	 * runtime) are hashed when passed.
+	 */
+	struct UniformID
+	{
+		const char* Name;   // Null-terminated, read on the first lookup only
+		uint64_t Key;
+
+		template<size_t N>
+		consteval UniformID(const char (&name)[N])
+			: Name(name), Key(Hash::FNV1a(std::string_view(name, N - 1)))
+		{
+		}
+
+		UniformID(const std::string& name)
+			: Name(name.c_str()), Key(Hash::FNV1a(name))
+		{
+		}
+	};
+
+	/**
+	 * Member of a uniform block as the driver laid it out (byte offsets).
+	 */
+	struct UniformBlockMember
+	{
+		std::string Name;
+		unsigned int Type = 0;   // GL type, e.g. GL_FLOAT_MAT4
+		int Offset = 0;
+		int ArraySize = 1;
+		int ArrayStride = 0;     // 0 if not an array
+		int MatrixStride = 0;    // 0 if not a matrix
+	};
+
+	/**
+	 * Active uniform block of a linked program (see Shader::GetUniformBlocks).
+	 */
+	struct UniformBlockInfo
+	{
+		std::string Name;
+		int Binding = 0;
+		int Size = 0;                              // Bytes the block reads from its buffer
+		std::vector<UniformBlockMember> Members;   // Sorted by offset
+
+		const UniformBlockMember* FindMember(std::string_view name) const
+		{
+			for (const UniformBlockMember& member : Members)
+			{
+				if (member.Name == name)
+					return &member;
+			}
+			return nullptr;
+		}
 	};
 
 	// Shader Class
@@ -35,38 +116,129 @@ namespace VizEngine
 		Shader(Shader&& other) noexcept;
 		Shader& operator=(Shader&& other) noexcept;
 
+		/**
+		 * Start building a shader without waiting for the driver: the stages
+		 * are compiled and the program linked with no status queries, so the
+		 * driver can work on many programs at once (on its own threads with
+		 * GL_KHR_parallel_shader_compile). A cached binary (see ShaderCache)
+		 * is loaded right away.
+		 * IsReady() finishes the program once the driver reports completion;
+		 * Wait() and the first Bind() / uniform call finish it by blocking.
+		 * @return nullptr if the file can't be parsed
+		 */
+		static std::shared_ptr<Shader> CompileAsync(const std::string& shaderFile);
+
+		// Non-blocking check of a CompileAsync program (blocks without
+		// parallel compile support). True once linked or failed (see IsValid).
+		bool IsReady();
+		// Blocks until the program is linked. Returns IsValid().
+		bool Wait();
+
+		// True if the driver compiles on background threads
+		static bool IsParallelCompileSupported();
+
+		// Content hash of a .shader file with its #includes expanded, so files
+		// that include different shared code hash differently. False if the
+		// file can't be read or parsed.
+		static bool HashSource(const std::string& shaderFile, uint64_t& outHash);
+
 		// Binds the Shader Program
 		void Bind() const;
 		// Unbinds the Shader Program
 		void Unbind() const;
 
-		// Validation
+		// Validation (a program still linking counts as valid until it fails)
 		bool IsValid() const { return m_program != 0; }
+		bool IsCompute() const { return m_IsCompute; }
+
+		// True if the program has an active uniform with this name (no warning if not)
+		bool HasUniform(UniformID id);
+
+		/**
+		 * Active uniform blocks with their binding, size and member offsets,
+		 * reflected once after linking. Lets C++ structs mirroring a std140
+		 * block be checked against what the driver actually compiled.
+		 */
+		const std::vector<UniformBlockInfo>& GetUniformBlocks() const;
+		// nullptr if the program has no active block with this name
+		const UniformBlockInfo* FindUniformBlock(std::string_view name) const;
+
+		/**
+		 * Program built with the keywords in `keywords` that this file declares
+		 * #defined (for `#ifdef SHADOWS` etc.). Undeclared keywords are ignored,
+		 * so callers pass everything that applies and programs that don't care
+		 * share one variant. *this is the variant without keywords; the others
+		 * are compiled on first request without waiting (see CompileAsync) and
+		 * kept here and in the binary cache, which keys them by source.
+		 * Uniforms set on one variant don't reach the others: shared state
+		 * belongs in uniform blocks and layout(binding = N) samplers.
+		 */
+		Shader& GetVariant(uint64_t keywords);
+		// Keywords of this variant / all keywords the file declares
+		uint64_t GetKeywords() const { return m_Keywords; }
+		uint64_t GetSupportedKeywords() const { return m_SupportedKeywords; }
+		// Variants requested so far, this one included
+		size_t GetVariantCount() const { return m_Base ? m_Base->GetVariantCount() : m_Variants.size() + 1; }
+
+		// GL program object (0 if the shader failed)
+		unsigned int GetID() const { return m_program; }
+		const std::string& GetPath() const { return m_shaderPath; }
 
 		// Utility uniform functions
-		void SetBool(const std::string& name, bool value);
-		void SetInt(const std::string& name, int value);
-		void SetFloat(const std::string& name, float value);
-		void SetVec3(const std::string& name, const glm::vec3& value);
-		void SetVec4(const std::string& name, const glm::vec4& value);
-		void SetColor(const std::string& name, const glm::vec4& value);
-		void SetMatrix4fv(const std::string& name, const glm::mat4& matrix);
+		void SetBool(UniformID id, bool value);
+		void SetInt(UniformID id, int value);
+		void SetIntArray(UniformID id, const int* values, int count);
+		void SetFloat(UniformID id, float value);
+		void SetVec3(UniformID id, const glm::vec3& value);
+		void SetVec4(UniformID id, const glm::vec4& value);
+		void SetColor(UniformID id, const glm::vec4& value);
+		void SetMatrix4fv(UniformID id, const glm::mat4& matrix);
 
 	private:
+		friend class Renderer;
+
+		struct PendingLink;
+		struct DeferLink {};
+
+		// Parses the file and issues the compile and link (see CompileAsync)
+		Shader(const std::string& shaderFile, DeferLink);
+		// Issues the compile and link of `sources` with `keywords` defined
+		Shader(const std::string& shaderFile, std::shared_ptr<const ShaderPrograms> sources, uint64_t keywords, DeferLink);
+
 		std::string m_shaderPath;
-		unsigned int m_program;
-		std::unordered_map<std::string, int> m_LocationCache;
+		mutable unsigned int m_program;
+		mutable std::unique_ptr<PendingLink> m_Pending;   // Set while the driver links
+		bool m_IsCompute = false;
+		// Keys are already hashes (UniformID::Key)
+		struct UniformKeyHash
+		{
+			size_t operator()(uint64_t key) const { return static_cast<size_t>(key); }
+		};
+		std::unordered_map<uint64_t, int, UniformKeyHash> m_LocationCache;
+		mutable std::vector<UniformBlockInfo> m_UniformBlocks;
+		mutable bool m_UniformBlocksReflected = false;
+		mutable bool m_UniformBlocksChecked = false;   // Validated by Renderer::CheckUniformBlocks
+
+		// Permutations
+		std::shared_ptr<const ShaderPrograms> m_Sources;   // Before defines, shared with the variants
+		uint64_t m_Keywords = 0;
+		uint64_t m_SupportedKeywords = 0;
+		Shader* m_Base = nullptr;                          // Owner of this variant; nullptr for the base
+		std::unordered_map<uint64_t, std::unique_ptr<Shader>> m_Variants;
 
 		// Shader parser with a return type of ShaderPrograms
-		ShaderPrograms ShaderParser(const std::string& shaderFile);
-		// Shader compiler
-		unsigned int CompileShader(unsigned int type, const std::string& source);
-		// Creates the final shader 
-		unsigned int CreateShader(const std::string& vert, const std::string& frag);
+		static ShaderPrograms ShaderParser(const std::string& shaderFile);
+		// Shader compiler (no status query)
+		static unsigned int CompileShader(unsigned int type, const std::string& source);
+		// Waits for a pending link and checks it; const so that Bind() can
+		// finish the program on first use. Returns IsValid().
+		bool FinishLink() const;
 		// Get uniform location for the set shader uniforms
-		int GetUniformLocation(const std::string& name);
+		int GetUniformLocation(UniformID id);
+		// Fills m_UniformBlocks from the linked program
+		void ReflectUniformBlocks() const;
 		// Utility function for checking shader compilation/linking errors.
 		// Returns true on success, false on error.
-		bool CheckCompileErrors(unsigned int shader, std::string type);
+		static bool CheckCompileErrors(unsigned int shader, std::string type);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "ShaderCache.h"
+#include "VizEngine/Core/Hash.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace VizEngine
+{
+	//==========================================================================
+	// On-disk layout
+	//==========================================================================
+	// [Header][Program binary]
+
+	static constexpr char CacheMagic[4] = { 'V', 'P', 'S', 'B' };
+	static constexpr uint32_t CacheVersion = 1;
+
+	struct CacheHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t SourceKey;
+		uint64_t DriverKey;
+		uint32_t BinaryFormat;
+		uint32_t BinarySize;
+	};
+
+	static std::atomic<bool> s_Enabled{ true };
+
+	void ShaderCache::SetEnabled(bool enabled)
+	{
+		s_Enabled = enabled;
+	}
+
+	bool ShaderCache::IsEnabled()
+	{
+		return s_Enabled;
+	}
+
+	// Vendor, renderer and version of the current context's driver, or 0 if
+	// it can't return program binaries. Queried once.
+	static uint64_t GetDriverKey()
+	{
+		static const uint64_t key = []
+		{
+			GLint formats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+			if (formats <= 0)
+			{
+				VP_CORE_INFO("Shader cache: driver supports no program binary formats, disabled");
+				return uint64_t(0);
+			}
+
+			uint64_t hash = Hash::FNV1aOffset;
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				const char* value = reinterpret_cast<const char*>(glGetString(name));
+				hash = Hash::FNV1a(value ? value : "", hash);
+				hash = Hash::FNV1a("|", hash);
+			}
+			return hash != 0 ? hash : uint64_t(1);
+		}();
+		return key;
+	}
+
+	std::string ShaderCache::GetCachePath(const std::string& shaderPath, uint64_t sourceKey)
+	{
+		uint64_t key = Hash::Combine(Hash::Combine(sourceKey, GetDriverKey()), CacheVersion);
+
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.glbin", static_cast<unsigned long long>(key));
+		std::filesystem::path directory = std::filesystem::path(shaderPath).parent_path() / ".vpcache";
+		return (directory / name).string();
+	}
+
+	unsigned int ShaderCache::Load(const std::string& cachePath, uint64_t sourceKey)
+	{
+		uint64_t driverKey = GetDriverKey();
+		if (!IsEnabled() || driverKey == 0)
+		{
+			return 0;
+		}
+
+		MappedFile file;
+		if (!file.Open(cachePath))
+		{
+			return 0;
+		}
+
+		CacheHeader header;
+		if (file.GetSize() < sizeof(CacheHeader))
+		{
+			VP_CORE_WARN("Shader cache: '{}' is truncated", cachePath);
+			return 0;
+		}
+		std::memcpy(&header, file.GetData(), sizeof(CacheHeader));
+		if (std::memcmp(header.Magic, CacheMagic, sizeof(CacheMagic)) != 0 || header.Version != CacheVersion ||
+			header.SourceKey != sourceKey || header.DriverKey != driverKey ||
+			file.GetSize() - sizeof(CacheHeader) < header.BinarySize)
+		{
+			VP_CORE_TRACE("Shader cache: '{}' does not match this source or driver", cachePath);
+			return 0;
+		}
+
+		unsigned int program = glCreateProgram();
+		glProgramBinary(program, header.BinaryFormat, file.GetData() + sizeof(CacheHeader),
+			static_cast<GLsizei>(header.BinarySize));
+
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		if (!linked)
+		{
+			// Drivers may reject their own binaries (e.g. after an update that
+			// kept the version string); drop the entry so it is rewritten
+			VP_CORE_WARN("Shader cache: driver rejected '{}', compiling from source", cachePath);
+			glDeleteProgram(program);
+			file.Close();
+			std::error_code ec;
+			std::filesystem::remove(cachePath, ec);
+			return 0;
+		}
+
+		return program;
+	}
+
+	bool ShaderCache::Store(const std::string& cachePath, uint64_t sourceKey, unsigned int program)
+	{
+		uint64_t driverKey = GetDriverKey();
+		if (!IsEnabled() || driverKey == 0 || program == 0)
+		{
+			return false;
+		}
+
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+		{
+			return false;
+		}
+
+		std::vector<uint8_t> out(sizeof(CacheHeader) + static_cast<size_t>(length));
+		GLenum binaryFormat = 0;
+		GLsizei written = 0;
+		glGetProgramBinary(program, length, &written, &binaryFormat, out.data() + sizeof(CacheHeader));
+		if (written <= 0)
+		{
+			return false;
+		}
+		out.resize(sizeof(CacheHeader) + static_cast<size_t>(written));
+
+		CacheHeader header = {};
+		std::memcpy(header.Magic, CacheMagic, sizeof(CacheMagic));
+		header.Version = CacheVersion;
+		header.SourceKey = sourceKey;
+		header.DriverKey = driverKey;
+		header.BinaryFormat = binaryFormat;
+		header.BinarySize = static_cast<uint32_t>(written);
+		std::memcpy(out.data(), &header, sizeof(CacheHeader));
+
+		// Temporary file and rename, so readers never see a torn file
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+		std::string tempPath = cachePath + ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+			if (!file)
+			{
+				VP_CORE_WARN("Shader cache: cannot write '{}'", tempPath);
+				return false;
+			}
+		}
+		std::filesystem::rename(tempPath, cachePath, ec);
+		if (ec)
+		{
+			VP_CORE_WARN("Shader cache: cannot replace '{}': {}", cachePath, ec.message());
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+
+		VP_CORE_TRACE("Shader cache written: {} ({} bytes)", cachePath, out.size());
+		return true;
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "VizEngine/Core.h"
+#include <cstdint>
+#include <string>
+
+namespace VizEngine
+{
+	/**
+	 * On-disk cache of linked shader programs (glGetProgramBinary).
+	 *
+	 * Entries live in .vpcache next to the shader file, named by a key of the
+	 * program's sources. The driver's vendor, renderer and version strings
+	 * are part of every entry's header, so a driver update or another GPU
+	 * misses instead of feeding the driver a binary it doesn't know; a binary
+	 * the driver rejects anyway is deleted and the caller compiles from source.
+	 *
+	 * All functions except SetEnabled / IsEnabled need the GL context.
+	 */
+	class VizEngine_API ShaderCache
+	{
+	public:
+		/**
+		 * Use the cache in Shader. On by default; also off when the driver
+		 * supports no binary formats. Thread-safe.
+		 */
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		/**
+		 * Entry for a program built from `shaderPath`.
+		 * @param sourceKey Hash of everything the program is compiled from
+		 */
+		static std::string GetCachePath(const std::string& shaderPath, uint64_t sourceKey);
+
+		/**
+		 * Create a program from a cached binary.
+		 * @return the linked program, or 0 if there is no valid entry
+		 */
+		static unsigned int Load(const std::string& cachePath, uint64_t sourceKey);
+
+		/**
+		 * Store a linked program (linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT).
+		 */
+		static bool Store(const std::string& cachePath, uint64_t sourceKey, unsigned int program);
+	};
+}
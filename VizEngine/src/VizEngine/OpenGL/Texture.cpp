@@ -1,13 +1,221 @@
 #include "Texture.h"
 #include "VizEngine/Log.h"
+#include "VizEngine/Core/Hash.h"
+#include "VizEngine/Core/HdrImage.h"
+#include "VizEngine/Core/Ktx2.h"
+#include "VizEngine/Core/MappedFile.h"
+#include "VizEngine/Core/MipGenerator.h"
+#include "VizEngine/Core/ThreadPool.h"
+#include "VizEngine/Core/UploadQueue.h"
 #include "stb_image.h"
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
 namespace VizEngine
 {
-	Texture::Texture(const std::string& path)
+	//==========================================================================
+	// Load settings
+	//==========================================================================
+	struct LoadSettings
+	{
+		bool Compress = false;
+		TextureCompressionOptions Compression;
+		bool GenerateMips = true;
+		MipOptions Mips;
+		bool Stream = false;
+		HdrFormat Hdr = HdrFormat::Half;
+		MipContent Content = MipContent::Color;  // Per load, not a global setting
+	};
+
+	static std::mutex s_SettingsMutex;
+	static LoadSettings s_Settings;
+
+	static LoadSettings GetLoadSettings()
+	{
+		std::lock_guard<std::mutex> lock(s_SettingsMutex);
+		return s_Settings;
+	}
+
+	// RGBA8 image file with a CPU-built mip chain. Same orientation as
+	// Texture(path). Runs on any thread.
+	static bool LoadWithMips(const std::string& path, const LoadSettings& settings, TextureData& out)
+	{
+		auto start = std::chrono::steady_clock::now();
+		stbi_set_flip_vertically_on_load_thread(1);
+		int width = 0, height = 0, channels = 0;
+		stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+		if (!pixels)
+		{
+			return false;
+		}
+
+		bool generated = MipGenerator::Generate(pixels, width, height, settings.Content, settings.Mips, out);
+		stbi_image_free(pixels);
+
+		VP_CORE_TRACE("Generated {} mips for {} in {:.1f} ms", out.Levels.size(), path,
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		return generated;
+	}
+
+	// BCn version of an image file, from the texture cache or freshly compressed.
+	// Same orientation as Texture(path). Runs on any thread.
+	static bool LoadCompressed(const std::string& path, const LoadSettings& settings, TextureData& out)
+	{
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			return false;
+		}
+		uint64_t sourceKey = Hash::Combine(Hash::Bytes(file.GetData(), file.GetSize()), Hash::FNV1a("Texture(path)"));
+		std::string cachePath = TextureCompressor::GetCachePath(path, sourceKey, settings.Content, settings.Mips, settings.Compression);
+		if (TextureCompressor::LoadCached(cachePath, out))
+		{
+			return true;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		stbi_set_flip_vertically_on_load_thread(1);
+		int width = 0, height = 0, channels = 0;
+		stbi_uc* pixels = stbi_load_from_memory(file.GetData(), static_cast<int>(file.GetSize()), &width, &height, &channels, 4);
+		if (!pixels)
+		{
+			return false;
+		}
+
+		BlockFormat format = TextureCompressor::ChooseFormat(pixels, width, height, settings.Content, settings.Compression);
+		bool compressed = TextureCompressor::Compress(pixels, width, height, format, settings.Content, settings.Mips, out);
+		stbi_image_free(pixels);
+		if (!compressed)
+		{
+			return false;
+		}
+		TextureCompressor::Store(cachePath, out);
+
+		VP_CORE_TRACE("Compressed {} ({}x{}) in {:.1f} ms", path, width, height,
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		return true;
+	}
+
+	// Mip chain of an LDR image file as the settings ask for it. Runs on any thread.
+	static bool LoadPrepared(const std::string& path, const LoadSettings& settings, TextureData& out)
+	{
+		if (Ktx2::IsKtx2Path(path))
+		{
+			return Ktx2::Load(path, out);
+		}
+		return settings.Compress ? LoadCompressed(path, settings, out) : LoadWithMips(path, settings, out);
+	}
+
+	// Streams reload the file; compressed images come back from the texture cache
+	static TextureStreamSource FileSource(const std::string& path, const LoadSettings& settings)
+	{
+		return [path, settings]() -> std::shared_ptr<const TextureData>
+		{
+			auto data = std::make_shared<TextureData>();
+			return LoadPrepared(path, settings, *data) ? data : nullptr;
+		};
+	}
+
+	void Texture::SetCompressOnLoad(bool enabled, const TextureCompressionOptions& options)
+	{
+		std::lock_guard<std::mutex> lock(s_SettingsMutex);
+		s_Settings.Compress = enabled;
+		s_Settings.Compression = options;
+	}
+
+	bool Texture::IsCompressOnLoad()
+	{
+		std::lock_guard<std::mutex> lock(s_SettingsMutex);
+		return s_Settings.Compress;
+	}
+
+	void Texture::SetMipsOnLoad(bool enabled, const MipOptions& options)
+	{
+		std::lock_guard<std::mutex> lock(s_SettingsMutex);
+		s_Settings.GenerateMips = enabled;
+		s_Settings.Mips = options;
+	}
+
+	bool Texture::IsMipsOnLoad()
+	{
+		std::lock_guard<std::mutex> lock(s_SettingsMutex);
+		return s_Settings.GenerateMips;
+	}
+
+	void Texture::SetStreamOnLoad(bool enabled)
+	{
+		std::lock_guard<std::mutex> lock(s_SettingsMutex);
+		s_Settings.Stream = enabled;
+	}
+
+	bool Texture::IsStreamOnLoad()
+	{
+		std::lock_guard<std::mutex> lock(s_SettingsMutex);
+		return s_Settings.Stream;
+	}
+
+	void Texture::SetHdrFormat(HdrFormat format)
+	{
+		std::lock_guard<std::mutex> lock(s_SettingsMutex);
+		s_Settings.Hdr = format;
+	}
+
+	HdrFormat Texture::GetHdrFormat()
+	{
+		std::lock_guard<std::mutex> lock(s_SettingsMutex);
+		return s_Settings.Hdr;
+	}
+
+	uint64_t Texture::GetLoadSettingsHash(bool isHDR, MipContent content)
+	{
+		LoadSettings settings = GetLoadSettings();
+		if (isHDR)
+		{
+			return Hash::Combine(Hash::FNV1a("hdr"), static_cast<uint64_t>(settings.Hdr));
+		}
+
+		// KTX2 files ignore these; they only get a separate entry per setting
+		uint64_t flags = (settings.Compress ? 1u : 0u) | (settings.GenerateMips ? 2u : 0u) | (settings.Stream ? 4u : 0u);
+		uint64_t hash = Hash::Combine(static_cast<uint64_t>(content), flags);
+		if (settings.Compress)
+		{
+			hash = Hash::Combine(hash, TextureCompressor::GetOptionsHash(settings.Compression, content, settings.Mips));
+		}
+		else if (settings.GenerateMips)
+		{
+			hash = Hash::Combine(hash, MipGenerator::GetOptionsHash(content, settings.Mips));
+		}
+		return hash;
+	}
+
+	Texture::Texture(const std::string& path, MipContent content)
 		: m_texture(0), m_FilePath(path), m_LocalBuffer(nullptr),
 		  m_Width(0), m_Height(0), m_BPP(0)
 	{
+		LoadSettings settings = GetLoadSettings();
+		settings.Content = content;
+		bool isKtx2 = Ktx2::IsKtx2Path(path);
+		if (isKtx2 || settings.Compress || settings.GenerateMips)
+		{
+			TextureData data;
+			if (LoadPrepared(path, settings, data))
+			{
+				CreateStreamed(data, settings.Stream ? FileSource(path, settings) : TextureStreamSource());
+				if (isKtx2)
+				{
+					VP_CORE_INFO("KTX2 Texture loaded: {} ({}x{}, {} levels)", path, m_Width, m_Height, data.Levels.size());
+				}
+				return;
+			}
+			if (isKtx2)
+			{
+				return;  // Ktx2::Load reported the error
+			}
+			// Fall through: the stb path below reports the error
+		}
+
 		stbi_set_flip_vertically_on_load(1);
 		m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
 
@@ -80,6 +288,167 @@ namespace VizEngine
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
+	Texture::Texture(const TextureData& data)
+		: m_texture(0), m_FilePath("prepared"), m_LocalBuffer(nullptr),
+		  m_Width(0), m_Height(0), m_BPP(0)
+	{
+		if (!data.IsValid())
+		{
+			VP_CORE_ERROR("Failed to create texture from prepared data: no levels or format");
+			return;
+		}
+		CreateFromData(data);
+	}
+
+	Texture::Texture(const TextureData& data, TextureStreamSource source)
+		: m_texture(0), m_FilePath("streamed"), m_LocalBuffer(nullptr),
+		  m_Width(0), m_Height(0), m_BPP(0)
+	{
+		if (!data.IsValid())
+		{
+			VP_CORE_ERROR("Failed to create texture from prepared data: no levels or format");
+			return;
+		}
+		CreateStreamed(data, std::move(source));
+	}
+
+	void Texture::CreateStreamed(const TextureData& data, TextureStreamSource source)
+	{
+		if (!source || data.Levels.size() < 2 || data.Faces != 1 || !TextureStreamer::Get().GetSettings().Enabled)
+		{
+			CreateFromData(data);
+			return;
+		}
+
+		m_Width = data.GetWidth();
+		m_Height = data.GetHeight();
+		m_BPP = 4;
+		m_StreamId = TextureStreamer::Get().Register(*this, data, std::move(source));
+	}
+
+	void Texture::Reallocate(const TextureData& layout, int firstLevel, int residentLevel, const TextureData* source)
+	{
+		// Keep filtering and wrapping the user may have changed
+		GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, magFilter = GL_LINEAR, wrapS = GL_REPEAT, wrapT = GL_REPEAT;
+		if (m_texture != 0)
+		{
+			glBindTexture(GL_TEXTURE_2D, m_texture);
+			glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &minFilter);
+			glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &magFilter);
+			glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &wrapS);
+			glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, &wrapT);
+		}
+
+		GLuint texture = 0;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+
+		GLsizei levelCount = static_cast<GLsizei>(layout.Levels.size());
+		const TextureData::Level& top = layout.Levels[firstLevel];
+		glTexStorage2D(GL_TEXTURE_2D, levelCount - firstLevel, layout.InternalFormat, top.Width, top.Height);
+
+		GLint alignment = 4;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		for (GLsizei level = firstLevel; level < levelCount; level++)
+		{
+			const TextureData::Level& entry = layout.Levels[level];
+			GLint target = level - firstLevel;
+			if (level >= residentLevel && m_texture != 0)
+			{
+				glCopyImageSubData(m_texture, GL_TEXTURE_2D, level - residentLevel, 0, 0, 0,
+					texture, GL_TEXTURE_2D, target, 0, 0, 0, entry.Width, entry.Height, 1);
+			}
+			else if (source && layout.Compressed)
+			{
+				glCompressedTexSubImage2D(GL_TEXTURE_2D, target, 0, 0, entry.Width, entry.Height, layout.InternalFormat,
+					static_cast<GLsizei>(entry.Size), source->GetLevelData(level));
+			}
+			else if (source)
+			{
+				glTexSubImage2D(GL_TEXTURE_2D, target, 0, 0, entry.Width, entry.Height,
+					layout.Format, layout.Type, source->GetLevelData(level));
+			}
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		if (m_texture != 0)
+		{
+			glDeleteTextures(1, &m_texture);
+		}
+		m_texture = texture;
+	}
+
+	void Texture::CreateFromData(const TextureData& data)
+	{
+		m_Width = data.GetWidth();
+		m_Height = data.GetHeight();
+		m_BPP = 4;
+		m_IsCubemap = data.Faces == 6;
+		m_IsHDR = data.Type == GL_HALF_FLOAT || data.Type == GL_FLOAT;
+		GLenum target = m_IsCubemap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+
+		glGenTextures(1, &m_texture);
+		glBindTexture(target, m_texture);
+
+		// Levels are tightly packed; the default alignment of 4 breaks odd R8/RG8 rows
+		GLint alignment = 4;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		GLsizei levelCount = static_cast<GLsizei>(data.Levels.size());
+		for (GLsizei level = 0; level < levelCount; level++)
+		{
+			const TextureData::Level& entry = data.Levels[level];
+			for (unsigned int face = 0; face < data.Faces; face++)
+			{
+				GLenum image = m_IsCubemap ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + face : GL_TEXTURE_2D;
+				if (data.Compressed)
+				{
+					glCompressedTexImage2D(image, level, data.InternalFormat, entry.Width, entry.Height, 0,
+						static_cast<GLsizei>(entry.Size / data.Faces), data.GetFaceData(level, face));
+				}
+				else
+				{
+					glTexImage2D(image, level, data.InternalFormat, entry.Width, entry.Height, 0,
+						data.Format, data.Type, data.GetFaceData(level, face));
+				}
+			}
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+		// Prebuilt chains may stop short of 1x1
+		bool generateMips = levelCount == 1 && !data.Compressed;
+		bool hasMips = levelCount > 1 || generateMips;
+		if (!generateMips)
+		{
+			glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+		}
+
+		// Cubemaps are sampled by direction and must not wrap across faces
+		GLint wrap = m_IsCubemap ? GL_CLAMP_TO_EDGE : GL_REPEAT;
+		glTexParameteri(target, GL_TEXTURE_MIN_FILTER, hasMips ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(target, GL_TEXTURE_WRAP_S, wrap);
+		glTexParameteri(target, GL_TEXTURE_WRAP_T, wrap);
+		if (m_IsCubemap)
+		{
+			glTexParameteri(target, GL_TEXTURE_WRAP_R, wrap);
+		}
+
+		if (generateMips)
+		{
+			glGenerateMipmap(target);
+		}
+		glBindTexture(target, 0);
+	}
+
 	Texture::Texture(int width, int height, unsigned int internalFormat, unsigned int format, unsigned int dataType)
 		: m_texture(0), m_FilePath("framebuffer"), m_LocalBuffer(nullptr),
 		  m_Width(width), m_Height(height), m_BPP(4)
@@ -120,36 +489,14 @@ namespace VizEngine
 
 		if (m_IsHDR)
 		{
-			// Load HDR image (floating-point data)
-			float* hdrData = stbi_loadf(filepath.c_str(), &m_Width, &m_Height, &m_BPP, 0);
-
-			if (hdrData)
+			// Packed to half / RGB9E5 on the CPU (see HdrImage)
+			TextureData data;
+			if (HdrImage::Load(filepath, GetHdrFormat(), data))
 			{
-				glGenTextures(1, &m_texture);
-				glBindTexture(GL_TEXTURE_2D, m_texture);
-
-				// Upload as 16-bit float texture (GL_RGB16F)
-				glTexImage2D(
-					GL_TEXTURE_2D,
-					0,                  // Mipmap level
-					GL_RGB16F,          // Internal format (HDR)
-					m_Width,
-					m_Height,
-					0,                  // Border
-					GL_RGB,             // Format
-					GL_FLOAT,           // Data type
-					hdrData
-				);
-
-				// Set texture parameters
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+				CreateHDR(data);
 
-				VP_CORE_INFO("HDR Texture loaded: {} ({}x{}, {} channels)", filepath, m_Width, m_Height, m_BPP);
-
-				stbi_image_free(hdrData);
+				VP_CORE_INFO("HDR Texture loaded: {} ({}x{}, {})", filepath, m_Width, m_Height,
+					data.InternalFormat == GL_RGB9_E5 ? "RGB9E5" : "half");
 			}
 			else
 			{
@@ -185,6 +532,162 @@ namespace VizEngine
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
+	Texture::Texture(const float* data, int width, int height, int channels)
+		: m_texture(0), m_FilePath("hdr"), m_LocalBuffer(nullptr),
+		  m_Width(width), m_Height(height), m_BPP(channels), m_IsHDR(true)
+	{
+		if (!data || width <= 0 || height <= 0 || (channels != 3 && channels != 4))
+		{
+			VP_CORE_ERROR("Failed to create HDR texture: invalid parameters ({}x{}, {} channels)", width, height, channels);
+			return;
+		}
+
+		TextureData packed;
+		HdrImage::Pack(data, width, height, channels, HdrFormat::Half, packed);
+		CreateHDR(packed);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	Texture::Texture(const TextureData& data, bool isHDR)
+		: m_texture(0), m_FilePath("hdr"), m_LocalBuffer(nullptr),
+		  m_Width(0), m_Height(0), m_BPP(0), m_IsHDR(isHDR)
+	{
+		if (data.Levels.empty() || data.Compressed)
+		{
+			VP_CORE_ERROR("Failed to create HDR texture: no uncompressed image data");
+			return;
+		}
+
+		CreateHDR(data);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void Texture::CreateHDR(const TextureData& data)
+	{
+		const TextureData::Level& level = data.Levels.front();
+		m_Width = level.Width;
+		m_Height = level.Height;
+		m_BPP = data.Format == GL_RGBA ? 4 : 3;
+
+		glGenTextures(1, &m_texture);
+		glBindTexture(GL_TEXTURE_2D, m_texture);
+
+		// Already in the internal format: the driver copies instead of converting
+		GLint alignment = 4;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, data.InternalFormat, m_Width, m_Height, 0,
+			data.Format, data.Type, data.Bytes.data() + level.Offset);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+		// Set texture parameters
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+
+	AsyncHandle<Texture> Texture::LoadAsync(const std::string& path, bool isHDR)
+	{
+		return LoadFileAsync(path, isHDR, MipContent::Color);
+	}
+
+	AsyncHandle<Texture> Texture::LoadAsync(const std::string& path, MipContent content)
+	{
+		return LoadFileAsync(path, false, content);
+	}
+
+	AsyncHandle<Texture> Texture::LoadFileAsync(const std::string& path, bool isHDR, MipContent content)
+	{
+		auto promise = std::make_shared<std::promise<std::shared_ptr<Texture>>>();
+		AsyncHandle<Texture> handle(promise->get_future().share());
+
+		ThreadPool::Get().Submit([path, isHDR, content, promise]()
+		{
+			LoadSettings settings = GetLoadSettings();
+			settings.Content = content;
+			bool isKtx2 = Ktx2::IsKtx2Path(path);
+			if (!isHDR && (isKtx2 || settings.Compress || settings.GenerateMips))
+			{
+				// Decoding, mip generation and compression all happen here on the worker
+				auto data = std::make_shared<TextureData>();
+				bool loaded = LoadPrepared(path, settings, *data);
+				if (!loaded)
+				{
+					if (!isKtx2)
+					{
+						VP_CORE_ERROR("Failed to load texture: {} ({})", path, stbi_failure_reason() ? stbi_failure_reason() : "unreadable file");
+					}
+					promise->set_value(nullptr);
+					return;
+				}
+
+				const char* kind = isKtx2 ? "KTX2" : (settings.Compress ? "Compressed" : "LDR");
+				UploadQueue::Get().Enqueue([path, promise, data, kind, settings]()
+				{
+					auto texture = std::make_shared<Texture>(*data, settings.Stream ? FileSource(path, settings) : TextureStreamSource());
+					texture->m_FilePath = path;
+
+					VP_CORE_INFO("{} Texture loaded: {} ({}x{}, {} levels)", kind,
+						path, data->GetWidth(), data->GetHeight(), data->Levels.size());
+					promise->set_value(std::move(texture));
+				});
+				return;
+			}
+
+			if (isHDR)
+			{
+				// Decoded and packed here; the upload needs no conversion
+				auto data = std::make_shared<TextureData>();
+				if (!HdrImage::Load(path, settings.Hdr, *data))
+				{
+					VP_CORE_ERROR("Failed to load HDR texture: {}", path);
+					promise->set_value(nullptr);
+					return;
+				}
+
+				UploadQueue::Get().Enqueue([path, promise, data]()
+				{
+					auto texture = std::make_shared<Texture>(*data, true);
+					texture->m_FilePath = path;
+
+					VP_CORE_INFO("HDR Texture loaded: {} ({}x{}, {})", path, data->GetWidth(), data->GetHeight(),
+						data->InternalFormat == GL_RGB9_E5 ? "RGB9E5" : "half");
+					promise->set_value(std::move(texture));
+				});
+				return;
+			}
+
+			// Same orientation as the synchronous constructors, without
+			// touching the global flip flag other threads may rely on
+			stbi_set_flip_vertically_on_load_thread(1);
+
+			int width = 0, height = 0, channels = 0;
+			stbi_uc* raw = stbi_load(path.c_str(), &width, &height, &channels, 4);
+
+			if (!raw)
+			{
+				VP_CORE_ERROR("Failed to load texture: {} ({})", path, stbi_failure_reason());
+				promise->set_value(nullptr);
+				return;
+			}
+
+			// Freed by whichever side drops it last (also if the upload never runs)
+			std::shared_ptr<stbi_uc> pixels(raw, stbi_image_free);
+
+			UploadQueue::Get().Enqueue([path, promise, pixels, width, height, channels]()
+			{
+				auto texture = std::make_shared<Texture>(pixels.get(), width, height, 4);
+				texture->m_FilePath = path;
+
+				VP_CORE_INFO("LDR Texture loaded: {} ({}x{}, {} channels)", path, width, height, channels);
+				promise->set_value(std::move(texture));
+			});
+		});
+
+		return handle;
+	}
+
 	Texture::Texture(int resolution, bool isHDR)
 		: m_texture(0), m_FilePath("cubemap"), m_LocalBuffer(nullptr),
 		  m_Width(resolution), m_Height(resolution), m_BPP(3),
@@ -226,8 +729,42 @@ namespace VizEngine
 			m_Width, m_Height, isHDR ? "HDR" : "LDR");
 	}
 
+	Texture::Texture(int resolution, unsigned int internalFormat, int mipLevels)
+		: m_texture(0), m_FilePath("cubemap"), m_LocalBuffer(nullptr),
+		  m_Width(resolution), m_Height(resolution), m_BPP(4),
+		  m_IsCubemap(true)
+	{
+		switch (internalFormat)
+		{
+		case GL_RGBA16F: case GL_RGB16F: case GL_RGBA32F: case GL_RGB32F:
+		case GL_R11F_G11F_B10F: case GL_RGB9_E5:
+			m_IsHDR = true;
+			break;
+		default:
+			break;
+		}
+
+		glGenTextures(1, &m_texture);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, m_texture);
+		glTexStorage2D(GL_TEXTURE_CUBE_MAP, std::max(mipLevels, 1), internalFormat, m_Width, m_Height);
+
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, mipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+		VP_CORE_INFO("Empty cubemap created: {}x{} per face, {} mips", m_Width, m_Height, std::max(mipLevels, 1));
+	}
+
 	Texture::~Texture()
 	{
+		if (m_StreamId != 0)
+		{
+			TextureStreamer::Get().Unregister(m_StreamId);
+		}
 		if (m_texture != 0)
 		{
 			glDeleteTextures(1, &m_texture);
@@ -243,12 +780,18 @@ namespace VizEngine
 		  m_Height(other.m_Height),
 		  m_BPP(other.m_BPP),
 		  m_IsCubemap(other.m_IsCubemap),
-		  m_IsHDR(other.m_IsHDR)
+		  m_IsHDR(other.m_IsHDR),
+		  m_StreamId(other.m_StreamId)
 	{
 		other.m_texture = 0;
 		other.m_LocalBuffer = nullptr;
 		other.m_IsCubemap = false;
 		other.m_IsHDR = false;
+		other.m_StreamId = 0;
+		if (m_StreamId != 0)
+		{
+			TextureStreamer::Get().Relocate(m_StreamId, *this);
+		}
 	}
 
 	// Move assignment operator
@@ -256,6 +799,10 @@ namespace VizEngine
 	{
 		if (this != &other)
 		{
+			if (m_StreamId != 0)
+			{
+				TextureStreamer::Get().Unregister(m_StreamId);
+			}
 			if (m_texture != 0)
 			{
 				glDeleteTextures(1, &m_texture);
@@ -268,10 +815,16 @@ namespace VizEngine
 			m_BPP = other.m_BPP;
 			m_IsCubemap = other.m_IsCubemap;
 			m_IsHDR = other.m_IsHDR;
+			m_StreamId = other.m_StreamId;
 			other.m_texture = 0;
 			other.m_LocalBuffer = nullptr;
 			other.m_IsCubemap = false;
 			other.m_IsHDR = false;
+			other.m_StreamId = 0;
+			if (m_StreamId != 0)
+			{
+				TextureStreamer::Get().Relocate(m_StreamId, *this);
+			}
 		}
 		return *this;
 	}
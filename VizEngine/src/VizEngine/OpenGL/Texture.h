@@ -4,18 +4,41 @@
 #include <string>
 #include <glad/glad.h>
 #include "VizEngine/Core.h"
+#include "VizEngine/Core/AsyncHandle.h"
+#include "VizEngine/Core/HdrImage.h"
+#include "VizEngine/Core/TextureCompressor.h"
+#include "VizEngine/Core/TextureData.h"
+#include "VizEngine/Core/TextureStreamer.h"
 
 namespace VizEngine
 {
 	class VizEngine_API Texture
 	{
 	public:
-		// Load from file
-		Texture(const std::string& path);
+		// Load from file (.ktx2 files keep their compressed format and mips, see Ktx2).
+		// Other images get CPU-built mips filtered as `content` says (see
+		// SetMipsOnLoad); compressed normal maps may use BC5.
+		Texture(const std::string& path, MipContent content = MipContent::Color);
 		
 		// Create from raw pixel data (for embedded textures in glTF)
 		Texture(const unsigned char* data, int width, int height, int channels = 4);
 	
+	/**
+	 * Upload a prepared mip chain as-is (block-compressed or not).
+	 * A single uncompressed level gets its mips from glGenerateMipmap;
+	 * a single compressed level is sampled without mips.
+	 * Data with 6 faces becomes a cubemap.
+	 */
+	explicit Texture(const TextureData& data);
+
+	/**
+	 * Upload only the smallest mips of `data`; the TextureStreamer loads finer
+	 * ones from `source` as renderers request them. Single-level data,
+	 * cubemaps, an empty source or disabled streaming upload everything, as
+	 * Texture(data).
+	 */
+	Texture(const TextureData& data, TextureStreamSource source);
+
 	/**
 	 * Create an empty texture for use as a framebuffer attachment.
 	 * @param width Texture width
@@ -28,21 +51,95 @@ namespace VizEngine
 
 	/**
 	 * Load HDR equirectangular image (for environment maps).
-	 * Uses stbi_loadf for floating-point data.
+	 * Radiance files are decoded in parallel straight to the upload format
+	 * (see HdrImage, SetHdrFormat); other formats go through stbi_loadf.
 	 * @param filepath Path to .hdr file
-	 * @param isHDR Set to true to load as HDR (GL_RGB16F)
+	 * @param isHDR Set to true to load as HDR (GL_RGB16F or GL_RGB9_E5)
 	 */
 	Texture(const std::string& filepath, bool isHDR);
 
+	/**
+	 * Upload level 0 of an image packed by HdrImage, without mips.
+	 */
+	Texture(const TextureData& data, bool isHDR);
+
+	/**
+	 * Create an HDR texture from floating-point pixel data (GL_RGB16F / GL_RGBA16F).
+	 * Converted to half floats before the upload.
+	 * @param channels 3 (RGB) or 4 (RGBA)
+	 */
+	Texture(const float* data, int width, int height, int channels);
+
 	/**
 	 * Create an empty cubemap texture.
 	 * @param resolution Resolution per face (e.g., 512, 1024)
 	 * @param isHDR Use HDR format (GL_RGB16F) or LDR (GL_RGB8)
 	 */
 	Texture(int resolution, bool isHDR);
+
+	/**
+	 * Create an empty cubemap with immutable storage for `mipLevels` levels,
+	 * e.g. GL_RGBA16F for compute shaders writing it as an image.
+	 * @param resolution Resolution per face of level 0
+	 */
+	Texture(int resolution, unsigned int internalFormat, int mipLevels);
 		
 		~Texture();
 
+		/**
+		 * Load an image file without blocking: decoding runs on the ThreadPool,
+		 * the GL texture is created on the main thread by the UploadQueue.
+		 * Produces the same texture as Texture(path) or Texture(path, true).
+		 */
+		static AsyncHandle<Texture> LoadAsync(const std::string& path, bool isHDR = false);
+
+		/**
+		 * LoadAsync for an LDR image whose mips are not color, e.g. a normal
+		 * or roughness map. Produces the same texture as Texture(path, content).
+		 */
+		static AsyncHandle<Texture> LoadAsync(const std::string& path, MipContent content);
+
+		/**
+		 * Make Texture(path) and LoadAsync(path) compress LDR images to BCn with
+		 * a full mip chain, cached next to the image (see TextureCompressor).
+		 * Off by default. Thread-safe.
+		 */
+		static void SetCompressOnLoad(bool enabled, const TextureCompressionOptions& options = {});
+		static bool IsCompressOnLoad();
+
+		/**
+		 * Make Texture(path) and LoadAsync(path) build LDR mip chains with
+		 * MipGenerator (filtered per MipContent, color in linear light) instead
+		 * of glGenerateMipmap. LoadAsync does this on the worker. On by
+		 * default, as ModelLoadOptions::GenerateMips. Thread-safe.
+		 */
+		static void SetMipsOnLoad(bool enabled, const MipOptions& options = {});
+		static bool IsMipsOnLoad();
+
+		/**
+		 * Make Texture(path) and LoadAsync(path) stream mip chains built by the
+		 * loaders above (KTX2, compressed or CPU mips) from their files instead
+		 * of uploading them whole (see TextureStreamer). Off by default.
+		 * Thread-safe.
+		 */
+		static void SetStreamOnLoad(bool enabled);
+		static bool IsStreamOnLoad();
+
+		/**
+		 * Format HDR images are loaded in by Texture(path, true) and
+		 * LoadAsync(path, true). RGB9E5 takes 4 bytes per texel instead of 6
+		 * but drops alpha and negative values. Half by default. Thread-safe.
+		 */
+		static void SetHdrFormat(HdrFormat format);
+		static HdrFormat GetHdrFormat();
+
+		/**
+		 * Hash of the current load settings that change what Texture(path,
+		 * isHDR) or Texture(path, content) produces (mips, compression,
+		 * streaming, HDR format). Thread-safe.
+		 */
+		static uint64_t GetLoadSettingsHash(bool isHDR, MipContent content = MipContent::Color);
+
 		// Prevent copying (Rule of 5)
 		Texture(const Texture&) = delete;
 		Texture& operator=(const Texture&) = delete;
@@ -64,13 +161,30 @@ namespace VizEngine
 		inline unsigned int GetID() const { return m_texture; }
 		inline bool IsCubemap() const { return m_IsCubemap; }
 		inline bool IsHDR() const { return m_IsHDR; }
+		inline bool IsStreamed() const { return m_StreamId != 0; }
 
 	private:
+		friend class TextureStreamer;
+
+		static AsyncHandle<Texture> LoadFileAsync(const std::string& path, bool isHDR, MipContent content);
+
+		void CreateHDR(const TextureData& data);
+		void CreateFromData(const TextureData& data);
+		void CreateStreamed(const TextureData& data, TextureStreamSource source);
+
+		/**
+		 * Recreate the texture holding levels [firstLevel, end) of `layout`.
+		 * Levels below `residentLevel` are uploaded from `source`, the others
+		 * copied from the current texture on the GPU.
+		 */
+		void Reallocate(const TextureData& layout, int firstLevel, int residentLevel, const TextureData* source);
+
 		unsigned int m_texture;
 		std::string m_FilePath;
 		unsigned char* m_LocalBuffer;
 		int m_Width, m_Height, m_BPP;
 		bool m_IsCubemap = false;
 		bool m_IsHDR = false;
+		uint64_t m_StreamId = 0;   // TextureStreamer entry, 0 if not streamed
 	};
 }
\ No newline at end of file
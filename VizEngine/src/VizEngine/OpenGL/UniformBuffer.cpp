@@ -0,0 +1,69 @@
+#include "UniformBuffer.h"
+#include "VizEngine/Log.h"
+
+namespace VizEngine
+{
+	UniformBuffer::UniformBuffer(size_t size, unsigned int binding, const void* data)
+		: m_ubo(0), m_Binding(binding), m_Size(size)
+	{
+		glGenBuffers(1, &m_ubo);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+		glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), data, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		Bind();
+	}
+
+	UniformBuffer::~UniformBuffer()
+	{
+		if (m_ubo != 0)
+		{
+			glDeleteBuffers(1, &m_ubo);
+		}
+	}
+
+	UniformBuffer::UniformBuffer(UniformBuffer&& other) noexcept
+		: m_ubo(other.m_ubo), m_Binding(other.m_Binding), m_Size(other.m_Size)
+	{
+		other.m_ubo = 0;
+		other.m_Size = 0;
+	}
+
+	UniformBuffer& UniformBuffer::operator=(UniformBuffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_ubo != 0)
+			{
+				glDeleteBuffers(1, &m_ubo);
+			}
+			m_ubo = other.m_ubo;
+			m_Binding = other.m_Binding;
+			m_Size = other.m_Size;
+			other.m_ubo = 0;
+			other.m_Size = 0;
+		}
+		return *this;
+	}
+
+	void UniformBuffer::SetData(const void* data, size_t size, size_t offset)
+	{
+		if (offset + size > m_Size)
+		{
+			VP_CORE_ERROR("UniformBuffer: write of {} bytes at {} exceeds size {}", size, offset, m_Size);
+			return;
+		}
+		glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+		glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	void UniformBuffer::Bind() const
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_ubo);
+	}
+
+	void UniformBuffer::BindRange(size_t offset, size_t size) const
+	{
+		glBindBufferRange(GL_UNIFORM_BUFFER, m_Binding, m_ubo, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+	}
+}
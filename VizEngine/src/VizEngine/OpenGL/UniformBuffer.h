@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <glad/glad.h>
+#include "VizEngine/Core.h"
+
+namespace VizEngine
+{
+	/**
+	 * Uniform buffer object bound to a fixed binding point, for GLSL blocks
+	 * declared with layout(std140, binding = N). The data layout must follow
+	 * std140 (vec3 and array elements padded to 16 bytes).
+	 */
+	class VizEngine_API UniformBuffer
+	{
+	public:
+		// Allocates `size` bytes (uninitialized if data is nullptr) and binds them to `binding`
+		UniformBuffer(size_t size, unsigned int binding, const void* data = nullptr);
+		~UniformBuffer();
+
+		// Prevent copying (Rule of 5)
+		UniformBuffer(const UniformBuffer&) = delete;
+		UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+		// Allow moving
+		UniformBuffer(UniformBuffer&& other) noexcept;
+		UniformBuffer& operator=(UniformBuffer&& other) noexcept;
+
+		// Update `size` bytes at `offset`
+		void SetData(const void* data, size_t size, size_t offset = 0);
+
+		// Bind to the binding point again (e.g. after another buffer took it)
+		void Bind() const;
+
+		// Bind `size` bytes at `offset` (a multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT)
+		void BindRange(size_t offset, size_t size) const;
+
+		inline unsigned int GetID() const { return m_ubo; }
+		inline unsigned int GetBinding() const { return m_Binding; }
+		inline size_t GetSize() const { return m_Size; }
+
+	private:
+		unsigned int m_ubo;
+		unsigned int m_Binding;
+		size_t m_Size;
+	};
+}
@@ -51,7 +51,7 @@ namespace VizEngine
 			const auto& element = elements[i];
 			glEnableVertexAttribArray(i);
 			glVertexAttribPointer(i, element.count, element.type, element.normalised, layout.GetStride(), reinterpret_cast<const void*>(static_cast<size_t>(offset)));
-			offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
+			offset += element.GetSize();
 		}
 	}
 
@@ -8,6 +8,10 @@
 
 namespace VizEngine
 {
+	// Tag types for attribute formats without a matching C++ type
+	struct HalfFloat {};      // GL_HALF_FLOAT (16-bit IEEE float)
+	struct Int2_10_10_10 {};  // GL_INT_2_10_10_10_REV (signed normalized, always 4 components)
+
 	struct VertexBufferElement
 	{
 		unsigned int type;
@@ -21,9 +25,23 @@ namespace VizEngine
 			case GL_FLOAT: return 4;
 			case GL_UNSIGNED_INT: return 4;
 			case GL_UNSIGNED_BYTE: return 1;
+			case GL_HALF_FLOAT: return 2;
+			case GL_SHORT: return 2;
+			case GL_UNSIGNED_SHORT: return 2;
+			case GL_INT_2_10_10_10_REV: return 4;  // Whole element, not per component
 			}
 			return 0;
 		}
+
+		// Size of the whole element in bytes
+		unsigned int GetSize() const
+		{
+			if (type == GL_INT_2_10_10_10_REV)
+			{
+				return GetSizeOfType(type);
+			}
+			return count * GetSizeOfType(type);
+		}
 	};
 
 	class VizEngine_API VertexBufferLayout
@@ -32,39 +50,79 @@ namespace VizEngine
 		VertexBufferLayout()
 			: m_Stride(0) {}
 
+		/**
+		 * Append an attribute of `count` components.
+		 * Integer types other than unsigned int are normalized: unsigned char and
+		 * unsigned short map to [0, 1], short and Int2_10_10_10 to [-1, 1].
+		 */
 		template<typename T>
 		void Push(unsigned int count)
 		{
-			static_assert(std::is_same<T, float>::value || std::is_same<T, unsigned int>::value || std::is_same<T, unsigned char>::value,
+			static_assert(std::is_same<T, float>::value || std::is_same<T, unsigned int>::value || std::is_same<T, unsigned char>::value ||
+				std::is_same<T, HalfFloat>::value || std::is_same<T, short>::value || std::is_same<T, unsigned short>::value ||
+				std::is_same<T, Int2_10_10_10>::value,
 				"Unsupported type for VertexBufferLayout::Push");
 		}
 
-		template<>
-		void Push<float>(unsigned int count)
-		{
-			m_Elements.push_back({GL_FLOAT, count, GL_FALSE});
-			m_Stride += count * VertexBufferElement::GetSizeOfType(GL_FLOAT);
-		}
-
-		template<>
-		void Push<unsigned int>(unsigned int count)
-		{
-			m_Elements.push_back({GL_UNSIGNED_INT, count, GL_FALSE});
-			m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
-		}
-
-		template<>
-		void Push<unsigned char>(unsigned int count)
-		{
-			m_Elements.push_back({GL_UNSIGNED_BYTE, count, GL_TRUE});
-			m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
-		}
-
 		inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
 		inline unsigned int GetStride() const { return m_Stride; }
 
 	private:
+		void PushElement(unsigned int type, unsigned int count, unsigned char normalised)
+		{
+			VertexBufferElement element = { type, count, normalised };
+			m_Elements.push_back(element);
+			m_Stride += element.GetSize();
+		}
+
 		std::vector<VertexBufferElement> m_Elements;
 		unsigned int m_Stride;
 	};
-}
\ No newline at end of file
+
+	// Explicit specializations live at namespace scope (in-class ones are an MSVC extension)
+	template<>
+	inline void VertexBufferLayout::Push<float>(unsigned int count)
+	{
+		PushElement(GL_FLOAT, count, GL_FALSE);
+	}
+
+	template<>
+	inline void VertexBufferLayout::Push<unsigned int>(unsigned int count)
+	{
+		PushElement(GL_UNSIGNED_INT, count, GL_FALSE);
+	}
+
+	template<>
+	inline void VertexBufferLayout::Push<unsigned char>(unsigned int count)
+	{
+		PushElement(GL_UNSIGNED_BYTE, count, GL_TRUE);
+	}
+
+	template<>
+	inline void VertexBufferLayout::Push<HalfFloat>(unsigned int count)
+	{
+		PushElement(GL_HALF_FLOAT, count, GL_FALSE);
+	}
+
+	template<>
+	inline void VertexBufferLayout::Push<short>(unsigned int count)
+	{
+		PushElement(GL_SHORT, count, GL_TRUE);
+	}
+
+	template<>
+	inline void VertexBufferLayout::Push<unsigned short>(unsigned int count)
+	{
+		PushElement(GL_UNSIGNED_SHORT, count, GL_TRUE);
+	}
+
+	template<>
+	inline void VertexBufferLayout::Push<Int2_10_10_10>(unsigned int count)
+	{
+		if (count != 4)
+		{
+			VP_CORE_WARN("Int2_10_10_10 attributes always have 4 components (got {})", count);
+		}
+		PushElement(GL_INT_2_10_10_10_REV, 4, GL_TRUE);
+	}
+}
@@ -5,6 +5,7 @@
 #include "VizEngine/OpenGL/Shader.h"
 #include "VizEngine/OpenGL/VertexArray.h"
 #include "VizEngine/OpenGL/VertexBuffer.h"
+#include "VizEngine/Core/AssetManager.h"
 #include "VizEngine/Core/Camera.h"
 #include "VizEngine/Log.h"
 
@@ -29,7 +30,11 @@ namespace VizEngine
 		}
 
 		// Load skybox shader
-		m_Shader = std::make_shared<Shader>("resources/shaders/skybox.shader");
+		m_Shader = AssetManager::Get().LoadShader("resources/shaders/skybox.shader");
+		if (!m_Shader)
+		{
+			throw std::runtime_error("Skybox: Failed to load skybox shader");
+		}
 
 		// Setup cube mesh
 		SetupMesh();
@@ -34,6 +34,8 @@ namespace VizEngine
 		 */
 		void Render(const Camera& camera);
 
+		const std::shared_ptr<Texture>& GetCubemap() const { return m_Cubemap; }
+
 	private:
 		std::shared_ptr<Texture> m_Cubemap;
 		std::unique_ptr<VertexArray> m_VAO;
@@ -0,0 +1,186 @@
+// VizEngine/src/VizEngine/Renderer/UniformBlocks.cpp
+
+#include "UniformBlocks.h"
+#include "VizEngine/Core/Camera.h"
+#include "VizEngine/Core/Light.h"
+#include "VizEngine/OpenGL/Shader.h"
+#include "VizEngine/Log.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+namespace VizEngine
+{
+	//==========================================================================
+	// FrameUniforms
+	//==========================================================================
+
+	void FrameUniforms::SetCamera(const Camera& camera)
+	{
+		View = camera.GetViewMatrix();
+		Projection = camera.GetProjectionMatrix();
+		ViewProjection = Projection * View;
+		CameraPosition = glm::vec4(camera.GetPosition(), 1.0f);
+	}
+
+	void FrameUniforms::SetLight(const DirectionalLight& light)
+	{
+		LightDirection = glm::vec4(light.GetDirection(), 0.0f);
+		LightAmbient = glm::vec4(light.Ambient, 0.0f);
+		LightDiffuse = glm::vec4(light.Diffuse, 0.0f);
+		LightSpecular = glm::vec4(light.Specular, 0.0f);
+	}
+
+	//==========================================================================
+	// Layout validation
+	//==========================================================================
+
+	namespace
+	{
+		struct ExpectedMember
+		{
+			std::string_view Name;
+			size_t Offset;
+			unsigned int Type;
+		};
+
+		struct ExpectedBlock
+		{
+			std::string_view Name;
+			unsigned int Binding;
+			size_t Size;
+			std::vector<ExpectedMember> Members;
+		};
+
+		const std::vector<ExpectedBlock>& GetExpectedBlocks()
+		{
+			static const std::vector<ExpectedBlock> blocks = {
+				{ "FrameData", UniformBlockBinding::Frame, sizeof(FrameUniforms), {
+					{ "u_View", offsetof(FrameUniforms, View), GL_FLOAT_MAT4 },
+					{ "u_Projection", offsetof(FrameUniforms, Projection), GL_FLOAT_MAT4 },
+					{ "u_ViewProjection", offsetof(FrameUniforms, ViewProjection), GL_FLOAT_MAT4 },
+					{ "u_LightSpaceMatrix", offsetof(FrameUniforms, LightSpaceMatrix), GL_FLOAT_MAT4 },
+					{ "u_CameraPosition", offsetof(FrameUniforms, CameraPosition), GL_FLOAT_VEC4 },
+					{ "u_LightDirection", offsetof(FrameUniforms, LightDirection), GL_FLOAT_VEC4 },
+					{ "u_LightAmbient", offsetof(FrameUniforms, LightAmbient), GL_FLOAT_VEC4 },
+					{ "u_LightDiffuse", offsetof(FrameUniforms, LightDiffuse), GL_FLOAT_VEC4 },
+					{ "u_LightSpecular", offsetof(FrameUniforms, LightSpecular), GL_FLOAT_VEC4 } } },
+				{ "MaterialData", UniformBlockBinding::Material, sizeof(MaterialUniforms), {
+					{ "u_ObjectColor", offsetof(MaterialUniforms, Color), GL_FLOAT_VEC4 },
+					{ "u_MaterialParams", offsetof(MaterialUniforms, Params), GL_FLOAT_VEC4 } } },
+				{ "ObjectData", UniformBlockBinding::Object, sizeof(ObjectUniforms), {
+					{ "u_Model", offsetof(ObjectUniforms, Model), GL_FLOAT_MAT4 },
+					{ "u_NormalMatrix", offsetof(ObjectUniforms, NormalMatrix), GL_FLOAT_MAT4 },
+					{ "u_PositionScale", offsetof(ObjectUniforms, PositionScale), GL_FLOAT_VEC4 },
+					{ "u_PositionOffset", offsetof(ObjectUniforms, PositionOffset), GL_FLOAT_VEC4 } } },
+			};
+			return blocks;
+		}
+	}
+
+	bool ValidateUniformBlocks(const Shader& shader)
+	{
+		bool valid = true;
+		for (const ExpectedBlock& expected : GetExpectedBlocks())
+		{
+			const UniformBlockInfo* block = shader.FindUniformBlock(expected.Name);
+			if (!block)
+			{
+				continue;  // Programs declare only the blocks they read
+			}
+
+			if (block->Binding != static_cast<int>(expected.Binding) || block->Size != static_cast<int>(expected.Size))
+			{
+				VP_CORE_ERROR("Uniform block {}: binding {} and {} bytes, expected binding {} and {} bytes (std140)",
+					expected.Name, block->Binding, block->Size, expected.Binding, expected.Size);
+				valid = false;
+				continue;
+			}
+
+			for (const UniformBlockMember& member : block->Members)
+			{
+				auto it = std::find_if(expected.Members.begin(), expected.Members.end(),
+					[&](const ExpectedMember& e) { return e.Name == member.Name; });
+				if (it == expected.Members.end())
+				{
+					VP_CORE_ERROR("Uniform block {}: unknown member {}", expected.Name, member.Name);
+					valid = false;
+				}
+				else if (member.Offset != static_cast<int>(it->Offset) || member.Type != it->Type)
+				{
+					VP_CORE_ERROR("Uniform block {}: {} at offset {}, expected {}", expected.Name, member.Name,
+						member.Offset, it->Offset);
+					valid = false;
+				}
+			}
+		}
+		return valid;
+	}
+
+	//==========================================================================
+	// UniformBlockArray
+	//==========================================================================
+
+	UniformBlockArray::UniformBlockArray(size_t elementSize, unsigned int binding)
+		: m_ElementSize(elementSize), m_Binding(binding)
+	{
+	}
+
+	void UniformBlockArray::Resize(size_t count)
+	{
+		if (m_Stride == 0)
+		{
+			// Queried here rather than in the constructor, which may run before the GL context exists
+			GLint alignment = 256;
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+			size_t align = static_cast<size_t>(std::max(alignment, 1));
+			m_Stride = (m_ElementSize + align - 1) / align * align;
+		}
+
+		m_Count = count;
+		if (count * m_Stride > m_Data.size())
+		{
+			// Grow by half again, so adding objects one at a time doesn't reallocate every frame
+			size_t capacity = std::max(count, m_Data.size() / m_Stride * 3 / 2);
+			m_Data.resize(capacity * m_Stride);
+			m_Buffer = std::make_unique<UniformBuffer>(m_Data.size(), m_Binding, m_Data.data());
+			m_DirtyBegin = SIZE_MAX;
+			m_DirtyEnd = 0;
+		}
+	}
+
+	void UniformBlockArray::Set(size_t index, const void* data)
+	{
+		uint8_t* element = m_Data.data() + index * m_Stride;
+		if (std::memcmp(element, data, m_ElementSize) == 0)
+		{
+			return;
+		}
+		std::memcpy(element, data, m_ElementSize);
+		m_DirtyBegin = std::min(m_DirtyBegin, index);
+		m_DirtyEnd = std::max(m_DirtyEnd, index + 1);
+	}
+
+	size_t UniformBlockArray::Upload()
+	{
+		if (m_DirtyBegin >= m_DirtyEnd || !m_Buffer)
+		{
+			return 0;
+		}
+
+		size_t offset = m_DirtyBegin * m_Stride;
+		size_t size = (m_DirtyEnd - m_DirtyBegin - 1) * m_Stride + m_ElementSize;
+		m_Buffer->SetData(m_Data.data() + offset, size, offset);
+		m_DirtyBegin = SIZE_MAX;
+		m_DirtyEnd = 0;
+		return size;
+	}
+
+	void UniformBlockArray::Bind(size_t index) const
+	{
+		m_Buffer->BindRange(index * m_Stride, m_ElementSize);
+	}
+}
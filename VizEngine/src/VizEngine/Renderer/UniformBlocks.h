@@ -0,0 +1,136 @@
+// VizEngine/src/VizEngine/Renderer/UniformBlocks.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "glm.hpp"
+#include "VizEngine/Core.h"
+#include "VizEngine/OpenGL/UniformBuffer.h"
+
+namespace VizEngine
+{
+	class Camera;
+	class Shader;
+	struct DirectionalLight;
+
+	/**
+	 * Binding points of the engine's uniform blocks. Shaders declare them as
+	 * layout(std140, binding = N); 3 is the EnvironmentLighting block
+	 * (SphericalHarmonics::UniformBinding).
+	 */
+	struct UniformBlockBinding
+	{
+		static constexpr unsigned int Frame = 0;
+		static constexpr unsigned int Material = 1;
+		static constexpr unsigned int Object = 2;
+	};
+
+	/**
+	 * std140 layout of the FrameData block: camera, light and shadow state,
+	 * uploaded once per pass and read by every program (Renderer::UploadFrameUniforms).
+	 */
+	struct FrameUniforms
+	{
+		glm::mat4 View = glm::mat4(1.0f);
+		glm::mat4 Projection = glm::mat4(1.0f);
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		glm::mat4 LightSpaceMatrix = glm::mat4(1.0f);   // Light's projection * view
+		glm::vec4 CameraPosition = glm::vec4(0.0f);     // xyz
+		glm::vec4 LightDirection = glm::vec4(0.0f, -1.0f, 0.0f, 0.0f);   // xyz, normalized
+		glm::vec4 LightAmbient = glm::vec4(0.0f);       // rgb
+		glm::vec4 LightDiffuse = glm::vec4(0.0f);       // rgb
+		glm::vec4 LightSpecular = glm::vec4(0.0f);      // rgb
+
+		void SetCamera(const Camera& camera);
+		void SetLight(const DirectionalLight& light);
+	};
+
+	/**
+	 * std140 layout of the MaterialData block (one per SceneObject).
+	 */
+	struct MaterialUniforms
+	{
+		glm::vec4 Color = glm::vec4(1.0f);
+		glm::vec4 Params = glm::vec4(0.5f, 0.0f, 0.0f, 0.0f);   // x = roughness
+	};
+
+	/**
+	 * std140 layout of the ObjectData block (one per SceneObject).
+	 * PositionScale/PositionOffset decode packed vertices (see Mesh::GetVertexFormat).
+	 */
+	struct ObjectUniforms
+	{
+		glm::mat4 Model = glm::mat4(1.0f);
+		glm::mat4 NormalMatrix = glm::mat4(1.0f);           // Inverse transpose of Model (upper 3x3)
+		glm::vec4 PositionScale = glm::vec4(1.0f);          // xyz; w = 1 for octahedral normals
+		glm::vec4 PositionOffset = glm::vec4(0.0f);         // xyz
+	};
+
+	static_assert(sizeof(FrameUniforms) == 336, "FrameUniforms must match the std140 FrameData block");
+	static_assert(sizeof(MaterialUniforms) == 32, "MaterialUniforms must match the std140 MaterialData block");
+	static_assert(sizeof(ObjectUniforms) == 160, "ObjectUniforms must match the std140 ObjectData block");
+
+	/**
+	 * Checks the engine blocks a program declares (FrameData, MaterialData,
+	 * ObjectData) against the structs above, using the layout the driver
+	 * reports (Shader::GetUniformBlocks): binding, size and every member's
+	 * offset. A mismatch means the GLSL and C++ declarations drifted apart.
+	 * @return false (and logs) on a mismatch
+	 */
+	VizEngine_API bool ValidateUniformBlocks(const Shader& shader);
+
+	/**
+	 * Array of one uniform block type in a single buffer, one element per
+	 * object, bound per draw with glBindBufferRange.
+	 *
+	 * Set() keeps a CPU copy and only marks elements whose bytes changed;
+	 * Upload() sends the dirty span in one call. Objects that don't move or
+	 * change material cost nothing per frame, and drawing them again (another
+	 * pass or camera) re-binds a range instead of re-sending uniforms.
+	 */
+	class VizEngine_API UniformBlockArray
+	{
+	public:
+		UniformBlockArray(size_t elementSize, unsigned int binding);
+
+		// Prevent copying (owns a GL buffer)
+		UniformBlockArray(const UniformBlockArray&) = delete;
+		UniformBlockArray& operator=(const UniformBlockArray&) = delete;
+
+		// Allow moving
+		UniformBlockArray(UniformBlockArray&&) noexcept = default;
+		UniformBlockArray& operator=(UniformBlockArray&&) noexcept = default;
+
+		/**
+		 * Make room for `count` elements. Growing reallocates the buffer and
+		 * uploads everything on the next Upload().
+		 */
+		void Resize(size_t count);
+		size_t Size() const { return m_Count; }
+
+		// Copy element `index` (elementSize bytes); marks it dirty if it changed
+		void Set(size_t index, const void* data);
+
+		/**
+		 * Upload the span of elements changed since the last call.
+		 * @return Bytes uploaded
+		 */
+		size_t Upload();
+
+		// Bind element `index` to the binding point
+		void Bind(size_t index) const;
+
+	private:
+		size_t m_ElementSize;
+		size_t m_Stride = 0;     // elementSize rounded up to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+		unsigned int m_Binding;
+		size_t m_Count = 0;
+		std::vector<uint8_t> m_Data;
+		size_t m_DirtyBegin = SIZE_MAX;   // Element range [begin, end)
+		size_t m_DirtyEnd = 0;
+		std::unique_ptr<UniformBuffer> m_Buffer;
+	};
+}
@@ -0,0 +1,79 @@
+#shader compute
+#version 460 core
+
+// Split-sum BRDF integration LUT (see CubemapUtils::GetBrdfLut).
+// x = N.V, y = roughness; stores the scale and bias applied to F0:
+// specular = prefiltered * (F0 * lut.r + lut.g)
+
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+layout(binding = 0, rg16f) uniform writeonly image2D u_Output;
+
+uniform int u_Size;
+uniform int u_SampleCount;
+
+const float PI = 3.14159265359;
+
+vec2 Hammersley(uint i, uint count)
+{
+    return vec2(float(i) / float(count), float(bitfieldReverse(i)) * 2.3283064365386963e-10);
+}
+
+vec3 ImportanceSampleGGX(vec2 xi, vec3 N, float alpha)
+{
+    float phi = 2.0 * PI * xi.x;
+    float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (alpha * alpha - 1.0) * xi.y));
+    float sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+
+    vec3 up = abs(N.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 tangent = normalize(cross(up, N));
+    vec3 bitangent = cross(N, tangent);
+    return normalize(tangent * (cos(phi) * sinTheta) + bitangent * (sin(phi) * sinTheta) + N * cosTheta);
+}
+
+// Smith-Schlick visibility with the IBL remapping k = alpha / 2
+float GeometrySmith(float NdotV, float NdotL, float alpha)
+{
+    float k = alpha * 0.5;
+    float gv = NdotV / (NdotV * (1.0 - k) + k);
+    float gl = NdotL / (NdotL * (1.0 - k) + k);
+    return gv * gl;
+}
+
+void main()
+{
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    if (texel.x >= u_Size || texel.y >= u_Size)
+    {
+        return;
+    }
+
+    float NdotV = (float(texel.x) + 0.5) / float(u_Size);
+    float roughness = (float(texel.y) + 0.5) / float(u_Size);
+    float alpha = roughness * roughness;
+
+    vec3 N = vec3(0.0, 0.0, 1.0);
+    vec3 V = vec3(sqrt(1.0 - NdotV * NdotV), 0.0, NdotV);
+
+    float scale = 0.0;
+    float bias = 0.0;
+    uint sampleCount = uint(u_SampleCount);
+    for (uint i = 0u; i < sampleCount; ++i)
+    {
+        vec3 H = ImportanceSampleGGX(Hammersley(i, sampleCount), N, alpha);
+        vec3 L = normalize(2.0 * dot(V, H) * H - V);
+
+        float NdotL = max(L.z, 0.0);
+        float NdotH = max(H.z, 0.0);
+        float VdotH = max(dot(V, H), 0.0);
+        if (NdotL > 0.0)
+        {
+            float visibility = GeometrySmith(NdotV, NdotL, alpha) * VdotH / (NdotH * NdotV);
+            float fresnel = pow(1.0 - VdotH, 5.0);
+            scale += (1.0 - fresnel) * visibility;
+            bias += fresnel * visibility;
+        }
+    }
+
+    imageStore(u_Output, texel, vec4(scale, bias, 0.0, 0.0) / float(sampleCount));
+}
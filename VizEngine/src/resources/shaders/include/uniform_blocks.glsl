@@ -0,0 +1,32 @@
+// Engine uniform blocks (see Renderer/UniformBlocks.h); any stage may include this
+
+// Per-frame state shared by every program (see FrameUniforms)
+layout(std140, binding = 0) uniform FrameData
+{
+	mat4 u_View;
+	mat4 u_Projection;
+	mat4 u_ViewProjection;
+	mat4 u_LightSpaceMatrix;   // Light's projection * view
+	vec4 u_CameraPosition;     // xyz
+	vec4 u_LightDirection;     // xyz, direction the light travels
+	vec4 u_LightAmbient;       // rgb
+	vec4 u_LightDiffuse;
+	vec4 u_LightSpecular;
+};
+
+// Per-object material (see MaterialUniforms)
+layout(std140, binding = 1) uniform MaterialData
+{
+	vec4 u_ObjectColor;
+	vec4 u_MaterialParams;     // x = roughness
+};
+
+// Per-object state (see ObjectUniforms). Packed meshes store positions relative
+// to their bounds and may store octahedral normals (u_PositionScale.w = 1)
+layout(std140, binding = 2) uniform ObjectData
+{
+	mat4 u_Model;
+	mat4 u_NormalMatrix;       // Inverse transpose of u_Model
+	vec4 u_PositionScale;
+	vec4 u_PositionOffset;
+};
@@ -1,3 +1,10 @@
+// Variants (see Shader::GetVariant): features that are off compile out
+// SHADOWS       shadow map bound (u_ShadowMap)
+// TEXTURED      object has a base color texture (u_MainTex)
+// ENV_DIFFUSE   SH irradiance ambient instead of u_LightAmbient
+// ENV_SPECULAR  prefiltered environment reflections
+#keywords SHADOWS TEXTURED ENV_DIFFUSE ENV_SPECULAR
+
 #shader vertex
 #version 460 core
 
@@ -10,29 +17,43 @@ out vec3 v_FragPos;
 out vec3 v_Normal;
 out vec4 v_Color;
 out vec2 v_TexCoord;
+#ifdef SHADOWS
 out vec4 v_FragPosLightSpace;  // Position in light space for shadow mapping
+#endif
+
+#include "include/uniform_blocks.glsl"
 
-uniform mat4 u_Model;
-uniform mat4 u_MVP;
-uniform mat4 u_LightSpaceMatrix;  // Light's projection * view
+vec3 DecodeOctahedral(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	return normalize(n);
+}
 
 void main()
 {
+	vec4 position = vec4(u_PositionOffset.xyz + u_PositionScale.xyz * aPos.xyz, 1.0);
+	vec3 normal = u_PositionScale.w > 0.5 ? DecodeOctahedral(aNormal.xy) : aNormal;
+
 	// World position for lighting and shadow calculations
-	vec4 worldPos = u_Model * aPos;
+	vec4 worldPos = u_Model * position;
 	v_FragPos = worldPos.xyz;
 	
-	// Transform normal to world space
-	// Note: For non-uniform scaling, use inverse transpose of model matrix
-	v_Normal = mat3(transpose(inverse(u_Model))) * aNormal;
+	// Transform normal to world space (inverse transpose, computed on the CPU
+	// once per object, keeps normals perpendicular under non-uniform scaling)
+	v_Normal = mat3(u_NormalMatrix) * normal;
 	
 	v_Color = aColor;
 	v_TexCoord = aTexCoord;
 	
+#ifdef SHADOWS
 	// Transform position to light space for shadow mapping
 	v_FragPosLightSpace = u_LightSpaceMatrix * worldPos;
+#endif
 	
-	gl_Position = u_MVP * aPos;
+	gl_Position = u_ViewProjection * worldPos;
 }
 
 #shader fragment
@@ -44,27 +65,52 @@ in vec3 v_FragPos;
 in vec3 v_Normal;
 in vec4 v_Color;
 in vec2 v_TexCoord;
+#ifdef SHADOWS
 in vec4 v_FragPosLightSpace;
+#endif
+
+#include "include/uniform_blocks.glsl"
 
-// Light properties
-uniform vec3 u_LightDirection;
-uniform vec3 u_LightAmbient;
-uniform vec3 u_LightDiffuse;
-uniform vec3 u_LightSpecular;
+// Texture units are fixed here rather than set per program, so every variant agrees
+#ifdef TEXTURED
+layout(binding = 0) uniform sampler2D u_MainTex;
+#endif
 
-// Camera position (for specular)
-uniform vec3 u_ViewPos;
+// Shadow mapping
+#ifdef SHADOWS
+layout(binding = 1) uniform sampler2D u_ShadowMap;
+#endif
 
-// Object properties
-uniform vec4 u_ObjectColor;
-uniform sampler2D u_MainTex;
+// Diffuse environment lighting as SH9 irradiance (see SphericalHarmonics)
+layout(std140, binding = 3) uniform EnvironmentLighting
+{
+	vec4 u_IrradianceSH[9];    // rgb
+	vec4 u_IrradianceParams;   // x = diffuse intensity (ENV_DIFFUSE)
+	                           // y = specular intensity, z = last prefiltered mip (ENV_SPECULAR)
+};
 
-// Material properties
-uniform float u_Roughness;
+// Specular environment lighting, split-sum GGX (see CubemapUtils::PrefilterSpecular)
+#ifdef ENV_SPECULAR
+layout(binding = 5) uniform samplerCube u_PrefilteredMap;
+layout(binding = 6) uniform sampler2D u_BrdfLut;
+#endif
 
-// Shadow mapping
-uniform sampler2D u_ShadowMap;
+#ifdef ENV_DIFFUSE
+vec3 EvaluateIrradiance(vec3 n)
+{
+	return u_IrradianceSH[0].rgb * 0.282095
+		+ u_IrradianceSH[1].rgb * (0.488603 * n.y)
+		+ u_IrradianceSH[2].rgb * (0.488603 * n.z)
+		+ u_IrradianceSH[3].rgb * (0.488603 * n.x)
+		+ u_IrradianceSH[4].rgb * (1.092548 * n.x * n.y)
+		+ u_IrradianceSH[5].rgb * (1.092548 * n.y * n.z)
+		+ u_IrradianceSH[6].rgb * (0.315392 * (3.0 * n.z * n.z - 1.0))
+		+ u_IrradianceSH[7].rgb * (1.092548 * n.x * n.z)
+		+ u_IrradianceSH[8].rgb * (0.546274 * (n.x * n.x - n.y * n.y));
+}
+#endif
 
+#ifdef SHADOWS
 // Calculate shadow with PCF (Percentage Closer Filtering)
 // Returns 0.0 = fully lit, 1.0 = fully in shadow
 float CalculateShadow(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
@@ -109,11 +155,16 @@ float CalculateShadow(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
 	
 	return shadow;
 }
+#endif
 
 void main()
 {
 	// Sample texture
+#ifdef TEXTURED
 	vec4 texColor = texture(u_MainTex, v_TexCoord);
+#else
+	vec4 texColor = vec4(1.0);
+#endif
 	
 	// Base color: texture * vertex color * object color
 	vec3 baseColor = texColor.rgb * v_Color.rgb * u_ObjectColor.rgb;
@@ -122,33 +173,56 @@ void main()
 	vec3 norm = normalize(v_Normal);
 	
 	// Light direction (pointing FROM light TO fragment, so we negate)
-	vec3 lightDir = normalize(-u_LightDirection);
+	vec3 lightDir = normalize(-u_LightDirection.xyz);
 	
 	// === AMBIENT ===
-	// Constant base illumination (always present, even in shadow)
-	vec3 ambient = u_LightAmbient * baseColor;
+	// Base illumination (always present, even in shadow): the environment's
+	// irradiance in the normal direction, or a constant without one
+#ifdef ENV_DIFFUSE
+	vec3 ambientLight = max(EvaluateIrradiance(norm), vec3(0.0)) * u_IrradianceParams.x;
+#else
+	vec3 ambientLight = u_LightAmbient.rgb;
+#endif
+	vec3 ambient = ambientLight * baseColor;
 	
 	// === DIFFUSE ===
 	// Lambert's cosine law: more light when surface faces the light
 	float diff = max(dot(norm, lightDir), 0.0);
-	vec3 diffuse = u_LightDiffuse * diff * baseColor;
+	vec3 diffuse = u_LightDiffuse.rgb * diff * baseColor;
 	
 	// === SPECULAR ===
 	// Blinn-Phong specular: uses half vector instead of reflection
-	vec3 viewDir = normalize(u_ViewPos - v_FragPos);
+	vec3 viewDir = normalize(u_CameraPosition.xyz - v_FragPos);
 	vec3 halfDir = normalize(lightDir + viewDir);
 	// Convert roughness (0=shiny, 1=matte) to Blinn-Phong exponent
-	float shininess = mix(256.0, 8.0, u_Roughness);
+	float roughness = u_MaterialParams.x;
+	float shininess = mix(256.0, 8.0, roughness);
 	float spec = pow(max(dot(norm, halfDir), 0.0), shininess);
-	vec3 specular = u_LightSpecular * spec;
+	vec3 specular = u_LightSpecular.rgb * spec;
+	
+	// === ENVIRONMENT SPECULAR ===
+	// Prefiltered radiance along the reflection (mip = roughness) scaled by
+	// the BRDF LUT's terms for a dielectric (F0 = 0.04)
+	vec3 envSpecular = vec3(0.0);
+#ifdef ENV_SPECULAR
+	vec3 reflected = reflect(-viewDir, norm);
+	float NdotV = max(dot(norm, viewDir), 0.0);
+	vec3 prefiltered = textureLod(u_PrefilteredMap, reflected, roughness * u_IrradianceParams.z).rgb;
+	vec2 brdf = texture(u_BrdfLut, vec2(NdotV, roughness)).rg;
+	envSpecular = prefiltered * (0.04 * brdf.x + brdf.y) * u_IrradianceParams.y;
+#endif
 	
 	// === SHADOW ===
 	// Calculate shadow factor (0.0 = lit, 1.0 = shadowed)
+#ifdef SHADOWS
 	float shadow = CalculateShadow(v_FragPosLightSpace, norm, lightDir);
+#else
+	float shadow = 0.0;
+#endif
 	
-	// Apply shadow to diffuse and specular (NOT to ambient)
+	// Apply shadow to diffuse and specular (NOT to ambient or the environment)
 	// Ambient light reaches shadowed areas (indirect lighting simulation)
-	vec3 result = ambient + (1.0 - shadow) * (diffuse + specular);
+	vec3 result = ambient + envSpecular + (1.0 - shadow) * (diffuse + specular);
 	
 	FragColor = vec4(result, texColor.a * u_ObjectColor.a);
 }
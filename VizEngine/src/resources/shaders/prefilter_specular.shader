@@ -0,0 +1,148 @@
+#shader compute
+#version 460 core
+
+// GGX-prefiltered specular environment (see CubemapUtils::PrefilterSpecular).
+// One dispatch writes every face and mip: workgroups are numbered across the
+// 8x8 tiles of all mips (x) and faces (z), so a workgroup covers one tile of
+// one mip, and mip m holds roughness m / (u_MipCount - 1).
+
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+#define MAX_MIPS 8
+
+layout(binding = 0, rgba16f) uniform writeonly imageCube u_Output0;
+layout(binding = 1, rgba16f) uniform writeonly imageCube u_Output1;
+layout(binding = 2, rgba16f) uniform writeonly imageCube u_Output2;
+layout(binding = 3, rgba16f) uniform writeonly imageCube u_Output3;
+layout(binding = 4, rgba16f) uniform writeonly imageCube u_Output4;
+layout(binding = 5, rgba16f) uniform writeonly imageCube u_Output5;
+layout(binding = 6, rgba16f) uniform writeonly imageCube u_Output6;
+layout(binding = 7, rgba16f) uniform writeonly imageCube u_Output7;
+
+uniform samplerCube u_Environment;
+uniform float u_EnvironmentSize;          // Face size of u_Environment level 0
+uniform int u_Resolution;                 // Face size of output mip 0
+uniform int u_MipCount;
+uniform int u_TileStart[MAX_MIPS];        // First workgroup of each mip
+uniform int u_SampleCount[MAX_MIPS];      // GGX samples per texel of each mip
+
+const float PI = 3.14159265359;
+
+void Store(int mip, ivec3 coord, vec4 value)
+{
+    // Constant image indices: the mip is uniform per workgroup, but not
+    // every driver accepts image arrays indexed by it
+    switch (mip)
+    {
+    case 0: imageStore(u_Output0, coord, value); break;
+    case 1: imageStore(u_Output1, coord, value); break;
+    case 2: imageStore(u_Output2, coord, value); break;
+    case 3: imageStore(u_Output3, coord, value); break;
+    case 4: imageStore(u_Output4, coord, value); break;
+    case 5: imageStore(u_Output5, coord, value); break;
+    case 6: imageStore(u_Output6, coord, value); break;
+    default: imageStore(u_Output7, coord, value); break;
+    }
+}
+
+// Direction through texel center `uv` (-1..1) of a face, in the GL cubemap
+// convention (rows go down the face, towards -t)
+vec3 FaceDirection(uint face, vec2 uv)
+{
+    switch (face)
+    {
+    case 0u: return normalize(vec3( 1.0, -uv.y, -uv.x));
+    case 1u: return normalize(vec3(-1.0, -uv.y,  uv.x));
+    case 2u: return normalize(vec3( uv.x,  1.0,  uv.y));
+    case 3u: return normalize(vec3( uv.x, -1.0, -uv.y));
+    case 4u: return normalize(vec3( uv.x, -uv.y,  1.0));
+    default: return normalize(vec3(-uv.x, -uv.y, -1.0));
+    }
+}
+
+vec2 Hammersley(uint i, uint count)
+{
+    return vec2(float(i) / float(count), float(bitfieldReverse(i)) * 2.3283064365386963e-10);
+}
+
+// Half vector around N distributed as GGX D(h) * (n.h)
+vec3 ImportanceSampleGGX(vec2 xi, vec3 N, float alpha)
+{
+    float phi = 2.0 * PI * xi.x;
+    float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (alpha * alpha - 1.0) * xi.y));
+    float sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+
+    vec3 up = abs(N.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 tangent = normalize(cross(up, N));
+    vec3 bitangent = cross(N, tangent);
+    return normalize(tangent * (cos(phi) * sinTheta) + bitangent * (sin(phi) * sinTheta) + N * cosTheta);
+}
+
+float DistributionGGX(float NdotH, float alpha)
+{
+    float a2 = alpha * alpha;
+    float d = NdotH * NdotH * (a2 - 1.0) + 1.0;
+    return a2 / (PI * d * d);
+}
+
+void main()
+{
+    // Mip of this workgroup
+    int tile = int(gl_WorkGroupID.x);
+    int mip = 0;
+    while (mip + 1 < u_MipCount && tile >= u_TileStart[mip + 1])
+    {
+        ++mip;
+    }
+
+    int size = max(u_Resolution >> mip, 1);
+    int tilesPerRow = (size + 7) / 8;
+    int local = tile - u_TileStart[mip];
+    ivec2 texel = ivec2(local % tilesPerRow, local / tilesPerRow) * 8 + ivec2(gl_LocalInvocationID.xy);
+    if (texel.x >= size || texel.y >= size)
+    {
+        return;
+    }
+
+    uint face = gl_WorkGroupID.z;
+    vec2 uv = (vec2(texel) + 0.5) / float(size) * 2.0 - 1.0;
+    vec3 N = FaceDirection(face, uv);
+
+    // Roughness 0 is a mirror: resample the environment at this mip's size
+    float roughness = u_MipCount > 1 ? float(mip) / float(u_MipCount - 1) : 0.0;
+    if (roughness == 0.0)
+    {
+        float lod = max(log2(u_EnvironmentSize / float(size)), 0.0);
+        Store(mip, ivec3(texel, face), vec4(textureLod(u_Environment, N, lod).rgb, 1.0));
+        return;
+    }
+
+    // Importance-sample GGX with N = V = R; each sample reads the environment
+    // mip whose texels cover its solid angle (filtered importance sampling),
+    // which removes most of the noise of small sample counts
+    float alpha = roughness * roughness;
+    uint sampleCount = uint(u_SampleCount[mip]);
+    float texelSolidAngle = 4.0 * PI / (6.0 * u_EnvironmentSize * u_EnvironmentSize);
+
+    vec3 color = vec3(0.0);
+    float weight = 0.0;
+    for (uint i = 0u; i < sampleCount; ++i)
+    {
+        vec3 H = ImportanceSampleGGX(Hammersley(i, sampleCount), N, alpha);
+        float NdotH = max(dot(N, H), 0.0);
+        vec3 L = normalize(2.0 * NdotH * H - N);
+        float NdotL = dot(N, L);
+        if (NdotL > 0.0)
+        {
+            // pdf of L: D * NdotH / (4 * VdotH), with V = N
+            float pdf = DistributionGGX(NdotH, alpha) * 0.25 + 0.0001;
+            float sampleSolidAngle = 1.0 / (float(sampleCount) * pdf);
+            float lod = max(0.5 * log2(sampleSolidAngle / texelSolidAngle) + 1.0, 0.0);
+
+            color += textureLod(u_Environment, L, lod).rgb * NdotL;
+            weight += NdotL;
+        }
+    }
+
+    Store(mip, ivec3(texel, face), vec4(color / max(weight, 0.0001), 1.0));
+}
@@ -3,13 +3,13 @@
 
 layout(location = 0) in vec4 aPos;
 
-uniform mat4 u_LightSpaceMatrix;  // Light's projection * view
-uniform mat4 u_Model;              // Model matrix
+#include "include/uniform_blocks.glsl"
 
 void main()
 {
     // Transform vertex to light's clip space
-    gl_Position = u_LightSpaceMatrix * u_Model * aPos;
+    vec4 position = vec4(u_PositionOffset.xyz + u_PositionScale.xyz * aPos.xyz, 1.0);
+    gl_Position = u_LightSpaceMatrix * u_Model * position;
 }
 
 
@@ -1,3 +1,5 @@
+#keywords TEXTURED
+
 #shader vertex
 #version 460 core
 
@@ -9,11 +11,11 @@ layout (location = 3) in vec2 aTexCoord;
 out vec4 v_Color;
 out vec2 v_TexCoord;
 
-uniform mat4 u_MVP;
+#include "include/uniform_blocks.glsl"
 
 void main()
 {
-	gl_Position = u_MVP * aPos;
+	gl_Position = u_ViewProjection * u_Model * vec4(u_PositionOffset.xyz + u_PositionScale.xyz * aPos.xyz, 1.0);
 	v_Color = aColor;
 	v_TexCoord = aTexCoord;
 }
@@ -26,12 +28,19 @@ out vec4 FragColor;
 in vec4 v_Color;
 in vec2 v_TexCoord;
 
-uniform vec4 u_ObjectColor;
-uniform sampler2D u_MainTex;
+#include "include/uniform_blocks.glsl"
+
+#ifdef TEXTURED
+layout(binding = 0) uniform sampler2D u_MainTex;
+#endif
 
 void main()
 {
+#ifdef TEXTURED
 	vec4 texColor = texture(u_MainTex, v_TexCoord);
+#else
+	vec4 texColor = vec4(1.0);
+#endif
 	vec3 combinedColor = v_Color.rgb * u_ObjectColor.rgb * texColor.rgb;
 	FragColor = vec4(combinedColor, texColor.a * u_ObjectColor.a);
 }